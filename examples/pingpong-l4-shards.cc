@@ -0,0 +1,121 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Runs a ring of PingpongL4 instances on one host, spread over several
+ * worker processes with L4ShardHelper.  Instance i listens on
+ * basePort + 2*i (UDP) and basePort + 2*i + 1 (TCP) and pings instance
+ * (i + 1) % instances.
+ *
+ *   ./waf --run "pingpong-l4-shards --instances=16 --shards=4"
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/node-module.h"
+#include "ns3/pingpong-l4-module.h"
+#include "ns3/rapidnet-module.h"
+#include "ns3/values-module.h"
+#include "ns3/l4-platform-helper.h"
+#include "ns3/l4-shard-helper.h"
+#include "ns3/uinteger.h"
+
+#define tlink(src, next) \
+  tuple (PingpongL4::TLINK, \
+	 attr ("tLink_attr1", StrValue, src), \
+	 attr ("tLink_attr2", StrValue, next))
+
+using namespace std;
+using namespace ns3;
+using namespace ns3::rapidnet;
+using namespace ns3::rapidnet::pingpongl4;
+
+NS_LOG_COMPONENT_DEFINE ("PingpongL4Shards");
+
+string
+LocSpec (string ipAddress, uint16_t port)
+{
+  stringstream ss;
+  ss << ipAddress << ":" << port;
+  return ss.str ();
+}
+
+void
+InsertLink (Ptr<RapidNetApplicationBase> app, string next)
+{
+  app->Insert (tlink (app->GetLocalLocSpec (), next));
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t instances = 4;
+  uint32_t shards = 2;
+  uint32_t basePort = 11111;
+  bool pin = false;
+  double duration = 10.0;
+  string localIPAddress = "127.0.0.1";
+
+  CommandLine cmd;
+  cmd.AddValue ("instances", "Number of RapidNet instances", instances);
+  cmd.AddValue ("shards", "Number of worker processes", shards);
+  cmd.AddValue ("basePort", "RapidNet port of instance 0", basePort);
+  cmd.AddValue ("pin", "Pin each worker to one CPU", pin);
+  cmd.AddValue ("duration", "Run time in seconds", duration);
+  cmd.AddValue ("localIPAddress", "Local IPAddress", localIPAddress);
+  cmd.Parse (argc, argv);
+
+  // Fork before the simulator and the L4 select threads exist
+  L4ShardHelper shardHelper;
+  shardHelper.SetNumShards (shards);
+  shardHelper.SetCpuAffinity (pin);
+  uint32_t shard = shardHelper.Fork ();
+
+  GlobalValue::Bind ("SimulatorImplementationType",
+		     StringValue ("ns3::RealtimeSimulatorImpl"));
+  LogComponentEnable ("PingpongL4", LOG_LEVEL_INFO);
+  LogComponentEnable ("RapidNetApplicationBase", LOG_LEVEL_INFO);
+
+  L4PlatformHelper platform;
+  PingpongL4Helper helper = PingpongL4Helper ();
+  helper.SetL4Platform (true);
+  helper.SetLocalAddress (Ipv4Address (localIPAddress.c_str ()));
+
+  vector<uint32_t> local = shardHelper.GetLocalInstances (instances);
+  ApplicationContainer apps;
+  for (vector<uint32_t>::iterator i = local.begin (); i != local.end (); i++)
+    {
+      Ptr<Node> node = CreateObject<Node> ();
+      platform.Install (node);
+      helper.SetAttribute ("RapidNetPort", UintegerValue (basePort + 2 * *i));
+      ApplicationContainer app = helper.Install (NodeContainer (node));
+      apps.Add (app);
+
+      string next = LocSpec (localIPAddress, basePort + 2 * ((*i + 1) % instances));
+      Simulator::Schedule (Seconds (2.0), &InsertLink,
+                           app.Get (0)->GetObject<RapidNetApplicationBase> (), next);
+    }
+  NS_LOG_INFO ("Shard " << shard << " hosts " << local.size () << " instances");
+
+  apps.Start (Seconds (0.0));
+  apps.Stop (Seconds (duration));
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return shardHelper.Wait ();
+}
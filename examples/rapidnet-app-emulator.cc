@@ -297,6 +297,12 @@ main(int argc, char *argv[])
 
   // Run simulator
   Simulator::Run ();
+
+  // Dump how far behind real time the events ran
+  ofstream realtimeStats ((g_dir + "/realtime-stats.txt").c_str ());
+  DynamicCast<RealtimeSimulatorImpl> (Simulator::GetImplementation ())->PrintStatistics (realtimeStats);
+  realtimeStats.close ();
+
   Simulator::Destroy ();
   decorator_out->close();
   delete decorator_out;
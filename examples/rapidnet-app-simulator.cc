@@ -85,6 +85,9 @@ string g_phy = DEFAULT_PHY;
 // The print stream for printing tuple.
 string g_printStream = DEFAULT_PRINT_STREAM_NAME;
 
+// Turn on/off the QoS wifi MAC with A-MSDU aggregation
+bool g_wifiQos = false;
+
 // The base IP address
 Ipv4Address g_baseIp = DEFAULT_BASE_IP;
 
@@ -136,6 +139,15 @@ double g_printPeriod = 0;
 // Maximum jitter in milliseconds.
 int g_maxJitter = RapidNetApplicationBase::MAX_JITTER;
 
+// End of the common prefix of the sweep in seconds, 0 => no sweep
+double g_sweepPrefix = 0;
+
+// Variants of the sweep, see AddSweepVariants
+string g_sweep = "";
+
+// Maximum number of variants which run at once, 0 => number of processors
+uint32_t g_sweepProcs = 0;
+
 int main(int argc, char *argv[])
 {
   NodeContainer nodes;
@@ -149,6 +161,7 @@ int main(int argc, char *argv[])
   cmd.AddValue ("duration", "Duration of simulation in seconds (double)", g_duration);
   cmd.AddValue ("nodes", "Number of nodes (integer)", g_numNodes);
   cmd.AddValue ("phy", "The physical layer (wifi/csma)", g_phy);
+  cmd.AddValue ("wifi-qos", "Set the QoS wifi MAC with A-MSDU aggregation (0=Off/1=On)", g_wifiQos);
   cmd.AddValue ("stream", "The print stream (cout/clog)", g_printStream);
   cmd.AddValue ("print-period", "Period for printing, 0 if only once", g_printPeriod);
   cmd.AddValue ("print-reln", "Names of relations to be printed (comma separated list of strings)", g_printReln);
@@ -168,11 +181,15 @@ int main(int argc, char *argv[])
   cmd.AddValue ("queryNum", "Number of DSR/Epidemic queries", g_queryNum);
   cmd.AddValue ("maxJitter", "Maximum value of jitter (in milliseconds)", g_maxJitter);
   cmd.AddValue ("dir", "Directory where the simulation results are dumped", g_dir);
+  cmd.AddValue ("sweep-prefix", "Time at which the sweep variants fork, 0 if no sweep (double)", g_sweepPrefix);
+  cmd.AddValue ("sweep", "Sweep variants (name[:perturbation,...];...)", g_sweep);
+  cmd.AddValue ("sweep-procs", "Maximum number of variants run at once, 0 for the number of processors", g_sweepProcs);
   cmd.Parse(argc, argv);
 
   NS_LOG_INFO ("Duration                             : " << g_duration << " sec");
   NS_LOG_INFO ("Number of nodes                      : " << g_numNodes);
   NS_LOG_INFO ("Physical layer                       : " << g_phy);
+  NS_LOG_INFO ("Wifi QoS and A-MSDU aggregation      : " << __OnOff (g_wifiQos));
   NS_LOG_INFO ("Print stream                         : " << g_printStream);
   NS_LOG_INFO ("Print Relations                      : " << g_printReln);
   NS_LOG_INFO ("Print Period                         : " << g_printPeriod);
@@ -188,6 +205,11 @@ int main(int argc, char *argv[])
   NS_LOG_INFO ("Mobility model distance attribute    : " << g_distance);
   NS_LOG_INFO ("Maximum jitter (milliseconds)        : " << g_maxJitter);
   NS_LOG_INFO ("Number of DSR/Epidemic queries       : " << g_queryNum);
+  if (g_sweepPrefix > 0)
+    {
+      NS_LOG_INFO ("Sweep prefix                         : " << g_sweepPrefix << " sec");
+      NS_LOG_INFO ("Sweep variants                       : " << g_sweep);
+    }
 
 
   //Turn on the logs
@@ -210,8 +232,13 @@ int main(int argc, char *argv[])
 
   // Install physical layer
   string pcapFilename = g_dir + "/pcaps/" + g_appName;
-  netDevices = g_phy == WIFI ? InstallWifi (nodes, g_tracePcap, pcapFilename)
+  netDevices = g_phy == WIFI ? InstallWifi (nodes, g_tracePcap, pcapFilename, g_wifiQos)
     : InstallCsma (nodes, g_tracePcap, pcapFilename);
+  if (g_phy == WIFI && g_wifiQos)
+    {
+      Config::SetDefault ("ns3::rapidnet::RapidNetApplicationBase::WifiQos",
+        BooleanValue (true));
+    }
 
   // Install IPv4 stack
   InstallIpv4 (nodes, netDevices, g_baseIp);
@@ -259,7 +286,22 @@ int main(int argc, char *argv[])
   Simulator::Stop (Seconds (g_duration));
 
   // Run simulator
-  Simulator::Run ();
+  if (g_sweepPrefix > 0)
+    {
+      // Converge once, then run each variant in its own process
+      Sweep sweep;
+      if (g_sweepProcs > 0)
+        {
+          sweep.SetMaxProcesses (g_sweepProcs);
+        }
+      AddSweepVariants (sweep, apps, g_sweep);
+      SetSweepCollector (sweep, apps, g_printReln);
+      sweep.Run (Seconds (g_sweepPrefix), g_dir + "/sweep.tsv");
+    }
+  else
+    {
+      Simulator::Run ();
+    }
   Simulator::Destroy ();
 
   decorator_out->close();
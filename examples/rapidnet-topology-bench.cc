@@ -0,0 +1,131 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Measures the startup time of side x side grids of nodes, each linked
+ * to its right and lower neighbours by point-to-point links, running
+ * Pathvector2. The links are built by PointToPointHelper and numbered
+ * by an Ipv4AddressHelper with one /30 subnet per link, which is where
+ * Ipv4AddressGenerator used to spend quadratic time. Each grid is built
+ * through Sweep::RunInChild.
+ *
+ *   ./waf --run "rapidnet-topology-bench --sides=50,100,141"
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/node-module.h"
+#include "ns3/helper-module.h"
+#include "ns3/rapidnet-module.h"
+#include "ns3/pathvector2-helper.h"
+#include "ns3/system-wall-clock-ms.h"
+
+using namespace std;
+using namespace ns3;
+using namespace ns3::rapidnet;
+using namespace ns3::rapidnet::pathvector2;
+
+static void
+InstallLinks (NodeContainer nodes, const vector<pair<uint32_t, uint32_t> >& links)
+{
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("5Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("2ms"));
+  vector<NetDeviceContainer> devices;
+  for (vector<pair<uint32_t, uint32_t> >::const_iterator it = links.begin ();
+       it != links.end (); ++it)
+    {
+      devices.push_back (p2p.Install (nodes.Get (it->first), nodes.Get (it->second)));
+    }
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("10.0.0.0", "255.255.255.252");
+  for (vector<NetDeviceContainer>::iterator it = devices.begin ();
+       it != devices.end (); ++it)
+    {
+      address.Assign (*it);
+      address.NewNetwork ();
+    }
+}
+
+static void
+Run (uint32_t side)
+{
+  vector<pair<uint32_t, uint32_t> > links;
+  for (uint32_t y = 0; y < side; y++)
+    {
+      for (uint32_t x = 0; x < side; x++)
+        {
+          if (x + 1 < side)
+            {
+              links.push_back (make_pair (y * side + x, y * side + x + 1));
+            }
+          if (y + 1 < side)
+            {
+              links.push_back (make_pair (y * side + x, (y + 1) * side + x));
+            }
+        }
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  NodeContainer nodes;
+  nodes.Create (side * side);
+  InstallLinks (nodes, links);
+  unsigned long topology = clock.End ();
+
+  clock.Start ();
+  ApplicationContainer apps = Create<Pathvector2Helper> ()->Install (nodes);
+  apps.Start (Seconds (0.0));
+  unsigned long install = clock.End ();
+
+  cout << nodes.GetN () << "\t" << links.size () << "\t" << topology
+       << "\t" << install << "\t" << topology + install << endl;
+  Simulator::Destroy ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  string sides = "100";
+
+  CommandLine cmd;
+  cmd.AddValue ("sides", "Comma-separated numbers of nodes on each side of the grids", sides);
+  cmd.Parse (argc, argv);
+
+  cout << "nodes\tlinks\ttopology(ms)\tapps(ms)\ttotal(ms)" << endl;
+  istringstream list (sides);
+  string side;
+  while (getline (list, side, ','))
+    {
+      if (!Sweep::RunInChild (MakeBoundCallback (&Run, (uint32_t) atoi (side.c_str ()))))
+        {
+          cerr << "run " << side << " failed" << endl;
+          return 1;
+        }
+    }
+  return 0;
+}
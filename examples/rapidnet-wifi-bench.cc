@@ -0,0 +1,202 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Runs Pathvector2 on a static grid of wifi nodes, once with the
+ * non-QoS adhoc MAC and once with the QoS adhoc MAC, A-MSDU aggregation
+ * and tuples tagged with their priority class, from the same seed, each
+ * through Sweep::RunInChild. The path tuples are sent to the neighbours,
+ * so that they can be aggregated, while the discovery beacons are
+ * broadcast. For each configuration, it reports the tuples received per
+ * second and the convergence time, the last time a bestPath tuple changed
+ * at any node.
+ *
+ *   ./waf --run "rapidnet-wifi-bench --side=4 --spacing=80 --duration=60"
+ */
+
+#include <iostream>
+#include <string>
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/node-module.h"
+#include "ns3/helper-module.h"
+#include "ns3/rapidnet-module.h"
+#include "ns3/values-module.h"
+#include "ns3/pathvector2-helper.h"
+#include "ns3/system-wall-clock-ms.h"
+
+using namespace std;
+using namespace ns3;
+using namespace ns3::rapidnet;
+using namespace ns3::rapidnet::pathvector2;
+
+#define BEST_PATH "bestPath"
+
+struct BenchConfig
+{
+  bool qos;
+  uint32_t side;
+  double spacing;
+  double duration;
+  uint32_t seed;
+  uint32_t maxAmsduSize;
+};
+
+struct BenchResult
+{
+  uint64_t sent;
+  uint64_t received;
+  uint32_t paths;
+  Time converged;
+  unsigned long ms;
+};
+
+static uint64_t g_digest;
+
+static uint64_t
+GetDigest (ApplicationContainer apps, uint32_t *paths)
+{
+  uint64_t digest = 0;
+  *paths = 0;
+  for (ApplicationContainer::Iterator it = apps.Begin (); it != apps.End (); ++it)
+    {
+      Ptr<RapidNetApplicationBase> app = DynamicCast<RapidNetApplicationBase, Application> (*it);
+      list<Ptr<Tuple> > tuples = app->GetRelation (BEST_PATH)->GetAllTuples ();
+      for (list<Ptr<Tuple> >::iterator jt = tuples.begin (); jt != tuples.end (); ++jt)
+        {
+          ostringstream os;
+          os << *jt;
+          string s = os.str ();
+          uint64_t hash = 14695981039346656037ULL;
+          for (string::iterator c = s.begin (); c != s.end (); ++c)
+            {
+              hash = (hash ^ (unsigned char) *c) * 1099511628211ULL;
+            }
+          // order-independent: the relations are hash maps.
+          digest += hash;
+          (*paths)++;
+        }
+    }
+  return digest;
+}
+
+static void
+Sample (ApplicationContainer apps, Time period, BenchResult *result)
+{
+  uint32_t paths;
+  uint64_t digest = GetDigest (apps, &paths);
+  if (digest != g_digest)
+    {
+      g_digest = digest;
+      result->converged = Simulator::Now ();
+    }
+  Simulator::Schedule (period, &Sample, apps, period, result);
+}
+
+static BenchResult
+Run (bool qos, uint32_t side, double spacing, double duration, uint32_t seed,
+     uint32_t maxAmsduSize)
+{
+  BenchResult result;
+  SeedManager::SetSeed (seed);
+  Config::SetDefault ("ns3::rapidnet::RapidNetApplicationBase::WifiQos",
+                      BooleanValue (qos));
+
+  NodeContainer nodes;
+  nodes.Create (side * side);
+  NetDeviceContainer devices = InstallWifi (nodes, false, "", qos, maxAmsduSize);
+  InstallIpv4 (nodes, devices, "192.168.0.0");
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (spacing),
+                                 "DeltaY", DoubleValue (spacing),
+                                 "GridWidth", UintegerValue (side));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  ApplicationContainer apps = Create<Pathvector2Helper> ()->Install (nodes);
+  apps.Start (Seconds (0.0));
+  apps.Stop (Seconds (duration));
+
+  g_digest = 0;
+  result.converged = Seconds (0);
+  Simulator::Schedule (Seconds (0.1), &Sample, apps, Seconds (0.1), &result);
+  Simulator::Stop (Seconds (duration));
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  result.ms = clock.End ();
+
+  result.sent = 0;
+  result.received = 0;
+  for (ApplicationContainer::Iterator it = apps.Begin (); it != apps.End (); ++it)
+    {
+      Ptr<RapidNetApplicationBase> app = DynamicCast<RapidNetApplicationBase, Application> (*it);
+      result.sent += app->totalPacketsSent;
+      result.received += app->totalPacketsReceived;
+    }
+  GetDigest (apps, &result.paths);
+  Simulator::Destroy ();
+  return result;
+}
+
+static void
+RunAndPrint (BenchConfig *config)
+{
+  BenchResult r = Run (config->qos, config->side, config->spacing,
+                       config->duration, config->seed, config->maxAmsduSize);
+  cout << (config->qos ? "qos+amsdu" : "non-qos") << "\t" << r.sent
+       << "\t" << r.received
+       << "\t" << r.received / config->duration
+       << "\t" << r.converged.GetSeconds ()
+       << "\t" << r.paths << "\t" << r.ms << endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  BenchConfig config;
+  config.side = 4;
+  config.spacing = 80.0;
+  config.duration = 60.0;
+  config.seed = 1;
+  config.maxAmsduSize = 3839;
+
+  CommandLine cmd;
+  cmd.AddValue ("side", "Number of nodes on each side of the grid", config.side);
+  cmd.AddValue ("spacing", "Distance between neighbouring nodes in meters", config.spacing);
+  cmd.AddValue ("duration", "Duration of each run in seconds", config.duration);
+  cmd.AddValue ("seed", "Seed of both runs", config.seed);
+  cmd.AddValue ("amsdu", "Maximum size of an A-MSDU in bytes", config.maxAmsduSize);
+  cmd.Parse (argc, argv);
+
+  cout << "mac\tsent\treceived\treceived/s\tconverged(s)\tbestPaths\twall(ms)" << endl;
+  for (uint32_t qos = 0; qos < 2; qos++)
+    {
+      config.qos = qos;
+      if (!Sweep::RunInChild (MakeBoundCallback (&RunAndPrint, &config)))
+        {
+          cerr << "run " << qos << " failed" << endl;
+          return 1;
+        }
+    }
+  return 0;
+}
@@ -17,6 +17,10 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/core-config.h"
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
 #include "buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
@@ -78,6 +82,8 @@ class BufferDataList : public std::vector<struct BufferData*>
 {
 public:
   ~BufferDataList ();
+  static void Delete (void *list);
+  static void CreateKey (void);
 };
 
 static struct BufferData *BufferAllocate (uint32_t reqSize);
@@ -90,13 +96,56 @@ static void BufferDeallocate (struct BufferData *data);
 namespace ns3 {
 
 #ifdef BUFFER_HEURISTICS
-static uint32_t g_recommendedStart = 0;
-static uint64_t g_nAddNoRealloc = 0;
-static uint64_t g_nAddRealloc = 0;
-static BufferDataList  g_freeList;
-static uint32_t g_maxSize = 0;
-static uint64_t g_nAllocs = 0;
-static uint64_t g_nCreates = 0;
+// the free list and the size hints are per-thread so that packets can
+// be created and destroyed concurrently by the parallel simulator.
+static __thread uint32_t g_recommendedStart = 0;
+static __thread uint64_t g_nAddNoRealloc = 0;
+static __thread uint64_t g_nAddRealloc = 0;
+static BufferDataList g_mainFreeList;
+static __thread BufferDataList *g_freeList = 0;
+static __thread uint32_t g_maxSize = 0;
+static __thread uint64_t g_nAllocs = 0;
+static __thread uint64_t g_nCreates = 0;
+
+#ifdef HAVE_PTHREAD_H
+static pthread_t g_mainThread = pthread_self ();
+static pthread_key_t g_freeListKey;
+static pthread_once_t g_freeListKeyOnce = PTHREAD_ONCE_INIT;
+#endif
+
+void
+BufferDataList::Delete (void *list)
+{
+  delete static_cast<BufferDataList *> (list);
+}
+
+void
+BufferDataList::CreateKey (void)
+{
+#ifdef HAVE_PTHREAD_H
+  pthread_key_create (&g_freeListKey, &BufferDataList::Delete);
+#endif
+}
+
+static BufferDataList *
+GetFreeList (void)
+{
+  if (g_freeList == 0)
+    {
+#ifdef HAVE_PTHREAD_H
+      if (!pthread_equal (pthread_self (), g_mainThread))
+        {
+          // released by the thread-specific key when the thread exits.
+          pthread_once (&g_freeListKeyOnce, &BufferDataList::CreateKey);
+          g_freeList = new BufferDataList ();
+          pthread_setspecific (g_freeListKey, g_freeList);
+          return g_freeList;
+        }
+#endif
+      g_freeList = &g_mainFreeList;
+    }
+  return g_freeList;
+}
 #endif /* BUFFER_HEURISTICS */
 
 BufferDataList::~BufferDataList ()
@@ -154,14 +203,15 @@ Buffer::Recycle (struct BufferData *data)
   NS_ASSERT (data->m_count == 0);
   g_maxSize = std::max (g_maxSize, data->m_size);
   /* feed into free list */
+  BufferDataList *freeList = GetFreeList ();
   if (data->m_size < g_maxSize ||
-      g_freeList.size () > 1000)
+      freeList->size () > 1000)
     {
       BufferDeallocate (data);
     }
   else
     {
-      g_freeList.push_back (data);
+      freeList->push_back (data);
     }
 }
 
@@ -170,10 +220,11 @@ Buffer::Create (uint32_t dataSize)
 {
   /* try to find a buffer correctly sized. */
   g_nCreates++;
-  while (!g_freeList.empty ()) 
+  BufferDataList *freeList = GetFreeList ();
+  while (!freeList->empty ()) 
     {
-      struct BufferData *data = g_freeList.back ();
-      g_freeList.pop_back ();
+      struct BufferData *data = freeList->back ();
+      freeList->pop_back ();
       if (data->m_size >= dataSize) 
         {
           data->m_count = 1;
@@ -17,10 +17,14 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/core-config.h"
 #include "byte-tag-list.h"
 #include "ns3/log.h"
 #include <vector>
 #include <string.h>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
 
 NS_LOG_COMPONENT_DEFINE ("ByteTagList");
 
@@ -42,8 +46,10 @@ static class ByteTagListDataFreeList : public std::vector<struct ByteTagListData
 {
 public:
   ~ByteTagListDataFreeList ();
-} g_freeList;
-static uint32_t g_maxSize = 0;
+} g_mainFreeList;
+// per-thread, so that the parallel simulator can allocate tags concurrently.
+static __thread ByteTagListDataFreeList *g_freeList = 0;
+static __thread uint32_t g_maxSize = 0;
 
 ByteTagListDataFreeList::~ByteTagListDataFreeList ()
 {
@@ -54,6 +60,43 @@ ByteTagListDataFreeList::~ByteTagListDataFreeList ()
       delete [] buffer;
     }
 }
+
+#ifdef HAVE_PTHREAD_H
+static pthread_t g_mainThread = pthread_self ();
+static pthread_key_t g_freeListKey;
+static pthread_once_t g_freeListKeyOnce = PTHREAD_ONCE_INIT;
+
+static void
+DeleteFreeList (void *list)
+{
+  delete static_cast<ByteTagListDataFreeList *> (list);
+}
+
+static void
+CreateFreeListKey (void)
+{
+  pthread_key_create (&g_freeListKey, &DeleteFreeList);
+}
+#endif
+
+static ByteTagListDataFreeList *
+GetFreeList (void)
+{
+  if (g_freeList == 0)
+    {
+#ifdef HAVE_PTHREAD_H
+      if (!pthread_equal (pthread_self (), g_mainThread))
+        {
+          pthread_once (&g_freeListKeyOnce, &CreateFreeListKey);
+          g_freeList = new ByteTagListDataFreeList ();
+          pthread_setspecific (g_freeListKey, g_freeList);
+          return g_freeList;
+        }
+#endif
+      g_freeList = &g_mainFreeList;
+    }
+  return g_freeList;
+}
 #endif /* USE_FREE_LIST */
 
 ByteTagList::Iterator::Item::Item (TagBuffer buf_)
@@ -338,10 +381,11 @@ struct ByteTagListData *
 ByteTagList::Allocate (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
-  while (!g_freeList.empty ())
+  ByteTagListDataFreeList *freeList = GetFreeList ();
+  while (!freeList->empty ())
     {
-      struct ByteTagListData *data = g_freeList.back ();
-      g_freeList.pop_back ();
+      struct ByteTagListData *data = freeList->back ();
+      freeList->pop_back ();
       NS_ASSERT (data != 0);
       if (data->size >= size)
 	{
@@ -372,7 +416,8 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
   data->count--;
   if (data->count == 0)
     {
-      if (g_freeList.size () > FREE_LIST_SIZE ||
+      ByteTagListDataFreeList *freeList = GetFreeList ();
+      if (freeList->size () > FREE_LIST_SIZE ||
 	  data->size < g_maxSize)
 	{
 	  uint8_t *buffer = (uint8_t *)data;
@@ -380,7 +425,7 @@ ByteTagList::Deallocate (struct ByteTagListData *data)
 	}
       else
 	{
-	  g_freeList.push_back (data);
+	  freeList->push_back (data);
 	}
     }
 }
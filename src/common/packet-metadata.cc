@@ -17,8 +17,12 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/core-config.h"
 #include <utility>
 #include <list>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
@@ -34,9 +38,16 @@ namespace ns3 {
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
+__thread uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
+PacketMetadata::DataFreeList PacketMetadata::m_mainFreeList;
+__thread PacketMetadata::DataFreeList *PacketMetadata::m_freeList = 0;
+
+#ifdef HAVE_PTHREAD_H
+static pthread_t g_mainThread = pthread_self ();
+static pthread_key_t g_freeListKey;
+static pthread_once_t g_freeListKeyOnce = PTHREAD_ONCE_INIT;
+#endif
 
 PacketMetadata::DataFreeList::~DataFreeList ()
 {
@@ -44,7 +55,44 @@ PacketMetadata::DataFreeList::~DataFreeList ()
     {
       PacketMetadata::Deallocate (*i);
     }
-  PacketMetadata::m_enable = false;
+  if (this == &PacketMetadata::m_mainFreeList)
+    {
+      PacketMetadata::m_enable = false;
+    }
+}
+
+void
+PacketMetadata::DataFreeList::Delete (void *list)
+{
+  delete static_cast<DataFreeList *> (list);
+}
+
+void
+PacketMetadata::DataFreeList::CreateKey (void)
+{
+#ifdef HAVE_PTHREAD_H
+  pthread_key_create (&g_freeListKey, &DataFreeList::Delete);
+#endif
+}
+
+PacketMetadata::DataFreeList *
+PacketMetadata::GetFreeList (void)
+{
+  if (m_freeList == 0)
+    {
+#ifdef HAVE_PTHREAD_H
+      if (!pthread_equal (pthread_self (), g_mainThread))
+        {
+          // released by the thread-specific key when the thread exits.
+          pthread_once (&g_freeListKeyOnce, &DataFreeList::CreateKey);
+          m_freeList = new DataFreeList ();
+          pthread_setspecific (g_freeListKey, m_freeList);
+          return m_freeList;
+        }
+#endif
+      m_freeList = &m_mainFreeList;
+    }
+  return m_freeList;
 }
 
 void 
@@ -525,10 +573,11 @@ PacketMetadata::Create (uint32_t size)
     {
       m_maxSize = size;
     }
-  while (!m_freeList.empty ()) 
+  DataFreeList *freeList = GetFreeList ();
+  while (!freeList->empty ()) 
     {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
+      struct PacketMetadata::Data *data = freeList->back ();
+      freeList->pop_back ();
       if (data->m_size >= size) 
         {
           NS_LOG_LOGIC ("create found size="<<data->m_size);
@@ -550,16 +599,17 @@ PacketMetadata::Recycle (struct PacketMetadata::Data *data)
       PacketMetadata::Deallocate (data);
       return;
     } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
+  DataFreeList *freeList = GetFreeList ();
+  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<freeList->size ());
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
+  if (freeList->size () > 1000 ||
       data->m_size < m_maxSize) 
     {
       PacketMetadata::Deallocate (data);
     } 
   else 
     {
-      m_freeList.push_back (data);
+      freeList->push_back (data);
     }
 }
 
@@ -596,6 +646,15 @@ PacketMetadata::CreateFragment (uint32_t start, uint32_t end) const
   return fragment;
 }
 
+PacketMetadata
+PacketMetadata::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  PacketMetadata copy = *this;
+  copy.ReserveCopy (0);
+  return copy;
+}
+
 void 
 PacketMetadata::AddHeader (const Header &header, uint32_t size)
 {
@@ -617,8 +676,7 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
   item.prev = 0xffff;
   item.typeUid = uid;
   item.size = size;
-  item.chunkUid = m_chunkUid;
-  m_chunkUid++;
+  item.chunkUid = __sync_fetch_and_add (&m_chunkUid, 1);
   uint16_t written = AddSmall (&item);
   UpdateHead (written);
 }
@@ -683,8 +741,7 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
   item.prev = m_tail;
   item.typeUid = uid;
   item.size = size;
-  item.chunkUid = m_chunkUid;
-  m_chunkUid++;
+  item.chunkUid = __sync_fetch_and_add (&m_chunkUid, 1);
   uint16_t written = AddSmall (&item);
   UpdateTail (written);
 }
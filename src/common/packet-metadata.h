@@ -146,6 +146,10 @@ public:
    * and then, RemoveAtEnd (end).
    */
   PacketMetadata CreateFragment (uint32_t start, uint32_t end) const;
+  /**
+   * \returns a copy of this metadata which shares no storage with it.
+   */
+  PacketMetadata CreateFullCopy (void) const;
   void AddAtEnd (PacketMetadata const&o);
   void AddPaddingAtEnd (uint32_t end);
   void RemoveAtStart (uint32_t start);
@@ -240,6 +244,8 @@ private:
   {
   public:
     ~DataFreeList ();
+    static void Delete (void *list);
+    static void CreateKey (void);
   };
 
   friend DataFreeList::~DataFreeList ();
@@ -276,7 +282,12 @@ private:
   static struct PacketMetadata::Data *Allocate (uint32_t n);
   static void Deallocate (struct PacketMetadata::Data *data);
   
-  static DataFreeList m_freeList;
+  static DataFreeList *GetFreeList (void);
+
+  // the free list and the size hint are per-thread so that packets can
+  // be created and destroyed concurrently by the parallel simulator.
+  static DataFreeList m_mainFreeList;
+  static __thread DataFreeList *m_freeList;
   static bool m_enable;
   static bool m_enableChecking;
 
@@ -285,7 +296,7 @@ private:
   // middle of a simulation, which isn't allowed.
   static bool m_metadataSkipped;
 
-  static uint32_t m_maxSize;
+  static __thread uint32_t m_maxSize;
   static uint16_t m_chunkUid;
   
   struct Data *m_data;
@@ -167,6 +167,25 @@ PacketTagList::Peek (Tag &tag) const
   return false;
 }
 
+PacketTagList
+PacketTagList::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  PacketTagList copy;
+  struct TagData **prev = &copy.m_next;
+  for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
+    {
+      struct TagData *data = AllocData ();
+      memcpy (data->data, cur->data, PACKET_TAG_MAX_SIZE);
+      data->tid = cur->tid;
+      data->count = 1;
+      data->next = 0;
+      *prev = data;
+      prev = &data->next;
+    }
+  return copy;
+}
+
 const struct PacketTagList::TagData *
 PacketTagList::Head (void) const
 {
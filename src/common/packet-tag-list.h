@@ -56,6 +56,12 @@ public:
   bool Peek (Tag &tag) const;
   inline void RemoveAll (void);
 
+  /**
+   * \returns a list which shares no tag storage with this one, and
+   *          can thus be handed over to another thread.
+   */
+  PacketTagList CreateFullCopy (void) const;
+
   const struct PacketTagList::TagData *Head (void) const;
 
 private:
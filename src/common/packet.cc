@@ -133,15 +133,29 @@ Packet::Copy (void) const
   return Ptr<Packet> (new Packet (*this), false);
 }
 
+Ptr<Packet>
+Packet::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Buffer buffer;
+  buffer.AddAtStart (m_buffer.GetSize ());
+  buffer.Begin ().Write (m_buffer.Begin (), m_buffer.End ());
+  ByteTagList byteTagList;
+  byteTagList.Add (m_byteTagList);
+  byteTagList.AddAtStart (buffer.GetCurrentStartOffset () - m_buffer.GetCurrentStartOffset (),
+                          buffer.GetCurrentStartOffset ());
+  return Ptr<Packet> (new Packet (buffer, byteTagList, 
+                                  m_packetTagList.CreateFullCopy (),
+                                  m_metadata.CreateFullCopy ()), false);
+}
+
 Packet::Packet ()
   : m_buffer (),
     m_byteTagList (),
     m_packetTagList (),
-    m_metadata (m_globalUid, 0),
+    m_metadata (__sync_fetch_and_add (&m_globalUid, 1), 0),
     m_refCount (1)
-{
-  m_globalUid++;
-}
+{}
 
 Packet::Packet (const Packet &o)
   : m_buffer (o.m_buffer),
@@ -169,19 +183,16 @@ Packet::Packet (uint32_t size)
   : m_buffer (size),
     m_byteTagList (),
     m_packetTagList (),
-    m_metadata (m_globalUid, size),
+    m_metadata (__sync_fetch_and_add (&m_globalUid, 1), size),
     m_refCount (1)
-{
-  m_globalUid++;
-}
+{}
 Packet::Packet (uint8_t const*buffer, uint32_t size)
   : m_buffer (),
     m_byteTagList (),
     m_packetTagList (),
-    m_metadata (m_globalUid, size),
+    m_metadata (__sync_fetch_and_add (&m_globalUid, 1), size),
     m_refCount (1)
 {
-  m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
   i.Write (buffer, size);
@@ -206,6 +206,17 @@ public:
 
   Ptr<Packet> Copy (void) const;
 
+  /**
+   * \returns a copy of this packet which shares no data, tag or
+   *          metadata storage with it.
+   *
+   * Unlike Copy, the returned packet can be handed over to another
+   * thread: the parallel simulator uses this for packets which
+   * cross from one logical process to another.  The copy keeps the
+   * uid of the original packet.
+   */
+  Ptr<Packet> CreateFullCopy (void) const;
+
   /**
    * Create an empty packet with a new uid (as returned
    * by getUid).
@@ -344,5 +344,3 @@ ObjectBase::TraceDisconnect (std::string name, std::string context, const Callba
 
 
 } // namespace ns3
-
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::ObjectBase)
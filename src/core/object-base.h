@@ -24,14 +24,6 @@
 #include "callback.h"
 #include <string>
 
-
-//Forward declaration of class boost::serialization::access
-namespace boost{
-  namespace serialization{
-    class access;
-  }
-}
-
 /**
  * This macro should be invoked once for every class which
  * defines a new GetTypeId method.
@@ -164,11 +156,6 @@ protected:
 
 private:
 
-  friend class boost::serialization::access;
-
-  template<typename Archive>
-  void serialize(Archive& ar, const unsigned version){}  
-
   bool DoSet (Ptr<const AttributeAccessor> spec,
               Ptr<const AttributeChecker> checker, 
               const AttributeValue &value);
@@ -178,6 +165,4 @@ private:
 
 } // namespace ns3
 
-BOOST_CLASS_EXPORT_KEY(ns3::ObjectBase)
-
 #endif /* OBJECT_BASE_H */
@@ -269,8 +269,6 @@ Object::MaybeDelete (void) const
 
 } // namespace ns3
 
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::Object)
-
 #ifdef RUN_SELF_TESTS
 
 #include "test.h"
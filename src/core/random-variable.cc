@@ -95,6 +95,7 @@ public:
   virtual double  GetValue() = 0;
   virtual uint32_t GetInteger();
   virtual RandomVariableBase*   Copy(void) const = 0;
+  void NewStream (void);
 
 protected:
   RngStream* m_generator;  //underlying generator being wrapped
@@ -124,6 +125,12 @@ uint32_t RandomVariableBase::GetInteger()
   return (uint32_t)GetValue();
 }
 
+void RandomVariableBase::NewStream (void)
+{
+  delete m_generator;
+  m_generator = new RngStream ();
+}
+
 //-------------------------------------------------------
 
 RandomVariable::RandomVariable()
@@ -162,6 +169,12 @@ RandomVariable::GetInteger (void) const
   return m_variable->GetInteger ();
 }
 
+void
+RandomVariable::NewStream (void)
+{
+  m_variable->NewStream ();
+}
+
 RandomVariableBase *
 RandomVariable::Peek (void) const
 {
@@ -138,6 +138,16 @@ public:
    */
   uint32_t GetInteger (void) const;
 
+  /**
+   * \brief Draws the values from a new stream of the package, taken now
+   * rather than when the first value is drawn.
+   *
+   * An object which draws its values in an order which depends on
+   * other objects calls this when it is created, so that the stream it
+   * gets does not.
+   */
+  void NewStream (void);
+
 private:
   friend std::ostream &operator << (std::ostream &os, const RandomVariable &var);
   friend std::istream &operator >> (std::istream &os, RandomVariable &var);
@@ -50,5 +50,3 @@ RefCountBase::GetReferenceCount (void) const
 }
 
 } // namespace ns3
-
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::RefCountBase)
@@ -25,16 +25,6 @@
 
 #include <stdint.h>
 
-#include <boost/serialization/export.hpp>
-
-
-//Forward declaration of class boost::serialization::access
-namespace boost{
-  namespace serialization{
-    class access;
-  }
-}
-
 namespace ns3 {
 
 /**
@@ -76,14 +66,6 @@ public:
 
 private:
 
-  friend class boost::serialization::access;
-
-  template<typename Archive>
-  void serialize(Archive& ar, const unsigned version)
-  {
-    ar & m_count;
-  }  
-
   // Note we make this mutable so that the const methods can still
   // change it.
   mutable uint32_t m_count;  // Reference count
@@ -114,6 +96,4 @@ RefCountBase::Unref (void) const
 
 } // namespace ns3
 
-BOOST_CLASS_EXPORT_KEY(ns3::RefCountBase)
-
 #endif /* __REF_COUNT_BASE_H__*/
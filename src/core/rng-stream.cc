@@ -361,6 +361,16 @@ RngStream::RngStream(const RngStream& r)
 }
       
 
+RngStream::RngStream (const uint32_t seed[6])
+{
+  anti = false;
+  incPrec = false;
+  // unlike InitializeStream, leaves nextSeed alone.
+  for (int i = 0; i < 6; ++i) {
+    Bg[i] = Cg[i] = Ig[i] = seed[i];
+  }
+}
+
 void RngStream::InitializeStream()
 { // Moved from the RngStream constructor above to allow seeding
   // AFTER the global package seed has been set in the Random
@@ -465,6 +475,22 @@ RngStream::GetPackageRun (void)
   g_rngRun.GetValue (run);
   return run.Get ();
 }
+void
+RngStream::GetNextSeed (uint32_t seed[6])
+{
+  EnsureGlobalInitialized ();
+  for (int i = 0; i < 6; i++)
+    {
+      seed[i] = static_cast<uint32_t> (nextSeed[i]);
+    }
+}
+bool
+RngStream::SetNextSeed (const uint32_t seed[6])
+{
+  // or the first stream allocated would reset it
+  EnsureGlobalInitialized ();
+  return SetPackageSeed (seed);
+}
 bool 
 RngStream::CheckSeed(uint32_t seed)
 {
@@ -528,6 +554,14 @@ void RngStream::GetState (uint32_t seed[6]) const
 }
 
 
+//-------------------------------------------------------------------------
+void RngStream::SetState (const uint32_t seed[6])
+{
+   for (int i = 0; i < 6; ++i)
+      Cg[i] = seed[i];
+}
+
+
 //-------------------------------------------------------------------------
 void RngStream::IncreasedPrecis (bool incp)
 {
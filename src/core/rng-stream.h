@@ -40,6 +40,11 @@ class RngStream {
 public:  //public api
   RngStream ();
   RngStream (const RngStream&);
+  /**
+   * \brief Creates a stream starting at the given state, without
+   * allocating one of the streams of the package.
+   */
+  explicit RngStream (const uint32_t seed[6]);
   void InitializeStream(); // Separate initialization
   void ResetStartStream ();
   void ResetStartSubstream ();
@@ -50,6 +55,11 @@ public:  //public api
   bool SetSeeds (const uint32_t seed[6]);
   void AdvanceState (int32_t e, int32_t c);
   void GetState (uint32_t seed[6]) const;
+  /**
+   * \brief Moves the stream to a state returned by GetState, leaving the
+   * start of the stream and of the current substream alone.
+   */
+  void SetState (const uint32_t seed[6]);
   double RandU01 ();
   int32_t RandInt (int32_t i, int32_t j);
 public: //public static api
@@ -58,6 +68,12 @@ public: //public static api
   static void GetPackageSeed (uint32_t seed[6]);
   static void SetPackageRun (uint32_t run);
   static uint32_t GetPackageRun (void);
+  /**
+   * \brief The seed of the next stream of the package, which moves on
+   * each time a stream is allocated.
+   */
+  static void GetNextSeed (uint32_t seed[6]);
+  static bool SetNextSeed (const uint32_t seed[6]);
   static bool CheckSeed(const uint32_t seed[6]);
   static bool CheckSeed(uint32_t seed);
 private: //members
@@ -233,7 +233,7 @@ CsmaChannel::PropagationCompleteEvent()
     {
       if (it->IsActive ())
       {
-        it->devicePtr->Receive (m_currentPkt->Copy (), m_deviceList[m_currentSrc].devicePtr);
+        it->devicePtr->Receive (m_currentPkt, m_deviceList[m_currentSrc].devicePtr);
       }
       devId++;
     }
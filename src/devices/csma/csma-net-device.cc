@@ -710,10 +710,10 @@ CsmaNetDevice::SetReceiveErrorModel (Ptr<ErrorModel> em)
 }
 
   void
-CsmaNetDevice::Receive (Ptr<Packet> packet, Ptr<CsmaNetDevice> senderDevice)
+CsmaNetDevice::Receive (Ptr<const Packet> originalPacket, Ptr<CsmaNetDevice> senderDevice)
 {
-  NS_LOG_FUNCTION (packet << senderDevice);
-  NS_LOG_LOGIC ("UID is " << packet->GetUid ());
+  NS_LOG_FUNCTION (originalPacket << senderDevice);
+  NS_LOG_LOGIC ("UID is " << originalPacket->GetUid ());
 
   //
   // We never forward up packets that we sent.  Real devices don't do this since
@@ -728,28 +728,46 @@ CsmaNetDevice::Receive (Ptr<Packet> packet, Ptr<CsmaNetDevice> senderDevice)
   // Hit the trace hook.  This trace will fire on all packets received from the
   // channel except those originated by this device.
   //
-  m_phyRxEndTrace (packet);
+  m_phyRxEndTrace (originalPacket);
 
   // 
   // Only receive if the send side of net device is enabled
   //
   if (IsReceiveEnabled () == false)
     {
-      m_phyRxDropTrace (packet);
+      m_phyRxDropTrace (originalPacket);
       return;
     }
 
+  EthernetHeader header (false);
+
+  //
+  // The packet is shared by all the devices of the channel.  A packet for
+  // another host is only seen by the promiscuous sniffer: when nothing else
+  // can look at it, classify it on the shared packet and do not copy it.
+  //
+  if (!m_receiveErrorModel && m_promiscRxCallback.IsNull ())
+    {
+      originalPacket->PeekHeader (header);
+      if (!header.GetDestination ().IsBroadcast () &&
+          !header.GetDestination ().IsGroup () &&
+          header.GetDestination () != m_address)
+        {
+          m_promiscSnifferTrace (originalPacket);
+          return;
+        }
+    }
+
   //
   // Trace sinks will expect complete packets, not packets without some of the
-  // headers.
+  // headers: strip the headers from our own copy.
   //
-  Ptr<Packet> originalPacket = packet->Copy ();
+  Ptr<Packet> packet = originalPacket->Copy ();
 
   EthernetTrailer trailer;
   packet->RemoveTrailer (trailer);
   trailer.CheckFcs (packet);
 
-  EthernetHeader header (false);
   packet->RemoveHeader (header);
 
   NS_LOG_LOGIC ("Pkt source is " << header.GetSource ());
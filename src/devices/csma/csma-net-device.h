@@ -149,10 +149,13 @@ public:
    * arrived at the device.
    *
    * \see CsmaChannel
+   * The packet is shared by all the devices attached to the channel: it
+   * is only copied by the devices which pass it up.
+   *
    * \param p a reference to the received packet
    * \param sender the CsmaNetDevice that transmitted the packet in the first place
    */
-  void Receive (Ptr<Packet> p, Ptr<CsmaNetDevice> sender);
+  void Receive (Ptr<const Packet> p, Ptr<CsmaNetDevice> sender);
 
   /**
    * Is the send side of the network device enabled?
@@ -20,6 +20,7 @@
 #include "point-to-point-net-device.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/node.h"
 #include "ns3/log.h"
 
 NS_LOG_COMPONENT_DEFINE ("PointToPointChannel");
@@ -70,6 +71,13 @@ PointToPointChannel::Attach(Ptr<PointToPointNetDevice> device)
     {
       m_link[0].m_dst = m_link[1].m_src;
       m_link[1].m_dst = m_link[0].m_src;
+      for (int32_t i = 0; i < N_DEVICES; i++)
+        {
+          if (m_link[i].m_dst->GetNode () != 0)
+            {
+              m_link[i].m_dstNodeId = m_link[i].m_dst->GetNode ()->GetId ();
+            }
+        }
       m_link[0].m_state = IDLE;
       m_link[1].m_state = IDLE;
     }
@@ -88,12 +96,32 @@ PointToPointChannel::TransmitStart(
   NS_ASSERT(m_link[1].m_state != INITIALIZING);
 
   uint32_t wire = src == m_link[0].m_src ? 0 : 1;
+  if (m_link[wire].m_dstNodeId == Simulator::NO_CONTEXT)
+    {
+      // the device was attached before being added to its node.
+      m_link[wire].m_dstNodeId = m_link[wire].m_dst->GetNode ()->GetId ();
+    }
+  uint32_t context = m_link[wire].m_dstNodeId;
 
-  Simulator::Schedule (txTime + m_delay, &PointToPointNetDevice::Receive,
-    m_link[wire].m_dst, p);
+  // The receiver may run in another thread: hand it a raw device
+  // pointer and a packet which shares nothing with the sender.
+  if (!Simulator::IsLocalContext (context))
+    {
+      p = p->CreateFullCopy ();
+    }
+  Simulator::ScheduleWithContext (context, txTime + m_delay, 
+    &PointToPointNetDevice::Receive, PeekPointer (m_link[wire].m_dst), p);
   return true;
 }
 
+Address
+PointToPointChannel::GetRemoteAddress (const PointToPointNetDevice *src) const
+{
+  NS_ASSERT (m_nDevices == N_DEVICES);
+  uint32_t wire = src == PeekPointer (m_link[0].m_src) ? 0 : 1;
+  return m_link[wire].m_dst->GetAddress ();
+}
+
 uint32_t 
 PointToPointChannel::GetNDevices (void) const
 {
@@ -24,6 +24,7 @@
 #include "ns3/ptr.h"
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
+#include "ns3/address.h"
 
 namespace ns3 {
 
@@ -70,6 +71,16 @@ public:
    */
   bool TransmitStart (Ptr<Packet> p, Ptr<PointToPointNetDevice> src, Time txTime);
 
+  /**
+   * \brief Get the address of the device at the other end of the link
+   * \param src Device asking for the address of its peer
+   * \returns the address of the peer device
+   *
+   * Unlike GetDevice, this does not take a reference to the peer
+   * device, which may be running in another thread.
+   */
+  Address GetRemoteAddress (const PointToPointNetDevice *src) const;
+
   /**
    * \brief Get number of devices on this channel
    * \returns number of devices on this channel
@@ -108,10 +119,13 @@ private:
   class Link
   {
   public:
-    Link() : m_state (INITIALIZING), m_src (0), m_dst (0) {}
+    Link() : m_state (INITIALIZING), m_src (0), m_dst (0), m_dstNodeId (0xffffffff) {}
     WireState                  m_state;
     Ptr<PointToPointNetDevice> m_src;
     Ptr<PointToPointNetDevice> m_dst;
+    // the context of the receive events on this wire, known once
+    // the destination device is attached to a node
+    uint32_t                   m_dstNodeId;
   };
     
   Link    m_link[N_DEVICES];
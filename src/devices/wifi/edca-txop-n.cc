@@ -336,7 +336,11 @@ EdcaTxopN::NotifyAccessGranted (void)
       else
         {
           WifiMacHeader peekedHdr;
+          // a retransmission must carry the same msdus as the first
+          // attempt, and an A-MSDU is never aggregated again.
           if (m_currentHdr.IsQosData () &&
+              !m_currentHdr.IsRetry () &&
+              !m_currentHdr.IsQosAmsdu () &&
               m_queue->PeekByTidAndAddress (&peekedHdr, m_currentHdr.GetQosTid (), 
                                             WifiMacHeader::ADDR1, m_currentHdr.GetAddr1 ()) &&
               !m_currentHdr.GetAddr1 ().IsBroadcast () &&
@@ -184,38 +184,27 @@ InterferenceHelper::GetEnergyDuration (double energyW)
 {
   Time now = Simulator::Now ();
 
-  // first, we iterate over all events and, each event
-  // which contributes energy to the channel now is 
-  // appended to the noise interference array.
-  Events::const_iterator i = m_events.begin ();
+  // first, we iterate over the events which contribute energy
+  // to the channel now: those which end after now.
+  Events::const_iterator first = m_events.upper_bound (now);
   double noiseInterferenceW = 0.0;
-  NiChanges ni;
-  while (i != m_events.end ()) 
+  for (Events::const_iterator i = first; i != m_events.end (); i++) 
     {
-      Ptr<Event> ev = *i;
-      NS_ASSERT (ev->GetStartTime () <= now);
-      if (ev->GetEndTime () > now)
-	{
-          ni.push_back (NiChange (ev->GetEndTime (), -ev->GetRxPowerW ()));
-          noiseInterferenceW += ev->GetRxPowerW ();
-	}
-      i++;
+      NS_ASSERT (i->second->GetStartTime () <= now);
+      noiseInterferenceW += i->second->GetRxPowerW ();
     }
   if (noiseInterferenceW < energyW)
     {
       return MicroSeconds (0);
     }
 
-  /* quicksort vector of NI changes by time. 
-   */
-  std::sort (ni.begin (), ni.end (), std::less<NiChange> ());
-
-  // Now, we iterate the piecewise linear noise function
+  // Now, we iterate the piecewise linear noise function: the
+  // events are already sorted by end time.
   Time end = now;
-  for (NiChanges::const_iterator i = ni.begin (); i != ni.end (); i++) 
+  for (Events::const_iterator i = first; i != m_events.end (); i++) 
     {
-      noiseInterferenceW += i->GetDelta ();
-      end = i->GetTime ();
+      noiseInterferenceW -= i->second->GetRxPowerW ();
+      end = i->first;
       if (noiseInterferenceW < energyW) 
 	{
 	  break;
@@ -289,15 +278,9 @@ InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
   if (Simulator::Now () > GetMaxPacketDuration ())
     {
       Time end = Simulator::Now () - GetMaxPacketDuration ();
-      Events::iterator i = m_events.begin ();
-      while (i != m_events.end () &&
-             (*i)->GetEndTime () <= end) 
-        {
-          i++;
-        }
-      m_events.erase (m_events.begin (), i);
+      m_events.erase (m_events.begin (), m_events.upper_bound (end));
     } 
-  m_events.push_back (event);
+  m_events.insert (std::make_pair (event->GetEndTime (), event));
 }
 
 
@@ -318,26 +301,29 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, WifiM
 double
 InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges *ni) const
 {
-  Events::const_iterator i = m_events.begin ();
+  // the events which end before the start of this event
+  // cannot overlap it.
+  Events::const_iterator i = m_events.lower_bound (event->GetStartTime ());
   double noiseInterference = 0.0;
   while (i != m_events.end ()) 
     {
-      if (event == (*i)) 
+      Ptr<Event> ev = i->second;
+      if (event == ev) 
         {
           i++;
           continue;
         }
-      if (event->Overlaps ((*i)->GetStartTime ())) 
+      if (event->Overlaps (ev->GetStartTime ())) 
         {
-          ni->push_back (NiChange ((*i)->GetStartTime (), (*i)->GetRxPowerW ()));
+          ni->push_back (NiChange (ev->GetStartTime (), ev->GetRxPowerW ()));
         }
-      if (event->Overlaps ((*i)->GetEndTime ())) 
+      if (event->Overlaps (ev->GetEndTime ())) 
         {
-          ni->push_back (NiChange ((*i)->GetEndTime (), -(*i)->GetRxPowerW ()));
+          ni->push_back (NiChange (ev->GetEndTime (), -ev->GetRxPowerW ()));
         }
-      if ((*i)->Overlaps (event->GetStartTime ())) 
+      if (ev->Overlaps (event->GetStartTime ())) 
         {
-          noiseInterference += (*i)->GetRxPowerW ();
+          noiseInterference += ev->GetRxPowerW ();
         }
       i++;
     }
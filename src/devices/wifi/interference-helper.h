@@ -22,7 +22,7 @@
 
 #include <stdint.h>
 #include <vector>
-#include <list>
+#include <map>
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
@@ -103,7 +103,12 @@ private:
     double m_delta;
   };
   typedef std::vector <NiChange> NiChanges;
-  typedef std::list<Ptr<Event> > Events;
+  /**
+   * The events, ordered by end time: the events which overlap a time t
+   * are found among those which end at or after t, without visiting the
+   * events which ended before.
+   */
+  typedef std::multimap<Time, Ptr<Event> > Events;
 
   InterferenceHelper (const InterferenceHelper &o);
   InterferenceHelper &operator = (const InterferenceHelper &o);
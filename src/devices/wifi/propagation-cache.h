@@ -0,0 +1,218 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef PROPAGATION_CACHE_H
+#define PROPAGATION_CACHE_H
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/callback.h"
+#include "ns3/mobility-model.h"
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \brief the values computed by a propagation model for each pair of
+ *        mobility models.
+ *
+ * Each mobility model seen by the cache gets an epoch, incremented by
+ * its CourseChange trace source: a value is only valid as long as the
+ * epochs of its two ends have not changed. The position of a moving
+ * model changes without course change, so the values of a pair with a
+ * non-zero velocity are only kept for the time quantum of the cache, and
+ * are not cached at all with a zero quantum.
+ *
+ * The key is an input of the model which is not part of the pair, such
+ * as the transmission power: a value computed for another key is
+ * recomputed.
+ */
+template <typename T>
+class PropagationCache
+{
+public:
+  PropagationCache ();
+  ~PropagationCache ();
+
+  void SetQuantum (Time quantum);
+  Time GetQuantum (void) const;
+
+  /**
+   * \returns true and sets value if a valid value is cached for a, b
+   *          and key.
+   */
+  bool Lookup (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double key, T &value);
+  void Store (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double key, T value);
+  /**
+   * Forgets all the values and disconnects from the mobility models.
+   */
+  void Clear (void);
+
+private:
+  typedef std::pair<const MobilityModel *, const MobilityModel *> Pair;
+  struct Entry
+  {
+    double key;
+    T value;
+    uint32_t epochA;
+    uint32_t epochB;
+    bool moving;
+    Time time;
+  };
+  struct Tracked
+  {
+    Ptr<MobilityModel> mobility;
+    uint32_t epoch;
+  };
+  typedef std::map<const MobilityModel *, Tracked> TrackedMap;
+  typedef std::map<Pair, Entry> EntryMap;
+
+  PropagationCache (const PropagationCache &o);
+  PropagationCache &operator = (const PropagationCache &o);
+  uint32_t GetEpoch (Ptr<MobilityModel> mobility);
+  void CourseChanged (Ptr<const MobilityModel> mobility);
+  static bool IsMoving (Ptr<const MobilityModel> mobility);
+
+  Time m_quantum;
+  TrackedMap m_tracked;
+  EntryMap m_entries;
+};
+
+} // namespace ns3
+
+namespace ns3 {
+
+template <typename T>
+PropagationCache<T>::PropagationCache ()
+  : m_quantum (Seconds (0.0))
+{}
+
+template <typename T>
+PropagationCache<T>::~PropagationCache ()
+{
+  Clear ();
+}
+
+template <typename T>
+void
+PropagationCache<T>::SetQuantum (Time quantum)
+{
+  m_quantum = quantum;
+}
+
+template <typename T>
+Time
+PropagationCache<T>::GetQuantum (void) const
+{
+  return m_quantum;
+}
+
+template <typename T>
+uint32_t
+PropagationCache<T>::GetEpoch (Ptr<MobilityModel> mobility)
+{
+  typename TrackedMap::iterator i = m_tracked.find (PeekPointer (mobility));
+  if (i != m_tracked.end ())
+    {
+      return i->second.epoch;
+    }
+  // the cache holds a reference to the mobility models it tracks: their
+  // addresses cannot be reused by other models while they are cached.
+  Tracked tracked;
+  tracked.mobility = mobility;
+  tracked.epoch = 0;
+  m_tracked[PeekPointer (mobility)] = tracked;
+  mobility->TraceConnectWithoutContext ("CourseChange",
+    MakeCallback (&PropagationCache<T>::CourseChanged, this));
+  return 0;
+}
+
+template <typename T>
+void
+PropagationCache<T>::CourseChanged (Ptr<const MobilityModel> mobility)
+{
+  typename TrackedMap::iterator i = m_tracked.find (PeekPointer (mobility));
+  if (i != m_tracked.end ())
+    {
+      i->second.epoch++;
+    }
+}
+
+template <typename T>
+bool
+PropagationCache<T>::IsMoving (Ptr<const MobilityModel> mobility)
+{
+  Vector v = mobility->GetVelocity ();
+  return v.x != 0.0 || v.y != 0.0 || v.z != 0.0;
+}
+
+template <typename T>
+bool
+PropagationCache<T>::Lookup (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double key, T &value)
+{
+  typename EntryMap::const_iterator i = m_entries.find (Pair (PeekPointer (a), PeekPointer (b)));
+  if (i == m_entries.end ())
+    {
+      return false;
+    }
+  const Entry &entry = i->second;
+  if (entry.key != key
+      || entry.epochA != GetEpoch (a)
+      || entry.epochB != GetEpoch (b)
+      || (entry.moving && Simulator::Now () >= entry.time + m_quantum))
+    {
+      return false;
+    }
+  value = entry.value;
+  return true;
+}
+
+template <typename T>
+void
+PropagationCache<T>::Store (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double key, T value)
+{
+  Entry entry;
+  entry.key = key;
+  entry.value = value;
+  entry.epochA = GetEpoch (a);
+  entry.epochB = GetEpoch (b);
+  entry.moving = IsMoving (a) || IsMoving (b);
+  entry.time = Simulator::Now ();
+  if (entry.moving && m_quantum.IsZero ())
+    {
+      return;
+    }
+  m_entries[Pair (PeekPointer (a), PeekPointer (b))] = entry;
+}
+
+template <typename T>
+void
+PropagationCache<T>::Clear (void)
+{
+  for (typename TrackedMap::iterator i = m_tracked.begin (); i != m_tracked.end (); i++)
+    {
+      i->second.mobility->TraceDisconnectWithoutContext ("CourseChange",
+        MakeCallback (&PropagationCache<T>::CourseChanged, this));
+    }
+  m_tracked.clear ();
+  m_entries.clear ();
+}
+
+} // namespace ns3
+
+#endif /* PROPAGATION_CACHE_H */
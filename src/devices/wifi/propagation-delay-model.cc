@@ -21,6 +21,8 @@
 #include "ns3/random-variable.h"
 #include "ns3/mobility-model.h"
 #include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/assert.h"
 
 namespace ns3 {
 
@@ -101,4 +103,72 @@ ConstantSpeedPropagationDelayModel::GetSpeed (void) const
   return m_speed;
 }
 
+NS_OBJECT_ENSURE_REGISTERED (CachingPropagationDelayModel);
+
+TypeId
+CachingPropagationDelayModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachingPropagationDelayModel")
+    .SetParent<PropagationDelayModel> ()
+    .AddConstructor<CachingPropagationDelayModel> ()
+    .AddAttribute ("Model", "The propagation delay model whose results are cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachingPropagationDelayModel::SetModel,
+                                        &CachingPropagationDelayModel::GetModel),
+                   MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("Quantum", "How long the delay between moving nodes is kept.",
+                   TimeValue (Seconds (0.0)),
+                   MakeTimeAccessor (&CachingPropagationDelayModel::SetQuantum,
+                                     &CachingPropagationDelayModel::GetQuantum),
+                   MakeTimeChecker ())
+    ;
+  return tid;
+}
+
+CachingPropagationDelayModel::CachingPropagationDelayModel ()
+{}
+CachingPropagationDelayModel::~CachingPropagationDelayModel ()
+{}
+void
+CachingPropagationDelayModel::DoDispose (void)
+{
+  m_cache.Clear ();
+  m_model = 0;
+  PropagationDelayModel::DoDispose ();
+}
+void
+CachingPropagationDelayModel::SetModel (Ptr<PropagationDelayModel> model)
+{
+  m_model = model;
+  m_cache.Clear ();
+}
+Ptr<PropagationDelayModel>
+CachingPropagationDelayModel::GetModel (void) const
+{
+  return m_model;
+}
+void
+CachingPropagationDelayModel::SetQuantum (Time quantum)
+{
+  m_cache.SetQuantum (quantum);
+}
+Time
+CachingPropagationDelayModel::GetQuantum (void) const
+{
+  return m_cache.GetQuantum ();
+}
+Time
+CachingPropagationDelayModel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  NS_ASSERT (m_model != 0);
+  Time delay;
+  if (m_cache.Lookup (a, b, 0.0, delay))
+    {
+      return delay;
+    }
+  delay = m_model->GetDelay (a, b);
+  m_cache.Store (a, b, 0.0, delay);
+  return delay;
+}
+
 } // namespace ns3
@@ -24,6 +24,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/random-variable.h"
+#include "propagation-cache.h"
 
 namespace ns3 {
 
@@ -91,6 +92,37 @@ private:
   double m_speed;
 };
 
+/**
+ * \brief memoize the delay computed by another model
+ *
+ * The delay computed by the model set with the Model attribute is kept
+ * for each pair of mobility models, as in CachingPropagationLossModel.
+ * The random models should not be cached.
+ */
+class CachingPropagationDelayModel : public PropagationDelayModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  CachingPropagationDelayModel ();
+  virtual ~CachingPropagationDelayModel ();
+  virtual Time GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  /**
+   * \param model the model whose results are cached
+   */
+  void SetModel (Ptr<PropagationDelayModel> model);
+  Ptr<PropagationDelayModel> GetModel (void) const;
+  /**
+   * \param quantum how long the delay between moving nodes is kept
+   */
+  void SetQuantum (Time quantum);
+  Time GetQuantum (void) const;
+private:
+  virtual void DoDispose (void);
+  Ptr<PropagationDelayModel> m_model;
+  mutable PropagationCache<Time> m_cache;
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_DELAY_MODEL_H */
@@ -24,6 +24,7 @@
 #include "ns3/mobility-model.h"
 #include "ns3/boolean.h"
 #include "ns3/double.h"
+#include "ns3/pointer.h"
 #include <math.h>
 
 NS_LOG_COMPONENT_DEFINE ("PropagationLossModel");
@@ -543,4 +544,81 @@ FixedRssLossModel::DoCalcRxPower (double txPowerDbm,
 
 // ------------------------------------------------------------------------- //
 
+NS_OBJECT_ENSURE_REGISTERED (CachingPropagationLossModel);
+
+TypeId
+CachingPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachingPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .AddConstructor<CachingPropagationLossModel> ()
+    .AddAttribute ("Model", "The propagation loss model whose results are cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachingPropagationLossModel::SetModel,
+                                        &CachingPropagationLossModel::GetModel),
+                   MakePointerChecker<PropagationLossModel> ())
+    .AddAttribute ("Quantum", "How long the reception power between moving nodes is kept.",
+                   TimeValue (Seconds (0.0)),
+                   MakeTimeAccessor (&CachingPropagationLossModel::SetQuantum,
+                                     &CachingPropagationLossModel::GetQuantum),
+                   MakeTimeChecker ())
+    ;
+  return tid;
+}
+
+CachingPropagationLossModel::CachingPropagationLossModel ()
+{}
+
+CachingPropagationLossModel::~CachingPropagationLossModel ()
+{}
+
+void
+CachingPropagationLossModel::DoDispose (void)
+{
+  m_cache.Clear ();
+  m_model = 0;
+  PropagationLossModel::DoDispose ();
+}
+
+void
+CachingPropagationLossModel::SetModel (Ptr<PropagationLossModel> model)
+{
+  m_model = model;
+  m_cache.Clear ();
+}
+
+Ptr<PropagationLossModel>
+CachingPropagationLossModel::GetModel (void) const
+{
+  return m_model;
+}
+
+void
+CachingPropagationLossModel::SetQuantum (Time quantum)
+{
+  m_cache.SetQuantum (quantum);
+}
+
+Time
+CachingPropagationLossModel::GetQuantum (void) const
+{
+  return m_cache.GetQuantum ();
+}
+
+double
+CachingPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                            Ptr<MobilityModel> a,
+                                            Ptr<MobilityModel> b) const
+{
+  NS_ASSERT (m_model != 0);
+  double rxPowerDbm;
+  if (m_cache.Lookup (a, b, txPowerDbm, rxPowerDbm))
+    {
+      return rxPowerDbm;
+    }
+  rxPowerDbm = m_model->CalcRxPower (txPowerDbm, a, b);
+  m_cache.Store (a, b, txPowerDbm, rxPowerDbm);
+  return rxPowerDbm;
+}
+
 } // namespace ns3
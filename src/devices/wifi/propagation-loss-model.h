@@ -25,6 +25,7 @@
 
 #include "ns3/object.h"
 #include "ns3/random-variable.h"
+#include "propagation-cache.h"
 
 namespace ns3 {
 
@@ -370,6 +371,49 @@ private:
   double m_rss;
 };
 
+/**
+ * \brief memoize the reception power computed by another model
+ *
+ * The reception power computed by the model set with the Model attribute
+ * is kept for each pair of mobility models and transmission power: it
+ * is computed again when one of the two models reports a course change.
+ * The power between moving nodes is kept for the time set with the
+ * Quantum attribute, and recomputed for every packet with the default
+ * zero quantum.
+ *
+ * Only the models which return the same power for the same positions
+ * should be cached: not the random, Nakagami or Jakes models.
+ */
+class CachingPropagationLossModel : public PropagationLossModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  CachingPropagationLossModel ();
+  virtual ~CachingPropagationLossModel ();
+
+  /**
+   * \param model the model whose results are cached
+   */
+  void SetModel (Ptr<PropagationLossModel> model);
+  Ptr<PropagationLossModel> GetModel (void) const;
+  /**
+   * \param quantum how long the power between moving nodes is kept
+   */
+  void SetQuantum (Time quantum);
+  Time GetQuantum (void) const;
+
+private:
+  CachingPropagationLossModel (const CachingPropagationLossModel &o);
+  CachingPropagationLossModel & operator = (const CachingPropagationLossModel &o);
+  virtual void DoDispose (void);
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  Ptr<PropagationLossModel> m_model;
+  mutable PropagationCache<double> m_cache;
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_LOSS_MODEL_H */
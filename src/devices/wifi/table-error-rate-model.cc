@@ -0,0 +1,164 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "table-error-rate-model.h"
+#include "yans-error-rate-model.h"
+#include "ns3/pointer.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include <math.h>
+
+NS_LOG_COMPONENT_DEFINE ("TableErrorRateModel");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (TableErrorRateModel);
+
+// bounds of ln (-ln (success rate of one bit)): a bit which is always
+// received, and a bit which is never received.
+static const double MIN_LOG_ERROR = -700.0;
+static const double MAX_LOG_ERROR = 700.0;
+
+TypeId
+TableErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TableErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .AddConstructor<TableErrorRateModel> ()
+    .AddAttribute ("Model", "The error rate model which is tabulated.",
+                   PointerValue (),
+                   MakePointerAccessor (&TableErrorRateModel::SetModel,
+                                        &TableErrorRateModel::GetModel),
+                   MakePointerChecker<ErrorRateModel> ())
+    .AddAttribute ("MinSnr", "The lowest snr of the tables (dB).",
+                   DoubleValue (-20.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_minSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr", "The highest snr of the tables (dB).",
+                   DoubleValue (40.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_maxSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Resolution", "The snr step of the tables (dB).",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_resolutionDb),
+                   MakeDoubleChecker<double> (1e-6))
+    ;
+  return tid;
+}
+
+TableErrorRateModel::TableErrorRateModel ()
+  : m_model (CreateObject<YansErrorRateModel> ())
+{}
+
+void
+TableErrorRateModel::DoDispose (void)
+{
+  m_model = 0;
+  Clear ();
+  ErrorRateModel::DoDispose ();
+}
+
+void
+TableErrorRateModel::Clear (void)
+{
+  m_tables.clear ();
+}
+
+void
+TableErrorRateModel::SetModel (Ptr<ErrorRateModel> model)
+{
+  m_model = model;
+  Clear ();
+}
+
+Ptr<ErrorRateModel>
+TableErrorRateModel::GetModel (void) const
+{
+  return m_model;
+}
+
+const std::vector<double> &
+TableErrorRateModel::GetTable (WifiMode mode) const
+{
+  if (mode.GetUid () >= m_tables.size ())
+    {
+      m_tables.resize (mode.GetUid () + 1);
+    }
+  std::vector<double> &table = m_tables[mode.GetUid ()];
+  if (!table.empty ())
+    {
+      return table;
+    }
+  uint32_t n = (uint32_t) ((m_maxSnrDb - m_minSnrDb) / m_resolutionDb) + 1;
+  NS_LOG_DEBUG ("building the table of " << mode << " (" << n << " values)");
+  table.reserve (n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double snr = pow (10.0, (m_minSnrDb + i * m_resolutionDb) / 10.0);
+      double success = m_model->GetChunkSuccessRate (mode, snr, 1);
+      double logError;
+      if (success >= 1.0)
+        {
+          logError = MIN_LOG_ERROR;
+        }
+      else if (success <= 0.0)
+        {
+          logError = MAX_LOG_ERROR;
+        }
+      else
+        {
+          logError = log (-log (success));
+          logError = std::max (MIN_LOG_ERROR, std::min (MAX_LOG_ERROR, logError));
+        }
+      table.push_back (logError);
+    }
+  return table;
+}
+
+double
+TableErrorRateModel::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
+{
+  if (snr > 0.0)
+    {
+      const std::vector<double> &table = GetTable (mode);
+      double x = (10.0 * log10 (snr) - m_minSnrDb) / m_resolutionDb;
+      if (x >= 0.0 && x < table.size () - 1.0)
+        {
+          uint32_t i = (uint32_t) x;
+          double a = table[i];
+          double b = table[i + 1];
+          if (a > MIN_LOG_ERROR && a < MAX_LOG_ERROR
+              && b > MIN_LOG_ERROR && b < MAX_LOG_ERROR)
+            {
+              double logError = a + (x - i) * (b - a);
+              return exp (-(nbits * exp (logError)));
+            }
+          else if (a == MIN_LOG_ERROR && b == MIN_LOG_ERROR)
+            {
+              return 1.0;
+            }
+          else if (a == MAX_LOG_ERROR && b == MAX_LOG_ERROR)
+            {
+              return 0.0;
+            }
+          // the edges of the saturated ranges are not interpolated
+        }
+    }
+  return m_model->GetChunkSuccessRate (mode, snr, nbits);
+}
+
+} // namespace ns3
@@ -0,0 +1,77 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef TABLE_ERROR_RATE_MODEL_H
+#define TABLE_ERROR_RATE_MODEL_H
+
+#include <stdint.h>
+#include <vector>
+#include "wifi-mode.h"
+#include "error-rate-model.h"
+
+namespace ns3 {
+
+/**
+ * \brief an interpolated table of the success rates of another model
+ *
+ * The chunk success rate of the error rate models is the success rate
+ * of one bit raised to the number of bits of the chunk: this model
+ * tabulates, for each WifiMode, the success rate of one bit computed by
+ * the model set with the Model attribute (a YansErrorRateModel by
+ * default) on a grid of snr values in dB, and interpolates it, instead
+ * of evaluating the erfc, pow and binomial sums of the model for each
+ * chunk. The tables are built the first time a mode is used.
+ *
+ * The table holds ln (-ln (success rate of one bit)), which is smooth in
+ * dB. The snr values outside of the table, and next to the snr where
+ * the success rate of a bit reaches 0 or 1, are computed by the model.
+ * With the default 0.01 dB resolution, the success rates of the
+ * YansErrorRateModel are matched within 1e-5 for chunks of a few bytes
+ * or more, and within 1e-3 for single bits: bench-error-rate prints the
+ * error for each mode.
+ */
+class TableErrorRateModel : public ErrorRateModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TableErrorRateModel ();
+
+  /**
+   * \param model the model which is tabulated
+   */
+  void SetModel (Ptr<ErrorRateModel> model);
+  Ptr<ErrorRateModel> GetModel (void) const;
+
+  virtual double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
+
+private:
+  virtual void DoDispose (void);
+  const std::vector<double> &GetTable (WifiMode mode) const;
+  void Clear (void);
+
+  Ptr<ErrorRateModel> m_model;
+  double m_minSnrDb;
+  double m_maxSnrDb;
+  double m_resolutionDb;
+  // indexed by the uid of the mode, empty until the mode is used
+  mutable std::vector<std::vector<double> > m_tables;
+};
+
+} // namespace ns3
+
+#endif /* TABLE_ERROR_RATE_MODEL_H */
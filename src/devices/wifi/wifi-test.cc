@@ -28,13 +28,17 @@
 #include "propagation-loss-model.h"
 #include "error-rate-model.h"
 #include "yans-error-rate-model.h"
+#include "table-error-rate-model.h"
+#include "interference-helper.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 #include "ns3/object-factory.h"
 #include "dca-txop.h"
 #include "ns3/pointer.h"
+#include <math.h>
 
 namespace ns3 {
 
@@ -153,6 +157,337 @@ WifiTest::RunTests (void)
 static WifiTest g_wifiTest;
 
 
+class YansWifiChannelTest : public Test
+{
+public:
+  YansWifiChannelTest ();
+
+  virtual bool RunTests (void);
+private:
+  Ptr<YansWifiPhy> CreatePhy (Vector pos, Ptr<YansWifiChannel> channel);
+  void Send (Ptr<YansWifiChannel> channel, Ptr<YansWifiPhy> sender);
+  static void Received (uint32_t *count, Ptr<const Packet> packet);
+  static void ReceiveOk (std::vector<uint32_t> *sizes, Ptr<Packet> packet, double snr,
+                         WifiMode mode, enum WifiPreamble preamble);
+  static void ReceiveError (Ptr<const Packet> packet, double snr);
+
+  std::vector<uint32_t> m_received;
+  std::vector<uint32_t> m_sizes;
+};
+
+YansWifiChannelTest::YansWifiChannelTest ()
+  : Test ("YansWifiChannel")
+{}
+
+void
+YansWifiChannelTest::Received (uint32_t *count, Ptr<const Packet> packet)
+{
+  (*count)++;
+}
+void
+YansWifiChannelTest::ReceiveOk (std::vector<uint32_t> *sizes, Ptr<Packet> packet, double snr,
+                                WifiMode mode, enum WifiPreamble preamble)
+{
+  sizes->push_back (packet->GetSize ());
+  // like a mac stripping its header
+  packet->RemoveAtStart (20);
+}
+void
+YansWifiChannelTest::ReceiveError (Ptr<const Packet> packet, double snr)
+{}
+
+Ptr<YansWifiPhy>
+YansWifiChannelTest::CreatePhy (Vector pos, Ptr<YansWifiChannel> channel)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (pos);
+  node->AggregateObject (mobility);
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  phy->SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  phy->SetMobility (node);
+  phy->SetChannel (channel);
+  phy->SetReceiveOkCallback (MakeBoundCallback (&YansWifiChannelTest::ReceiveOk, &m_sizes));
+  phy->SetReceiveErrorCallback (MakeCallback (&YansWifiChannelTest::ReceiveError));
+  return phy;
+}
+
+void
+YansWifiChannelTest::Send (Ptr<YansWifiChannel> channel, Ptr<YansWifiPhy> sender)
+{
+  for (uint32_t i = 0; i < m_received.size (); i++)
+    {
+      m_received[i] = 0;
+    }
+  channel->Send (sender, Create<Packet> (100), 16.0, WifiPhy::Get6mba (), WIFI_PREAMBLE_LONG);
+}
+
+bool
+YansWifiChannelTest::RunTests (void)
+{
+  bool result = true;
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  Ptr<FixedRssLossModel> loss = CreateObject<FixedRssLossModel> ();
+  loss->SetRss (-50.0);
+  channel->SetPropagationLossModel (loss);
+
+  double x[] = {0.0, 50.0, 99.0, 150.0, -99.0, 1000.0};
+  std::vector<Ptr<YansWifiPhy> > phys;
+  m_received.resize (6);
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      phys.push_back (CreatePhy (Vector (x[i], (i == 4) ? 20.0 : 0.0, 0.0), channel));
+      phys[i]->TraceConnectWithoutContext ("PhyRxBegin",
+        MakeBoundCallback (&YansWifiChannelTest::Received, &m_received[i]));
+    }
+
+  // without a range, every other phy receives the packet
+  Simulator::Schedule (MilliSeconds (1), &YansWifiChannelTest::Send, this, channel, phys[0]);
+  Simulator::Run ();
+  NS_TEST_ASSERT_EQUAL (m_received[0], 0);
+  NS_TEST_ASSERT_EQUAL (m_received[3], 1);
+  NS_TEST_ASSERT_EQUAL (m_received[5], 1);
+  // the receivers share the sent packet but get their own copy
+  NS_TEST_ASSERT_EQUAL (m_sizes.size (), 5);
+  for (uint32_t i = 0; i < m_sizes.size (); i++)
+    {
+      NS_TEST_ASSERT_EQUAL (m_sizes[i], 100);
+    }
+
+  channel->SetMaxRange (100.0);
+  Simulator::Schedule (MilliSeconds (1), &YansWifiChannelTest::Send, this, channel, phys[0]);
+  Simulator::Run ();
+  NS_TEST_ASSERT_EQUAL (m_received[1], 1);
+  NS_TEST_ASSERT_EQUAL (m_received[2], 1);
+  NS_TEST_ASSERT_EQUAL (m_received[3], 0);
+  NS_TEST_ASSERT_EQUAL (m_received[4], 0);
+  NS_TEST_ASSERT_EQUAL (m_received[5], 0);
+
+  // the index follows the course changes
+  phys[5]->GetMobility ()->GetObject<MobilityModel> ()->SetPosition (Vector (-80.0, 0.0, 0.0));
+  Simulator::Schedule (MilliSeconds (1), &YansWifiChannelTest::Send, this, channel, phys[0]);
+  Simulator::Run ();
+  NS_TEST_ASSERT_EQUAL (m_received[5], 1);
+  NS_TEST_ASSERT_EQUAL (m_received[3], 0);
+
+  // the range of the log distance model above the energy detection threshold
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  double range = channel->SetMaxRangeFromLossModel (16.0206, -96.0);
+  NS_TEST_ASSERT (range > 145.0 && range < 155.0);
+  NS_TEST_ASSERT_EQUAL (channel->GetMaxRange (), range);
+
+  Simulator::Destroy ();
+  return result;
+}
+
+static YansWifiChannelTest g_yansWifiChannelTest;
+
+
+class CountingPropagationLossModel : public PropagationLossModel
+{
+public:
+  CountingPropagationLossModel () : m_count (0) {}
+  mutable uint32_t m_count;
+private:
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const
+  {
+    m_count++;
+    return txPowerDbm - a->GetDistanceFrom (b);
+  }
+};
+
+class CachingPropagationLossModelTest : public Test
+{
+public:
+  CachingPropagationLossModelTest ();
+
+  virtual bool RunTests (void);
+};
+
+CachingPropagationLossModelTest::CachingPropagationLossModelTest ()
+  : Test ("CachingPropagationLossModel")
+{}
+
+bool
+CachingPropagationLossModelTest::RunTests (void)
+{
+  bool result = true;
+
+  Ptr<CountingPropagationLossModel> counting = CreateObject<CountingPropagationLossModel> ();
+  Ptr<CachingPropagationLossModel> cache = CreateObject<CachingPropagationLossModel> ();
+  cache->SetModel (counting);
+  Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  b->SetPosition (Vector (10.0, 0.0, 0.0));
+
+  NS_TEST_ASSERT_EQUAL (cache->CalcRxPower (20.0, a, b), 10.0);
+  NS_TEST_ASSERT_EQUAL (cache->CalcRxPower (20.0, a, b), 10.0);
+  NS_TEST_ASSERT_EQUAL (counting->m_count, 1);
+  // another transmission power, or the reverse direction
+  NS_TEST_ASSERT_EQUAL (cache->CalcRxPower (16.0, a, b), 6.0);
+  NS_TEST_ASSERT_EQUAL (cache->CalcRxPower (20.0, b, a), 10.0);
+  NS_TEST_ASSERT_EQUAL (counting->m_count, 3);
+
+  // a course change invalidates the pairs of the model
+  b->SetPosition (Vector (5.0, 0.0, 0.0));
+  NS_TEST_ASSERT_EQUAL (cache->CalcRxPower (20.0, a, b), 15.0);
+  NS_TEST_ASSERT_EQUAL (counting->m_count, 4);
+
+  // moving nodes are only cached for the quantum
+  Ptr<ConstantVelocityMobilityModel> c = CreateObject<ConstantVelocityMobilityModel> ();
+  c->SetVelocity (Vector (1.0, 0.0, 0.0));
+  cache->CalcRxPower (20.0, a, c);
+  cache->CalcRxPower (20.0, a, c);
+  NS_TEST_ASSERT_EQUAL (counting->m_count, 6);
+  cache->SetQuantum (Seconds (1.0));
+  cache->CalcRxPower (20.0, a, c);
+  cache->CalcRxPower (20.0, a, c);
+  NS_TEST_ASSERT_EQUAL (counting->m_count, 7);
+
+  // replacing the model through its attribute drops the cached results
+  Ptr<CountingPropagationLossModel> other = CreateObject<CountingPropagationLossModel> ();
+  cache->SetAttribute ("Model", PointerValue (other));
+  NS_TEST_ASSERT_EQUAL (cache->CalcRxPower (20.0, a, b), 15.0);
+  NS_TEST_ASSERT_EQUAL (other->m_count, 1);
+
+  cache->Dispose ();
+  Simulator::Destroy ();
+  return result;
+}
+
+static CachingPropagationLossModelTest g_cachingPropagationLossModelTest;
+
+
+class InterferenceHelperTest : public Test
+{
+public:
+  InterferenceHelperTest ();
+
+  virtual bool RunTests (void);
+private:
+  void Add (uint32_t i, Time duration, double rxPowerW);
+  void Calculate (uint32_t i);
+  void EnergyDuration (double energyW);
+
+  InterferenceHelper m_interference;
+  std::vector<Ptr<InterferenceHelper::Event> > m_events;
+  std::vector<InterferenceHelper::SnrPer> m_snrPer;
+  Time m_energyDuration;
+};
+
+InterferenceHelperTest::InterferenceHelperTest ()
+  : Test ("InterferenceHelper")
+{}
+
+void
+InterferenceHelperTest::Add (uint32_t i, Time duration, double rxPowerW)
+{
+  m_events[i] = m_interference.Add (1000, WifiPhy::Get6mba (), WIFI_PREAMBLE_LONG,
+                                    duration, rxPowerW);
+}
+
+void
+InterferenceHelperTest::Calculate (uint32_t i)
+{
+  m_snrPer[i] = m_interference.CalculateSnrPer (m_events[i]);
+}
+
+void
+InterferenceHelperTest::EnergyDuration (double energyW)
+{
+  m_energyDuration = m_interference.GetEnergyDuration (energyW);
+}
+
+bool
+InterferenceHelperTest::RunTests (void)
+{
+  bool result = true;
+
+  m_interference.Configure80211aParameters ();
+  m_interference.SetNoiseFigure (1.0);
+  m_interference.SetErrorRateModel (CreateObject<YansErrorRateModel> ());
+  m_events.resize (3);
+  m_snrPer.resize (3);
+
+  // 0 and 1 overlap, 2 starts after both ended
+  Simulator::Schedule (MicroSeconds (0), &InterferenceHelperTest::Add, this, 0, MicroSeconds (100), 1e-9);
+  Simulator::Schedule (MicroSeconds (50), &InterferenceHelperTest::Add, this, 1, MicroSeconds (100), 1e-10);
+  Simulator::Schedule (MicroSeconds (60), &InterferenceHelperTest::EnergyDuration, this, 5e-10);
+  Simulator::Schedule (MicroSeconds (100), &InterferenceHelperTest::Calculate, this, 0);
+  Simulator::Schedule (MicroSeconds (150), &InterferenceHelperTest::Calculate, this, 1);
+  Simulator::Schedule (MicroSeconds (500), &InterferenceHelperTest::Add, this, 2, MicroSeconds (100), 1e-9);
+  Simulator::Schedule (MicroSeconds (600), &InterferenceHelperTest::Calculate, this, 2);
+  Simulator::Run ();
+
+  // the energy is above the threshold until the end of 0
+  NS_TEST_ASSERT_EQUAL (m_energyDuration, MicroSeconds (40));
+  // 1 starts during 0: the snr of 0 is only limited by the noise floor,
+  // the snr of 1 by the interference of 0.
+  NS_TEST_ASSERT_EQUAL (m_snrPer[0].snr, m_snrPer[2].snr);
+  NS_TEST_ASSERT_EQUAL (m_snrPer[0].per, m_snrPer[2].per);
+  NS_TEST_ASSERT (m_snrPer[1].snr > 0.099 && m_snrPer[1].snr < 0.1);
+  NS_TEST_ASSERT (m_snrPer[0].per < 0.01);
+  NS_TEST_ASSERT (m_snrPer[1].per > 0.5);
+
+  Simulator::Destroy ();
+  return result;
+}
+
+static InterferenceHelperTest g_interferenceHelperTest;
+
+
+class TableErrorRateModelTest : public Test
+{
+public:
+  TableErrorRateModelTest ();
+
+  virtual bool RunTests (void);
+};
+
+TableErrorRateModelTest::TableErrorRateModelTest ()
+  : Test ("TableErrorRateModel")
+{}
+
+bool
+TableErrorRateModelTest::RunTests (void)
+{
+  bool result = true;
+
+  Ptr<YansErrorRateModel> yans = CreateObject<YansErrorRateModel> ();
+  Ptr<TableErrorRateModel> table = CreateObject<TableErrorRateModel> ();
+  table->SetModel (yans);
+
+  WifiMode modes[] = {WifiPhy::Get6mba (), WifiPhy::Get24mba (), WifiPhy::Get54mba (),
+                      WifiPhy::Get1mbb (), WifiPhy::Get11mbb ()};
+  double maxError = 0.0;
+  for (uint32_t m = 0; m < sizeof (modes) / sizeof (modes[0]); m++)
+    {
+      for (double snrDb = -5.0; snrDb < 35.0; snrDb += 0.0123)
+        {
+          double snr = pow (10.0, snrDb / 10.0);
+          double error = fabs (table->GetChunkSuccessRate (modes[m], snr, 8 * 1500)
+                               - yans->GetChunkSuccessRate (modes[m], snr, 8 * 1500));
+          maxError = std::max (maxError, error);
+        }
+    }
+  NS_TEST_ASSERT (maxError < 1e-4);
+
+  // outside of the table, the model is used
+  NS_TEST_ASSERT_EQUAL (table->GetChunkSuccessRate (WifiPhy::Get6mba (), 1e5, 1000),
+                        yans->GetChunkSuccessRate (WifiPhy::Get6mba (), 1e5, 1000));
+  NS_TEST_ASSERT_EQUAL (table->GetChunkSuccessRate (WifiPhy::Get6mba (), 0.0, 1000),
+                        yans->GetChunkSuccessRate (WifiPhy::Get6mba (), 0.0, 1000));
+
+  return result;
+}
+
+static TableErrorRateModelTest g_tableErrorRateModelTest;
+
+
 } // namespace ns3
 
 #endif /* RUN_SELF_TESTS */
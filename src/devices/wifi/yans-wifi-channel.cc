@@ -24,11 +24,15 @@
 #include "ns3/node.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/object-factory.h"
+#include "ns3/constant-position-mobility-model.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "propagation-loss-model.h"
 #include "propagation-delay-model.h"
+#include <algorithm>
+#include <math.h>
 
 NS_LOG_COMPONENT_DEFINE ("YansWifiChannel");
 
@@ -48,17 +52,36 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange", "The distance (m) beyond which receivers are ignored, "
+                   "or zero to deliver every packet to every phy.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&YansWifiChannel::SetMaxRange,
+                                       &YansWifiChannel::GetMaxRange),
+                   MakeDoubleChecker<double> (0.0))
     ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_maxRange (0.0),
+    m_maxSpeed (0.0)
 {}
 YansWifiChannel::~YansWifiChannel ()
 {
+  ClearIndex ();
   m_phyList.clear ();
 }
 
+void
+YansWifiChannel::DoDispose (void)
+{
+  ClearIndex ();
+  m_phyList.clear ();
+  m_loss = 0;
+  m_delay = 0;
+  WifiChannel::DoDispose ();
+}
+
 void 
 YansWifiChannel::SetPropagationLossModel (Ptr<PropagationLossModel> loss)
 {
@@ -70,32 +93,224 @@ YansWifiChannel::SetPropagationDelayModel (Ptr<PropagationDelayModel> delay)
   m_delay = delay;
 }
 
+void
+YansWifiChannel::SetMaxRange (double range)
+{
+  ClearIndex ();
+  m_maxRange = range;
+}
+double
+YansWifiChannel::GetMaxRange (void) const
+{
+  return m_maxRange;
+}
+
+double
+YansWifiChannel::SetMaxRangeFromLossModel (double txPowerDbm, double thresholdDbm)
+{
+  Ptr<ConstantPositionMobilityModel> a = CreateObject<ConstantPositionMobilityModel> ();
+  Ptr<ConstantPositionMobilityModel> b = CreateObject<ConstantPositionMobilityModel> ();
+  double near = 0.0;
+  double far = 1.0;
+  b->SetPosition (Vector (far, 0.0, 0.0));
+  while (m_loss->CalcRxPower (txPowerDbm, a, b) >= thresholdDbm && far < 1e7)
+    {
+      near = far;
+      far *= 2;
+      b->SetPosition (Vector (far, 0.0, 0.0));
+    }
+  // the first distance below the threshold, within a centimeter
+  while (far - near > 0.01)
+    {
+      double middle = (near + far) / 2;
+      b->SetPosition (Vector (middle, 0.0, 0.0));
+      if (m_loss->CalcRxPower (txPowerDbm, a, b) >= thresholdDbm)
+        {
+          near = middle;
+        }
+      else
+        {
+          far = middle;
+        }
+    }
+  NS_LOG_DEBUG ("max range for " << txPowerDbm << "dbm above " << thresholdDbm << "dbm: " << far << "m");
+  SetMaxRange (far);
+  return far;
+}
+
 void 
 YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const Packet> packet, double txPowerDbm,
                        WifiMode wifiMode, WifiPreamble preamble) const
 {
   Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
   NS_ASSERT (senderMobility != 0);
-  uint32_t j = 0;
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  if (m_maxRange <= 0)
+    {
+      for (uint32_t j = 0; j < m_phyList.size (); j++)
+        {
+          if (sender != m_phyList[j])
+            {
+              Deliver (j, senderMobility, packet, txPowerDbm, wifiMode, preamble);
+            }
+        }
+      return;
+    }
+  std::vector<uint32_t> receivers;
+  GetReceivers (senderMobility, receivers);
+  for (std::vector<uint32_t>::const_iterator j = receivers.begin (); j != receivers.end (); j++)
+    {
+      if (sender != m_phyList[*j])
+        {
+          Deliver (*j, senderMobility, packet, txPowerDbm, wifiMode, preamble);
+        }
+    }
+}
+
+void
+YansWifiChannel::Deliver (uint32_t j, Ptr<MobilityModel> senderMobility,
+                          Ptr<const Packet> packet, double txPowerDbm,
+                          WifiMode wifiMode, WifiPreamble preamble) const
+{
+  Ptr<MobilityModel> receiverMobility = m_phyList[j]->GetMobility ()->GetObject<MobilityModel> ();
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower="<<txPowerDbm<<"dbm, rxPower="<<rxPowerDbm<<"dbm, "<<
+                "distance="<<senderMobility->GetDistanceFrom (receiverMobility)<<"m, delay="<<delay);
+  // all the receivers share the sent packet: a phy only copies it
+  // when it passes it up, see YansWifiPhy::EndSync.
+  Simulator::Schedule (delay, &YansWifiChannel::Receive, this, 
+                       j, packet, rxPowerDbm, wifiMode, preamble);
+}
+
+void
+YansWifiChannel::GetReceivers (Ptr<MobilityModel> senderMobility,
+                               std::vector<uint32_t> &receivers) const
+{
+  UpdateIndex ();
+  Vector position = senderMobility->GetPosition ();
+  double radius = m_maxRange + m_maxSpeed * (Simulator::Now () - m_lastRefresh).GetSeconds ();
+  Cell low = GetCell (Vector (position.x - radius, position.y - radius, 0.0));
+  Cell high = GetCell (Vector (position.x + radius, position.y + radius, 0.0));
+  for (int64_t x = low.first; x <= high.first; x++)
     {
-      if (sender != (*i))
+      for (int64_t y = low.second; y <= high.second; y++)
         {
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower="<<txPowerDbm<<"dbm, rxPower="<<rxPowerDbm<<"dbm, "<<
-                        "distance="<<senderMobility->GetDistanceFrom (receiverMobility)<<"m, delay="<<delay);
-          Ptr<Packet> copy = packet->Copy ();
-          Simulator::Schedule (delay, &YansWifiChannel::Receive, this, 
-                               j, copy, rxPowerDbm, wifiMode, preamble);
+          Grid::const_iterator cell = m_grid.find (Cell (x, y));
+          if (cell == m_grid.end ())
+            {
+              continue;
+            }
+          for (std::vector<uint32_t>::const_iterator i = cell->second.begin ();
+               i != cell->second.end (); i++)
+            {
+              if (m_indexed[*i].mobility->GetDistanceFrom (senderMobility) <= m_maxRange)
+                {
+                  receivers.push_back (*i);
+                }
+            }
         }
-      j++;
     }
+  // same order, and so same event uids, as without the index
+  std::sort (receivers.begin (), receivers.end ());
+}
+
+void
+YansWifiChannel::UpdateIndex (void) const
+{
+  Time now = Simulator::Now ();
+  if (m_indexed.empty ())
+    {
+      m_lastRefresh = now;
+    }
+  while (m_indexed.size () < m_phyList.size ())
+    {
+      uint32_t i = m_indexed.size ();
+      Indexed indexed;
+      indexed.mobility = m_phyList[i]->GetMobility ()->GetObject<MobilityModel> ();
+      indexed.placed = false;
+      m_indexed.push_back (indexed);
+      m_mobilities[PeekPointer (indexed.mobility)] = i;
+      indexed.mobility->TraceConnectWithoutContext ("CourseChange",
+        MakeCallback (&YansWifiChannel::CourseChanged, this));
+      Place (i);
+    }
+  // once the moving phys may be half a cell away from their cell, they
+  // are placed again, so that at most a few cells are searched.
+  if (m_maxSpeed * (now - m_lastRefresh).GetSeconds () > m_maxRange / 2)
+    {
+      m_maxSpeed = 0.0;
+      for (uint32_t i = 0; i < m_indexed.size (); i++)
+        {
+          if (m_indexed[i].speed > 0.0)
+            {
+              Place (i);
+            }
+        }
+      m_lastRefresh = now;
+    }
+}
+
+void
+YansWifiChannel::Place (uint32_t i) const
+{
+  Indexed &indexed = m_indexed[i];
+  Vector velocity = indexed.mobility->GetVelocity ();
+  indexed.speed = sqrt (velocity.x * velocity.x + velocity.y * velocity.y);
+  m_maxSpeed = std::max (m_maxSpeed, indexed.speed);
+  Cell cell = GetCell (indexed.mobility->GetPosition ());
+  if (indexed.placed)
+    {
+      if (cell == indexed.cell)
+        {
+          return;
+        }
+      std::vector<uint32_t> &phys = m_grid[indexed.cell];
+      phys.erase (std::find (phys.begin (), phys.end (), i));
+      if (phys.empty ())
+        {
+          m_grid.erase (indexed.cell);
+        }
+    }
+  m_grid[cell].push_back (i);
+  indexed.cell = cell;
+  indexed.placed = true;
+}
+
+YansWifiChannel::Cell
+YansWifiChannel::GetCell (const Vector &position) const
+{
+  return Cell ((int64_t)floor (position.x / m_maxRange),
+               (int64_t)floor (position.y / m_maxRange));
+}
+
+void
+YansWifiChannel::CourseChanged (Ptr<const MobilityModel> mobility) const
+{
+  std::map<const MobilityModel *, uint32_t>::const_iterator i =
+    m_mobilities.find (PeekPointer (mobility));
+  if (i != m_mobilities.end ())
+    {
+      Place (i->second);
+    }
+}
+
+void
+YansWifiChannel::ClearIndex (void)
+{
+  for (std::vector<Indexed>::const_iterator i = m_indexed.begin (); i != m_indexed.end (); i++)
+    {
+      const YansWifiChannel *self = this;
+      i->mobility->TraceDisconnectWithoutContext ("CourseChange",
+        MakeCallback (&YansWifiChannel::CourseChanged, self));
+    }
+  m_indexed.clear ();
+  m_grid.clear ();
+  m_mobilities.clear ();
+  m_maxSpeed = 0.0;
 }
 
 void
-YansWifiChannel::Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
+YansWifiChannel::Receive (uint32_t i, Ptr<const Packet> packet, double rxPowerDbm,
                           WifiMode txMode, WifiPreamble preamble) const
 {
   m_phyList[i]->StartReceivePacket (packet, rxPowerDbm, txMode, preamble);
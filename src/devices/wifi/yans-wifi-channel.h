@@ -21,8 +21,11 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include <vector>
+#include <map>
 #include <stdint.h>
 #include "ns3/packet.h"
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
 #include "wifi-channel.h"
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
@@ -30,6 +33,7 @@
 namespace ns3 {
 
 class NetDevice;
+class MobilityModel;
 class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
@@ -44,6 +48,15 @@ class YansWifiPhy;
  * class and contains a ns3::PropagationLossModel and a ns3::PropagationDelayModel.
  * By default, no propagation models are set so, it is the caller's responsability
  * to set them before using the channel.
+ *
+ * By default, every packet is delivered to every other phy of the channel,
+ * however weak the signal. When the MaxRange attribute is set, the phys
+ * are kept in a grid of MaxRange-wide cells, updated from the CourseChange
+ * notifications of their mobility models, and a packet is only delivered
+ * to the phys within MaxRange of the sender: the others do not even see
+ * it as noise. SetMaxRangeFromLossModel computes the distance at which
+ * the loss model brings the tx power down to a threshold such as the
+ * EnergyDetectionThreshold of the phys.
  */
 class YansWifiChannel : public WifiChannel
 {
@@ -68,6 +81,22 @@ public:
    */
   void SetPropagationDelayModel (Ptr<PropagationDelayModel> delay);
 
+  /**
+   * \param range the distance (m) beyond which receivers are ignored, or
+   *        zero to deliver every packet to every phy.
+   */
+  void SetMaxRange (double range);
+  double GetMaxRange (void) const;
+  /**
+   * \param txPowerDbm the highest tx power of the senders
+   * \param thresholdDbm the weakest rx power of interest
+   * \returns the distance beyond which the propagation loss model
+   *          gives less than thresholdDbm, now the MaxRange.
+   *
+   * The loss must increase with the distance, and not be random.
+   */
+  double SetMaxRangeFromLossModel (double txPowerDbm, double thresholdDbm);
+
   /**
    * \param sender the device from which the packet is originating.
    * \param packet the packet to send
@@ -83,13 +112,42 @@ public:
 
 private:
   typedef std::vector<Ptr<YansWifiPhy> > PhyList;
-  void Receive (uint32_t i, Ptr<Packet> packet, double rxPowerDbm,
+  typedef std::pair<int64_t, int64_t> Cell;
+  typedef std::map<Cell, std::vector<uint32_t> > Grid;
+  struct Indexed
+  {
+    Ptr<MobilityModel> mobility;
+    Cell cell;
+    bool placed;
+    double speed;
+  };
+  virtual void DoDispose (void);
+  void Receive (uint32_t i, Ptr<const Packet> packet, double rxPowerDbm,
                 WifiMode txMode, WifiPreamble preamble) const;
-
+  void Deliver (uint32_t i, Ptr<MobilityModel> senderMobility,
+                Ptr<const Packet> packet, double txPowerDbm,
+                WifiMode wifiMode, WifiPreamble preamble) const;
+  void GetReceivers (Ptr<MobilityModel> senderMobility,
+                     std::vector<uint32_t> &receivers) const;
+  void UpdateIndex (void) const;
+  void Place (uint32_t i) const;
+  Cell GetCell (const Vector &position) const;
+  void CourseChanged (Ptr<const MobilityModel> mobility) const;
+  void ClearIndex (void);
 
   PhyList m_phyList;
   Ptr<PropagationLossModel> m_loss;
   Ptr<PropagationDelayModel> m_delay;
+  double m_maxRange;
+  // the spatial index, built on the first Send once the phys have their
+  // mobility models.
+  mutable std::vector<Indexed> m_indexed;
+  mutable Grid m_grid;
+  mutable std::map<const MobilityModel *, uint32_t> m_mobilities;
+  // the moving phys may have left their cell by up to
+  // m_maxSpeed * (now - m_lastRefresh)
+  mutable double m_maxSpeed;
+  mutable Time m_lastRefresh;
 };
 
 } // namespace ns3
@@ -313,7 +313,7 @@ YansWifiPhy::SetReceiveErrorCallback (SyncErrorCallback callback)
   m_state->SetReceiveErrorCallback (callback);
 }
 void 
-YansWifiPhy::StartReceivePacket (Ptr<Packet> packet, 
+YansWifiPhy::StartReceivePacket (Ptr<const Packet> packet, 
                                  double rxPowerDbm,
                                  WifiMode txMode,
                                  enum WifiPreamble preamble)
@@ -570,7 +570,7 @@ YansWifiPhy::GetPowerDbm (uint8_t power) const
 }
 
 void
-YansWifiPhy::EndSync (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> event)
+YansWifiPhy::EndSync (Ptr<const Packet> packet, Ptr<InterferenceHelper::Event> event)
 {
   NS_LOG_FUNCTION (this << packet << event);
   NS_ASSERT (IsStateSync ());
@@ -589,7 +589,9 @@ YansWifiPhy::EndSync (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> event)
       double signalDbm = RatioToDb (event->GetRxPowerW ()) + 30;
       double noiseDbm = RatioToDb(event->GetRxPowerW() / snrPer.snr) - GetRxNoiseFigure() + 30 ;
       NotifyPromiscSniffRx (packet, m_channelFreqMhz, dataRate500KbpsUnits, isShortPreamble, signalDbm, noiseDbm);
-      m_state->SwitchFromSyncEndOk (packet, snrPer.snr, event->GetPayloadMode (), event->GetPreambleType ());
+      // the packet is shared by all the receivers of the channel: the
+      // mac strips its headers from a private copy.
+      m_state->SwitchFromSyncEndOk (packet->Copy (), snrPer.snr, event->GetPayloadMode (), event->GetPreambleType ());
     } 
   else 
     {
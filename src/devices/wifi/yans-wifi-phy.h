@@ -69,7 +69,7 @@ public:
   virtual ~YansWifiPhy ();
 
   void SetChannel (Ptr<YansWifiChannel> channel);
-  void StartReceivePacket (Ptr<Packet> packet,
+  void StartReceivePacket (Ptr<const Packet> packet,
                            double rxPowerDbm,
                            WifiMode mode,
                            WifiPreamble preamble);
@@ -132,7 +132,7 @@ private:
   double WToDbm (double w) const;
   double RatioToDb (double ratio) const;
   double GetPowerDbm (uint8_t power) const;
-  void EndSync (Ptr<Packet> packet, Ptr<InterferenceHelper::Event> event);
+  void EndSync (Ptr<const Packet> packet, Ptr<InterferenceHelper::Event> event);
 
 private:
   double   m_edThresholdW;
@@ -0,0 +1,496 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "binary-mobility-helper.h"
+
+NS_LOG_COMPONENT_DEFINE ("BinaryMobilityHelper");
+
+namespace ns3 {
+
+/*
+ * The trace file holds a TraceHeader, one TraceNode per node, indexed
+ * by node id, and the waypoints of each node, sorted by time. All the
+ * fields are in the byte order of the host which wrote the file.
+ */
+static const char TRACE_MAGIC[8] = {'n', 's', '3', 'm', 'o', 'b', '\0', '\1'};
+
+struct TraceHeader
+{
+  char magic[8];
+  uint32_t nNodes;
+  uint32_t reserved;
+};
+
+struct TraceNode
+{
+  uint64_t offset;
+  uint32_t nWaypoints;
+  uint32_t reserved;
+};
+
+struct TraceWaypoint
+{
+  double time;
+  float position[3];
+  float velocity[3];
+};
+
+/**
+ * The trace file mapped in memory, which is unmapped when the last
+ * waypoint event is run or destroyed.
+ */
+class MobilityTrace : public SimpleRefCount<MobilityTrace>
+{
+public:
+  MobilityTrace (std::string filename);
+  ~MobilityTrace ();
+  uint32_t GetNNodes (void) const;
+  uint32_t GetNWaypoints (uint32_t node) const;
+  const TraceWaypoint &GetWaypoint (uint32_t node, uint32_t i) const;
+private:
+  const uint8_t *m_data;
+  size_t m_size;
+};
+
+MobilityTrace::MobilityTrace (std::string filename)
+  : m_data (0),
+    m_size (0)
+{
+  int fd = open (filename.c_str (), O_RDONLY);
+  if (fd == -1)
+    {
+      NS_FATAL_ERROR ("Could not open mobility trace " << filename);
+    }
+  struct stat st;
+  if (fstat (fd, &st) == -1 || st.st_size < (off_t)sizeof (TraceHeader))
+    {
+      NS_FATAL_ERROR ("Invalid mobility trace " << filename);
+    }
+  m_size = st.st_size;
+  void *data = mmap (0, m_size, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (data == MAP_FAILED)
+    {
+      NS_FATAL_ERROR ("Could not map mobility trace " << filename);
+    }
+  m_data = (const uint8_t *)data;
+  const TraceHeader *header = (const TraceHeader *)m_data;
+  if (memcmp (header->magic, TRACE_MAGIC, sizeof (TRACE_MAGIC)) != 0
+      || m_size < sizeof (TraceHeader) + header->nNodes * sizeof (TraceNode))
+    {
+      NS_FATAL_ERROR ("Invalid mobility trace " << filename);
+    }
+  for (uint32_t node = 0; node < GetNNodes (); node++)
+    {
+      const TraceNode *index = (const TraceNode *)(m_data + sizeof (TraceHeader)) + node;
+      if (index->offset > m_size
+          || index->nWaypoints > (m_size - index->offset) / sizeof (TraceWaypoint))
+        {
+          NS_FATAL_ERROR ("Invalid mobility trace " << filename);
+        }
+    }
+}
+
+MobilityTrace::~MobilityTrace ()
+{
+  munmap ((void *)m_data, m_size);
+}
+
+uint32_t
+MobilityTrace::GetNNodes (void) const
+{
+  return ((const TraceHeader *)m_data)->nNodes;
+}
+
+uint32_t
+MobilityTrace::GetNWaypoints (uint32_t node) const
+{
+  const TraceNode *index = (const TraceNode *)(m_data + sizeof (TraceHeader)) + node;
+  return index->nWaypoints;
+}
+
+const TraceWaypoint &
+MobilityTrace::GetWaypoint (uint32_t node, uint32_t i) const
+{
+  const TraceNode *index = (const TraceNode *)(m_data + sizeof (TraceHeader)) + node;
+  return ((const TraceWaypoint *)(m_data + index->offset))[i];
+}
+
+static void ScheduleWaypoint (Ptr<MobilityTrace> trace, Ptr<ConstantVelocityMobilityModel> model,
+                              uint32_t node, uint32_t i, uint32_t window);
+
+static void
+ApplyWaypoint (Ptr<MobilityTrace> trace, Ptr<ConstantVelocityMobilityModel> model,
+               uint32_t node, uint32_t i, uint32_t window)
+{
+  const TraceWaypoint &waypoint = trace->GetWaypoint (node, i);
+  NS_LOG_DEBUG ("node=" << node << " at=" << waypoint.time);
+  model->SetPosition (Vector (waypoint.position[0], waypoint.position[1], waypoint.position[2]));
+  model->SetVelocity (Vector (waypoint.velocity[0], waypoint.velocity[1], waypoint.velocity[2]));
+  ScheduleWaypoint (trace, model, node, i + window, window);
+}
+
+static void
+ScheduleWaypoint (Ptr<MobilityTrace> trace, Ptr<ConstantVelocityMobilityModel> model,
+                  uint32_t node, uint32_t i, uint32_t window)
+{
+  if (i >= trace->GetNWaypoints (node))
+    {
+      return;
+    }
+  Time delay = Seconds (trace->GetWaypoint (node, i).time) - Simulator::Now ();
+  if (delay.IsStrictlyNegative ())
+    {
+      delay = Seconds (0.0);
+    }
+  Simulator::Schedule (delay, &ApplyWaypoint, trace, model, node, i, window);
+}
+
+BinaryMobilityHelper::BinaryMobilityHelper (std::string filename)
+  : m_filename (filename),
+    m_window (1)
+{}
+
+void
+BinaryMobilityHelper::SetWindow (uint32_t window)
+{
+  NS_ASSERT (window > 0);
+  m_window = window;
+}
+
+void
+BinaryMobilityHelper::LayoutObjectStore (const ObjectStore &store) const
+{
+  Ptr<MobilityTrace> trace = Create<MobilityTrace> (m_filename);
+  for (uint32_t node = 0; node < trace->GetNNodes (); node++)
+    {
+      Ptr<Object> object = store.Get (node);
+      if (object == 0)
+        {
+          break;
+        }
+      if (trace->GetNWaypoints (node) == 0)
+        {
+          continue;
+        }
+      Ptr<ConstantVelocityMobilityModel> model = object->GetObject<ConstantVelocityMobilityModel> ();
+      if (model == 0)
+        {
+          model = CreateObject<ConstantVelocityMobilityModel> ();
+          object->AggregateObject (model);
+        }
+      for (uint32_t i = 0; i < m_window; i++)
+        {
+          ScheduleWaypoint (trace, model, node, i, m_window);
+        }
+    }
+}
+
+void
+BinaryMobilityHelper::Install (void) const
+{
+  Install (NodeList::Begin (), NodeList::End ());
+}
+
+namespace {
+
+struct Ns2Setdest
+{
+  double time;
+  double x;
+  double y;
+  double speed;
+  bool operator < (const Ns2Setdest &o) const
+  {
+    return time < o.time;
+  }
+};
+
+struct Ns2Node
+{
+  Vector position;
+  std::vector<Ns2Setdest> setdests;
+};
+
+TraceWaypoint
+MakeWaypoint (double time, const Vector &position, const Vector &velocity)
+{
+  TraceWaypoint waypoint;
+  waypoint.time = time;
+  waypoint.position[0] = position.x;
+  waypoint.position[1] = position.y;
+  waypoint.position[2] = position.z;
+  waypoint.velocity[0] = velocity.x;
+  waypoint.velocity[1] = velocity.y;
+  waypoint.velocity[2] = velocity.z;
+  return waypoint;
+}
+
+// replays the setdest commands of a node in time order.
+std::vector<TraceWaypoint>
+GetWaypoints (Ns2Node &node)
+{
+  std::vector<TraceWaypoint> waypoints;
+  std::stable_sort (node.setdests.begin (), node.setdests.end ());
+  double time = 0.0;
+  Vector position = node.position;
+  Vector velocity;
+  Vector destination;
+  bool moving = false;
+  double arrival = 0.0;
+  waypoints.push_back (MakeWaypoint (time, position, velocity));
+  for (std::vector<Ns2Setdest>::const_iterator i = node.setdests.begin ();
+       i != node.setdests.end (); ++i)
+    {
+      if (moving && arrival <= i->time)
+        {
+          time = arrival;
+          position = destination;
+          velocity = Vector ();
+          moving = false;
+          waypoints.push_back (MakeWaypoint (time, position, velocity));
+        }
+      position.x += velocity.x * (i->time - time);
+      position.y += velocity.y * (i->time - time);
+      time = i->time;
+      destination = Vector (i->x, i->y, position.z);
+      double distance = CalculateDistance (position, destination);
+      if (i->speed > 0.0 && distance > 0.0)
+        {
+          double k = i->speed / distance;
+          velocity = Vector (k * (destination.x - position.x), k * (destination.y - position.y), 0.0);
+          arrival = time + distance / i->speed;
+          moving = true;
+        }
+      else
+        {
+          velocity = Vector ();
+          moving = false;
+        }
+      waypoints.push_back (MakeWaypoint (time, position, velocity));
+    }
+  if (moving)
+    {
+      waypoints.push_back (MakeWaypoint (arrival, destination, Vector ()));
+    }
+  return waypoints;
+}
+
+} // anonymous namespace
+
+void
+BinaryMobilityHelper::ConvertNs2 (std::string ns2Filename, std::string filename)
+{
+  std::ifstream ns2File (ns2Filename.c_str (), std::ios::in);
+  if (!ns2File.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open ns2 mobility trace " << ns2Filename);
+    }
+  std::vector<Ns2Node> nodes;
+  std::string line;
+  while (getline (ns2File, line))
+    {
+      std::string::size_type startNodeId = line.find ("$node_(");
+      std::string::size_type endNodeId = line.find_first_of (")", startNodeId);
+      if (startNodeId == std::string::npos || endNodeId == std::string::npos)
+        {
+          continue;
+        }
+      uint32_t id;
+      std::istringstream idStream (line.substr (startNodeId + 7, endNodeId - startNodeId - 7));
+      if (!(idStream >> id))
+        {
+          continue;
+        }
+      if (id >= nodes.size ())
+        {
+          nodes.resize (id + 1);
+        }
+      std::istringstream command (line.substr (endNodeId + 1));
+      std::string verb;
+      command >> verb;
+      if (verb == "set")
+        {
+          std::string coordinate;
+          double value;
+          command >> coordinate >> value;
+          if (coordinate == "X_")
+            {
+              nodes[id].position.x = value;
+            }
+          else if (coordinate == "Y_")
+            {
+              nodes[id].position.y = value;
+            }
+          else if (coordinate == "Z_")
+            {
+              nodes[id].position.z = value;
+            }
+        }
+      else if (verb == "setdest")
+        {
+          Ns2Setdest setdest;
+          command >> setdest.x >> setdest.y >> setdest.speed;
+          std::string::size_type at = line.find (" at ");
+          std::istringstream atStream (line.substr (at + 4));
+          if (at == std::string::npos || !(atStream >> setdest.time) || !command)
+            {
+              NS_LOG_WARN ("Invalid setdest command: " << line);
+              continue;
+            }
+          nodes[id].setdests.push_back (setdest);
+        }
+    }
+  ns2File.close ();
+
+  std::ofstream file (filename.c_str (), std::ios::out | std::ios::binary);
+  if (!file.is_open ())
+    {
+      NS_FATAL_ERROR ("Could not open mobility trace " << filename);
+    }
+  TraceHeader header;
+  memcpy (header.magic, TRACE_MAGIC, sizeof (TRACE_MAGIC));
+  header.nNodes = nodes.size ();
+  header.reserved = 0;
+  file.write ((const char *)&header, sizeof (header));
+  // the index is written before the waypoints, which are only known
+  // one node at a time.
+  std::vector<TraceNode> index (nodes.size ());
+  for (uint32_t id = 0; id < nodes.size (); id++)
+    {
+      file.write ((const char *)&index[id], sizeof (TraceNode));
+    }
+  uint64_t offset = sizeof (TraceHeader) + index.size () * sizeof (TraceNode);
+  for (uint32_t id = 0; id < nodes.size (); id++)
+    {
+      std::vector<TraceWaypoint> waypoints = GetWaypoints (nodes[id]);
+      index[id].offset = offset;
+      index[id].nWaypoints = waypoints.size ();
+      index[id].reserved = 0;
+      file.write ((const char *)&waypoints[0], waypoints.size () * sizeof (TraceWaypoint));
+      offset += waypoints.size () * sizeof (TraceWaypoint);
+      std::vector<Ns2Setdest> ().swap (nodes[id].setdests);
+    }
+  if (!index.empty ())
+    {
+      file.seekp (sizeof (TraceHeader));
+      file.write ((const char *)&index[0], index.size () * sizeof (TraceNode));
+    }
+  file.close ();
+  if (file.fail ())
+    {
+      NS_FATAL_ERROR ("Could not write mobility trace " << filename);
+    }
+}
+
+} // namespace ns3
+
+#ifdef RUN_SELF_TESTS
+
+#include "ns3/test.h"
+#include <cstdio>
+
+namespace ns3 {
+
+class BinaryMobilityHelperTest : public Test
+{
+public:
+  BinaryMobilityHelperTest ();
+  virtual bool RunTests (void);
+private:
+  void CheckPosition (Ptr<MobilityModel> model, Vector position);
+  bool m_result;
+};
+
+static BinaryMobilityHelperTest g_binaryMobilityHelperTest;
+
+BinaryMobilityHelperTest::BinaryMobilityHelperTest ()
+  : Test ("BinaryMobilityHelper")
+{}
+
+void
+BinaryMobilityHelperTest::CheckPosition (Ptr<MobilityModel> model, Vector position)
+{
+  bool result = true;
+  NS_TEST_ASSERT (CalculateDistance (model->GetPosition (), position) < 1e-4);
+  m_result = m_result && result;
+}
+
+bool
+BinaryMobilityHelperTest::RunTests (void)
+{
+  m_result = true;
+  std::string ns2Filename = "binary-mobility-helper-test.ns2";
+  std::string filename = "binary-mobility-helper-test.bin";
+  std::ofstream ns2File (ns2Filename.c_str ());
+  ns2File << "$node_(0) set X_ 0.0" << std::endl
+          << "$node_(0) set Y_ 0.0" << std::endl
+          << "$node_(1) set X_ 5.0" << std::endl
+          << "$node_(1) set Y_ 5.0" << std::endl
+          << "$ns_ at 20.0 \"$node_(0) setdest 10.0 10.0 2.0\"" << std::endl
+          << "$ns_ at 1.0 \"$node_(0) setdest 10.0 0.0 1.0\"" << std::endl;
+  ns2File.close ();
+  BinaryMobilityHelper::ConvertNs2 (ns2Filename, filename);
+
+  for (uint32_t window = 1; window < 4; window++)
+    {
+      std::vector<Ptr<ConstantVelocityMobilityModel> > models;
+      models.push_back (CreateObject<ConstantVelocityMobilityModel> ());
+      models.push_back (CreateObject<ConstantVelocityMobilityModel> ());
+      BinaryMobilityHelper helper (filename);
+      helper.SetWindow (window);
+      helper.Install (models.begin (), models.end ());
+      Simulator::Schedule (Seconds (0.5), &BinaryMobilityHelperTest::CheckPosition, this,
+                           models[0], Vector (0.0, 0.0, 0.0));
+      Simulator::Schedule (Seconds (6.0), &BinaryMobilityHelperTest::CheckPosition, this,
+                           models[0], Vector (5.0, 0.0, 0.0));
+      Simulator::Schedule (Seconds (15.0), &BinaryMobilityHelperTest::CheckPosition, this,
+                           models[0], Vector (10.0, 0.0, 0.0));
+      Simulator::Schedule (Seconds (22.0), &BinaryMobilityHelperTest::CheckPosition, this,
+                           models[0], Vector (10.0, 4.0, 0.0));
+      Simulator::Schedule (Seconds (30.0), &BinaryMobilityHelperTest::CheckPosition, this,
+                           models[0], Vector (10.0, 10.0, 0.0));
+      Simulator::Schedule (Seconds (30.0), &BinaryMobilityHelperTest::CheckPosition, this,
+                           models[1], Vector (5.0, 5.0, 0.0));
+      Simulator::Run ();
+      Simulator::Destroy ();
+    }
+
+  std::remove (ns2Filename.c_str ());
+  std::remove (filename.c_str ());
+  return m_result;
+}
+
+} // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
@@ -0,0 +1,135 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef BINARY_MOBILITY_HELPER_H
+#define BINARY_MOBILITY_HELPER_H
+
+#include <string>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/object.h"
+
+namespace ns3 {
+
+/**
+ * \brief a topology object which plays binary mobility traces.
+ *
+ * A binary mobility trace holds, for each node, the list of its
+ * waypoints sorted by time: at the time of a waypoint, the node is
+ * moved to the position of the waypoint and moves at its velocity
+ * until the next waypoint. The waypoints of each node are contiguous
+ * in the file, which is mapped in memory: only the next waypoints of
+ * each node, the Window, are scheduled at any time, and each waypoint
+ * schedules the waypoint which comes Window waypoints later. The time
+ * and memory needed to install a trace thus depend on the number of
+ * nodes only, and not on the length of the trace.
+ *
+ * ConvertNs2 converts an ns2 movement file generated by the CMU
+ * setdest tool to this format.
+ */
+class BinaryMobilityHelper
+{
+public:
+  /**
+   * \param filename filename of file which contains the
+   *        binary mobility trace.
+   */
+  BinaryMobilityHelper (std::string filename);
+
+  /**
+   * \param window the number of waypoints scheduled for each node
+   *        (1 by default).
+   */
+  void SetWindow (uint32_t window);
+
+  /**
+   * Map the trace file and configure the movement patterns of all
+   * nodes contained in the global ns3::NodeList whose nodeId matches
+   * the nodeId of the nodes in the trace file.
+   */
+  void Install (void) const;
+
+  /**
+   * \param begin an iterator which points to the start of the input
+   *        object array.
+   * \param end an iterator which points to the end of the input
+   *        object array.
+   *
+   * Map the trace file and configure the movement patterns of all
+   * input objects. Each input object is identified by a unique node
+   * id which reflects the index of the object in the input array.
+   */
+  template <typename T>
+  void Install (T begin, T end) const;
+
+  /**
+   * \param ns2Filename filename of file which contains the ns2
+   *        movement trace.
+   * \param filename filename of the binary mobility trace to write.
+   *
+   * Convert the "set X_", "set Y_", "set Z_" and "setdest" commands
+   * of an ns2 movement trace: a setdest command is converted to a
+   * waypoint at its time, and to a waypoint with a null velocity when
+   * the node reaches its destination.
+   */
+  static void ConvertNs2 (std::string ns2Filename, std::string filename);
+private:
+  class ObjectStore
+  {
+  public:
+    virtual ~ObjectStore () {}
+    virtual Ptr<Object> Get (uint32_t i) const = 0;
+  };
+  void LayoutObjectStore (const ObjectStore &store) const;
+  std::string m_filename;
+  uint32_t m_window;
+};
+
+} // namespace ns3
+
+namespace ns3 {
+
+template <typename T>
+void
+BinaryMobilityHelper::Install (T begin, T end) const
+{
+  class MyObjectStore : public ObjectStore
+  {
+  public:
+    MyObjectStore (T begin, T end)
+      : m_begin (begin),
+      m_end (end)
+        {}
+    virtual Ptr<Object> Get (uint32_t i) const {
+      T iterator = m_begin;
+      iterator += i;
+      if (iterator >= m_end)
+        {
+          return 0;
+        }
+      return *iterator;
+    }
+  private:
+    T m_begin;
+    T m_end;
+  };
+  LayoutObjectStore (MyObjectStore (begin, end));
+}
+
+} // namespace ns3
+
+#endif /* BINARY_MOBILITY_HELPER_H */
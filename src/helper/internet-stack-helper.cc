@@ -178,8 +178,15 @@ InternetStackHelper::InternetStackHelper ()
   static Ipv4StaticRoutingHelper staticRouting;
   static Ipv4GlobalRoutingHelper globalRouting;
   static Ipv4ListRoutingHelper listRouting;
-  listRouting.Add (staticRouting, 0);
-  listRouting.Add (globalRouting, -10);
+  static bool listRoutingFilled = false;
+  // the helpers are shared by all the InternetStackHelpers: adding them
+  // again would aggregate a second GlobalRouter to each node.
+  if (!listRoutingFilled)
+    {
+      listRouting.Add (staticRouting, 0);
+      listRouting.Add (globalRouting, -10);
+      listRoutingFilled = true;
+    }
   SetRoutingHelper (listRouting);
 }
 
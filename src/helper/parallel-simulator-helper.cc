@@ -0,0 +1,303 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "parallel-simulator-helper.h"
+#include "ns3/parallel-simulator-impl.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/channel.h"
+#include "ns3/uinteger.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+#include <algorithm>
+#include <set>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ParallelSimulatorHelper");
+
+namespace ns3 {
+
+static uint32_t
+FindRoot (std::vector<uint32_t> &parent, uint32_t i)
+{
+  while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+  return i;
+}
+
+static void
+Join (std::vector<uint32_t> &parent, uint32_t a, uint32_t b)
+{
+  a = FindRoot (parent, a);
+  b = FindRoot (parent, b);
+  // the root of a group is its smallest node id.
+  if (a < b)
+    {
+      parent[b] = a;
+    }
+  else
+    {
+      parent[a] = b;
+    }
+}
+
+ParallelSimulatorHelper::ParallelSimulatorHelper ()
+  : m_maxThreads (0)
+{}
+
+void
+ParallelSimulatorHelper::SetMaxThreads (uint32_t n)
+{
+  m_maxThreads = n;
+}
+
+Time
+ParallelSimulatorHelper::Partition (uint32_t nLps) const
+{
+  Ptr<ParallelSimulatorImpl> impl = DynamicCast<ParallelSimulatorImpl> (Simulator::GetImplementation ());
+  if (impl == 0)
+    {
+      NS_FATAL_ERROR ("ParallelSimulatorHelper::Partition(): the simulator implementation is not ns3::ParallelSimulatorImpl");
+    }
+  NS_ASSERT (nLps > 0);
+
+  uint32_t nNodes = NodeList::GetNNodes ();
+  std::vector<uint32_t> parent (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      parent[i] = i;
+    }
+
+  // group the nodes which cannot be separated and keep the links
+  // which can.
+  std::set<Ptr<Channel> > seen;
+  std::vector<Ptr<PointToPointChannel> > links;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<Node> node = NodeList::GetNode (i);
+      for (uint32_t j = 0; j < node->GetNDevices (); j++)
+        {
+          Ptr<Channel> channel = node->GetDevice (j)->GetChannel ();
+          if (channel == 0 || !seen.insert (channel).second)
+            {
+              continue;
+            }
+          Ptr<PointToPointChannel> link = DynamicCast<PointToPointChannel> (channel);
+          if (link != 0 && link->GetNDevices () == 2)
+            {
+              TimeValue delay;
+              link->GetAttribute ("Delay", delay);
+              if (delay.Get ().IsStrictlyPositive ())
+                {
+                  links.push_back (link);
+                  continue;
+                }
+            }
+          for (uint32_t k = 1; k < channel->GetNDevices (); k++)
+            {
+              Join (parent, channel->GetDevice (0)->GetNode ()->GetId (),
+                    channel->GetDevice (k)->GetNode ()->GetId ());
+            }
+        }
+    }
+
+  // hand out the groups in order of their smallest node id.
+  std::vector<uint32_t> size (nNodes, 0);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      size[FindRoot (parent, i)]++;
+    }
+  std::vector<uint32_t> lpOf (nNodes, 0);
+  uint32_t assigned = 0;
+  uint32_t lastLp = 0;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      if (FindRoot (parent, i) != i)
+        {
+          continue;
+        }
+      uint32_t target = (uint64_t)assigned * nLps / nNodes;
+      if (assigned != 0 && target > lastLp)
+        {
+          lastLp++;
+        }
+      lpOf[i] = lastLp;
+      assigned += size[i];
+    }
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      impl->SetPartition (i, lpOf[FindRoot (parent, i)]);
+    }
+
+  // compare time steps: Time arithmetic overflows near the maximum
+  // simulation time.
+  int64_t lookahead = Simulator::GetMaximumSimulationTime ().GetTimeStep ();
+  for (std::vector<Ptr<PointToPointChannel> >::const_iterator i = links.begin (); i != links.end (); ++i)
+    {
+      uint32_t a = (*i)->GetDevice (0)->GetNode ()->GetId ();
+      uint32_t b = (*i)->GetDevice (1)->GetNode ()->GetId ();
+      if (lpOf[FindRoot (parent, a)] != lpOf[FindRoot (parent, b)])
+        {
+          TimeValue delay;
+          (*i)->GetAttribute ("Delay", delay);
+          lookahead = std::min (lookahead, delay.Get ().GetTimeStep ());
+        }
+    }
+  NS_LOG_LOGIC ("partitioned " << nNodes << " nodes into " << (lastLp + 1) <<
+                " logical processes, lookahead " << lookahead);
+  impl->SetLookahead (TimeStep (lookahead));
+  impl->SetAttribute ("MaxThreads", UintegerValue (m_maxThreads));
+  return TimeStep (lookahead);
+}
+
+} // namespace ns3
+
+
+#ifdef RUN_SELF_TESTS
+
+#include "ns3/test.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/string.h"
+#include "ns3/packet.h"
+#include <sstream>
+
+namespace ns3 {
+
+class ParallelSimulatorHelperTest : public Test
+{
+public:
+  ParallelSimulatorHelperTest ();
+  virtual bool RunTests (void);
+private:
+  std::string RunRing (uint32_t nThreads);
+  void Send (uint32_t node, uint32_t hops);
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                uint16_t protocol, const Address &from);
+
+  std::vector<Ptr<NetDevice> > m_next;
+  std::vector<std::ostringstream *> m_traces;
+};
+
+ParallelSimulatorHelperTest::ParallelSimulatorHelperTest ()
+  : Test ("ParallelSimulatorHelper")
+{}
+
+void
+ParallelSimulatorHelperTest::Send (uint32_t node, uint32_t hops)
+{
+  // the size of a packet is the number of hops it has left.
+  m_next[node]->Send (Create<Packet> (hops), m_next[node]->GetBroadcast (), 0x800);
+}
+
+bool
+ParallelSimulatorHelperTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                      uint16_t protocol, const Address &from)
+{
+  // each node only ever writes to its own trace.
+  uint32_t node = device->GetNode ()->GetId ();
+  *m_traces[node] << Simulator::Now ().GetTimeStep () << ":" << packet->GetSize () << " ";
+  if (packet->GetSize () > 1)
+    {
+      Send (node, packet->GetSize () - 1);
+    }
+  return true;
+}
+
+std::string
+ParallelSimulatorHelperTest::RunRing (uint32_t nThreads)
+{
+  uint32_t nNodes = 8;
+  Simulator::Destroy ();
+  if (nThreads != 0)
+    {
+      Simulator::SetImplementation (CreateObject<ParallelSimulatorImpl> ());
+    }
+
+  // all the links have the same delay and data rate, so that many
+  // packets arrive at the same time.
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("1Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+  m_next.clear ();
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      NetDeviceContainer devices = p2p.Install (nodes.Get (i), nodes.Get ((i + 1) % nNodes));
+      m_next.push_back (devices.Get (0));
+      devices.Get (1)->SetReceiveCallback (MakeCallback (&ParallelSimulatorHelperTest::Receive, this));
+      m_traces.push_back (new std::ostringstream ());
+    }
+  if (nThreads != 0)
+    {
+      ParallelSimulatorHelper parallel;
+      parallel.SetMaxThreads (nThreads);
+      parallel.Partition (4);
+    }
+
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      for (uint32_t j = 0; j < 20; j++)
+        {
+          Simulator::ScheduleWithContext (i, MicroSeconds (100 * j),
+                                          &ParallelSimulatorHelperTest::Send, this, i, 1 + (i + j) % 24);
+        }
+    }
+  Simulator::Run ();
+
+  std::string result;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      result += m_traces[i]->str () + "\n";
+      delete m_traces[i];
+    }
+  m_traces.clear ();
+  m_next.clear ();
+  Simulator::Destroy ();
+  return result;
+}
+
+bool
+ParallelSimulatorHelperTest::RunTests (void)
+{
+  bool result = true;
+
+  // the packets which cross logical processes must arrive exactly as
+  // with the sequential simulator, whatever the number of threads.
+  std::string sequential = RunRing (0);
+  NS_TEST_ASSERT (!sequential.empty ());
+  NS_TEST_ASSERT (RunRing (1) == sequential);
+  NS_TEST_ASSERT (RunRing (2) == sequential);
+  NS_TEST_ASSERT (RunRing (4) == sequential);
+
+  return result;
+}
+
+static ParallelSimulatorHelperTest g_parallelSimulatorHelperTest;
+
+} // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
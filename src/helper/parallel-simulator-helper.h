@@ -0,0 +1,67 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef PARALLEL_SIMULATOR_HELPER_H
+#define PARALLEL_SIMULATOR_HELPER_H
+
+#include "ns3/nstime.h"
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \brief Partition the nodes of a simulation for ns3::ParallelSimulatorImpl
+ *
+ * Nodes which share a channel other than a point-to-point link with
+ * a non-zero delay always end up in the same logical process, since
+ * such channels keep state which all the attached devices access.
+ * The resulting groups of nodes are assigned, by increasing node id,
+ * to contiguous and roughly equally sized logical processes, and the
+ * lookahead is set to the smallest delay of the point-to-point links
+ * which were cut.
+ *
+ * The simulator implementation must have been selected with the
+ * "SimulatorImplementationType" global value, and Partition must be
+ * called once the topology is built, before Simulator::Run.
+ */
+class ParallelSimulatorHelper
+{
+public:
+  ParallelSimulatorHelper ();
+
+  /**
+   * \param n the maximum number of threads which run logical processes,
+   *        zero to use one per online processor.
+   */
+  void SetMaxThreads (uint32_t n);
+
+  /**
+   * \param nLps the number of logical processes to create
+   * \returns the lookahead of the resulting partitioning
+   *
+   * Fewer logical processes are created if there are not enough
+   * independent groups of nodes.
+   */
+  Time Partition (uint32_t nLps) const;
+
+private:
+  uint32_t m_maxThreads;
+};
+
+} // namespace ns3
+
+#endif /* PARALLEL_SIMULATOR_HELPER_H */
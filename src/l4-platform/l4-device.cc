@@ -268,7 +268,7 @@ L4Device::Start ()
   }
   NS_LOG_INFO("L4Device :Creating TransportSelect object with m_selectNotifyFd [1] : " << m_selectNotifyFd [1]);
   //Create TransportSelect Object and pass it listening socket
-  m_transportSelect = TransportSelect (m_selectNotifyFd [1], this);
+  m_transportSelect = TransportSelect (m_selectNotifyFd [1], this, &m_readyFds);
 
   //Spawn TransportSelect thread
   m_transportSelectThread = Create<SystemThread> (MakeCallback (&TransportSelect::Run, &m_transportSelect));
@@ -463,6 +463,30 @@ L4Device::ExceptionFd (int fd)
   }
 }
 
+void
+L4Device::ReadyFdsPending (void)
+{
+  m_readyFdBatch.clear ();
+  m_readyFds.Drain (m_readyFdBatch);
+  NS_LOG_INFO ("Main thread got " << m_readyFdBatch.size () << " ready fds");
+  for (ReadyFdBatch::const_iterator it = m_readyFdBatch.begin ();
+    it != m_readyFdBatch.end (); it++)
+  {
+    switch (it->m_kind)
+    {
+      case ReadyFd::READ:
+        ReadFdReady (it->m_fd);
+        break;
+      case ReadyFd::WRITE:
+        WriteFdReady (it->m_fd);
+        break;
+      case ReadyFd::EXCEPTION:
+        ExceptionFd (it->m_fd);
+        break;
+    }
+  }
+}
+
 void 
 L4Device::CloseFd (int fd)
 {
@@ -37,6 +37,7 @@
 #include <map>
 #include "transport-socket.h"
 #include "transport-select.h"
+#include "ready-fd-queue.h"
 
 namespace ns3 {
 
@@ -111,6 +112,11 @@ public:
   void ReadFdReady (int fd);
   void WriteFdReady (int fd);
   void ExceptionFd (int fd);
+  /**
+   * Simulator-thread handler for the batches handed over by TransportSelect.
+   * Dispatches every pending notification in arrival order.
+   */
+  void ReadyFdsPending (void);
   void CloseFd (int fd);
   void AddFd (int fd, Ptr<Socket> socket);
   void AddGenericFd (int fd,
@@ -123,6 +129,8 @@ private:
   Ptr<Node> m_node;
   int m_selectNotifyFd [2];
   TransportSelect m_transportSelect;
+  ReadyFdQueue m_readyFds;
+  ReadyFdBatch m_readyFdBatch;
   Ptr<SystemThread> m_transportSelectThread;
 
 
@@ -0,0 +1,157 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "l4-shard-helper.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+
+#include <unistd.h>
+#include <sys/wait.h>
+#ifndef DARWIN
+#include <sched.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE ("L4ShardHelper");
+
+namespace ns3 {
+
+L4ShardHelper::L4ShardHelper ()
+  : m_numShards (1),
+    m_shard (0),
+    m_pin (false)
+{
+}
+
+L4ShardHelper::~L4ShardHelper ()
+{
+}
+
+void
+L4ShardHelper::SetNumShards (uint32_t numShards)
+{
+  NS_ASSERT_MSG (numShards > 0, "L4ShardHelper: need at least one shard");
+  NS_ASSERT_MSG (m_children.empty (), "L4ShardHelper: already forked");
+  m_numShards = numShards;
+}
+
+uint32_t
+L4ShardHelper::GetNumShards (void) const
+{
+  return m_numShards;
+}
+
+void
+L4ShardHelper::SetCpuAffinity (bool pin)
+{
+  m_pin = pin;
+}
+
+uint32_t
+L4ShardHelper::Fork (void)
+{
+  NS_LOG_FUNCTION (m_numShards);
+  NS_ASSERT_MSG (m_children.empty () && m_shard == 0,
+                 "L4ShardHelper::Fork (): called more than once");
+  for (uint32_t shard = 1; shard < m_numShards; shard++)
+    {
+      pid_t pid = fork ();
+      if (pid == -1)
+        {
+          NS_FATAL_ERROR ("L4ShardHelper::Fork (): fork failed for shard " << shard);
+        }
+      if (pid == 0)
+        {
+          m_shard = shard;
+          m_children.clear ();
+          Pin ();
+          NS_LOG_INFO ("Shard " << m_shard << " running as pid " << getpid ());
+          return m_shard;
+        }
+      m_children.push_back (pid);
+    }
+  Pin ();
+  NS_LOG_INFO ("Shard 0 running as pid " << getpid ());
+  return m_shard;
+}
+
+uint32_t
+L4ShardHelper::GetShard (void) const
+{
+  return m_shard;
+}
+
+bool
+L4ShardHelper::IsLocal (uint32_t instance) const
+{
+  return instance % m_numShards == m_shard;
+}
+
+std::vector<uint32_t>
+L4ShardHelper::GetLocalInstances (uint32_t numInstances) const
+{
+  std::vector<uint32_t> instances;
+  for (uint32_t i = m_shard; i < numInstances; i += m_numShards)
+    {
+      instances.push_back (i);
+    }
+  return instances;
+}
+
+int
+L4ShardHelper::Wait (void)
+{
+  int failed = 0;
+  for (std::vector<pid_t>::iterator i = m_children.begin (); i != m_children.end (); i++)
+    {
+      int status = 0;
+      if (waitpid (*i, &status, 0) == -1 ||
+          !WIFEXITED (status) || WEXITSTATUS (status) != 0)
+        {
+          NS_LOG_WARN ("Shard worker " << *i << " did not exit cleanly");
+          failed++;
+        }
+    }
+  m_children.clear ();
+  return failed;
+}
+
+void
+L4ShardHelper::Pin (void) const
+{
+#ifndef DARWIN
+  if (!m_pin)
+    {
+      return;
+    }
+  long cpus = sysconf (_SC_NPROCESSORS_ONLN);
+  if (cpus <= 0)
+    {
+      return;
+    }
+  cpu_set_t set;
+  CPU_ZERO (&set);
+  CPU_SET (m_shard % cpus, &set);
+  if (sched_setaffinity (0, sizeof (set), &set) == -1)
+    {
+      NS_LOG_WARN ("Could not pin shard " << m_shard << " to cpu " << m_shard % cpus);
+    }
+#endif
+}
+
+} // namespace ns3
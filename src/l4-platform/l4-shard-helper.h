@@ -0,0 +1,106 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef L4_SHARD_HELPER_H
+#define L4_SHARD_HELPER_H
+
+#include <stdint.h>
+#include <vector>
+#include <sys/types.h>
+
+namespace ns3 {
+
+/**
+ * \brief Spreads the RapidNet instances of one L4 deployment over several
+ * worker processes, each with its own event loop.
+ *
+ * The simulator, node list and reference counts are process-global and
+ * not thread-safe, so the shards are forked processes rather than threads.
+ * Each shard runs its own RealtimeSimulatorImpl and TransportSelect thread
+ * and hosts the instances whose index hashes to it; instances talk to each
+ * other over their sockets exactly as they do across hosts.
+ *
+ * Fork must be called before the simulator or any L4Device is created:
+ *
+ * \code
+ *   L4ShardHelper shards;
+ *   shards.SetNumShards (4);
+ *   shards.Fork ();
+ *   for (uint32_t i = 0; i < numInstances; i++)
+ *     if (shards.IsLocal (i))
+ *       ... create node, L4PlatformHelper::Install, install app on port(i)
+ *   Simulator::Run ();
+ *   Simulator::Destroy ();
+ *   return shards.Wait ();
+ * \endcode
+ */
+class L4ShardHelper
+{
+public:
+  L4ShardHelper ();
+  ~L4ShardHelper ();
+
+  void SetNumShards (uint32_t numShards);
+  uint32_t GetNumShards (void) const;
+
+  /**
+   * \brief Pin each shard to one CPU (shard index modulo online CPUs).
+   * Only has an effect on Linux.
+   */
+  void SetCpuAffinity (bool pin);
+
+  /**
+   * \brief Fork NumShards - 1 worker processes.
+   * \returns the shard index of the calling process, 0 in the parent.
+   */
+  uint32_t Fork (void);
+
+  /**
+   * \returns the shard index of this process.
+   */
+  uint32_t GetShard (void) const;
+
+  /**
+   * \returns true if instance is hosted by this shard.
+   */
+  bool IsLocal (uint32_t instance) const;
+
+  /**
+   * \returns the indices in [0, numInstances) hosted by this shard.
+   */
+  std::vector<uint32_t> GetLocalInstances (uint32_t numInstances) const;
+
+  /**
+   * \brief In the parent, wait for every worker to exit. Workers return
+   * immediately.
+   * \returns the number of workers that did not exit cleanly.
+   */
+  int Wait (void);
+
+private:
+  void Pin (void) const;
+
+  uint32_t m_numShards;
+  uint32_t m_shard;
+  bool m_pin;
+  std::vector<pid_t> m_children;
+};
+
+} // namespace ns3
+
+#endif /* L4_SHARD_HELPER_H */
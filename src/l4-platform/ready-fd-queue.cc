@@ -0,0 +1,122 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ready-fd-queue.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("ReadyFdQueue");
+
+namespace ns3 {
+
+ReadyFdQueue::ReadyFdQueue ()
+  : m_head (&m_stub),
+    m_tail (&m_stub),
+    m_drainPending (0)
+{
+  m_stub.m_next = 0;
+}
+
+ReadyFdQueue::~ReadyFdQueue ()
+{
+  Node *node;
+  while ((node = PopNode ()) != 0)
+    {
+      delete node;
+    }
+}
+
+//
+// Wait-free for producers: one atomic exchange publishes the node, the
+// store to prev->m_next links it for the consumer.
+//
+void
+ReadyFdQueue::PushNode (Node *node)
+{
+  node->m_next = 0;
+  __sync_synchronize ();
+  Node *prev = __sync_lock_test_and_set (&m_head, node);
+  prev->m_next = node;
+}
+
+//
+// Consumer only.  Returns 0 when the queue is empty or when a producer is
+// between its exchange and its link; in the latter case that producer has
+// not yet tested m_drainPending and will schedule another drain.
+//
+ReadyFdQueue::Node *
+ReadyFdQueue::PopNode (void)
+{
+  Node *tail = m_tail;
+  Node *next = tail->m_next;
+  if (tail == &m_stub)
+    {
+      if (next == 0)
+        {
+          return 0;
+        }
+      m_tail = next;
+      tail = next;
+      next = next->m_next;
+    }
+  if (next != 0)
+    {
+      m_tail = next;
+      return tail;
+    }
+  if (tail != m_head)
+    {
+      return 0;
+    }
+  PushNode (&m_stub);
+  next = tail->m_next;
+  if (next != 0)
+    {
+      m_tail = next;
+      return tail;
+    }
+  return 0;
+}
+
+bool
+ReadyFdQueue::Push (const ReadyFdBatch &batch)
+{
+  Node *node = new Node;
+  node->m_batch = batch;
+  PushNode (node);
+  return __sync_bool_compare_and_swap (&m_drainPending, 0, 1);
+}
+
+uint32_t
+ReadyFdQueue::Drain (ReadyFdBatch &out)
+{
+  __sync_lock_release (&m_drainPending);
+  __sync_synchronize ();
+
+  uint32_t count = 0;
+  Node *node;
+  while ((node = PopNode ()) != 0)
+    {
+      out.insert (out.end (), node->m_batch.begin (), node->m_batch.end ());
+      count += node->m_batch.size ();
+      delete node;
+    }
+  NS_LOG_LOGIC ("Drained " << count << " ready fds");
+  return count;
+}
+
+} // namespace ns3
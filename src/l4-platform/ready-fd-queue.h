@@ -0,0 +1,103 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef READY_FD_QUEUE_H
+#define READY_FD_QUEUE_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief A readiness notification for one file descriptor, as observed
+ * by the TransportSelect thread.
+ */
+struct ReadyFd
+{
+  enum Kind
+  {
+    READ = 1,
+    WRITE = 2,
+    EXCEPTION = 3,
+  };
+
+  ReadyFd (Kind kind, int fd)
+    : m_kind (kind), m_fd (fd)
+  {}
+
+  Kind m_kind;
+  int m_fd;
+};
+
+typedef std::vector<ReadyFd> ReadyFdBatch;
+
+/**
+ * \brief Lock-free multi-producer/single-consumer queue of ReadyFd batches
+ * handed from the TransportSelect thread to the simulator thread.
+ *
+ * Producers append a whole batch (all fds found ready by one select ()
+ * pass) with a single atomic exchange.  The simulator thread drains every
+ * pending batch in one event, so the RealtimeSimulatorImpl mutex is taken
+ * once per wake-up instead of once per ready fd.
+ *
+ * Push returns true when the caller must schedule a drain event; the
+ * consumer re-arms this by calling Drain, which resets the flag before it
+ * starts popping so that no batch can be left behind without an event.
+ */
+class ReadyFdQueue
+{
+public:
+  ReadyFdQueue ();
+  ~ReadyFdQueue ();
+
+  /**
+   * Producer side. Takes a copy of batch.
+   * \returns true if no drain is pending and the caller must schedule one.
+   */
+  bool Push (const ReadyFdBatch &batch);
+
+  /**
+   * Consumer side. Appends every pending notification to out, in the order
+   * the batches were pushed.
+   * \returns the number of notifications appended.
+   */
+  uint32_t Drain (ReadyFdBatch &out);
+
+private:
+  struct Node
+  {
+    Node *volatile m_next;
+    ReadyFdBatch m_batch;
+  };
+
+  ReadyFdQueue (const ReadyFdQueue &o);
+  ReadyFdQueue &operator = (const ReadyFdQueue &o);
+
+  void PushNode (Node *node);
+  Node *PopNode (void);
+
+  Node *volatile m_head;
+  Node *m_tail;
+  Node m_stub;
+  volatile int m_drainPending;
+};
+
+} // namespace ns3
+
+#endif /* READY_FD_QUEUE_H */
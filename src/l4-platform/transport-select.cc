@@ -29,13 +29,15 @@ NS_LOG_COMPONENT_DEFINE ("TransportSelect");
 
 namespace ns3 {
 
-TransportSelect::TransportSelect (int controlFd, Ptr<NetDevice> netDevice)
+TransportSelect::TransportSelect (int controlFd, Ptr<NetDevice> netDevice, ReadyFdQueue *readyFds)
 {
   m_controlFd = controlFd;
   m_l4Device = netDevice;
+  m_readyFds = readyFds;
 }
 
 TransportSelect::TransportSelect ()
+  : m_readyFds (0)
 {
 }
 
@@ -63,6 +65,7 @@ TransportSelect::Run (void)
   FD_SET (m_controlFd, &m_masterReadFds);
   m_fdMax = m_controlFd;
   NS_LOG_INFO ("Transport Select Control Fd: " << m_controlFd);
+  ReadyFdBatch batch;
   for (;;)
   {
     m_readFds = m_masterReadFds;
@@ -75,6 +78,7 @@ TransportSelect::Run (void)
       continue;
     }
     NS_LOG_INFO ("Select ready...");
+    batch.clear ();
 
     for (int fd=0; fd<=m_fdMax; fd++)
     {
@@ -140,6 +144,7 @@ TransportSelect::Run (void)
               close (fdRx);
               break;
             case SHUTDOWN:
+              Notify (batch);
               ShutDown ();
               return;
             default:
@@ -148,20 +153,18 @@ TransportSelect::Run (void)
         }
         else
         {
-          //Interrupt simulator
-          NS_LOG_INFO("TransportSelect::Run : Calling  impl->ScheduleRealtimeNow");
+          NS_LOG_INFO("TransportSelect::Run : ReadFd is set: " << fd);
           //Remove Fd for now
           FD_CLR (fd, &m_masterReadFds);
-          impl->ScheduleRealtimeNow (MakeEvent (&L4Device::ReadFdReady, DynamicCast<L4Device> (m_l4Device), fd));
+          batch.push_back (ReadyFd (ReadyFd::READ, fd));
         }
       }
       if (FD_ISSET (fd, &m_writeFds))
       {
-        //Interrupt simulator
-        NS_LOG_INFO("WriteFd is set, TransportSelect::Run : Calling  impl->ScheduleRealtimeNow");
+        NS_LOG_INFO("TransportSelect::Run : WriteFd is set: " << fd);
         //Remove Fd for now
         FD_CLR (fd, &m_masterWriteFds);
-        impl->ScheduleRealtimeNow (MakeEvent (&L4Device::WriteFdReady, DynamicCast<L4Device> (m_l4Device), fd));
+        batch.push_back (ReadyFd (ReadyFd::WRITE, fd));
       }
       if (FD_ISSET (fd, &m_exceptionFds))
       {
@@ -181,13 +184,34 @@ TransportSelect::Run (void)
           FD_CLR (fd, &m_masterWriteFds);
           FD_CLR (fd, &m_masterExceptionFds);
           close (fd);
-          impl->ScheduleRealtimeNow (MakeEvent (&L4Device::ExceptionFd, DynamicCast<L4Device> (m_l4Device), fd));
+          batch.push_back (ReadyFd (ReadyFd::EXCEPTION, fd));
         }
       }
     }
+    Notify (batch);
   }
 }
 
+//
+// Hand everything found ready in one select () pass to the simulator thread
+// as a single batch.  The simulator is only interrupted if it does not
+// already have a drain event pending.
+//
+  void
+TransportSelect::Notify (ReadyFdBatch &batch)
+{
+  if (batch.empty ())
+  {
+    return;
+  }
+  NS_LOG_INFO ("TransportSelect::Notify : handing over " << batch.size () << " ready fds");
+  if (m_readyFds->Push (batch))
+  {
+    m_rtImpl->ScheduleRealtimeNow (MakeEvent (&L4Device::ReadyFdsPending, DynamicCast<L4Device> (m_l4Device)));
+  }
+  batch.clear ();
+}
+
   void 
 TransportSelect::ShutDown ()
 {
@@ -24,6 +24,7 @@
 #include "ns3/simulator.h"
 #include "ns3/net-device.h"
 #include "ns3/realtime-simulator-impl.h"
+#include "ready-fd-queue.h"
 namespace ns3 {
 
 #define TS_CONTROL_MSG_SZ (1 + sizeof(int))
@@ -39,7 +40,7 @@ class TransportSelect
       SHUTDOWN = 9,
     };
 
-    TransportSelect (int controlFd, Ptr<NetDevice> netDevice);
+    TransportSelect (int controlFd, Ptr<NetDevice> netDevice, ReadyFdQueue *readyFds);
     TransportSelect ();
     ~TransportSelect ();
     
@@ -53,7 +54,9 @@ class TransportSelect
     int m_controlFd;
     RealtimeSimulatorImpl *m_rtImpl;
     void ReadInt (unsigned char* buf, int& num);
+    void Notify (ReadyFdBatch &batch);
     Ptr<NetDevice> m_l4Device;
+    ReadyFdQueue *m_readyFds;
 
 
 };
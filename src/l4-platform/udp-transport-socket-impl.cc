@@ -22,6 +22,8 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/udp-socket-factory.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/uinteger.h"
+#include "ns3/simulator.h"
 #include "udp-transport-socket-impl.h"
 #include "sys/types.h"
 #include <sys/socket.h>
@@ -30,6 +32,8 @@
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <limits>
+#include <errno.h>
+#include <string.h>
 #include "l4-device.h"
 #include "ns3/ipv4.h"
 
@@ -38,6 +42,20 @@ NS_LOG_COMPONENT_DEFINE ("UdpTransportSocketImpl");
 namespace ns3 {
 
 static const uint32_t MAX_IPV4_UDP_DATAGRAM_SIZE = 65507;
+static const uint32_t RX_BUFFER_SIZE = 65536;
+// milliseconds to wait before retrying a send which failed for lack
+// of kernel buffers
+static const uint32_t TX_RETRY_DELAY = 1;
+
+//
+// Whether a failed send may succeed later: the non-blocking socket
+// buffer is full, or the kernel is out of buffers.
+//
+static bool
+IsTransientSendError (int error)
+{
+  return error == EAGAIN || error == EWOULDBLOCK || error == ENOBUFS;
+}
 
 TypeId
 UdpTransportSocketImpl::GetTypeId (void)
@@ -45,6 +63,13 @@ UdpTransportSocketImpl::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::UdpTransportSocketImpl")
     .SetParent<Socket> ()
     .AddConstructor<UdpTransportSocketImpl> ()
+    .AddAttribute ("BatchSize",
+                   "Maximum number of datagrams moved per recvmmsg/sendmmsg call. "
+                   "Outgoing datagrams are held until BatchSize are queued or the "
+                   "current event completes; 1 sends every datagram immediately.",
+                   UintegerValue (16),
+                   MakeUintegerAccessor (&UdpTransportSocketImpl::m_batchSize),
+                   MakeUintegerChecker<uint32_t> (1, 1024))
     ;
   return tid;
 }
@@ -59,7 +84,11 @@ UdpTransportSocketImpl::UdpTransportSocketImpl ()
   }
   fcntl (m_socket, F_SETFL, O_NONBLOCK);
   NS_LOG_INFO("UdpTransportSocketImpl::UdpTransportSocketImpl : Creating Socket : " << m_socket);
-  m_packetBuffer = new uint8_t[65536];
+  // Sized from BatchSize on first receive, once attributes are set
+  m_packetBuffer = 0;
+  m_rxSlots = 0;
+  m_batchSize = 1;
+  m_txBlocked = false;
 }
 
 UdpTransportSocketImpl::~UdpTransportSocketImpl ()
@@ -69,6 +98,21 @@ UdpTransportSocketImpl::~UdpTransportSocketImpl ()
   m_packetBuffer = 0; 
 }
 
+void
+UdpTransportSocketImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Simulator::Cancel (m_txFlushEvent);
+  m_txQueue.clear ();
+  while (!m_rxQueue.empty ())
+    {
+      m_rxQueue.pop ();
+    }
+  m_l4Device = 0;
+  m_node = 0;
+  TransportSocket::DoDispose ();
+}
+
 enum Socket::SocketErrno
 UdpTransportSocketImpl::GetErrno (void) const
 {
@@ -150,6 +194,14 @@ int
 UdpTransportSocketImpl::Close (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  FlushTx ();
+  if (m_txBlocked)
+    {
+      NS_LOG_WARN ("Dropped " << m_txQueue.size () << " datagrams on close");
+      Simulator::Cancel (m_txFlushEvent);
+      m_txQueue.clear ();
+      m_txBlocked = false;
+    }
   m_l4Device -> CloseFd (m_socket);
   return 0;
 }
@@ -197,15 +249,137 @@ UdpTransportSocketImpl::SendTo (Ptr<Packet> p, uint32_t flags, const Address &ad
   InetSocketAddress transport = InetSocketAddress::ConvertFrom (address);
   Ipv4Address ipv4 = transport.GetIpv4 ();
   uint16_t port = transport.GetPort ();
-  struct sockaddr_in destAddr;
-  destAddr.sin_family = AF_INET;
-  destAddr.sin_addr.s_addr = htonl (ipv4.Get());
-  destAddr.sin_port = htons (port);
-  p->CopyData (m_packetBuffer, p->GetSize ());
-  sendto (m_socket, m_packetBuffer, p->GetSize(), 0, (struct sockaddr *)&destAddr, sizeof(destAddr));
+  m_txQueue.push_back (TxDatagram ());
+  TxDatagram &datagram = m_txQueue.back ();
+  bzero ((char *) &datagram.m_dest, sizeof (datagram.m_dest));
+  datagram.m_dest.sin_family = AF_INET;
+  datagram.m_dest.sin_addr.s_addr = htonl (ipv4.Get());
+  datagram.m_dest.sin_port = htons (port);
+  datagram.m_data.resize (p->GetSize ());
+  if (p->GetSize () > 0)
+    {
+      p->CopyData (&datagram.m_data[0], p->GetSize ());
+    }
+
+  if (m_txBlocked)
+    {
+      // Sent once the socket is writable again
+      return 0;
+    }
+  if (m_txQueue.size () >= m_batchSize)
+    {
+      FlushTx ();
+    }
+  else if (!m_txFlushEvent.IsRunning ())
+    {
+      // Coalesce everything sent while processing the current event
+      m_txFlushEvent = Simulator::ScheduleNow (&UdpTransportSocketImpl::FlushTx, this);
+    }
   return 0;
 }
 
+void
+UdpTransportSocketImpl::FlushTx (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Simulator::Cancel (m_txFlushEvent);
+  uint32_t count = m_txQueue.size ();
+  if (count == 0)
+    {
+      return;
+    }
+  m_txBlocked = false;
+  // Datagrams before next are sent or dropped
+  uint32_t next = 0;
+  uint32_t dropped = 0;
+  int error = 0;
+#ifndef DARWIN
+  std::vector<struct mmsghdr> msgs (count);
+  std::vector<struct iovec> iovs (count);
+  for (uint32_t i = 0; i < count; i++)
+    {
+      TxDatagram &datagram = m_txQueue[i];
+      iovs[i].iov_base = datagram.m_data.empty () ? 0 : &datagram.m_data[0];
+      iovs[i].iov_len = datagram.m_data.size ();
+      bzero ((char *) &msgs[i], sizeof (msgs[i]));
+      msgs[i].msg_hdr.msg_name = &datagram.m_dest;
+      msgs[i].msg_hdr.msg_namelen = sizeof (datagram.m_dest);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+  while (next < count)
+    {
+      int n = sendmmsg (m_socket, &msgs[next], count - next, 0);
+      if (n > 0)
+        {
+          next += n;
+          continue;
+        }
+      error = errno;
+      if (error == EINTR)
+        {
+          continue;
+        }
+      if (IsTransientSendError (error))
+        {
+          break;
+        }
+      // sendmmsg stops at the first datagram which fails: drop only
+      // that one, as a per-datagram sendto would, and go on.
+      NS_LOG_WARN ("Dropped datagram " << next << ": " << strerror (error));
+      dropped++;
+      next++;
+    }
+#else
+  while (next < count)
+    {
+      TxDatagram &datagram = m_txQueue[next];
+      if (sendto (m_socket, datagram.m_data.empty () ? 0 : &datagram.m_data[0],
+                  datagram.m_data.size (), 0, (struct sockaddr *)&datagram.m_dest,
+                  sizeof (datagram.m_dest)) != -1)
+        {
+          next++;
+          continue;
+        }
+      error = errno;
+      if (error == EINTR)
+        {
+          continue;
+        }
+      if (IsTransientSendError (error))
+        {
+          break;
+        }
+      NS_LOG_WARN ("Dropped datagram " << next << ": " << strerror (error));
+      dropped++;
+      next++;
+    }
+#endif
+  if (dropped > 0)
+    {
+      NS_LOG_WARN ("Dropped " << dropped << " of " << count << " queued datagrams");
+    }
+  NS_LOG_INFO ("Flushed " << next - dropped << " datagrams");
+  m_txQueue.erase (m_txQueue.begin (), m_txQueue.begin () + next);
+  if (m_txQueue.empty ())
+    {
+      return;
+    }
+  // Keep the unsent tail and send it once the socket buffer drains,
+  // rather than spinning on the event thread
+  NS_LOG_INFO ("Holding " << m_txQueue.size () << " datagrams: " << strerror (error));
+  m_txBlocked = true;
+  if (error != ENOBUFS && m_l4Device != 0)
+    {
+      m_l4Device->AddWriteFd (m_socket, this);
+    }
+  else
+    {
+      m_txFlushEvent = Simulator::Schedule (MilliSeconds (TX_RETRY_DELAY),
+        &UdpTransportSocketImpl::FlushTx, this);
+    }
+}
+
 uint32_t
 UdpTransportSocketImpl::GetRxAvailable (void) const
 {
@@ -227,20 +401,102 @@ UdpTransportSocketImpl::RecvFrom (uint32_t maxSize, uint32_t flags,
 {
   NS_LOG_FUNCTION (this << maxSize << flags);
   Ptr<Packet> packet;
-  int len;
-  struct sockaddr_in srcAddr;
-  socklen_t srcAddrLen = sizeof (srcAddr);
-  if ((len = recvfrom (m_socket, m_packetBuffer, 65536, 0, (struct sockaddr *)&srcAddr, &srcAddrLen)) != -1)
+  if (m_rxQueue.empty () && FillRxQueue () == 0)
   {
-      NS_LOG_INFO ("Received packet of len: " << (int) len);
-      packet = Create<Packet> ((const uint8_t *) (m_packetBuffer), len);
-      fromAddress = InetSocketAddress (inet_ntoa(srcAddr.sin_addr), ntohs (srcAddr.sin_port));  
+      //Drained, add ReadFd back
+      m_l4Device->AddReadFd (m_socket, this);
+      return packet;
   }
-  //Add ReadFd back
-  m_l4Device->AddReadFd (m_socket, this);
+  packet = m_rxQueue.front ().m_packet;
+  fromAddress = m_rxQueue.front ().m_from;
+  m_rxQueue.pop ();
   return packet;
 }
 
+uint32_t
+UdpTransportSocketImpl::RecvFromBatch (std::vector<Ptr<Packet> > &packets,
+  std::vector<Address> &fromAddresses)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_rxQueue.empty () && FillRxQueue () == 0)
+  {
+      //Drained, add ReadFd back
+      m_l4Device->AddReadFd (m_socket, this);
+      return 0;
+  }
+  uint32_t count = 0;
+  while (!m_rxQueue.empty ())
+  {
+      packets.push_back (m_rxQueue.front ().m_packet);
+      fromAddresses.push_back (m_rxQueue.front ().m_from);
+      m_rxQueue.pop ();
+      count++;
+  }
+  return count;
+}
+
+//
+// Reads up to m_batchSize datagrams with a single recvmmsg () and queues
+// them.  Returns the number queued, zero once the socket would block.
+//
+uint32_t
+UdpTransportSocketImpl::FillRxQueue (void)
+{
+  if (m_packetBuffer == 0 || m_rxSlots != m_batchSize)
+  {
+      delete [] m_packetBuffer;
+      m_packetBuffer = new uint8_t[m_batchSize * RX_BUFFER_SIZE];
+      m_rxSlots = m_batchSize;
+  }
+  std::vector<struct sockaddr_in> srcAddrs (m_batchSize);
+  std::vector<uint32_t> lens (m_batchSize);
+  uint32_t received = 0;
+#ifndef DARWIN
+  std::vector<struct mmsghdr> msgs (m_batchSize);
+  std::vector<struct iovec> iovs (m_batchSize);
+  for (uint32_t i = 0; i < m_batchSize; i++)
+  {
+      iovs[i].iov_base = m_packetBuffer + i * RX_BUFFER_SIZE;
+      iovs[i].iov_len = RX_BUFFER_SIZE;
+      bzero ((char *) &msgs[i], sizeof (msgs[i]));
+      msgs[i].msg_hdr.msg_name = &srcAddrs[i];
+      msgs[i].msg_hdr.msg_namelen = sizeof (srcAddrs[i]);
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  int n = recvmmsg (m_socket, &msgs[0], m_batchSize, MSG_DONTWAIT, 0);
+  if (n > 0)
+  {
+      received = n;
+      for (uint32_t i = 0; i < received; i++)
+      {
+          lens[i] = msgs[i].msg_len;
+      }
+  }
+#else
+  for (; received < m_batchSize; received++)
+  {
+      socklen_t srcAddrLen = sizeof (srcAddrs[received]);
+      int len = recvfrom (m_socket, m_packetBuffer + received * RX_BUFFER_SIZE,
+                          RX_BUFFER_SIZE, 0, (struct sockaddr *)&srcAddrs[received], &srcAddrLen);
+      if (len == -1)
+      {
+          break;
+      }
+      lens[received] = len;
+  }
+#endif
+  for (uint32_t i = 0; i < received; i++)
+  {
+      NS_LOG_INFO ("Received packet of len: " << lens[i]);
+      RxDatagram datagram;
+      datagram.m_packet = Create<Packet> ((const uint8_t *) (m_packetBuffer + i * RX_BUFFER_SIZE), lens[i]);
+      datagram.m_from = InetSocketAddress (inet_ntoa (srcAddrs[i].sin_addr), ntohs (srcAddrs[i].sin_port));
+      m_rxQueue.push (datagram);
+  }
+  return received;
+}
+
 int
 UdpTransportSocketImpl::GetSockName (Address &address) const
 {
@@ -290,7 +546,11 @@ UdpTransportSocketImpl::DataInd (void)
 void
 UdpTransportSocketImpl::DataWriteInd (void)
 {
-  return;
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_txBlocked)
+    {
+      FlushTx ();
+    }
 }
 
 void
@@ -20,12 +20,16 @@
 
 #include <stdint.h>
 #include <queue>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/socket.h>
 #include "ns3/callback.h"
 #include "ns3/traced-callback.h"
 #include "ns3/socket.h"
 #include "ns3/ptr.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/udp-socket.h"
+#include "ns3/event-id.h"
 #include "transport-socket.h"
 #include "l4-device.h"
 
@@ -63,6 +67,26 @@ public:
   virtual bool SetAllowBroadcast (bool allowBroadcast);
   virtual bool GetAllowBroadcast () const;
 
+  /**
+   * \brief Receive all datagrams currently available in one call.
+   *
+   * Drains the internal receive queue, refilling it with one batched
+   * syscall of up to BatchSize datagrams if it is empty.  Returns the
+   * number of packets appended; like RecvFrom, a return value of zero
+   * means the socket is drained and the read fd has been re-armed.
+   */
+  uint32_t RecvFromBatch (std::vector<Ptr<Packet> > &packets,
+    std::vector<Address> &fromAddresses);
+
+  /**
+   * \brief Push every queued outgoing datagram to the kernel.
+   *
+   * If the socket buffer is full, the unsent datagrams stay queued and
+   * are sent, along with any queued meanwhile, once the socket is
+   * writable again.
+   */
+  void FlushTx (void);
+
   void SetNode (Ptr<Node> node);
   void DataInd (void);
   void DataWriteInd (void);
@@ -70,8 +94,23 @@ public:
 
 
 
+protected:
+  virtual void DoDispose (void);
+
 private:
+  struct RxDatagram
+  {
+    Ptr<Packet> m_packet;
+    Address m_from;
+  };
+  struct TxDatagram
+  {
+    std::vector<uint8_t> m_data;
+    struct sockaddr_in m_dest;
+  };
+
   void ForwardUp (Ptr<Packet> p, Ipv4Address ipv4, uint16_t port);
+  uint32_t FillRxQueue (void);
   Ipv4Address m_defaultAddress;
   uint16_t m_defaultPort;
   enum SocketErrno m_errno;
@@ -80,6 +119,13 @@ private:
   uint16_t m_port;
   Ptr<L4Device> m_l4Device;
   uint8_t *m_packetBuffer;
+  uint32_t m_rxSlots;
+  uint32_t m_batchSize;
+  std::queue<RxDatagram> m_rxQueue;
+  std::vector<TxDatagram> m_txQueue;
+  EventId m_txFlushEvent;
+  // waiting for the socket to drain before sending m_txQueue
+  bool m_txBlocked;
 };
 
 }//namespace ns3
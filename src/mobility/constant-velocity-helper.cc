@@ -57,15 +57,25 @@ ConstantVelocityHelper::GetVelocity (void) const
 }
 void 
 ConstantVelocityHelper::SetVelocity (const Vector &vel)
+{
+  SetVelocity (vel, Simulator::Now ());
+}
+void 
+ConstantVelocityHelper::SetVelocity (const Vector &vel, Time now)
 {
   m_velocity = vel;
-  m_lastUpdate = Simulator::Now ();
+  m_lastUpdate = now;
 }
 
 void
 ConstantVelocityHelper::Update (void) const
 {
-  Time now = Simulator::Now ();
+  Update (Simulator::Now ());
+}
+
+void
+ConstantVelocityHelper::Update (Time now) const
+{
   NS_ASSERT (m_lastUpdate <= now);
   Time deltaTime = now - m_lastUpdate;
   m_lastUpdate = now;
@@ -82,7 +92,13 @@ ConstantVelocityHelper::Update (void) const
 void
 ConstantVelocityHelper::UpdateWithBounds (const Rectangle &bounds) const
 {
-  Update ();
+  UpdateWithBounds (bounds, Simulator::Now ());
+}
+
+void
+ConstantVelocityHelper::UpdateWithBounds (const Rectangle &bounds, Time now) const
+{
+  Update (now);
   m_position.x = std::min (bounds.xMax, m_position.x);
   m_position.x = std::max (bounds.xMin, m_position.x);
   m_position.y = std::min (bounds.yMax, m_position.y);
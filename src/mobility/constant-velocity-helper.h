@@ -39,11 +39,18 @@ class ConstantVelocityHelper
   Vector GetCurrentPosition (void) const;
   Vector GetVelocity (void) const;
   void SetVelocity (const Vector &vel);
+  void SetVelocity (const Vector &vel, Time now);
   void Pause (void);
   void Unpause (void);
 
   void UpdateWithBounds (const Rectangle &rectangle) const;
   void Update (void) const;
+  /**
+   * The versions with a time are used by the models which compute
+   * their course lazily, at a time earlier than now.
+   */
+  void UpdateWithBounds (const Rectangle &rectangle, Time now) const;
+  void Update (Time now) const;
  private:
   mutable Time m_lastUpdate;
   mutable Vector m_position;
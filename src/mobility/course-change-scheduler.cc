@@ -0,0 +1,151 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "course-change-scheduler.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable.h"
+#include "ns3/object-factory.h"
+#include <vector>
+
+namespace ns3 {
+
+CourseChangeScheduler::CourseChangeScheduler ()
+  : m_lazy (false),
+    m_pending (false),
+    m_updating (false)
+{}
+
+void
+CourseChangeScheduler::SetLazy (bool lazy)
+{
+  m_lazy = lazy;
+}
+
+bool
+CourseChangeScheduler::IsLazy (void) const
+{
+  return m_lazy;
+}
+
+Time
+CourseChangeScheduler::GetNow (void) const
+{
+  return m_updating ? m_now : Simulator::Now ();
+}
+
+void
+CourseChangeScheduler::Schedule (Time delay, const Callback<void> &handler, bool traced)
+{
+  m_handler = handler;
+  m_next = GetNow () + delay;
+  m_pending = false;
+  // while catching up, a course change still in the past is run by
+  // the Update loop.
+  if ((!m_lazy || traced) && m_next >= Simulator::Now ())
+    {
+      m_event = Simulator::Schedule (m_next - Simulator::Now (),
+                                     &CourseChangeScheduler::Run, this);
+    }
+  else
+    {
+      m_pending = true;
+    }
+}
+
+void
+CourseChangeScheduler::Cancel (void)
+{
+  Simulator::Remove (m_event);
+  m_pending = false;
+}
+
+void
+CourseChangeScheduler::Run (void)
+{
+  // the handler schedules the next course change.
+  Callback<void> handler = m_handler;
+  handler ();
+}
+
+void
+CourseChangeScheduler::Update (bool traced)
+{
+  // the listeners notified by a course change query the model again.
+  if (m_updating)
+    {
+      return;
+    }
+  m_updating = true;
+  while (m_pending && m_next <= Simulator::Now ())
+    {
+      m_pending = false;
+      m_now = m_next;
+      Callback<void> handler = m_handler;
+      handler ();
+    }
+  m_updating = false;
+  if (m_pending && traced)
+    {
+      m_pending = false;
+      m_event = Simulator::Schedule (m_next - Simulator::Now (),
+                                     &CourseChangeScheduler::Run, this);
+    }
+}
+
+Ptr<Object>
+CourseChangeScheduler::NewStreams (Ptr<Object> object)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (object->GetInstanceTypeId ());
+  std::vector<std::string> variables;
+  for (TypeId tid = object->GetInstanceTypeId (); tid.HasParent (); tid = tid.GetParent ())
+    {
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          uint32_t flags = TypeId::ATTR_GET | TypeId::ATTR_SET | TypeId::ATTR_CONSTRUCT;
+          if ((tid.GetAttributeFlags (i) & flags) != flags)
+            {
+              continue;
+            }
+          std::string name = tid.GetAttributeName (i);
+          Ptr<const AttributeChecker> checker = tid.GetAttributeChecker (i);
+          Ptr<AttributeValue> value = checker->Create ();
+          object->GetAttribute (name, *value);
+          factory.Set (name, *value);
+          if (dynamic_cast<RandomVariableValue *> (PeekPointer (value)) != 0)
+            {
+              variables.push_back (name);
+            }
+        }
+    }
+  if (variables.empty ())
+    {
+      return object;
+    }
+  Ptr<Object> copy = factory.Create ();
+  for (std::vector<std::string>::iterator i = variables.begin (); i != variables.end (); ++i)
+    {
+      RandomVariableValue value;
+      copy->GetAttribute (*i, value);
+      RandomVariable variable = value.Get ();
+      variable.NewStream ();
+      copy->SetAttribute (*i, RandomVariableValue (variable));
+    }
+  return copy;
+}
+
+} // namespace ns3
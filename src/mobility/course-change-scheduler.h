@@ -0,0 +1,102 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef COURSE_CHANGE_SCHEDULER_H
+#define COURSE_CHANGE_SCHEDULER_H
+
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/callback.h"
+#include "ns3/object.h"
+
+namespace ns3 {
+
+/**
+ * \brief runs the next course change of a random mobility model
+ *
+ * By default, the course change is a simulator event. A lazy scheduler
+ * only keeps the time and the handler of the next course change: the
+ * course changes which are due are run by Update, which the model calls
+ * each time its position or velocity is queried, with GetNow as the
+ * time of the course change. A lazy model which is never queried
+ * schedules no event. When a listener is connected to the CourseChange
+ * trace source of the model, the model calls Update at once, and the
+ * next course change is scheduled as an event again, so that the
+ * listener is notified on time.
+ *
+ * A lazy model draws its random values when it is queried. So that its
+ * course does not depend on the order in which the models are queried,
+ * it takes the streams of its random variables when it is created, with
+ * RandomVariable::NewStream, and draws its positions from a copy of its
+ * position allocator made by NewStreams.
+ */
+class CourseChangeScheduler
+{
+public:
+  CourseChangeScheduler ();
+
+  void SetLazy (bool lazy);
+  bool IsLazy (void) const;
+
+  /**
+   * \returns the time of the course change being run by Update, or now.
+   */
+  Time GetNow (void) const;
+  /**
+   * \param delay the delay from GetNow to the next course change
+   * \param handler the handler of the next course change
+   * \param traced whether listeners are connected to the model
+   */
+  void Schedule (Time delay, const Callback<void> &handler, bool traced);
+  /**
+   * Cancels the next course change.
+   */
+  void Cancel (void);
+  /**
+   * Runs the course changes which are due.
+   *
+   * \param traced whether listeners are connected to the model
+   */
+  void Update (bool traced);
+
+  /**
+   * \param object the object to copy
+   * \returns a copy of the object, with the same attributes, whose
+   *          random variables draw from new streams of the package, or
+   *          the object itself if it has no RandomVariable attribute.
+   *
+   * A position allocator without random variables, such as a list or a
+   * grid, is not copied: models which share it get its positions in
+   * the order in which they ask for them.
+   */
+  static Ptr<Object> NewStreams (Ptr<Object> object);
+
+private:
+  void Run (void);
+
+  Callback<void> m_handler;
+  EventId m_event;
+  Time m_next;
+  Time m_now;
+  bool m_lazy;
+  bool m_pending;
+  bool m_updating;
+};
+
+} // namespace ns3
+
+#endif /* COURSE_CHANGE_SCHEDULER_H */
@@ -25,6 +25,36 @@
 
 namespace ns3 {
 
+/**
+ * Connects listeners to the CourseChange trace source and then tells
+ * the model that it is traced.
+ */
+class MobilityModel::CourseChangeAccessor : public TraceSourceAccessor
+{
+public:
+  CourseChangeAccessor ()
+    : m_accessor (MakeTraceSourceAccessor (&MobilityModel::m_courseChangeTrace))
+  {}
+  virtual bool ConnectWithoutContext (ObjectBase *obj, const CallbackBase &cb) const {
+    return m_accessor->ConnectWithoutContext (obj, cb) && Notify (obj);
+  }
+  virtual bool Connect (ObjectBase *obj, std::string context, const CallbackBase &cb) const {
+    return m_accessor->Connect (obj, context, cb) && Notify (obj);
+  }
+  virtual bool DisconnectWithoutContext (ObjectBase *obj, const CallbackBase &cb) const {
+    return m_accessor->DisconnectWithoutContext (obj, cb);
+  }
+  virtual bool Disconnect (ObjectBase *obj, std::string context, const CallbackBase &cb) const {
+    return m_accessor->Disconnect (obj, context, cb);
+  }
+private:
+  static bool Notify (ObjectBase *obj) {
+    dynamic_cast<MobilityModel *> (obj)->NotifyCourseChangeConnected ();
+    return true;
+  }
+  Ptr<const TraceSourceAccessor> m_accessor;
+};
+
 TypeId 
 MobilityModel::GetTypeId (void)
 {
@@ -43,7 +73,7 @@ MobilityModel::GetTypeId (void)
                    MakeVectorChecker ())
     .AddTraceSource ("CourseChange", 
                      "The value of the position and/or velocity vector changed",
-                     MakeTraceSourceAccessor (&MobilityModel::m_courseChangeTrace))
+                     Create<CourseChangeAccessor> ())
     ;
   return tid;
 }
@@ -85,4 +115,14 @@ MobilityModel::NotifyCourseChange (void) const
   m_courseChangeTrace(this);
 }
 
+bool
+MobilityModel::IsCourseChangeTraced (void) const
+{
+  return !m_courseChangeTrace.IsEmpty ();
+}
+
+void
+MobilityModel::NotifyCourseChangeConnected (void)
+{}
+
 } // namespace ns3
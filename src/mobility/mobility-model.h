@@ -64,7 +64,20 @@ protected:
    * position changes to notify course change listeners.
    */
   void NotifyCourseChange (void) const;
+  /**
+   * \returns true if a listener is connected to the CourseChange
+   *          trace source.
+   */
+  bool IsCourseChangeTraced (void) const;
 private:
+  class CourseChangeAccessor;
+  /**
+   * Invoked when a listener is connected to the CourseChange trace
+   * source, after the connection. Subclasses which only compute their
+   * course when queried override this to schedule their next course
+   * change, so that the listener is notified on time.
+   */
+  virtual void NotifyCourseChangeConnected (void);
   /**
    * \returns the current position.
    *
@@ -22,6 +22,7 @@
 #include <cmath>
 #include "random-direction-2d-mobility-model.h"
 #include "ns3/log.h"
+#include "ns3/boolean.h"
 
 NS_LOG_COMPONENT_DEFINE ("RandomDirection2dMobilityModel");
 
@@ -51,14 +52,33 @@ RandomDirection2dMobilityModel::GetTypeId (void)
                    RandomVariableValue (ConstantVariable (2.0)),
                    MakeRandomVariableAccessor (&RandomDirection2dMobilityModel::m_pause),
                    MakeRandomVariableChecker ())
+    .AddAttribute ("Lazy",
+                   "Compute the course only when the position is queried.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RandomDirection2dMobilityModel::m_lazy),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
 
 
 RandomDirection2dMobilityModel::RandomDirection2dMobilityModel ()
+  : m_lazy (false)
+{}
+void
+RandomDirection2dMobilityModel::NotifyConstructionCompleted (void)
 {
-  m_event = Simulator::ScheduleNow (&RandomDirection2dMobilityModel::Start, this);
+  MobilityModel::NotifyConstructionCompleted ();
+  m_course.SetLazy (m_lazy);
+  if (m_lazy)
+    {
+      // the streams do not depend on the order of the queries
+      m_speed.NewStream ();
+      m_pause.NewStream ();
+      m_direction.NewStream ();
+    }
+  m_course.Schedule (Seconds (0.0), MakeCallback (&RandomDirection2dMobilityModel::Start, this),
+                     IsCourseChangeTraced ());
 }
 void 
 RandomDirection2dMobilityModel::DoDispose (void)
@@ -76,10 +96,11 @@ RandomDirection2dMobilityModel::Start (void)
 void
 RandomDirection2dMobilityModel::BeginPause (void)
 {
-  m_helper.Update ();
+  m_helper.Update (m_course.GetNow ());
   m_helper.Pause ();
   Time pause = Seconds (m_pause.GetValue ());
-  m_event = Simulator::Schedule (pause, &RandomDirection2dMobilityModel::ResetDirectionAndSpeed, this);
+  m_course.Schedule (pause, MakeCallback (&RandomDirection2dMobilityModel::ResetDirectionAndSpeed, this),
+                     IsCourseChangeTraced ());
   NotifyCourseChange ();
 }
 
@@ -87,18 +108,18 @@ void
 RandomDirection2dMobilityModel::SetDirectionAndSpeed (double direction)
 {
   NS_LOG_FUNCTION_NOARGS ();
-  m_helper.UpdateWithBounds (m_bounds);
+  m_helper.UpdateWithBounds (m_bounds, m_course.GetNow ());
   Vector position = m_helper.GetCurrentPosition ();
   double speed = m_speed.GetValue ();
   const Vector vector (std::cos (direction) * speed,
                        std::sin (direction) * speed,
                        0.0);
-  m_helper.SetVelocity (vector);
+  m_helper.SetVelocity (vector, m_course.GetNow ());
   m_helper.Unpause ();
   Vector next = m_bounds.CalculateIntersection (position, vector);
   Time delay = Seconds (CalculateDistance (position, next) / speed);
-  m_event = Simulator::Schedule (delay,
-				 &RandomDirection2dMobilityModel::BeginPause, this);
+  m_course.Schedule (delay, MakeCallback (&RandomDirection2dMobilityModel::BeginPause, this),
+                     IsCourseChangeTraced ());
   NotifyCourseChange ();
 }
 void
@@ -106,7 +127,7 @@ RandomDirection2dMobilityModel::ResetDirectionAndSpeed (void)
 {
   double direction = m_direction.GetValue (0, PI);
   
-  m_helper.UpdateWithBounds (m_bounds);
+  m_helper.UpdateWithBounds (m_bounds, m_course.GetNow ());
   Vector position = m_helper.GetCurrentPosition ();
   switch (m_bounds.GetClosestSide (position))
     {
@@ -125,22 +146,36 @@ RandomDirection2dMobilityModel::ResetDirectionAndSpeed (void)
     }
   SetDirectionAndSpeed (direction);
 }
+void
+RandomDirection2dMobilityModel::Update (void) const
+{
+  m_course.Update (IsCourseChangeTraced ());
+  m_helper.UpdateWithBounds (m_bounds, m_course.GetNow ());
+}
+
+void
+RandomDirection2dMobilityModel::NotifyCourseChangeConnected (void)
+{
+  Update ();
+}
 Vector
 RandomDirection2dMobilityModel::DoGetPosition (void) const
 {
-  m_helper.UpdateWithBounds (m_bounds);
+  Update ();
   return m_helper.GetCurrentPosition ();
 }
 void
 RandomDirection2dMobilityModel::DoSetPosition (const Vector &position)
 {
   m_helper.SetPosition (position);
-  Simulator::Remove (m_event);
-  m_event = Simulator::ScheduleNow (&RandomDirection2dMobilityModel::Start, this);
+  m_course.Cancel ();
+  m_course.Schedule (Seconds (0.0), MakeCallback (&RandomDirection2dMobilityModel::Start, this),
+                     IsCourseChangeTraced ());
 }
 Vector
 RandomDirection2dMobilityModel::DoGetVelocity (void) const
 {
+  Update ();
   return m_helper.GetVelocity ();
 }
 
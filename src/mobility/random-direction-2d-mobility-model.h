@@ -28,6 +28,7 @@
 #include "ns3/random-variable.h"
 #include "mobility-model.h"
 #include "constant-velocity-helper.h"
+#include "course-change-scheduler.h"
 
 namespace ns3 {
 
@@ -39,6 +40,9 @@ namespace ns3 {
  * then travels in the specific direction until it reaches one of
  * the boundaries of the model. When it reaches the boundary, it pauses,
  * selects a new direction and speed, aso.
+ *
+ * With the Lazy attribute, the course is only computed when the
+ * position or velocity is queried: see ns3::RandomWaypointMobilityModel.
  */
 class RandomDirection2dMobilityModel : public MobilityModel
 {
@@ -52,6 +56,9 @@ class RandomDirection2dMobilityModel : public MobilityModel
   void BeginPause (void);
   void SetDirectionAndSpeed (double direction);
   void InitializeDirectionAndSpeed (void);
+  void Update (void) const;
+  virtual void NotifyConstructionCompleted (void);
+  virtual void NotifyCourseChangeConnected (void);
   virtual void DoDispose (void);
   virtual Vector DoGetPosition (void) const;
   virtual void DoSetPosition (const Vector &position);
@@ -62,7 +69,8 @@ class RandomDirection2dMobilityModel : public MobilityModel
   Rectangle m_bounds;
   RandomVariable m_speed;
   RandomVariable m_pause;
-  EventId m_event;
+  bool m_lazy;
+  mutable CourseChangeScheduler m_course;
   ConstantVelocityHelper m_helper;
 };
 
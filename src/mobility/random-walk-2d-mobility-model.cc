@@ -20,6 +20,7 @@
 #include "random-walk-2d-mobility-model.h"
 #include "ns3/enum.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include <cmath>
@@ -68,25 +69,44 @@ RandomWalk2dMobilityModel::GetTypeId (void)
                    "A random variable used to pick the speed (m/s).",
                    RandomVariableValue (UniformVariable (2.0, 4.0)),
                    MakeRandomVariableAccessor (&RandomWalk2dMobilityModel::m_speed),
-                   MakeRandomVariableChecker ());
+                   MakeRandomVariableChecker ())
+    .AddAttribute ("Lazy",
+                   "Compute the course only when the position is queried.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RandomWalk2dMobilityModel::m_lazy),
+                   MakeBooleanChecker ());
   return tid;
 }
 
 RandomWalk2dMobilityModel::RandomWalk2dMobilityModel ()
+  : m_lazy (false)
+{}
+
+void
+RandomWalk2dMobilityModel::NotifyConstructionCompleted (void)
 {
-  m_event = Simulator::ScheduleNow (&RandomWalk2dMobilityModel::Start, this);
+  MobilityModel::NotifyConstructionCompleted ();
+  m_course.SetLazy (m_lazy);
+  if (m_lazy)
+    {
+      // the streams do not depend on the order of the queries
+      m_speed.NewStream ();
+      m_direction.NewStream ();
+    }
+  m_course.Schedule (Seconds (0.0), MakeCallback (&RandomWalk2dMobilityModel::Start, this),
+                     IsCourseChangeTraced ());
 }
 
 void
 RandomWalk2dMobilityModel::Start (void)
 {
-  m_helper.Update ();
+  m_helper.Update (m_course.GetNow ());
   double speed = m_speed.GetValue ();
   double direction = m_direction.GetValue ();
   Vector vector (std::cos (direction) * speed,
                  std::sin (direction) * speed,
                  0.0);
-  m_helper.SetVelocity (vector);
+  m_helper.SetVelocity (vector, m_course.GetNow ());
   m_helper.Unpause ();
 
   Time delayLeft;
@@ -111,22 +131,25 @@ RandomWalk2dMobilityModel::DoWalk (Time delayLeft)
   nextPosition.y += speed.y * delayLeft.GetSeconds ();
   if (m_bounds.IsInside (nextPosition))
     {
-      m_event = Simulator::Schedule (delayLeft, &RandomWalk2dMobilityModel::Start, this);
+      m_course.Schedule (delayLeft, MakeCallback (&RandomWalk2dMobilityModel::Start, this),
+                         IsCourseChangeTraced ());
     }
   else
     {
       nextPosition = m_bounds.CalculateIntersection (position, speed);
       Time delay = Seconds ((nextPosition.x - position.x) / speed.x);
-      m_event = Simulator::Schedule (delay, &RandomWalk2dMobilityModel::Rebound, this,
-                                     delayLeft - delay);      
+      m_timeLeft = delayLeft - delay;
+      m_course.Schedule (delay, MakeCallback (&RandomWalk2dMobilityModel::Rebound, this),
+                         IsCourseChangeTraced ());
     }  
   NotifyCourseChange ();
 }
 
 void
-RandomWalk2dMobilityModel::Rebound (Time delayLeft)
+RandomWalk2dMobilityModel::Rebound (void)
 {
-  m_helper.UpdateWithBounds (m_bounds);
+  Time delayLeft = m_timeLeft;
+  m_helper.UpdateWithBounds (m_bounds, m_course.GetNow ());
   Vector position = m_helper.GetCurrentPosition ();
   Vector speed = m_helper.GetVelocity ();
   switch (m_bounds.GetClosestSide (position))
@@ -140,7 +163,7 @@ RandomWalk2dMobilityModel::Rebound (Time delayLeft)
       speed.y = - speed.y;
       break;
     }
-  m_helper.SetVelocity (speed);
+  m_helper.SetVelocity (speed, m_course.GetNow ());
   m_helper.Unpause ();
   DoWalk (delayLeft);
 }
@@ -151,10 +174,22 @@ RandomWalk2dMobilityModel::DoDispose (void)
   // chain up
   MobilityModel::DoDispose ();
 }
+void
+RandomWalk2dMobilityModel::Update (void) const
+{
+  m_course.Update (IsCourseChangeTraced ());
+  m_helper.UpdateWithBounds (m_bounds, m_course.GetNow ());
+}
+
+void
+RandomWalk2dMobilityModel::NotifyCourseChangeConnected (void)
+{
+  Update ();
+}
 Vector
 RandomWalk2dMobilityModel::DoGetPosition (void) const
 {
-  m_helper.UpdateWithBounds (m_bounds);
+  Update ();
   return m_helper.GetCurrentPosition ();
 }
 void
@@ -162,12 +197,14 @@ RandomWalk2dMobilityModel::DoSetPosition (const Vector &position)
 {
   NS_ASSERT (m_bounds.IsInside (position));
   m_helper.SetPosition (position);
-  Simulator::Remove (m_event);
-  m_event = Simulator::ScheduleNow (&RandomWalk2dMobilityModel::Start, this);
+  m_course.Cancel ();
+  m_course.Schedule (Seconds (0.0), MakeCallback (&RandomWalk2dMobilityModel::Start, this),
+                     IsCourseChangeTraced ());
 }
 Vector
 RandomWalk2dMobilityModel::DoGetVelocity (void) const
 {
+  Update ();
   return m_helper.GetVelocity ();
 }
 
@@ -27,6 +27,7 @@
 #include "ns3/random-variable.h"
 #include "mobility-model.h"
 #include "constant-velocity-helper.h"
+#include "course-change-scheduler.h"
 
 namespace ns3 {
 
@@ -41,6 +42,9 @@ namespace ns3 {
  * of the model, we rebound on the boundary with a reflexive angle
  * and speed. This model is often identified as a brownian motion
  * model.
+ *
+ * With the Lazy attribute, the course is only computed when the
+ * position or velocity is queried: see ns3::RandomWaypointMobilityModel.
  */
 class RandomWalk2dMobilityModel : public MobilityModel 
 {
@@ -56,15 +60,21 @@ class RandomWalk2dMobilityModel : public MobilityModel
 
  private:
   void Start (void);
-  void Rebound (Time timeLeft);
+  void Rebound (void);
   void DoWalk (Time timeLeft);
+  void Update (void) const;
+  virtual void NotifyConstructionCompleted (void);
+  virtual void NotifyCourseChangeConnected (void);
   virtual void DoDispose (void);
   virtual Vector DoGetPosition (void) const;
   virtual void DoSetPosition (const Vector &position);
   virtual Vector DoGetVelocity (void) const;
 
   ConstantVelocityHelper m_helper;
-  EventId m_event;
+  bool m_lazy;
+  mutable CourseChangeScheduler m_course;
+  // the walk time left after the next rebound
+  Time m_timeLeft;
   enum Mode m_mode;
   double m_modeDistance;
   Time m_modeTime;
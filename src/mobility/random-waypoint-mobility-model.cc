@@ -21,6 +21,7 @@
 #include "ns3/simulator.h"
 #include "ns3/random-variable.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
 #include "random-waypoint-mobility-model.h"
 #include "position-allocator.h"
 
@@ -49,20 +50,43 @@ RandomWaypointMobilityModel::GetTypeId (void)
                    "The position model used to pick a destination point.",
                    PointerValue (),
                    MakePointerAccessor (&RandomWaypointMobilityModel::m_position),
-                   MakePointerChecker<PositionAllocator> ());
+                   MakePointerChecker<PositionAllocator> ())
+    .AddAttribute ("Lazy",
+                   "Compute the course only when the position is queried.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RandomWaypointMobilityModel::m_lazy),
+                   MakeBooleanChecker ());
   
   return tid;
 }
 
 RandomWaypointMobilityModel::RandomWaypointMobilityModel ()
+  : m_lazy (false)
+{}
+
+void
+RandomWaypointMobilityModel::NotifyConstructionCompleted (void)
 {
-  m_event = Simulator::ScheduleNow (&RandomWaypointMobilityModel::Start, this);
+  MobilityModel::NotifyConstructionCompleted ();
+  m_course.SetLazy (m_lazy);
+  if (m_lazy)
+    {
+      // the streams do not depend on the order of the queries
+      m_speed.NewStream ();
+      m_pause.NewStream ();
+      if (m_position != 0)
+        {
+          m_position = DynamicCast<PositionAllocator> (CourseChangeScheduler::NewStreams (m_position));
+        }
+    }
+  m_course.Schedule (Seconds (0.0), MakeCallback (&RandomWaypointMobilityModel::Start, this),
+                     IsCourseChangeTraced ());
 }
 
 void
 RandomWaypointMobilityModel::BeginWalk (void)
 {
-  m_helper.Update ();
+  m_helper.Update (m_course.GetNow ());
   Vector m_current = m_helper.GetCurrentPosition ();
   Vector destination = m_position->GetNext ();
   double speed = m_speed.GetValue ();
@@ -71,42 +95,209 @@ RandomWaypointMobilityModel::BeginWalk (void)
   double dz = (destination.z - m_current.z);
   double k = speed / std::sqrt (dx*dx + dy*dy + dz*dz);
 
-  m_helper.SetVelocity (Vector (k*dx, k*dy, k*dz));
+  m_helper.SetVelocity (Vector (k*dx, k*dy, k*dz), m_course.GetNow ());
   m_helper.Unpause ();
   Time travelDelay = Seconds (CalculateDistance (destination, m_current) / speed);
-  m_event = Simulator::Schedule (travelDelay,
-				 &RandomWaypointMobilityModel::Start, this);
+  m_course.Schedule (travelDelay, MakeCallback (&RandomWaypointMobilityModel::Start, this),
+                     IsCourseChangeTraced ());
   NotifyCourseChange ();
 }
 
 void
 RandomWaypointMobilityModel::Start (void)
 {
-  m_helper.Update ();
+  m_helper.Update (m_course.GetNow ());
   m_helper.Pause ();
   Time pause = Seconds (m_pause.GetValue ());
-  m_event = Simulator::Schedule (pause, &RandomWaypointMobilityModel::BeginWalk, this);
+  m_course.Schedule (pause, MakeCallback (&RandomWaypointMobilityModel::BeginWalk, this),
+                     IsCourseChangeTraced ());
   NotifyCourseChange ();
 }
 
+void
+RandomWaypointMobilityModel::Update (void) const
+{
+  m_course.Update (IsCourseChangeTraced ());
+  m_helper.Update (m_course.GetNow ());
+}
+
+void
+RandomWaypointMobilityModel::NotifyCourseChangeConnected (void)
+{
+  Update ();
+}
+
 Vector
 RandomWaypointMobilityModel::DoGetPosition (void) const
 {
-  m_helper.Update ();
+  Update ();
   return m_helper.GetCurrentPosition ();
 }
 void 
 RandomWaypointMobilityModel::DoSetPosition (const Vector &position)
 {
   m_helper.SetPosition (position);
-  Simulator::Remove (m_event);
-  m_event = Simulator::ScheduleNow (&RandomWaypointMobilityModel::Start, this);
+  m_course.Cancel ();
+  m_course.Schedule (Seconds (0.0), MakeCallback (&RandomWaypointMobilityModel::Start, this),
+                     IsCourseChangeTraced ());
 }
 Vector
 RandomWaypointMobilityModel::DoGetVelocity (void) const
 {
+  Update ();
   return m_helper.GetVelocity ();
 }
 
 
 } // namespace ns3
+
+#ifdef RUN_SELF_TESTS
+
+#include "ns3/test.h"
+#include "ns3/rng-stream.h"
+#include <algorithm>
+
+namespace ns3 {
+
+class RandomWaypointMobilityModelTest : public Test
+{
+public:
+  RandomWaypointMobilityModelTest ();
+  virtual bool RunTests (void);
+private:
+  Ptr<RandomWaypointMobilityModel> CreateModel (bool lazy);
+  Ptr<RandomWaypointMobilityModel> CreateRandomModel (Ptr<PositionAllocator> positions);
+  void Query (void);
+  void QueryModel (Ptr<MobilityModel> model);
+  Vector RunRandom (bool queryFirst, Ptr<MobilityModel> *other);
+  void CourseChange (Ptr<const MobilityModel> model);
+
+  Ptr<MobilityModel> m_eager;
+  Ptr<MobilityModel> m_lazy;
+  double m_maxDistance;
+  uint32_t m_courseChanges;
+};
+
+static RandomWaypointMobilityModelTest g_randomWaypointMobilityModelTest;
+
+RandomWaypointMobilityModelTest::RandomWaypointMobilityModelTest ()
+  : Test ("RandomWaypointMobilityModel")
+{}
+
+Ptr<RandomWaypointMobilityModel>
+RandomWaypointMobilityModelTest::CreateModel (bool lazy)
+{
+  Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator> ();
+  positions->Add (Vector (10.0, 0.0, 0.0));
+  positions->Add (Vector (10.0, 10.0, 0.0));
+  positions->Add (Vector (0.0, 0.0, 0.0));
+  return CreateObjectWithAttributes<RandomWaypointMobilityModel> ("Speed", RandomVariableValue (ConstantVariable (3.0)),
+                                                                  "Pause", RandomVariableValue (ConstantVariable (0.5)),
+                                                                  "PositionAllocator", PointerValue (positions),
+                                                                  "Lazy", BooleanValue (lazy));
+}
+
+Ptr<RandomWaypointMobilityModel>
+RandomWaypointMobilityModelTest::CreateRandomModel (Ptr<PositionAllocator> positions)
+{
+  return CreateObjectWithAttributes<RandomWaypointMobilityModel> ("Speed", RandomVariableValue (UniformVariable (1.0, 5.0)),
+                                                                  "Pause", RandomVariableValue (UniformVariable (0.0, 1.0)),
+                                                                  "PositionAllocator", PointerValue (positions),
+                                                                  "Lazy", BooleanValue (true));
+}
+
+void
+RandomWaypointMobilityModelTest::QueryModel (Ptr<MobilityModel> model)
+{
+  model->GetPosition ();
+}
+
+Vector
+RandomWaypointMobilityModelTest::RunRandom (bool queryFirst, Ptr<MobilityModel> *other)
+{
+  // both runs take the same streams of the package, which reads its
+  // seed when the first stream is made.
+  RngStream stream;
+  uint32_t seed[6];
+  RngStream::GetPackageSeed (seed);
+  RngStream::SetPackageSeed (seed);
+  Ptr<RandomRectanglePositionAllocator> positions = CreateObjectWithAttributes<RandomRectanglePositionAllocator>
+    ("X", RandomVariableValue (UniformVariable (0.0, 100.0)),
+     "Y", RandomVariableValue (UniformVariable (0.0, 100.0)));
+  Ptr<MobilityModel> first = CreateRandomModel (positions);
+  Ptr<MobilityModel> second = CreateRandomModel (positions);
+  for (uint32_t i = 1; i < 100; i++)
+    {
+      Simulator::Schedule (Seconds (i * 0.37), &RandomWaypointMobilityModelTest::QueryModel, this,
+                           queryFirst ? first : second);
+    }
+  Simulator::Stop (Seconds (40.0));
+  Simulator::Run ();
+  Vector position = first->GetPosition ();
+  *other = second;
+  return position;
+}
+
+void
+RandomWaypointMobilityModelTest::Query (void)
+{
+  m_maxDistance = std::max (m_maxDistance, CalculateDistance (m_eager->GetPosition (),
+                                                              m_lazy->GetPosition ()));
+}
+
+void
+RandomWaypointMobilityModelTest::CourseChange (Ptr<const MobilityModel> model)
+{
+  m_courseChanges++;
+}
+
+bool
+RandomWaypointMobilityModelTest::RunTests (void)
+{
+  bool result = true;
+
+  // a lazy model follows the course of an eager model, with events
+  // only for the queries.
+  m_eager = CreateModel (false);
+  m_lazy = CreateModel (true);
+  m_maxDistance = 0.0;
+  for (uint32_t i = 1; i < 100; i++)
+    {
+      Simulator::Schedule (Seconds (i * 0.37), &RandomWaypointMobilityModelTest::Query, this);
+    }
+  Simulator::Stop (Seconds (40.0));
+  Simulator::Run ();
+  NS_TEST_ASSERT (m_maxDistance < 1e-6);
+  Simulator::Destroy ();
+
+  // a lazy model with a listener notifies each course change on time.
+  m_lazy = CreateModel (true);
+  m_courseChanges = 0;
+  m_lazy->TraceConnectWithoutContext ("CourseChange",
+                                      MakeCallback (&RandomWaypointMobilityModelTest::CourseChange, this));
+  Simulator::Stop (Seconds (10.0));
+  Simulator::Run ();
+  NS_TEST_ASSERT (m_courseChanges > 1);
+  Simulator::Destroy ();
+
+  // the course of lazy models which share a random position allocator
+  // does not depend on which one is queried first.
+  Ptr<MobilityModel> second;
+  Vector first = RunRandom (true, &second);
+  Vector firstSecond = second->GetPosition ();
+  Simulator::Destroy ();
+  Vector other = RunRandom (false, &second);
+  Vector otherSecond = second->GetPosition ();
+  Simulator::Destroy ();
+  NS_TEST_ASSERT (CalculateDistance (first, other) < 1e-6);
+  NS_TEST_ASSERT (CalculateDistance (firstSecond, otherSecond) < 1e-6);
+  second = 0;
+
+  m_eager = 0;
+  m_lazy = 0;
+  return result;
+}
+
+} // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
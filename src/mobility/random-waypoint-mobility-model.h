@@ -21,6 +21,7 @@
 #define RANDOM_WAYPOINT_MOBILITY_MODEL_H
 
 #include "constant-velocity-helper.h"
+#include "course-change-scheduler.h"
 #include "mobility-model.h"
 #include "position-allocator.h"
 #include "ns3/ptr.h"
@@ -40,6 +41,14 @@ namespace ns3 {
  * a 3d random waypoint position model to this mobility model, the model 
  * will still work. There is no 3d position allocator for now but it should
  * be trivial to add one.
+ *
+ * With the Lazy attribute, the model only computes its course when its
+ * position or velocity is queried, and schedules no event unless
+ * listeners are connected to its CourseChange trace source: see
+ * ns3::CourseChangeScheduler. A lazy model draws its random values
+ * from streams of its own, taken when it is created, so its course does
+ * not depend on the order of the queries; with random variables, it
+ * differs from the course of the same model without the Lazy attribute.
  */
 class RandomWaypointMobilityModel : public MobilityModel
 {
@@ -49,6 +58,9 @@ public:
 private:
   void Start (void);
   void BeginWalk (void);
+  void Update (void) const;
+  virtual void NotifyConstructionCompleted (void);
+  virtual void NotifyCourseChangeConnected (void);
   virtual Vector DoGetPosition (void) const;
   virtual void DoSetPosition (const Vector &position);
   virtual Vector DoGetVelocity (void) const;
@@ -57,7 +69,8 @@ private:
   Ptr<PositionAllocator> m_position;
   RandomVariable m_speed;
   RandomVariable m_pause;
-  EventId m_event;
+  bool m_lazy;
+  mutable CourseChangeScheduler m_course;
 };
 
 } // namespace ns3
@@ -109,12 +109,26 @@ void Application::StopApplication()
 // Private helpers
 void Application::ScheduleStart (const Time &startTime)
 {
+  if (m_node != 0 && !Simulator::IsLocalContext (m_node->GetId ()))
+    {
+      // Let the node schedule its own start event so that the
+      // application runs in the context of its node.
+      Simulator::ScheduleWithContext (m_node->GetId (), Seconds (0),
+                                      &Application::ScheduleStart, this, startTime);
+      return;
+    }
   m_startEvent = Simulator::Schedule (startTime,
                                       &Application::StartApplication, this);
 }
 
 void Application::ScheduleStop (const Time &stopTime)
 {
+  if (m_node != 0 && !Simulator::IsLocalContext (m_node->GetId ()))
+    {
+      Simulator::ScheduleWithContext (m_node->GetId (), Seconds (0),
+                                      &Application::ScheduleStop, this, stopTime);
+      return;
+    }
   m_stopEvent = Simulator::Schedule (stopTime,
                                     &Application::StopApplication, this);
 }
@@ -255,6 +255,29 @@ Ipv4AddressGeneratorImpl::AddAllocated (const Ipv4Address address)
 
   NS_ABORT_MSG_UNLESS (addr, "Ipv4AddressGeneratorImpl::Add(): Allocating the broadcast address is not a good idea"); 
  
+//
+// Addresses are mostly allocated in increasing order, one subnet after the
+// other.  An address above the highest allocated block cannot collide: it
+// extends that block or starts a new one at the end of the list, without
+// walking the list, which would make the allocation of a large topology
+// quadratic in its number of subnets.
+//
+  if (!m_entries.empty () && addr > m_entries.back ().addrHigh)
+    {
+      if (addr == m_entries.back ().addrHigh + 1)
+        {
+          NS_LOG_LOGIC ("New addrHigh = " << Ipv4Address (addr));
+          m_entries.back ().addrHigh = addr;
+        }
+      else
+        {
+          Entry entry;
+          entry.addrLow = entry.addrHigh = addr;
+          m_entries.push_back (entry);
+        }
+      return true;
+    }
+
   std::list<Entry>::iterator i;
 
   for (i = m_entries.begin (); i != m_entries.end (); ++i)
@@ -647,6 +670,30 @@ Ipv4AddressGeneratorTest::RunTests (void)
 
   added = Ipv4AddressGenerator::AddAllocated ("0.0.0.21");
   NS_TEST_ASSERT_EQUAL (added, false);
+//
+// Addresses above the highest block start new blocks, which the addresses
+// below them must still be checked against.
+//
+  added = Ipv4AddressGenerator::AddAllocated ("0.0.0.25");
+  NS_TEST_ASSERT_EQUAL (added, true);
+
+  added = Ipv4AddressGenerator::AddAllocated ("0.0.0.26");
+  NS_TEST_ASSERT_EQUAL (added, true);
+
+  added = Ipv4AddressGenerator::AddAllocated ("0.0.0.23");
+  NS_TEST_ASSERT_EQUAL (added, true);
+
+  added = Ipv4AddressGenerator::AddAllocated ("0.0.0.25");
+  NS_TEST_ASSERT_EQUAL (added, false);
+
+  added = Ipv4AddressGenerator::AddAllocated ("0.0.0.22");
+  NS_TEST_ASSERT_EQUAL (added, true);
+
+  added = Ipv4AddressGenerator::AddAllocated ("0.0.0.24");
+  NS_TEST_ASSERT_EQUAL (added, true);
+
+  added = Ipv4AddressGenerator::AddAllocated ("0.0.0.26");
+  NS_TEST_ASSERT_EQUAL (added, false);
 
   Ipv4AddressGenerator::Reset ();
 
@@ -614,6 +614,28 @@ OlContext::table (ParseExpr *name, ParseExpr *ttl, ParseExpr *size,
       << tableInfo->timeout << ", size " << tableInfo->size);
 }
 
+void
+OlContext::Annotate (ParseFunctorName *annotation, ParseExpr *name,
+  ParseExpr *value)
+{
+  if (annotation->name != "priority")
+    {
+      ReportError ("unknown annotation " + annotation->name);
+      return;
+    }
+
+  ValInt32* val = dynamic_cast<ValInt32*> (PeekPointer (value->value));
+  if (val == NULL || val->GetInt32Value () < 0)
+    {
+      ReportError ("bad priority class for " + name->ToString ());
+      return;
+    }
+
+  tuplePriorities[name->value->ToString ()] = val->GetInt32Value ();
+  NS_LOG_DEBUG ("Priority " << name->ToString () << ", class "
+      << val->GetInt32Value ());
+}
+
 //
 // Adding a fact [not used]
 //
@@ -185,6 +185,10 @@ public:
   void table (ParseExpr *n, ParseExpr *t, ParseExpr *s, ParseExprList *k =
       NULL);
 
+  /** Register a relation annotation such as priority(linkDelete, 0) */
+  void Annotate (ParseFunctorName *annotation, ParseExpr *name,
+    ParseExpr *value);
+
   void Query (ParseTerm *term);
 
   void Fact (ParseTerm *term);
@@ -224,6 +228,9 @@ public:
   /** The type of watched table mappings */
   typedef map<string, string> WatchTableType;
 
+  /** The type of relation to wire priority class mappings */
+  typedef map<string, int> TuplePriorityMap;
+
   /** The external stage structure */
   struct ExtStageSpec
   {
@@ -303,6 +310,9 @@ private:
   /** The watched table map */
   WatchTableType watchTables;
 
+  /** The declared wire priority classes */
+  TuplePriorityMap tuplePriorities;
+
   ParseFunctor* singleQuery;
 
   set<string, less<string> > tuplesToTrace;
@@ -353,6 +363,11 @@ public:
     return watchTables;
   }
 
+  TuplePriorityMap GetTuplePriorities ()
+  {
+    return tuplePriorities;
+  }
+
   set<string> GetTuplesToTrace ()
   {
     return tuplesToTrace;
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton implementation for Bison's Yacc-like parsers in C
+/* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -36,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -43,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "2.3"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -55,141 +57,21 @@
 /* Pure parsers.  */
 #define YYPURE 1
 
-/* Using locations.  */
-#define YYLSP_NEEDED 0
+/* Push parsers.  */
+#define YYPUSH 0
+
+/* Pull parsers.  */
+#define YYPULL 1
+
 
 /* Substitute the variable and function names.  */
-#define yyparse ol_parser_parse
-#define yylex   ol_parser_lex
-#define yyerror ol_parser_error
-#define yylval  ol_parser_lval
-#define yychar  ol_parser_char
-#define yydebug ol_parser_debug
-#define yynerrs ol_parser_nerrs
-
-
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     OL_OR = 258,
-     OL_AND = 259,
-     OL_BITOR = 260,
-     OL_BITXOR = 261,
-     OL_BITAND = 262,
-     OL_BITNOT = 263,
-     OL_NEQ = 264,
-     OL_EQ = 265,
-     OL_LTE = 266,
-     OL_LT = 267,
-     OL_GTE = 268,
-     OL_GT = 269,
-     OL_RSHIFT = 270,
-     OL_LSHIFT = 271,
-     OL_MINUS = 272,
-     OL_PLUS = 273,
-     OL_MODULUS = 274,
-     OL_DIVIDE = 275,
-     OL_TIMES = 276,
-     OL_NOT = 277,
-     OL_IN = 278,
-     OL_ID = 279,
-     OL_ASSIGN = 280,
-     OL_AT = 281,
-     OL_NAME = 282,
-     OL_COMMA = 283,
-     OL_DOT = 284,
-     OL_EOF = 285,
-     OL_IF = 286,
-     OL_STRING = 287,
-     OL_VALUE = 288,
-     OL_VAR = 289,
-     OL_AGGFUNCNAME = 290,
-     OL_FUNCTION = 291,
-     OL_NULL = 292,
-     OL_RPAR = 293,
-     OL_LPAR = 294,
-     OL_LSQUB = 295,
-     OL_RSQUB = 296,
-     OL_LCURB = 297,
-     OL_RCURB = 298,
-     OL_COLON = 299,
-     OL_DEL = 300,
-     OL_QUERY = 301,
-     OL_MATERIALIZE = 302,
-     OL_KEYS = 303,
-     OL_SAYS = 304,
-     OL_ENCRYPTS = 305,
-     OL_CONTEXT = 306,
-     OL_WATCH = 307,
-     OL_WATCHFINE = 308,
-     OL_STAGE = 309,
-     OL_TRACE = 310,
-     OL_TRACETABLE = 311
-   };
-#endif
-/* Tokens.  */
-#define OL_OR 258
-#define OL_AND 259
-#define OL_BITOR 260
-#define OL_BITXOR 261
-#define OL_BITAND 262
-#define OL_BITNOT 263
-#define OL_NEQ 264
-#define OL_EQ 265
-#define OL_LTE 266
-#define OL_LT 267
-#define OL_GTE 268
-#define OL_GT 269
-#define OL_RSHIFT 270
-#define OL_LSHIFT 271
-#define OL_MINUS 272
-#define OL_PLUS 273
-#define OL_MODULUS 274
-#define OL_DIVIDE 275
-#define OL_TIMES 276
-#define OL_NOT 277
-#define OL_IN 278
-#define OL_ID 279
-#define OL_ASSIGN 280
-#define OL_AT 281
-#define OL_NAME 282
-#define OL_COMMA 283
-#define OL_DOT 284
-#define OL_EOF 285
-#define OL_IF 286
-#define OL_STRING 287
-#define OL_VALUE 288
-#define OL_VAR 289
-#define OL_AGGFUNCNAME 290
-#define OL_FUNCTION 291
-#define OL_NULL 292
-#define OL_RPAR 293
-#define OL_LPAR 294
-#define OL_LSQUB 295
-#define OL_RSQUB 296
-#define OL_LCURB 297
-#define OL_RCURB 298
-#define OL_COLON 299
-#define OL_DEL 300
-#define OL_QUERY 301
-#define OL_MATERIALIZE 302
-#define OL_KEYS 303
-#define OL_SAYS 304
-#define OL_ENCRYPTS 305
-#define OL_CONTEXT 306
-#define OL_WATCH 307
-#define OL_WATCHFINE 308
-#define OL_STAGE 309
-#define OL_TRACE 310
-#define OL_TRACETABLE 311
-
-
-
-
-/* Copy the first part of user declarations.  */
+#define yyparse         ol_parser_parse
+#define yylex           ol_parser_lex
+#define yyerror         ol_parser_error
+#define yydebug         ol_parser_debug
+#define yynerrs         ol_parser_nerrs
+
+/* First part of user prologue.  */
 #line 1 "src/rapidnet-compiler/ol-parser.y"
 
 /* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
@@ -226,88 +108,227 @@
   static void ol_parser_error(OlContext *ctxt, string msg);
 
 
+#line 112 "src/rapidnet-compiler/ol-parser.cc"
 
-/* Enabling traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 1
-#endif
-
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 0
-#endif
-
-/* Enabling the token table.  */
-#ifndef YYTOKEN_TABLE
-# define YYTOKEN_TABLE 0
-#endif
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
+# ifndef YY_NULLPTR
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
+#  else
+#   define YY_NULLPTR ((void*)0)
+#  endif
+# endif
 
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 96 "src/rapidnet-compiler/ol-parser.y"
+#include "ol-parser.hh"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_OL_OR = 3,                      /* OL_OR  */
+  YYSYMBOL_OL_AND = 4,                     /* OL_AND  */
+  YYSYMBOL_OL_BITOR = 5,                   /* OL_BITOR  */
+  YYSYMBOL_OL_BITXOR = 6,                  /* OL_BITXOR  */
+  YYSYMBOL_OL_BITAND = 7,                  /* OL_BITAND  */
+  YYSYMBOL_OL_BITNOT = 8,                  /* OL_BITNOT  */
+  YYSYMBOL_OL_EQ = 9,                      /* OL_EQ  */
+  YYSYMBOL_OL_NEQ = 10,                    /* OL_NEQ  */
+  YYSYMBOL_OL_GT = 11,                     /* OL_GT  */
+  YYSYMBOL_OL_GTE = 12,                    /* OL_GTE  */
+  YYSYMBOL_OL_LT = 13,                     /* OL_LT  */
+  YYSYMBOL_OL_LTE = 14,                    /* OL_LTE  */
+  YYSYMBOL_OL_LSHIFT = 15,                 /* OL_LSHIFT  */
+  YYSYMBOL_OL_RSHIFT = 16,                 /* OL_RSHIFT  */
+  YYSYMBOL_OL_PLUS = 17,                   /* OL_PLUS  */
+  YYSYMBOL_OL_MINUS = 18,                  /* OL_MINUS  */
+  YYSYMBOL_OL_TIMES = 19,                  /* OL_TIMES  */
+  YYSYMBOL_OL_DIVIDE = 20,                 /* OL_DIVIDE  */
+  YYSYMBOL_OL_MODULUS = 21,                /* OL_MODULUS  */
+  YYSYMBOL_OL_NOT = 22,                    /* OL_NOT  */
+  YYSYMBOL_OL_IN = 23,                     /* OL_IN  */
+  YYSYMBOL_OL_ID = 24,                     /* OL_ID  */
+  YYSYMBOL_OL_ASSIGN = 25,                 /* OL_ASSIGN  */
+  YYSYMBOL_OL_AT = 26,                     /* OL_AT  */
+  YYSYMBOL_OL_NAME = 27,                   /* OL_NAME  */
+  YYSYMBOL_OL_COMMA = 28,                  /* OL_COMMA  */
+  YYSYMBOL_OL_DOT = 29,                    /* OL_DOT  */
+  YYSYMBOL_OL_EOF = 30,                    /* OL_EOF  */
+  YYSYMBOL_OL_IF = 31,                     /* OL_IF  */
+  YYSYMBOL_OL_STRING = 32,                 /* OL_STRING  */
+  YYSYMBOL_OL_VALUE = 33,                  /* OL_VALUE  */
+  YYSYMBOL_OL_VAR = 34,                    /* OL_VAR  */
+  YYSYMBOL_OL_AGGFUNCNAME = 35,            /* OL_AGGFUNCNAME  */
+  YYSYMBOL_OL_FUNCTION = 36,               /* OL_FUNCTION  */
+  YYSYMBOL_OL_NULL = 37,                   /* OL_NULL  */
+  YYSYMBOL_OL_RPAR = 38,                   /* OL_RPAR  */
+  YYSYMBOL_OL_LPAR = 39,                   /* OL_LPAR  */
+  YYSYMBOL_OL_LSQUB = 40,                  /* OL_LSQUB  */
+  YYSYMBOL_OL_RSQUB = 41,                  /* OL_RSQUB  */
+  YYSYMBOL_OL_LCURB = 42,                  /* OL_LCURB  */
+  YYSYMBOL_OL_RCURB = 43,                  /* OL_RCURB  */
+  YYSYMBOL_OL_COLON = 44,                  /* OL_COLON  */
+  YYSYMBOL_OL_DEL = 45,                    /* OL_DEL  */
+  YYSYMBOL_OL_QUERY = 46,                  /* OL_QUERY  */
+  YYSYMBOL_OL_MATERIALIZE = 47,            /* OL_MATERIALIZE  */
+  YYSYMBOL_OL_KEYS = 48,                   /* OL_KEYS  */
+  YYSYMBOL_OL_SAYS = 49,                   /* OL_SAYS  */
+  YYSYMBOL_OL_ENCRYPTS = 50,               /* OL_ENCRYPTS  */
+  YYSYMBOL_OL_CONTEXT = 51,                /* OL_CONTEXT  */
+  YYSYMBOL_OL_WATCH = 52,                  /* OL_WATCH  */
+  YYSYMBOL_OL_WATCHFINE = 53,              /* OL_WATCHFINE  */
+  YYSYMBOL_OL_STAGE = 54,                  /* OL_STAGE  */
+  YYSYMBOL_OL_TRACE = 55,                  /* OL_TRACE  */
+  YYSYMBOL_OL_TRACETABLE = 56,             /* OL_TRACETABLE  */
+  YYSYMBOL_YYACCEPT = 57,                  /* $accept  */
+  YYSYMBOL_program = 58,                   /* program  */
+  YYSYMBOL_clauselist = 59,                /* clauselist  */
+  YYSYMBOL_clause = 60,                    /* clause  */
+  YYSYMBOL_materialize = 61,               /* materialize  */
+  YYSYMBOL_annotation = 62,                /* annotation  */
+  YYSYMBOL_tablearg = 63,                  /* tablearg  */
+  YYSYMBOL_primarykeys = 64,               /* primarykeys  */
+  YYSYMBOL_keylist = 65,                   /* keylist  */
+  YYSYMBOL_key = 66,                       /* key  */
+  YYSYMBOL_watch = 67,                     /* watch  */
+  YYSYMBOL_watchfine = 68,                 /* watchfine  */
+  YYSYMBOL_stage = 69,                     /* stage  */
+  YYSYMBOL_trace = 70,                     /* trace  */
+  YYSYMBOL_TraceTable = 71,                /* TraceTable  */
+  YYSYMBOL_fact = 72,                      /* fact  */
+  YYSYMBOL_rule = 73,                      /* rule  */
+  YYSYMBOL_namedRule = 74,                 /* namedRule  */
+  YYSYMBOL_unnamedRule = 75,               /* unnamedRule  */
+  YYSYMBOL_context = 76,                   /* context  */
+  YYSYMBOL_query = 77,                     /* query  */
+  YYSYMBOL_termlist = 78,                  /* termlist  */
+  YYSYMBOL_term = 79,                      /* term  */
+  YYSYMBOL_functor = 80,                   /* functor  */
+  YYSYMBOL_aggview = 81,                   /* aggview  */
+  YYSYMBOL_functorname = 82,               /* functorname  */
+  YYSYMBOL_functorbody = 83,               /* functorbody  */
+  YYSYMBOL_functorargs = 84,               /* functorargs  */
+  YYSYMBOL_functorarg = 85,                /* functorarg  */
+  YYSYMBOL_function = 86,                  /* function  */
+  YYSYMBOL_functionargs = 87,              /* functionargs  */
+  YYSYMBOL_functionarg = 88,               /* functionarg  */
+  YYSYMBOL_select = 89,                    /* select  */
+  YYSYMBOL_assign = 90,                    /* assign  */
+  YYSYMBOL_bool_expr = 91,                 /* bool_expr  */
+  YYSYMBOL_rel_atom = 92,                  /* rel_atom  */
+  YYSYMBOL_rel_oper = 93,                  /* rel_oper  */
+  YYSYMBOL_math_expr = 94,                 /* math_expr  */
+  YYSYMBOL_math_atom = 95,                 /* math_atom  */
+  YYSYMBOL_math_oper = 96,                 /* math_oper  */
+  YYSYMBOL_range_expr = 97,                /* range_expr  */
+  YYSYMBOL_range_atom = 98,                /* range_atom  */
+  YYSYMBOL_atom = 99,                      /* atom  */
+  YYSYMBOL_aggregate = 100,                /* aggregate  */
+  YYSYMBOL_agg_oper = 101                  /* agg_oper  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-  ns3::rapidnet_compiler::ParseBool::Operator  u_boper;
-  ns3::rapidnet_compiler::ParseMath::Operator  u_moper;
-  const char*                                   u_aoper;
-  ns3::rapidnet_compiler::ParseTermList        *u_termlist;
-  ns3::rapidnet_compiler::ParseTerm            *u_term;
-  ns3::rapidnet_compiler::ParseFunctorName     *u_functorname;
-  ns3::rapidnet_compiler::ParseExprList        *u_exprlist;
-  ns3::rapidnet_compiler::ParseExprListList    *u_exprlistlist;
-  ns3::rapidnet_compiler::ParseExpr            *v;
-  ns3::rapidnet_compiler::ParseAggTerm         *u_aggterm;
-  ns3::rapidnet_compiler::ParseKey             *u_key;
-  ns3::rapidnet_compiler::ParseRule            *u_rule;
-}
-/* Line 187 of yacc.c.  */
-#line 268 "src/rapidnet-compiler/ol-parser.cc"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
-# define YYSTYPE_IS_TRIVIAL 1
-#endif
-
-
-
-/* Copy the second part of user declarations.  */
 
 
-/* Line 216 of yacc.c.  */
-#line 281 "src/rapidnet-compiler/ol-parser.cc"
 
 #ifdef short
 # undef short
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
-#else
-typedef unsigned char yytype_uint8;
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
+
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#elif (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
+
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
 typedef signed char yytype_int8;
+#endif
+
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef short int yytype_int8;
+typedef short yytype_int16;
+#endif
+
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -315,55 +336,106 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
-# if YYENABLE_NLS
+# if defined YYENABLE_NLS && YYENABLE_NLS
 #  if ENABLE_NLS
 #   include <libintl.h> /* INFRINGES ON USER NAME SPACE */
-#   define YY_(msgid) dgettext ("bison-runtime", msgid)
+#   define YY_(Msgid) dgettext ("bison-runtime", Msgid)
 #  endif
 # endif
 # ifndef YY_
-#  define YY_(msgid) msgid
+#  define YY_(Msgid) Msgid
+# endif
+#endif
+
+
+#ifndef YY_ATTRIBUTE_PURE
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
+#endif
+
+#ifndef YY_ATTRIBUTE_UNUSED
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
+# else
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(e) ((void) (e))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(e) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-/* Identity function, used to suppress warnings about constant conditions.  */
-#ifndef lint
-# define YYID(n) (n)
-#else
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static int
-YYID (int i)
+/* Suppress an incorrect diagnostic about yylval being uninitialized.  */
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
+    _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
+    _Pragma ("GCC diagnostic pop")
 #else
-static int
-YYID (i)
-    int i;
+# define YY_INITIAL_VALUE(Value) Value
 #endif
-{
-  return i;
-}
+#ifndef YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END
+#endif
+#ifndef YY_INITIAL_VALUE
+# define YY_INITIAL_VALUE(Value) /* Nothing. */
+#endif
+
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
 #endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if !defined yyoverflow
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -380,11 +452,11 @@ YYID (i)
 #    define alloca _alloca
 #   else
 #    define YYSTACK_ALLOC alloca
-#    if ! defined _ALLOCA_H && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#    if ! defined _ALLOCA_H && ! defined EXIT_SUCCESS
 #     include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#     ifndef _STDLIB_H
-#      define _STDLIB_H 1
+      /* Use EXIT_SUCCESS as a witness for stdlib.h.  */
+#     ifndef EXIT_SUCCESS
+#      define EXIT_SUCCESS 0
 #     endif
 #    endif
 #   endif
@@ -392,8 +464,8 @@ YYID (i)
 # endif
 
 # ifdef YYSTACK_ALLOC
-   /* Pacify GCC's `empty if-body' warning.  */
-#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (YYID (0))
+   /* Pacify GCC's 'empty if-body' warning.  */
+#  define YYSTACK_FREE(Ptr) do { /* empty */; } while (0)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
     /* The OS might guarantee only one guard page at the bottom of the stack,
        and a page size can be as small as 4096 bytes.  So we cannot safely
@@ -407,111 +479,117 @@ YYID (i)
 #  ifndef YYSTACK_ALLOC_MAXIMUM
 #   define YYSTACK_ALLOC_MAXIMUM YYSIZE_MAXIMUM
 #  endif
-#  if (defined __cplusplus && ! defined _STDLIB_H \
+#  if (defined __cplusplus && ! defined EXIT_SUCCESS \
        && ! ((defined YYMALLOC || defined malloc) \
-	     && (defined YYFREE || defined free)))
+             && (defined YYFREE || defined free)))
 #   include <stdlib.h> /* INFRINGES ON USER NAME SPACE */
-#   ifndef _STDLIB_H
-#    define _STDLIB_H 1
+#   ifndef EXIT_SUCCESS
+#    define EXIT_SUCCESS 0
 #   endif
 #  endif
 #  ifndef YYMALLOC
 #   define YYMALLOC malloc
-#   if ! defined malloc && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined malloc && ! defined EXIT_SUCCESS
 void *malloc (YYSIZE_T); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 #  ifndef YYFREE
 #   define YYFREE free
-#   if ! defined free && ! defined _STDLIB_H && (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
+#   if ! defined free && ! defined EXIT_SUCCESS
 void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* !defined yyoverflow */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
-	 || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
+         || (defined YYSTYPE_IS_TRIVIAL && YYSTYPE_IS_TRIVIAL)))
 
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss;
-  YYSTYPE yyvs;
-  };
+  yy_state_t yyss_alloc;
+  YYSTYPE yyvs_alloc;
+};
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE)) \
       + YYSTACK_GAP_MAXIMUM)
 
-/* Copy COUNT objects from FROM to TO.  The source and destination do
-   not overlap.  */
-# ifndef YYCOPY
-#  if defined __GNUC__ && 1 < __GNUC__
-#   define YYCOPY(To, From, Count) \
-      __builtin_memcpy (To, From, (Count) * sizeof (*(From)))
-#  else
-#   define YYCOPY(To, From, Count)		\
-      do					\
-	{					\
-	  YYSIZE_T yyi;				\
-	  for (yyi = 0; yyi < (Count); yyi++)	\
-	    (To)[yyi] = (From)[yyi];		\
-	}					\
-      while (YYID (0))
-#  endif
-# endif
+# define YYCOPY_NEEDED 1
 
 /* Relocate STACK from its old location to the new one.  The
    local variables YYSIZE and YYSTACKSIZE give the old and new number of
    elements in the stack, and YYPTR gives the new location of the
    stack.  Advance YYPTR to a properly aligned location for the next
    stack.  */
-# define YYSTACK_RELOCATE(Stack)					\
-    do									\
-      {									\
-	YYSIZE_T yynewbytes;						\
-	YYCOPY (&yyptr->Stack, Stack, yysize);				\
-	Stack = &yyptr->Stack;						\
-	yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-	yyptr += yynewbytes / sizeof (*yyptr);				\
-      }									\
-    while (YYID (0))
+# define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
+    do                                                                  \
+      {                                                                 \
+        YYPTRDIFF_T yynewbytes;                                         \
+        YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
+        Stack = &yyptr->Stack_alloc;                                    \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
+      }                                                                 \
+    while (0)
 
 #endif
 
+#if defined YYCOPY_NEEDED && YYCOPY_NEEDED
+/* Copy COUNT objects from SRC to DST.  The source and destination do
+   not overlap.  */
+# ifndef YYCOPY
+#  if defined __GNUC__ && 1 < __GNUC__
+#   define YYCOPY(Dst, Src, Count) \
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
+#  else
+#   define YYCOPY(Dst, Src, Count)              \
+      do                                        \
+        {                                       \
+          YYPTRDIFF_T yyi;                      \
+          for (yyi = 0; yyi < (Count); yyi++)   \
+            (Dst)[yyi] = (Src)[yyi];            \
+        }                                       \
+      while (0)
+#  endif
+# endif
+#endif /* !YYCOPY_NEEDED */
+
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  46
+#define YYFINAL  48
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   326
+#define YYLAST   359
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  57
 /* YYNNTS -- Number of nonterminals.  */
-#define YYNNTS  44
+#define YYNNTS  45
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  116
-/* YYNRULES -- Number of states.  */
-#define YYNSTATES  241
+#define YYNRULES  118
+/* YYNSTATES -- Number of states.  */
+#define YYNSTATES  249
 
-/* YYTRANSLATE(YYLEX) -- Bison symbol number corresponding to YYLEX.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   311
 
-#define YYTRANSLATE(YYX)						\
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
 
-/* YYTRANSLATE[YYLEX] -- Bison symbol number corresponding to YYLEX.  */
-static const yytype_uint8 yytranslate[] =
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
+
+/* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -548,446 +626,340 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-/* YYPRHS[YYN] -- Index of the first RHS symbol of rule number YYN in
-   YYRHS.  */
-static const yytype_uint16 yyprhs[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,     0,     3,     5,     8,    10,    13,    15,    17,    19,
-      21,    23,    25,    27,    29,    31,    33,    45,    47,    52,
-      56,    58,    62,    66,    68,    74,    82,    92,    98,   104,
-     107,   109,   111,   114,   119,   125,   131,   138,   143,   147,
-     152,   154,   158,   160,   162,   164,   167,   172,   176,   182,
-     187,   194,   200,   208,   217,   219,   222,   226,   228,   232,
-     235,   240,   242,   244,   249,   253,   255,   259,   261,   263,
-     265,   269,   273,   277,   281,   284,   288,   292,   296,   298,
-     300,   302,   304,   306,   308,   310,   312,   314,   318,   322,
-     324,   326,   330,   332,   334,   336,   338,   340,   342,   344,
-     346,   348,   350,   352,   358,   364,   370,   376,   378,   380,
-     382,   384,   386,   388,   393,   399,   404
+       0,   132,   132,   133,   136,   137,   140,   141,   142,   143,
+     144,   145,   146,   147,   148,   149,   150,   153,   158,   162,
+     166,   169,   174,   176,   179,   181,   184,   189,   194,   199,
+     204,   209,   212,   215,   220,   225,   228,   231,   234,   237,
+     241,   245,   249,   250,   253,   253,   253,   256,   259,   262,
+     265,   268,   271,   274,   277,   281,   285,   289,   291,   294,
+     299,   302,   316,   332,   334,   341,   343,   347,   350,   355,
+     357,   361,   365,   367,   371,   373,   375,   377,   379,   381,
+     385,   387,   389,   393,   394,   395,   396,   397,   398,   401,
+     403,   407,   409,   411,   415,   416,   417,   418,   419,   420,
+     421,   422,   423,   424,   425,   429,   431,   433,   435,   439,
+     441,   445,   445,   445,   445,   449,   452,   460,   464
 };
+#endif
 
-/* YYRHS -- A `-1'-separated list of the rules' RHS.  */
-static const yytype_int8 yyrhs[] =
-{
-      58,     0,    -1,    30,    -1,    59,    30,    -1,    60,    -1,
-      60,    59,    -1,    72,    -1,    71,    -1,    61,    -1,    66,
-      -1,    67,    -1,    69,    -1,    70,    -1,    76,    -1,    68,
-      -1,    75,    -1,    47,    39,    27,    28,    62,    28,    62,
-      28,    63,    38,    29,    -1,    33,    -1,    48,    39,    64,
-      38,    -1,    48,    39,    38,    -1,    65,    -1,    65,    28,
-      64,    -1,    33,    44,    27,    -1,    33,    -1,    52,    39,
-      27,    38,    29,    -1,    53,    39,    27,    28,    32,    38,
-      29,    -1,    54,    39,    32,    28,    27,    28,    27,    38,
-      29,    -1,    55,    39,    27,    38,    29,    -1,    56,    39,
-      27,    38,    29,    -1,    79,    29,    -1,    73,    -1,    74,
-      -1,    27,    74,    -1,    79,    31,    77,    29,    -1,    45,
-      79,    31,    77,    29,    -1,    79,    31,    45,    77,    29,
-      -1,    45,    79,    45,    31,    77,    29,    -1,    79,    31,
-      80,    29,    -1,    51,    34,    44,    -1,    46,    81,    82,
-      29,    -1,    78,    -1,    78,    28,    77,    -1,    79,    -1,
-      89,    -1,    88,    -1,    81,    82,    -1,    34,    49,    81,
-      82,    -1,    50,    81,    82,    -1,    50,    34,    49,    81,
-      82,    -1,    81,    82,    26,    34,    -1,    34,    49,    81,
-      82,    26,    34,    -1,    50,    81,    82,    26,    34,    -1,
-      50,    34,    49,    81,    82,    26,    34,    -1,   100,    39,
-      82,    28,    82,    28,    79,    38,    -1,    27,    -1,    39,
-      38,    -1,    39,    83,    38,    -1,    84,    -1,    84,    28,
-      83,    -1,    26,    98,    -1,    26,    98,    28,    83,    -1,
-      98,    -1,    99,    -1,    36,    39,    86,    38,    -1,    36,
-      39,    38,    -1,    87,    -1,    87,    28,    86,    -1,    93,
-      -1,    98,    -1,    90,    -1,    34,    25,    91,    -1,    34,
-      25,    90,    -1,    39,    90,    38,    -1,    34,    23,    96,
-      -1,    22,    90,    -1,    90,     3,    90,    -1,    90,     4,
-      90,    -1,    91,    92,    91,    -1,    93,    -1,    85,    -1,
-      98,    -1,    10,    -1,     9,    -1,    14,    -1,    12,    -1,
-      13,    -1,    11,    -1,    93,    95,    94,    -1,    94,    95,
-      94,    -1,    98,    -1,    85,    -1,    39,    93,    38,    -1,
-      16,    -1,    15,    -1,    18,    -1,    17,    -1,    21,    -1,
-      20,    -1,    19,    -1,     6,    -1,     7,    -1,     5,    -1,
-       8,    -1,    39,    97,    28,    97,    38,    -1,    39,    97,
-      28,    97,    41,    -1,    40,    97,    28,    97,    38,    -1,
-      40,    97,    28,    97,    41,    -1,    93,    -1,    98,    -1,
-      33,    -1,    34,    -1,    32,    -1,    37,    -1,   100,    12,
-      34,    14,    -1,   100,    12,    26,    34,    14,    -1,   100,
-      12,    21,    14,    -1,    35,    -1
-};
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
 
-/* YYRLINE[YYN] -- source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
-{
-       0,   125,   125,   126,   129,   130,   133,   134,   135,   136,
-     137,   138,   139,   140,   141,   142,   145,   150,   154,   157,
-     162,   164,   167,   169,   172,   177,   182,   187,   192,   197,
-     200,   203,   208,   213,   216,   219,   222,   225,   229,   233,
-     237,   238,   241,   241,   241,   244,   247,   250,   253,   256,
-     259,   262,   265,   269,   273,   277,   279,   282,   287,   290,
-     304,   320,   322,   329,   331,   335,   338,   343,   345,   349,
-     353,   355,   359,   361,   363,   365,   367,   369,   373,   375,
-     377,   381,   382,   383,   384,   385,   386,   389,   391,   395,
-     397,   399,   403,   404,   405,   406,   407,   408,   409,   410,
-     411,   412,   413,   417,   419,   421,   423,   427,   429,   433,
-     433,   433,   433,   437,   440,   448,   452
-};
-#endif
+#if YYDEBUG || 0
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
 
-#if YYDEBUG || YYERROR_VERBOSE || YYTOKEN_TABLE
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "$end", "error", "$undefined", "OL_OR", "OL_AND", "OL_BITOR",
-  "OL_BITXOR", "OL_BITAND", "OL_BITNOT", "OL_NEQ", "OL_EQ", "OL_LTE",
-  "OL_LT", "OL_GTE", "OL_GT", "OL_RSHIFT", "OL_LSHIFT", "OL_MINUS",
-  "OL_PLUS", "OL_MODULUS", "OL_DIVIDE", "OL_TIMES", "OL_NOT", "OL_IN",
-  "OL_ID", "OL_ASSIGN", "OL_AT", "OL_NAME", "OL_COMMA", "OL_DOT", "OL_EOF",
-  "OL_IF", "OL_STRING", "OL_VALUE", "OL_VAR", "OL_AGGFUNCNAME",
+  "\"end of file\"", "error", "\"invalid token\"", "OL_OR", "OL_AND",
+  "OL_BITOR", "OL_BITXOR", "OL_BITAND", "OL_BITNOT", "OL_EQ", "OL_NEQ",
+  "OL_GT", "OL_GTE", "OL_LT", "OL_LTE", "OL_LSHIFT", "OL_RSHIFT",
+  "OL_PLUS", "OL_MINUS", "OL_TIMES", "OL_DIVIDE", "OL_MODULUS", "OL_NOT",
+  "OL_IN", "OL_ID", "OL_ASSIGN", "OL_AT", "OL_NAME", "OL_COMMA", "OL_DOT",
+  "OL_EOF", "OL_IF", "OL_STRING", "OL_VALUE", "OL_VAR", "OL_AGGFUNCNAME",
   "OL_FUNCTION", "OL_NULL", "OL_RPAR", "OL_LPAR", "OL_LSQUB", "OL_RSQUB",
   "OL_LCURB", "OL_RCURB", "OL_COLON", "OL_DEL", "OL_QUERY",
   "OL_MATERIALIZE", "OL_KEYS", "OL_SAYS", "OL_ENCRYPTS", "OL_CONTEXT",
   "OL_WATCH", "OL_WATCHFINE", "OL_STAGE", "OL_TRACE", "OL_TRACETABLE",
-  "$accept", "program", "clauselist", "clause", "materialize", "tablearg",
-  "primarykeys", "keylist", "key", "watch", "watchfine", "stage", "trace",
-  "TraceTable", "fact", "rule", "namedRule", "unnamedRule", "context",
-  "query", "termlist", "term", "functor", "aggview", "functorname",
-  "functorbody", "functorargs", "functorarg", "function", "functionargs",
-  "functionarg", "select", "assign", "bool_expr", "rel_atom", "rel_oper",
-  "math_expr", "math_atom", "math_oper", "range_expr", "range_atom",
-  "atom", "aggregate", "agg_oper", 0
+  "$accept", "program", "clauselist", "clause", "materialize",
+  "annotation", "tablearg", "primarykeys", "keylist", "key", "watch",
+  "watchfine", "stage", "trace", "TraceTable", "fact", "rule", "namedRule",
+  "unnamedRule", "context", "query", "termlist", "term", "functor",
+  "aggview", "functorname", "functorbody", "functorargs", "functorarg",
+  "function", "functionargs", "functionarg", "select", "assign",
+  "bool_expr", "rel_atom", "rel_oper", "math_expr", "math_atom",
+  "math_oper", "range_expr", "range_atom", "atom", "aggregate", "agg_oper", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[YYLEX-NUM] -- Internal token number corresponding to
-   token YYLEX-NUM.  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-/* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
-{
-       0,    57,    58,    58,    59,    59,    60,    60,    60,    60,
-      60,    60,    60,    60,    60,    60,    61,    62,    63,    63,
-      64,    64,    65,    65,    66,    67,    68,    69,    70,    71,
-      72,    72,    73,    74,    74,    74,    74,    74,    75,    76,
-      77,    77,    78,    78,    78,    79,    79,    79,    79,    79,
-      79,    79,    79,    80,    81,    82,    82,    83,    83,    83,
-      83,    84,    84,    85,    85,    86,    86,    87,    87,    88,
-      89,    89,    90,    90,    90,    90,    90,    90,    91,    91,
-      91,    92,    92,    92,    92,    92,    92,    93,    93,    94,
-      94,    94,    95,    95,    95,    95,    95,    95,    95,    95,
-      95,    95,    95,    96,    96,    96,    96,    97,    97,    98,
-      98,    98,    98,    99,    99,    99,   100
-};
+#define YYPACT_NINF (-152)
+
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
+
+#define YYTABLE_NINF (-111)
+
+#define yytable_value_is_error(Yyn) \
+  0
 
-/* YYR2[YYN] -- Number of symbols composing right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
+static const yytype_int16 yypact[] =
 {
-       0,     2,     1,     2,     1,     2,     1,     1,     1,     1,
-       1,     1,     1,     1,     1,     1,    11,     1,     4,     3,
-       1,     3,     3,     1,     5,     7,     9,     5,     5,     2,
-       1,     1,     2,     4,     5,     5,     6,     4,     3,     4,
-       1,     3,     1,     1,     1,     2,     4,     3,     5,     4,
-       6,     5,     7,     8,     1,     2,     3,     1,     3,     2,
-       4,     1,     1,     4,     3,     1,     3,     1,     1,     1,
-       3,     3,     3,     3,     2,     3,     3,     3,     1,     1,
-       1,     1,     1,     1,     1,     1,     1,     3,     3,     1,
-       1,     3,     1,     1,     1,     1,     1,     1,     1,     1,
-       1,     1,     1,     5,     5,     5,     5,     1,     1,     1,
-       1,     1,     1,     4,     5,     4,     1
+      84,    67,  -152,   -19,    69,    36,     6,    44,    43,    58,
+      70,    93,   103,   118,    83,    78,    35,  -152,  -152,  -152,
+    -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,
+      73,   123,  -152,  -152,   132,   127,    36,    19,   127,   140,
+     129,   127,   124,   154,   156,   155,   163,   175,  -152,  -152,
+    -152,  -152,   119,   226,   191,   236,   127,   143,   192,   193,
+     196,    36,   199,  -152,   188,   211,   212,   203,   204,   152,
+    -152,  -152,    26,  -152,   205,  -152,   152,   143,   214,   227,
+    -152,   225,   189,  -152,  -152,    49,   202,   213,   213,   230,
+     217,    90,   229,  -152,  -152,   228,   237,  -152,  -152,   254,
+     238,   252,   257,   143,  -152,   256,   127,   258,   262,   261,
+     267,   266,   268,   273,  -152,   120,   152,   243,    18,    21,
+     269,  -152,   143,  -152,   152,   152,  -152,  -152,  -152,  -152,
+    -152,  -152,   251,  -152,  -152,  -152,  -152,  -152,  -152,  -152,
+    -152,  -152,  -152,  -152,   251,   251,   127,   271,   256,  -152,
+     166,    -2,  -152,   270,  -152,   272,  -152,   274,   277,  -152,
+    -152,   275,   278,  -152,  -152,   251,   251,  -152,    49,   202,
+    -152,   251,  -152,   276,   279,   213,    20,  -152,  -152,  -152,
+    -152,   296,  -152,  -152,  -152,  -152,  -152,   280,   166,   281,
+    -152,   294,   282,   298,  -152,  -152,   256,   283,   286,   284,
+     213,   290,    87,   292,    21,  -152,   251,   127,  -152,   293,
+    -152,   299,  -152,   295,  -152,  -152,   287,   251,   251,  -152,
+     300,  -152,  -152,   264,   297,    75,   109,    69,   285,   289,
+    -152,  -152,  -152,  -152,  -152,   291,    46,   301,  -152,   288,
+    -152,   302,   303,  -152,   306,  -152,   304,  -152,  -152
 };
 
-/* YYDEFACT[STATE-NAME] -- Default rule to reduce with in state
-   STATE-NUM when YYTABLE doesn't specify something else to do.  Zero
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
    means the default is an error.  */
-static const yytype_uint8 yydefact[] =
+static const yytype_int8 yydefact[] =
 {
-       0,    54,     2,     0,     0,     0,     0,     0,     0,     0,
+       0,    56,     2,     0,     0,     0,     0,     0,     0,     0,
        0,     0,     0,     0,     0,     0,     4,     8,     9,    10,
-      14,    11,    12,     7,     6,    30,    31,    15,    13,     0,
-       0,    54,    32,     0,     0,     0,     0,     0,     0,     0,
-       0,     0,     0,     0,     0,     0,     1,     3,     5,    29,
-       0,     0,    45,     0,     0,     0,     0,     0,     0,    47,
-      38,     0,     0,     0,     0,     0,     0,   111,   109,   110,
-     116,     0,   112,     0,     0,     0,    40,    42,     0,    79,
-      44,    43,    69,     0,    78,     0,    80,     0,     0,   110,
-      55,     0,    57,    61,    62,     0,     0,    46,     0,     0,
-      39,     0,     0,     0,     0,     0,     0,     0,     0,   110,
-      74,     0,     0,     0,     0,    78,     0,    33,     0,    37,
-       0,     0,    82,    81,    86,    84,    85,    83,     0,   101,
-      99,   100,   102,    93,    92,    95,    94,    98,    97,    96,
-       0,     0,     0,    59,    56,     0,     0,    49,     0,    34,
-       0,    17,     0,    48,    51,    24,     0,     0,    27,    28,
-       0,     0,    73,    71,    70,    64,     0,    90,     0,    65,
-      67,    89,    72,    91,    35,    41,    75,    76,    77,    87,
-      89,    88,     0,     0,    58,     0,     0,     0,    50,    36,
-       0,     0,     0,     0,   107,     0,    89,     0,     0,    63,
-       0,     0,    60,   115,     0,   113,     0,    52,    25,     0,
-       0,     0,    66,     0,   114,     0,     0,     0,     0,     0,
-       0,     0,    26,   103,   104,   105,   106,     0,     0,     0,
-      53,    23,    19,     0,    20,    16,     0,    18,     0,    22,
-      21
+      11,    15,    12,    13,     7,     6,    32,    33,    16,    14,
+       0,     0,    56,    34,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     1,     3,
+       5,    31,     0,     0,    47,     0,     0,     0,     0,     0,
+       0,     0,    49,    40,     0,     0,     0,     0,     0,     0,
+     113,   111,   112,   118,     0,   114,     0,     0,     0,    42,
+      44,     0,    81,    46,    45,    71,     0,    80,     0,    82,
+       0,     0,     0,   112,    57,     0,    59,    63,    64,     0,
+       0,    48,     0,     0,    41,     0,     0,     0,     0,     0,
+       0,     0,     0,   112,    76,     0,     0,     0,     0,    80,
+       0,    35,     0,    39,     0,     0,    83,    84,    85,    87,
+      86,    88,     0,   103,   101,   102,   104,    94,    95,    96,
+      97,    98,    99,   100,     0,     0,     0,    61,     0,    58,
+       0,     0,    51,     0,    36,     0,    19,     0,    50,    53,
+      26,     0,     0,    29,    30,     0,     0,    75,    73,    72,
+      66,     0,    92,     0,    67,    69,    91,    74,    93,    37,
+      43,    77,    78,    79,    89,    91,    90,     0,     0,     0,
+      60,     0,     0,     0,    52,    38,     0,     0,     0,     0,
+     109,     0,    91,     0,     0,    65,     0,     0,    62,     0,
+     117,     0,   115,     0,    54,    27,     0,     0,     0,    68,
+       0,    18,   116,     0,     0,     0,     0,     0,     0,     0,
+      28,   105,   106,   107,   108,     0,     0,     0,    55,    25,
+      21,     0,    22,    17,     0,    20,     0,    24,    23
+};
+
+/* YYPGOTO[NTERM-NUM].  */
+static const yytype_int16 yypgoto[] =
+{
+    -152,  -152,   305,  -152,  -152,  -152,  -135,  -152,    88,  -152,
+    -152,  -152,  -152,  -152,  -152,  -152,  -152,  -152,   334,  -152,
+    -152,   -46,  -152,     0,  -152,     7,   -36,  -141,  -152,  -111,
+     130,  -152,  -152,  -152,   -51,   -97,  -152,   -73,     4,   250,
+    -152,  -151,   -45,  -152,   307
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    14,    15,    16,    17,   152,   221,   233,   234,    18,
+       0,    14,    15,    16,    17,    18,   157,   229,   241,   242,
       19,    20,    21,    22,    23,    24,    25,    26,    27,    28,
-      75,    76,    77,    78,    30,    52,    91,    92,    79,   168,
-     169,    80,    81,    82,    83,   128,    84,    85,   140,   162,
-     195,    86,    94,    95
+      29,    78,    79,    80,    81,    35,    54,    95,    96,    82,
+     173,   174,    83,    84,    85,    86,   132,    87,    88,   144,
+     167,   201,    89,    98,    99
 };
 
-/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-   STATE-NUM.  */
-#define YYPACT_NINF -145
-static const yytype_int16 yypact[] =
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
+static const yytype_int16 yytable[] =
 {
-      24,    -4,  -145,   -35,    54,     6,    43,    16,    57,    63,
-      72,    80,    81,    82,    99,    92,   104,  -145,  -145,  -145,
-    -145,  -145,  -145,  -145,  -145,  -145,  -145,  -145,  -145,    74,
-      84,  -145,  -145,   101,     6,   -13,    84,   106,    87,    84,
-      93,   112,   113,   110,   114,   116,  -145,  -145,  -145,  -145,
-     139,   235,   120,    84,   158,   117,   124,   136,     6,   142,
-    -145,   127,   141,   149,   132,   143,   166,  -145,  -145,    -1,
-    -145,   140,  -145,   166,   158,   153,   155,  -145,   157,   205,
-    -145,  -145,    23,   290,   222,   222,   239,   148,    52,  -145,
-    -145,   163,   165,  -145,  -145,   184,   170,   180,   178,   158,
-    -145,   176,    84,   181,   185,   186,   189,   188,   202,   209,
-    -145,    70,   166,   251,    17,   109,   204,  -145,   158,  -145,
-     166,   166,  -145,  -145,  -145,  -145,  -145,  -145,   259,  -145,
-    -145,  -145,  -145,  -145,  -145,  -145,  -145,  -145,  -145,  -145,
-     259,   259,    84,   206,  -145,   245,     8,  -145,   201,  -145,
-     207,  -145,   220,   223,  -145,  -145,   212,   224,  -145,  -145,
-     259,   259,  -145,    23,   290,  -145,   259,  -145,   213,   225,
-     222,    45,  -145,  -145,  -145,  -145,   258,  -145,  -145,  -145,
-    -145,  -145,   236,   245,  -145,   249,   231,   252,  -145,  -145,
-     176,   240,   246,   254,   222,   248,    -3,   266,   109,  -145,
-     259,    84,  -145,  -145,   272,  -145,   269,  -145,  -145,   267,
-     259,   259,  -145,   278,  -145,   260,   280,    49,    60,    54,
-     268,   273,  -145,  -145,  -145,  -145,  -145,   274,    26,   281,
-    -145,   270,  -145,   275,   287,  -145,   289,  -145,   284,  -145,
-    -145
+      30,    34,    59,   119,    37,    62,   172,    31,    97,   190,
+      97,   102,    38,   189,    41,   203,    30,   191,   114,   169,
+     101,   124,   125,    31,   192,   118,   133,   134,   135,   136,
+      36,   120,   193,   172,   172,   183,   137,   138,   139,   140,
+     141,   142,   143,    56,   175,    39,   147,   208,   -70,   115,
+      57,   116,   124,   125,   172,   172,   177,   155,   -70,   178,
+     172,   213,     1,    32,    58,   168,   225,   226,   106,     3,
+     158,    32,   176,   181,   182,    36,   180,    42,    40,   239,
+       4,     5,     6,    48,   240,     7,     8,     9,    10,    11,
+      12,    13,   200,   200,    32,   172,    32,    43,   204,   185,
+     185,     3,    51,     3,    52,    97,   172,   172,    49,    44,
+     187,     1,     4,   231,     2,  -110,   232,     7,     3,     7,
+     202,   202,    70,    71,    93,  -110,   185,    75,  -110,     4,
+       5,     6,    45,   175,     7,     8,     9,    10,    11,    12,
+      13,    69,    46,    97,   200,   200,    32,   233,   184,   186,
+     234,    70,    71,    72,    73,    74,    75,    47,    76,   165,
+     166,   176,    53,    52,    77,    69,    55,    60,    63,     7,
+      32,   220,   202,   202,    69,    70,    71,    72,    61,    74,
+      75,    64,    76,    65,    70,    71,   113,    66,    74,    75,
+      67,    76,    91,     7,   -92,   -92,   -92,   -92,    70,    71,
+      93,    73,    68,    75,   -92,   -92,   -92,   -92,   -92,   -92,
+     -92,   126,   127,   128,   129,   130,   131,   100,   133,   134,
+     135,   136,   104,   103,   105,   107,   108,   235,   137,   138,
+     139,   140,   141,   142,   143,   -91,   -91,   -91,   -91,   109,
+     110,   111,   112,   121,   117,   -91,   -91,   -91,   -91,   -91,
+     -91,   -91,    91,    92,   123,   122,   146,   148,    70,    71,
+      93,    73,    91,    75,    94,   150,   149,   151,    70,    71,
+      93,    73,   152,    75,    94,    70,    71,    93,   153,    74,
+      75,   170,   171,    70,    71,    93,   154,    74,    75,   156,
+     171,   160,   159,   161,   162,   163,   115,   164,   179,   188,
+     125,   195,   196,   197,   194,   210,   199,   206,   207,   212,
+     222,   216,   228,   198,   205,   215,   211,   214,   217,   209,
+     218,    50,   221,   223,   236,   224,   230,   237,   227,   238,
+     243,   246,   244,   247,   248,    33,   219,   239,   145,     0,
+     245,     0,     0,     0,     0,     0,     0,     0,     0,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,     0,    90
 };
 
-/* YYPGOTO[NTERM-NUM].  */
-static const yytype_int16 yypgoto[] =
+static const yytype_int16 yycheck[] =
 {
-    -145,  -145,   302,  -145,  -145,   129,  -145,    83,  -145,  -145,
-    -145,  -145,  -145,  -145,  -145,  -145,  -145,   319,  -145,  -145,
-     -46,  -145,     0,  -145,     5,   -34,  -134,  -145,  -104,   122,
-    -145,  -145,  -145,   -60,   -97,  -145,   -66,   -96,   238,  -145,
-    -144,   -48,  -145,   276
+       0,     1,    38,    76,     4,    41,   117,     0,    53,   150,
+      55,    57,     5,   148,     7,   166,    16,    19,    69,   116,
+      56,     3,     4,    16,    26,    76,     5,     6,     7,     8,
+      49,    77,    34,   144,   145,   132,    15,    16,    17,    18,
+      19,    20,    21,    36,   117,    39,    91,   188,    28,    23,
+      31,    25,     3,     4,   165,   166,    38,   103,    38,    38,
+     171,   196,    27,    27,    45,   116,   217,   218,    61,    34,
+     106,    27,   117,   124,   125,    49,   122,    34,    34,    33,
+      45,    46,    47,     0,    38,    50,    51,    52,    53,    54,
+      55,    56,   165,   166,    27,   206,    27,    39,   171,   144,
+     145,    34,    29,    34,    31,   150,   217,   218,    30,    39,
+     146,    27,    45,    38,    30,    28,    41,    50,    34,    50,
+     165,   166,    32,    33,    34,    38,   171,    37,    41,    45,
+      46,    47,    39,   206,    50,    51,    52,    53,    54,    55,
+      56,    22,    39,   188,   217,   218,    27,    38,   144,   145,
+      41,    32,    33,    34,    35,    36,    37,    39,    39,    39,
+      40,   206,    39,    31,    45,    22,    39,    27,    44,    50,
+      27,   207,   217,   218,    22,    32,    33,    34,    49,    36,
+      37,    27,    39,    27,    32,    33,    34,    32,    36,    37,
+      27,    39,    26,    50,     5,     6,     7,     8,    32,    33,
+      34,    35,    27,    37,    15,    16,    17,    18,    19,    20,
+      21,     9,    10,    11,    12,    13,    14,    26,     5,     6,
+       7,     8,    29,    31,    28,    26,    38,   227,    15,    16,
+      17,    18,    19,    20,    21,     5,     6,     7,     8,    28,
+      28,    38,    38,    29,    39,    15,    16,    17,    18,    19,
+      20,    21,    26,    27,    29,    28,    39,    28,    32,    33,
+      34,    35,    26,    37,    38,    28,    38,    13,    32,    33,
+      34,    35,    34,    37,    38,    32,    33,    34,    26,    36,
+      37,    38,    39,    32,    33,    34,    29,    36,    37,    33,
+      39,    29,    34,    32,    27,    29,    23,    29,    29,    28,
+       4,    29,    28,    26,    34,    11,    28,    28,    28,    11,
+      11,    27,    48,    38,    38,    29,    34,    34,    28,    38,
+      28,    16,    29,    28,    39,    38,    29,    38,    28,    38,
+      29,    28,    44,    27,   246,     1,   206,    33,    88,    -1,
+      38,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,
+      -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    -1,    52
 };
 
-/* YYTABLE[YYPACT[STATE-NUM]].  What to do in state STATE-NUM.  If
-   positive, shift that token.  If negative, reduce the rule which
-   number is the opposite.  If zero, do what YYDEFACT says.
-   If YYTABLE_NINF, syntax error.  */
-#define YYTABLE_NINF -109
-static const yytype_int16 yytable[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
-      29,    33,    56,    93,    35,    59,   110,   115,    98,   167,
-      36,   184,    39,   114,    34,   164,    29,   197,    54,    97,
-     120,   121,   111,    31,   112,  -108,   120,   121,   116,   185,
-       3,   178,    55,    31,   186,  -108,   167,   167,  -108,    53,
-     143,     4,   187,    31,   179,   181,     7,   170,    34,   202,
-      38,     1,   163,   150,     2,   172,   167,   167,     3,   231,
-     176,   177,   167,   102,   232,   171,   217,   218,   153,     4,
-       5,     6,   175,   -68,     7,     8,     9,    10,    11,    12,
-      13,    31,    37,   -68,    67,    68,    89,   223,     3,    72,
-     224,    40,   180,   180,   194,   194,   167,    93,   225,    46,
-     198,   226,    41,    49,     7,    50,   167,   167,   182,   160,
-     161,    42,   196,   196,   129,   130,   131,   132,   180,    43,
-      44,    45,    47,    51,   133,   134,   135,   136,   137,   138,
-     139,     1,    50,    57,   170,    93,    58,    60,     3,    61,
-      62,    64,    63,    65,   194,   194,    96,   173,    99,     4,
-       5,     6,   171,   100,     7,     8,     9,    10,    11,    12,
-      13,    66,   196,   196,   101,   104,    31,   213,   103,   105,
-     107,    67,    68,    69,    70,    71,    72,   106,    73,   113,
-      66,   108,   117,   118,    74,    31,   119,   142,    66,     7,
-      67,    68,    69,   145,    71,    72,   146,    73,    67,    68,
-     109,   144,    71,    72,   147,    73,   148,   149,     7,   151,
-     -90,   -90,   -90,   -90,   155,   154,   157,   158,   156,   227,
-     -90,   -90,   -90,   -90,   -90,   -90,   -90,   129,   130,   131,
-     132,   159,   111,   174,   183,   188,   189,   133,   134,   135,
-     136,   137,   138,   139,   -89,   -89,   -89,   -89,   190,   191,
-     192,   199,   193,   200,   -89,   -89,   -89,   -89,   -89,   -89,
-     -89,    88,   121,   203,   201,   204,   205,    67,    68,    89,
-      70,    88,    72,    90,   207,   208,   210,    67,    68,    89,
-      70,   209,    72,    67,    68,    89,   214,    71,    72,   165,
-     166,    67,    68,    89,   211,    71,    72,   215,   166,   122,
-     123,   124,   125,   126,   127,   216,   219,   228,   220,   222,
-     235,   229,   230,   237,   236,   238,   239,   231,    48,   206,
-      32,   240,   212,   141,     0,     0,    87
+       0,    27,    30,    34,    45,    46,    47,    50,    51,    52,
+      53,    54,    55,    56,    58,    59,    60,    61,    62,    67,
+      68,    69,    70,    71,    72,    73,    74,    75,    76,    77,
+      80,    82,    27,    75,    80,    82,    49,    80,    82,    39,
+      34,    82,    34,    39,    39,    39,    39,    39,     0,    30,
+      59,    29,    31,    39,    83,    39,    82,    31,    45,    83,
+      27,    49,    83,    44,    27,    27,    32,    27,    27,    22,
+      32,    33,    34,    35,    36,    37,    39,    45,    78,    79,
+      80,    81,    86,    89,    90,    91,    92,    94,    95,    99,
+     101,    26,    27,    34,    38,    84,    85,    99,   100,   101,
+      26,    83,    78,    31,    29,    28,    82,    26,    38,    28,
+      28,    38,    38,    34,    91,    23,    25,    39,    91,    94,
+      78,    29,    28,    29,     3,     4,     9,    10,    11,    12,
+      13,    14,    93,     5,     6,     7,     8,    15,    16,    17,
+      18,    19,    20,    21,    96,    96,    39,    99,    28,    38,
+      28,    13,    34,    26,    29,    78,    33,    63,    83,    34,
+      29,    32,    27,    29,    29,    39,    40,    97,    91,    92,
+      38,    39,    86,    87,    88,    94,    99,    38,    38,    29,
+      78,    91,    91,    92,    95,    99,    95,    83,    28,    63,
+      84,    19,    26,    34,    34,    29,    28,    26,    38,    28,
+      94,    98,    99,    98,    94,    38,    28,    28,    84,    38,
+      11,    34,    11,    63,    34,    29,    27,    28,    28,    87,
+      83,    29,    11,    28,    38,    98,    98,    28,    48,    64,
+      29,    38,    41,    38,    41,    80,    39,    38,    38,    33,
+      38,    65,    66,    29,    44,    38,    28,    27,    65
 };
 
-static const yytype_int16 yycheck[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
-       0,     1,    36,    51,     4,    39,    66,    73,    54,   113,
-       5,   145,     7,    73,    49,   112,    16,   161,    31,    53,
-       3,     4,    23,    27,    25,    28,     3,     4,    74,    21,
-      34,   128,    45,    27,    26,    38,   140,   141,    41,    34,
-      88,    45,    34,    27,   140,   141,    50,   113,    49,   183,
-      34,    27,   112,    99,    30,    38,   160,   161,    34,    33,
-     120,   121,   166,    58,    38,   113,   210,   211,   102,    45,
-      46,    47,   118,    28,    50,    51,    52,    53,    54,    55,
-      56,    27,    39,    38,    32,    33,    34,    38,    34,    37,
-      41,    34,   140,   141,   160,   161,   200,   145,    38,     0,
-     166,    41,    39,    29,    50,    31,   210,   211,   142,    39,
-      40,    39,   160,   161,     5,     6,     7,     8,   166,    39,
-      39,    39,    30,    39,    15,    16,    17,    18,    19,    20,
-      21,    27,    31,    27,   200,   183,    49,    44,    34,    27,
-      27,    27,    32,    27,   210,   211,    26,    38,    31,    45,
-      46,    47,   200,    29,    50,    51,    52,    53,    54,    55,
-      56,    22,   210,   211,    28,    38,    27,   201,    26,    28,
-      38,    32,    33,    34,    35,    36,    37,    28,    39,    39,
-      22,    38,    29,    28,    45,    27,    29,    39,    22,    50,
-      32,    33,    34,    28,    36,    37,    12,    39,    32,    33,
-      34,    38,    36,    37,    34,    39,    26,    29,    50,    33,
-       5,     6,     7,     8,    29,    34,    27,    29,    32,   219,
-      15,    16,    17,    18,    19,    20,    21,     5,     6,     7,
-       8,    29,    23,    29,    28,    34,    29,    15,    16,    17,
-      18,    19,    20,    21,     5,     6,     7,     8,    28,    26,
-      38,    38,    28,    28,    15,    16,    17,    18,    19,    20,
-      21,    26,     4,    14,    28,    34,    14,    32,    33,    34,
-      35,    26,    37,    38,    34,    29,    28,    32,    33,    34,
-      35,    27,    37,    32,    33,    34,    14,    36,    37,    38,
-      39,    32,    33,    34,    28,    36,    37,    28,    39,     9,
-      10,    11,    12,    13,    14,    38,    28,    39,    48,    29,
-      29,    38,    38,    38,    44,    28,    27,    33,    16,   190,
-       1,   238,   200,    85,    -1,    -1,    50
+       0,    57,    58,    58,    59,    59,    60,    60,    60,    60,
+      60,    60,    60,    60,    60,    60,    60,    61,    62,    63,
+      64,    64,    65,    65,    66,    66,    67,    68,    69,    70,
+      71,    72,    73,    73,    74,    75,    75,    75,    75,    75,
+      76,    77,    78,    78,    79,    79,    79,    80,    80,    80,
+      80,    80,    80,    80,    80,    81,    82,    83,    83,    84,
+      84,    84,    84,    85,    85,    86,    86,    87,    87,    88,
+      88,    89,    90,    90,    91,    91,    91,    91,    91,    91,
+      92,    92,    92,    93,    93,    93,    93,    93,    93,    94,
+      94,    95,    95,    95,    96,    96,    96,    96,    96,    96,
+      96,    96,    96,    96,    96,    97,    97,    97,    97,    98,
+      98,    99,    99,    99,    99,   100,   100,   100,   101
 };
 
-/* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-   symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
-       0,    27,    30,    34,    45,    46,    47,    50,    51,    52,
-      53,    54,    55,    56,    58,    59,    60,    61,    66,    67,
-      68,    69,    70,    71,    72,    73,    74,    75,    76,    79,
-      81,    27,    74,    79,    49,    79,    81,    39,    34,    81,
-      34,    39,    39,    39,    39,    39,     0,    30,    59,    29,
-      31,    39,    82,    81,    31,    45,    82,    27,    49,    82,
-      44,    27,    27,    32,    27,    27,    22,    32,    33,    34,
-      35,    36,    37,    39,    45,    77,    78,    79,    80,    85,
-      88,    89,    90,    91,    93,    94,    98,   100,    26,    34,
-      38,    83,    84,    98,    99,   100,    26,    82,    77,    31,
-      29,    28,    81,    26,    38,    28,    28,    38,    38,    34,
-      90,    23,    25,    39,    90,    93,    77,    29,    28,    29,
-       3,     4,     9,    10,    11,    12,    13,    14,    92,     5,
-       6,     7,     8,    15,    16,    17,    18,    19,    20,    21,
-      95,    95,    39,    98,    38,    28,    12,    34,    26,    29,
-      77,    33,    62,    82,    34,    29,    32,    27,    29,    29,
-      39,    40,    96,    90,    91,    38,    39,    85,    86,    87,
-      93,    98,    38,    38,    29,    77,    90,    90,    91,    94,
-      98,    94,    82,    28,    83,    21,    26,    34,    34,    29,
-      28,    26,    38,    28,    93,    97,    98,    97,    93,    38,
-      28,    28,    83,    14,    34,    14,    62,    34,    29,    27,
-      28,    28,    86,    82,    14,    28,    38,    97,    97,    28,
-      48,    63,    29,    38,    41,    38,    41,    79,    39,    38,
-      38,    33,    38,    64,    65,    29,    44,    38,    28,    27,
-      64
+       0,     2,     1,     2,     1,     2,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     1,     1,    11,     7,     1,
+       4,     3,     1,     3,     3,     1,     5,     7,     9,     5,
+       5,     2,     1,     1,     2,     4,     5,     5,     6,     4,
+       3,     4,     1,     3,     1,     1,     1,     2,     4,     3,
+       5,     4,     6,     5,     7,     8,     1,     2,     3,     1,
+       3,     2,     4,     1,     1,     4,     3,     1,     3,     1,
+       1,     1,     3,     3,     3,     3,     2,     3,     3,     3,
+       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
+       3,     1,     1,     3,     1,     1,     1,     1,     1,     1,
+       1,     1,     1,     1,     1,     5,     5,     5,     5,     1,
+       1,     1,     1,     1,     1,     4,     5,     4,     1
 };
 
-#define yyerrok		(yyerrstatus = 0)
-#define yyclearin	(yychar = YYEMPTY)
-#define YYEMPTY		(-2)
-#define YYEOF		0
 
-#define YYACCEPT	goto yyacceptlab
-#define YYABORT		goto yyabortlab
-#define YYERROR		goto yyerrorlab
+enum { YYENOMEM = -2 };
 
+#define yyerrok         (yyerrstatus = 0)
+#define yyclearin       (yychar = YYEMPTY)
 
-/* Like YYERROR except do call yyerror.  This remains here temporarily
-   to ease the transition to the new meaning of YYERROR, for GCC.
-   Once GCC version 2 has supplanted version 1, this can go.  */
+#define YYACCEPT        goto yyacceptlab
+#define YYABORT         goto yyabortlab
+#define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
-#define YYFAIL		goto yyerrlab
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)					\
-do								\
-  if (yychar == YYEMPTY && yylen == 1)				\
-    {								\
-      yychar = (Token);						\
-      yylval = (Value);						\
-      yytoken = YYTRANSLATE (yychar);				\
-      YYPOPSTACK (1);						\
-      goto yybackup;						\
-    }								\
-  else								\
-    {								\
-      yyerror (ctxt, YY_("syntax error: cannot back up")); \
-      YYERROR;							\
-    }								\
-while (YYID (0))
-
-
-#define YYTERROR	1
-#define YYERRCODE	256
-
-
-/* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
-   If N is 0, then set CURRENT to the empty location which ends
-   the previous symbol: RHS[0] (always defined).  */
-
-#define YYRHSLOC(Rhs, K) ((Rhs)[K])
-#ifndef YYLLOC_DEFAULT
-# define YYLLOC_DEFAULT(Current, Rhs, N)				\
-    do									\
-      if (YYID (N))                                                    \
-	{								\
-	  (Current).first_line   = YYRHSLOC (Rhs, 1).first_line;	\
-	  (Current).first_column = YYRHSLOC (Rhs, 1).first_column;	\
-	  (Current).last_line    = YYRHSLOC (Rhs, N).last_line;		\
-	  (Current).last_column  = YYRHSLOC (Rhs, N).last_column;	\
-	}								\
-      else								\
-	{								\
-	  (Current).first_line   = (Current).last_line   =		\
-	    YYRHSLOC (Rhs, 0).last_line;				\
-	  (Current).first_column = (Current).last_column =		\
-	    YYRHSLOC (Rhs, 0).last_column;				\
-	}								\
-    while (YYID (0))
-#endif
-
-
-/* YY_LOCATION_PRINT -- Print the location on the stream.
-   This macro was not mandated originally: define only if we know
-   we won't break user code: when these are the locations we know.  */
-
-#ifndef YY_LOCATION_PRINT
-# if YYLTYPE_IS_TRIVIAL
-#  define YY_LOCATION_PRINT(File, Loc)			\
-     fprintf (File, "%d.%d-%d.%d",			\
-	      (Loc).first_line, (Loc).first_column,	\
-	      (Loc).last_line,  (Loc).last_column)
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (ctxt, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 
-/* YYLEX -- calling `yylex' with the right arguments.  */
-
-#ifdef YYLEX_PARAM
-# define YYLEX yylex (&yylval, YYLEX_PARAM)
-#else
-# define YYLEX yylex (&yylval, ctxt)
-#endif
-
 /* Enable debugging if requested.  */
 #if YYDEBUG
 
@@ -996,83 +968,59 @@ while (YYID (0))
 #  define YYFPRINTF fprintf
 # endif
 
-# define YYDPRINTF(Args)			\
-do {						\
-  if (yydebug)					\
-    YYFPRINTF Args;				\
-} while (YYID (0))
-
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)			  \
-do {									  \
-  if (yydebug)								  \
-    {									  \
-      YYFPRINTF (stderr, "%s ", Title);					  \
-      yy_symbol_print (stderr,						  \
-		  Type, Value, ctxt); \
-      YYFPRINTF (stderr, "\n");						  \
-    }									  \
-} while (YYID (0))
-
-
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
-
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, OlContext *ctxt)
-#else
+# define YYDPRINTF(Args)                        \
+do {                                            \
+  if (yydebug)                                  \
+    YYFPRINTF Args;                             \
+} while (0)
+
+
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
+do {                                                                      \
+  if (yydebug)                                                            \
+    {                                                                     \
+      YYFPRINTF (stderr, "%s ", Title);                                   \
+      yy_symbol_print (stderr,                                            \
+                  Kind, Value, ctxt); \
+      YYFPRINTF (stderr, "\n");                                           \
+    }                                                                     \
+} while (0)
+
+
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
+
 static void
-yy_symbol_value_print (yyoutput, yytype, yyvaluep, ctxt)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    OlContext *ctxt;
-#endif
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, ns3::rapidnet_compiler::OlContext *ctxt)
 {
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (ctxt);
   if (!yyvaluep)
     return;
-  YYUSE (ctxt);
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# else
-  YYUSE (yyoutput);
-# endif
-  switch (yytype)
-    {
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, OlContext *ctxt)
-#else
-static void
-yy_symbol_print (yyoutput, yytype, yyvaluep, ctxt)
-    FILE *yyoutput;
-    int yytype;
-    YYSTYPE const * const yyvaluep;
-    OlContext *ctxt;
-#endif
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, ns3::rapidnet_compiler::OlContext *ctxt)
 {
-  if (yytype < YYNTOKENS)
-    YYFPRINTF (yyoutput, "token %s (", yytname[yytype]);
-  else
-    YYFPRINTF (yyoutput, "nterm %s (", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, ctxt);
-  YYFPRINTF (yyoutput, ")");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, ctxt);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1080,81 +1028,68 @@ yy_symbol_print (yyoutput, yytype, yyvaluep, ctxt)
 | TOP (included).                                                   |
 `------------------------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static void
-yy_stack_print (yytype_int16 *bottom, yytype_int16 *top)
-#else
 static void
-yy_stack_print (bottom, top)
-    yytype_int16 *bottom;
-    yytype_int16 *top;
-#endif
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
-  for (; bottom <= top; ++bottom)
-    YYFPRINTF (stderr, " %d", *bottom);
+  for (; yybottom <= yytop; yybottom++)
+    {
+      int yybot = *yybottom;
+      YYFPRINTF (stderr, " %d", yybot);
+    }
   YYFPRINTF (stderr, "\n");
 }
 
-# define YY_STACK_PRINT(Bottom, Top)				\
-do {								\
-  if (yydebug)							\
-    yy_stack_print ((Bottom), (Top));				\
-} while (YYID (0))
+# define YY_STACK_PRINT(Bottom, Top)                            \
+do {                                                            \
+  if (yydebug)                                                  \
+    yy_stack_print ((Bottom), (Top));                           \
+} while (0)
 
 
 /*------------------------------------------------.
 | Report that the YYRULE is going to be reduced.  |
 `------------------------------------------------*/
 
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yy_reduce_print (YYSTYPE *yyvsp, int yyrule, OlContext *ctxt)
-#else
-static void
-yy_reduce_print (yyvsp, yyrule, ctxt)
-    YYSTYPE *yyvsp;
-    int yyrule;
-    OlContext *ctxt;
-#endif
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, ns3::rapidnet_compiler::OlContext *ctxt)
 {
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  unsigned long int yylno = yyrline[yyrule];
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
-	     yyrule - 1, yylno);
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
+             yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
-      fprintf (stderr, "   $%d = ", yyi + 1);
-      yy_symbol_print (stderr, yyrhs[yyprhs[yyrule] + yyi],
-		       &(yyvsp[(yyi + 1) - (yynrhs)])
-		       		       , ctxt);
-      fprintf (stderr, "\n");
+      YYFPRINTF (stderr, "   $%d = ", yyi + 1);
+      yy_symbol_print (stderr,
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], ctxt);
+      YYFPRINTF (stderr, "\n");
     }
 }
 
-# define YY_REDUCE_PRINT(Rule)		\
-do {					\
-  if (yydebug)				\
-    yy_reduce_print (yyvsp, Rule, ctxt); \
-} while (YYID (0))
+# define YY_REDUCE_PRINT(Rule)          \
+do {                                    \
+  if (yydebug)                          \
+    yy_reduce_print (yyssp, yyvsp, Rule, ctxt); \
+} while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
 
 
 /* YYINITDEPTH -- initial size of the parser's stacks.  */
-#ifndef	YYINITDEPTH
+#ifndef YYINITDEPTH
 # define YYINITDEPTH 200
 #endif
 
@@ -1169,268 +1104,29 @@ int yydebug;
 # define YYMAXDEPTH 10000
 #endif
 
-
 
-#if YYERROR_VERBOSE
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
-/* Return the length of YYSTR.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static YYSIZE_T
-yystrlen (const char *yystr)
-#else
-static YYSIZE_T
-yystrlen (yystr)
-    const char *yystr;
-#endif
-{
-  YYSIZE_T yylen;
-  for (yylen = 0; yystr[yylen]; yylen++)
-    continue;
-  return yylen;
-}
-#  endif
-# endif
-
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
-/* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
-   YYDEST.  */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-static char *
-yystpcpy (char *yydest, const char *yysrc)
-#else
-static char *
-yystpcpy (yydest, yysrc)
-    char *yydest;
-    const char *yysrc;
-#endif
-{
-  char *yyd = yydest;
-  const char *yys = yysrc;
-
-  while ((*yyd++ = *yys++) != '\0')
-    continue;
 
-  return yyd - 1;
-}
-#  endif
-# endif
 
-# ifndef yytnamerr
-/* Copy to YYRES the contents of YYSTR after stripping away unnecessary
-   quotes and backslashes, so that it's suitable for yyerror.  The
-   heuristic is that double-quoting is unnecessary unless the string
-   contains an apostrophe, a comma, or backslash (other than
-   backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
-   null, do not copy; instead, return the length of what the result
-   would have been.  */
-static YYSIZE_T
-yytnamerr (char *yyres, const char *yystr)
-{
-  if (*yystr == '"')
-    {
-      YYSIZE_T yyn = 0;
-      char const *yyp = yystr;
-
-      for (;;)
-	switch (*++yyp)
-	  {
-	  case '\'':
-	  case ',':
-	    goto do_not_strip_quotes;
-
-	  case '\\':
-	    if (*++yyp != '\\')
-	      goto do_not_strip_quotes;
-	    /* Fall through.  */
-	  default:
-	    if (yyres)
-	      yyres[yyn] = *yyp;
-	    yyn++;
-	    break;
-
-	  case '"':
-	    if (yyres)
-	      yyres[yyn] = '\0';
-	    return yyn;
-	  }
-    do_not_strip_quotes: ;
-    }
-
-  if (! yyres)
-    return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
-}
-# endif
-
-/* Copy into YYRESULT an error message about the unexpected token
-   YYCHAR while in state YYSTATE.  Return the number of bytes copied,
-   including the terminating null byte.  If YYRESULT is null, do not
-   copy anything; just return the number of bytes that would be
-   copied.  As a special case, return 0 if an ordinary "syntax error"
-   message will do.  Return YYSIZE_MAXIMUM if overflow occurs during
-   size calculation.  */
-static YYSIZE_T
-yysyntax_error (char *yyresult, int yystate, int yychar)
-{
-  int yyn = yypact[yystate];
-
-  if (! (YYPACT_NINF < yyn && yyn <= YYLAST))
-    return 0;
-  else
-    {
-      int yytype = YYTRANSLATE (yychar);
-      YYSIZE_T yysize0 = yytnamerr (0, yytname[yytype]);
-      YYSIZE_T yysize = yysize0;
-      YYSIZE_T yysize1;
-      int yysize_overflow = 0;
-      enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-      char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-      int yyx;
-
-# if 0
-      /* This is so xgettext sees the translatable formats that are
-	 constructed on the fly.  */
-      YY_("syntax error, unexpected %s");
-      YY_("syntax error, unexpected %s, expecting %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s");
-      YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s");
-# endif
-      char *yyfmt;
-      char const *yyf;
-      static char const yyunexpected[] = "syntax error, unexpected %s";
-      static char const yyexpecting[] = ", expecting %s";
-      static char const yyor[] = " or %s";
-      char yyformat[sizeof yyunexpected
-		    + sizeof yyexpecting - 1
-		    + ((YYERROR_VERBOSE_ARGS_MAXIMUM - 2)
-		       * (sizeof yyor - 1))];
-      char const *yyprefix = yyexpecting;
-
-      /* Start YYX at -YYN if negative to avoid negative indexes in
-	 YYCHECK.  */
-      int yyxbegin = yyn < 0 ? -yyn : 0;
-
-      /* Stay within bounds of both yycheck and yytname.  */
-      int yychecklim = YYLAST - yyn + 1;
-      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-      int yycount = 1;
-
-      yyarg[0] = yytname[yytype];
-      yyfmt = yystpcpy (yyformat, yyunexpected);
-
-      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-	if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR)
-	  {
-	    if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-	      {
-		yycount = 1;
-		yysize = yysize0;
-		yyformat[sizeof yyunexpected - 1] = '\0';
-		break;
-	      }
-	    yyarg[yycount++] = yytname[yyx];
-	    yysize1 = yysize + yytnamerr (0, yytname[yyx]);
-	    yysize_overflow |= (yysize1 < yysize);
-	    yysize = yysize1;
-	    yyfmt = yystpcpy (yyfmt, yyprefix);
-	    yyprefix = yyor;
-	  }
-
-      yyf = YY_(yyformat);
-      yysize1 = yysize + yystrlen (yyf);
-      yysize_overflow |= (yysize1 < yysize);
-      yysize = yysize1;
-
-      if (yysize_overflow)
-	return YYSIZE_MAXIMUM;
-
-      if (yyresult)
-	{
-	  /* Avoid sprintf, as that infringes on the user's name space.
-	     Don't have undefined behavior even if the translation
-	     produced a string with the wrong number of "%s"s.  */
-	  char *yyp = yyresult;
-	  int yyi = 0;
-	  while ((*yyp = *yyf) != '\0')
-	    {
-	      if (*yyp == '%' && yyf[1] == 's' && yyi < yycount)
-		{
-		  yyp += yytnamerr (yyp, yyarg[yyi++]);
-		  yyf += 2;
-		}
-	      else
-		{
-		  yyp++;
-		  yyf++;
-		}
-	    }
-	}
-      return yysize;
-    }
-}
-#endif /* YYERROR_VERBOSE */
-
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
-/*ARGSUSED*/
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, OlContext *ctxt)
-#else
-static void
-yydestruct (yymsg, yytype, yyvaluep, ctxt)
-    const char *yymsg;
-    int yytype;
-    YYSTYPE *yyvaluep;
-    OlContext *ctxt;
-#endif
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, ns3::rapidnet_compiler::OlContext *ctxt)
 {
-  YYUSE (yyvaluep);
-  YYUSE (ctxt);
-
+  YY_USE (yyvaluep);
+  YY_USE (ctxt);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
-
-  switch (yytype)
-    {
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
-      default:
-	break;
-    }
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
-
-
-/* Prevent warnings from -Wmissing-prototypes.  */
-
-#ifdef YYPARSE_PARAM
-#if defined __STDC__ || defined __cplusplus
-int yyparse (void *YYPARSE_PARAM);
-#else
-int yyparse ();
-#endif
-#else /* ! YYPARSE_PARAM */
-#if defined __STDC__ || defined __cplusplus
-int yyparse (OlContext *ctxt);
-#else
-int yyparse ();
-#endif
-#endif /* ! YYPARSE_PARAM */
 
 
 
@@ -1441,208 +1137,193 @@ int yyparse ();
 | yyparse.  |
 `----------*/
 
-#ifdef YYPARSE_PARAM
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
-int
-yyparse (void *YYPARSE_PARAM)
-#else
-int
-yyparse (YYPARSE_PARAM)
-    void *YYPARSE_PARAM;
-#endif
-#else /* ! YYPARSE_PARAM */
-#if (defined __STDC__ || defined __C99__FUNC__ \
-     || defined __cplusplus || defined _MSC_VER)
 int
-yyparse (OlContext *ctxt)
-#else
-int
-yyparse (ctxt)
-    OlContext *ctxt;
-#endif
-#endif
+yyparse (ns3::rapidnet_compiler::OlContext *ctxt)
 {
-  /* The look-ahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
-/* The semantic value of the look-ahead symbol.  */
-YYSTYPE yylval;
-
-/* Number of syntax errors so far.  */
-int yynerrs;
 
-  int yystate;
-  int yyn;
-  int yyresult;
-  /* Number of tokens to shift before error messages enabled.  */
-  int yyerrstatus;
-  /* Look-ahead token as an internal (translated) token number.  */
-  int yytoken = 0;
-#if YYERROR_VERBOSE
-  /* Buffer for error messages, and its allocated size.  */
-  char yymsgbuf[128];
-  char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
 
-  /* Three stacks and their tools:
-     `yyss': related to states,
-     `yyvs': related to semantic values,
-     `yyls': related to locations.
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
 
-     Refer to the stacks thru separate pointers, to allow yyoverflow
-     to reallocate them elsewhere.  */
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
 
-  /* The state stack.  */
-  yytype_int16 yyssa[YYINITDEPTH];
-  yytype_int16 *yyss = yyssa;
-  yytype_int16 *yyssp;
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
+       to reallocate them elsewhere.  */
 
-  /* The semantic value stack.  */
-  YYSTYPE yyvsa[YYINITDEPTH];
-  YYSTYPE *yyvs = yyvsa;
-  YYSTYPE *yyvsp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
+    /* The semantic value stack: array, bottom, top.  */
+    YYSTYPE yyvsa[YYINITDEPTH];
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
-
-  YYSIZE_T yystacksize = YYINITDEPTH;
-
+  int yyn;
+  /* The return value of yyparse.  */
+  int yyresult;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
 
+
+#define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
+
   /* The number of symbols on the RHS of the reduced rule.
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY;		/* Cause a token to be read.  */
-
-  /* Initialize stack pointers.
-     Waste one element of value and location stack
-     so that they stay on the same level as the state stack.
-     The wasted elements are never initialized.  */
-
-  yyssp = yyss;
-  yyvsp = yyvs;
+  yychar = YYEMPTY; /* Cause a token to be read.  */
 
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
-	/* Give user a chance to reallocate the stack.  Use copies of
-	   these so that the &'s don't force the real ones into
-	   memory.  */
-	YYSTYPE *yyvs1 = yyvs;
-	yytype_int16 *yyss1 = yyss;
-
-
-	/* Each stack pointer address is followed by the size of the
-	   data in use in that stack, in bytes.  This used to be a
-	   conditional around just the two extra args, but that might
-	   be undefined if yyoverflow is a macro.  */
-	yyoverflow (YY_("memory exhausted"),
-		    &yyss1, yysize * sizeof (*yyssp),
-		    &yyvs1, yysize * sizeof (*yyvsp),
-
-		    &yystacksize);
-
-	yyss = yyss1;
-	yyvs = yyvs1;
+        /* Give user a chance to reallocate the stack.  Use copies of
+           these so that the &'s don't force the real ones into
+           memory.  */
+        yy_state_t *yyss1 = yyss;
+        YYSTYPE *yyvs1 = yyvs;
+
+        /* Each stack pointer address is followed by the size of the
+           data in use in that stack, in bytes.  This used to be a
+           conditional around just the two extra args, but that might
+           be undefined if yyoverflow is a macro.  */
+        yyoverflow (YY_("memory exhausted"),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yystacksize);
+        yyss = yyss1;
+        yyvs = yyvs1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-	goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
-	yystacksize = YYMAXDEPTH;
+        yystacksize = YYMAXDEPTH;
 
       {
-	yytype_int16 *yyss1 = yyss;
-	union yyalloc *yyptr =
-	  (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
-	if (! yyptr)
-	  goto yyexhaustedlab;
-	YYSTACK_RELOCATE (yyss);
-	YYSTACK_RELOCATE (yyvs);
-
+        yy_state_t *yyss1 = yyss;
+        union yyalloc *yyptr =
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
+        if (! yyptr)
+          YYNOMEM;
+        YYSTACK_RELOCATE (yyss_alloc, yyss);
+        YYSTACK_RELOCATE (yyvs_alloc, yyvs);
 #  undef YYSTACK_RELOCATE
-	if (yyss1 != yyssa)
-	  YYSTACK_FREE (yyss1);
+        if (yyss1 != yyssa)
+          YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
 
-
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-		  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
-	YYABORT;
+        YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+
+  if (yystate == YYFINAL)
+    YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
-     look-ahead token if we need one and don't already have one.  */
+     lookahead token if we need one and don't already have one.  */
 
-  /* First try to decide what to do without reference to look-ahead token.  */
+  /* First try to decide what to do without reference to lookahead token.  */
   yyn = yypact[yystate];
-  if (yyn == YYPACT_NINF)
+  if (yypact_value_is_default (yyn))
     goto yydefault;
 
-  /* Not known => get a look-ahead token if don't already have one.  */
+  /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid look-ahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = YYLEX;
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, ctxt);
     }
 
   if (yychar <= YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1657,30 +1338,26 @@ yybackup:
   yyn = yytable[yyn];
   if (yyn <= 0)
     {
-      if (yyn == 0 || yyn == YYTABLE_NINF)
-	goto yyerrlab;
+      if (yytable_value_is_error (yyn))
+        goto yyerrlab;
       yyn = -yyn;
       goto yyreduce;
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
   /* Count tokens shifted since error; after three, turn off error
      status.  */
   if (yyerrstatus)
     yyerrstatus--;
 
-  /* Shift the look-ahead token.  */
+  /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token unless it is eof.  */
-  if (yychar != YYEOF)
-    yychar = YYEMPTY;
-
   yystate = yyn;
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -1695,14 +1372,14 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
   yylen = yyr2[yyn];
 
   /* If YYLEN is nonzero, implement the default value of the action:
-     `$$ = $1'.
+     '$$ = $1'.
 
      Otherwise, the following line sets YYVAL to garbage.
      This behavior is undocumented and Bison
@@ -1715,252 +1392,301 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 125 "src/rapidnet-compiler/ol-parser.y"
-    { YYACCEPT; }
+  case 2: /* program: OL_EOF  */
+#line 132 "src/rapidnet-compiler/ol-parser.y"
+                       { YYACCEPT; }
+#line 1399 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 3:
-#line 126 "src/rapidnet-compiler/ol-parser.y"
-    { YYACCEPT; }
+  case 3: /* program: clauselist OL_EOF  */
+#line 133 "src/rapidnet-compiler/ol-parser.y"
+                                    { YYACCEPT; }
+#line 1405 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 16:
-#line 147 "src/rapidnet-compiler/ol-parser.y"
-    { ctxt->table((yyvsp[(3) - (11)].v), (yyvsp[(5) - (11)].v), (yyvsp[(7) - (11)].v), (yyvsp[(9) - (11)].u_exprlist)); }
+  case 17: /* materialize: OL_MATERIALIZE OL_LPAR OL_NAME OL_COMMA tablearg OL_COMMA tablearg OL_COMMA primarykeys OL_RPAR OL_DOT  */
+#line 155 "src/rapidnet-compiler/ol-parser.y"
+                        { ctxt->table((yyvsp[-8].v), (yyvsp[-6].v), (yyvsp[-4].v), (yyvsp[-2].u_exprlist)); }
+#line 1411 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 17:
-#line 151 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+  case 18: /* annotation: functorname OL_LPAR OL_NAME OL_COMMA tablearg OL_RPAR OL_DOT  */
+#line 159 "src/rapidnet-compiler/ol-parser.y"
+                        { ctxt->Annotate((yyvsp[-6].u_functorname), (yyvsp[-4].v), (yyvsp[-2].v)); }
+#line 1417 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 18:
-#line 154 "src/rapidnet-compiler/ol-parser.y"
-    {
-			(yyval.u_exprlist) = (yyvsp[(3) - (4)].u_exprlist);
-		}
+  case 19: /* tablearg: OL_VALUE  */
+#line 163 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1423 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 19:
-#line 157 "src/rapidnet-compiler/ol-parser.y"
-    {
-			(yyval.u_exprlist) = NULL; // This is going to be KeyID
+  case 20: /* primarykeys: OL_KEYS OL_LPAR keylist OL_RPAR  */
+#line 166 "src/rapidnet-compiler/ol-parser.y"
+                                                {
+			(yyval.u_exprlist) = (yyvsp[-1].u_exprlist);
 		}
+#line 1431 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 20:
-#line 162 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_exprlist) = new ParseExprList(); (yyval.u_exprlist)->push_front((yyvsp[(1) - (1)].u_key)); }
+  case 21: /* primarykeys: OL_KEYS OL_LPAR OL_RPAR  */
+#line 169 "src/rapidnet-compiler/ol-parser.y"
+                                          {
+			(yyval.u_exprlist) = NULL; // This is going to be KeyID
+		}
+#line 1439 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 21:
-#line 164 "src/rapidnet-compiler/ol-parser.y"
-    { (yyvsp[(3) - (3)].u_exprlist)->push_front((yyvsp[(1) - (3)].u_key)); (yyval.u_exprlist)=(yyvsp[(3) - (3)].u_exprlist); }
+  case 22: /* keylist: key  */
+#line 174 "src/rapidnet-compiler/ol-parser.y"
+                    { (yyval.u_exprlist) = new ParseExprList(); (yyval.u_exprlist)->push_front((yyvsp[0].u_key)); }
+#line 1445 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 22:
-#line 167 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_key) = new ParseKey ((yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v)); }
+  case 23: /* keylist: key OL_COMMA keylist  */
+#line 176 "src/rapidnet-compiler/ol-parser.y"
+                                     { (yyvsp[0].u_exprlist)->push_front((yyvsp[-2].u_key)); (yyval.u_exprlist)=(yyvsp[0].u_exprlist); }
+#line 1451 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 23:
-#line 169 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_key) = new ParseKey ((yyvsp[(1) - (1)].v)); }
+  case 24: /* key: OL_VALUE OL_COLON OL_NAME  */
+#line 179 "src/rapidnet-compiler/ol-parser.y"
+                                          { (yyval.u_key) = new ParseKey ((yyvsp[-2].v), (yyvsp[0].v)); }
+#line 1457 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 24:
-#line 172 "src/rapidnet-compiler/ol-parser.y"
-    {
-                ctxt->Watch((yyvsp[(3) - (5)].v), ""); /* no modifiers */
-		}
+  case 25: /* key: OL_VALUE  */
+#line 181 "src/rapidnet-compiler/ol-parser.y"
+                         { (yyval.u_key) = new ParseKey ((yyvsp[0].v)); }
+#line 1463 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 25:
-#line 177 "src/rapidnet-compiler/ol-parser.y"
-    {
-                ctxt->Watch((yyvsp[(3) - (7)].v), (yyvsp[(5) - (7)].v)->ToString()); /* With modifiers */
+  case 26: /* watch: OL_WATCH OL_LPAR OL_NAME OL_RPAR OL_DOT  */
+#line 184 "src/rapidnet-compiler/ol-parser.y"
+                                                        {
+                ctxt->Watch((yyvsp[-2].v), ""); /* no modifiers */
 		}
+#line 1471 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 26:
-#line 182 "src/rapidnet-compiler/ol-parser.y"
-    {
-			ctxt->Stage((yyvsp[(3) - (9)].v),(yyvsp[(5) - (9)].v),(yyvsp[(7) - (9)].v));
+  case 27: /* watchfine: OL_WATCHFINE OL_LPAR OL_NAME OL_COMMA OL_STRING OL_RPAR OL_DOT  */
+#line 189 "src/rapidnet-compiler/ol-parser.y"
+                                                                               {
+                ctxt->Watch((yyvsp[-4].v), (yyvsp[-2].v)->ToString()); /* With modifiers */
 		}
+#line 1479 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 27:
-#line 187 "src/rapidnet-compiler/ol-parser.y"
-    {
-			ctxt->TraceTuple((yyvsp[(3) - (5)].v));
+  case 28: /* stage: OL_STAGE OL_LPAR OL_STRING OL_COMMA OL_NAME OL_COMMA OL_NAME OL_RPAR OL_DOT  */
+#line 194 "src/rapidnet-compiler/ol-parser.y"
+                                                                                            {
+			ctxt->Stage((yyvsp[-6].v),(yyvsp[-4].v),(yyvsp[-2].v));
 		}
+#line 1487 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 28:
-#line 192 "src/rapidnet-compiler/ol-parser.y"
-    {
-			ctxt->TraceTable((yyvsp[(3) - (5)].v));
+  case 29: /* trace: OL_TRACE OL_LPAR OL_NAME OL_RPAR OL_DOT  */
+#line 199 "src/rapidnet-compiler/ol-parser.y"
+                                                        {
+			ctxt->TraceTuple((yyvsp[-2].v));
 		}
+#line 1495 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 29:
-#line 197 "src/rapidnet-compiler/ol-parser.y"
-    { ctxt->Fact((yyvsp[(1) - (2)].u_term)); }
-    break;
-
-  case 30:
-#line 201 "src/rapidnet-compiler/ol-parser.y"
-    { ctxt->AddRule ((yyvsp[(1) - (1)].u_rule)); }
-    break;
-
-  case 31:
+  case 30: /* TraceTable: OL_TRACETABLE OL_LPAR OL_NAME OL_RPAR OL_DOT  */
 #line 204 "src/rapidnet-compiler/ol-parser.y"
-    { ctxt->AddRule ((yyvsp[(1) - (1)].u_rule)); }
+                                                             {
+			ctxt->TraceTable((yyvsp[-2].v));
+		}
+#line 1503 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 32:
+  case 31: /* fact: functor OL_DOT  */
 #line 209 "src/rapidnet-compiler/ol-parser.y"
-    { ((OlContext::Rule*) (yyvsp[(2) - (2)].u_rule)->GetRule ())->SetName ((yyvsp[(1) - (2)].v)); (yyval.u_rule) = (yyvsp[(2) - (2)].u_rule); }
+                               { ctxt->Fact((yyvsp[-1].u_term)); }
+#line 1509 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 33:
-#line 214 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_rule) = new ParseRule (ctxt->CreateRule((yyvsp[(1) - (4)].u_term), (yyvsp[(3) - (4)].u_termlist), false)); }
+  case 32: /* rule: namedRule  */
+#line 213 "src/rapidnet-compiler/ol-parser.y"
+                { ctxt->AddRule ((yyvsp[0].u_rule)); }
+#line 1515 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 34:
-#line 217 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_rule) = new ParseRule (ctxt->CreateRule((yyvsp[(2) - (5)].u_term), (yyvsp[(4) - (5)].u_termlist), true)); }
+  case 33: /* rule: unnamedRule  */
+#line 216 "src/rapidnet-compiler/ol-parser.y"
+                { ctxt->AddRule ((yyvsp[0].u_rule)); }
+#line 1521 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 35:
-#line 220 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_rule) = new ParseRule (ctxt->CreateRule((yyvsp[(1) - (5)].u_term), (yyvsp[(4) - (5)].u_termlist), false, NULL, true)); }
+  case 34: /* namedRule: OL_NAME unnamedRule  */
+#line 221 "src/rapidnet-compiler/ol-parser.y"
+                { ((OlContext::Rule*) (yyvsp[0].u_rule)->GetRule ())->SetName ((yyvsp[-1].v)); (yyval.u_rule) = (yyvsp[0].u_rule); }
+#line 1527 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 36:
-#line 223 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_rule) = new ParseRule (ctxt->CreateRule((yyvsp[(2) - (6)].u_term), (yyvsp[(5) - (6)].u_termlist), true, NULL, true)); }
-    break;
-
-  case 37:
+  case 35: /* unnamedRule: functor OL_IF termlist OL_DOT  */
 #line 226 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_rule) = new ParseRule (ctxt->CreateAggRule((yyvsp[(1) - (4)].u_term), (yyvsp[(3) - (4)].u_aggterm), false)); }
+                { (yyval.u_rule) = new ParseRule (ctxt->CreateRule((yyvsp[-3].u_term), (yyvsp[-1].u_termlist), false)); }
+#line 1533 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 38:
-#line 230 "src/rapidnet-compiler/ol-parser.y"
-    { ctxt->SetContext((yyvsp[(2) - (3)].v)); }
+  case 36: /* unnamedRule: OL_DEL functor OL_IF termlist OL_DOT  */
+#line 229 "src/rapidnet-compiler/ol-parser.y"
+                { (yyval.u_rule) = new ParseRule (ctxt->CreateRule((yyvsp[-3].u_term), (yyvsp[-1].u_termlist), true)); }
+#line 1539 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 39:
-#line 233 "src/rapidnet-compiler/ol-parser.y"
-    {
-                  ctxt->Query(new ParseFunctor((yyvsp[(2) - (4)].u_functorname), (yyvsp[(3) - (4)].u_exprlist))); }
+  case 37: /* unnamedRule: functor OL_IF OL_DEL termlist OL_DOT  */
+#line 232 "src/rapidnet-compiler/ol-parser.y"
+                { (yyval.u_rule) = new ParseRule (ctxt->CreateRule((yyvsp[-4].u_term), (yyvsp[-1].u_termlist), false, NULL, true)); }
+#line 1545 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 40:
-#line 237 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_termlist) = new ParseTermList(); (yyval.u_termlist)->push_front((yyvsp[(1) - (1)].u_term)); }
+  case 38: /* unnamedRule: OL_DEL functor OL_DEL OL_IF termlist OL_DOT  */
+#line 235 "src/rapidnet-compiler/ol-parser.y"
+                { (yyval.u_rule) = new ParseRule (ctxt->CreateRule((yyvsp[-4].u_term), (yyvsp[-1].u_termlist), true, NULL, true)); }
+#line 1551 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 41:
+  case 39: /* unnamedRule: functor OL_IF aggview OL_DOT  */
 #line 238 "src/rapidnet-compiler/ol-parser.y"
-    { (yyvsp[(3) - (3)].u_termlist)->push_front((yyvsp[(1) - (3)].u_term)); (yyval.u_termlist)=(yyvsp[(3) - (3)].u_termlist); }
+                { (yyval.u_rule) = new ParseRule (ctxt->CreateAggRule((yyvsp[-3].u_term), (yyvsp[-1].u_aggterm), false)); }
+#line 1557 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 44:
-#line 241 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_term)=(yyvsp[(1) - (1)].u_term); }
+  case 40: /* context: OL_CONTEXT OL_VAR OL_COLON  */
+#line 242 "src/rapidnet-compiler/ol-parser.y"
+                { ctxt->SetContext((yyvsp[-1].v)); }
+#line 1563 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 45:
+  case 41: /* query: OL_QUERY functorname functorbody OL_DOT  */
 #line 245 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_term)=new ParseFunctor((yyvsp[(1) - (2)].u_functorname), (yyvsp[(2) - (2)].u_exprlist)); }
+                                                        {
+                  ctxt->Query(new ParseFunctor((yyvsp[-2].u_functorname), (yyvsp[-1].u_exprlist))); }
+#line 1570 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 46:
-#line 247 "src/rapidnet-compiler/ol-parser.y"
-    {
-			(yyval.u_term)=new ParseFunctor((yyvsp[(3) - (4)].u_functorname), (yyvsp[(4) - (4)].u_exprlist), NULL, (yyvsp[(1) - (4)].v), true); }
+  case 42: /* termlist: term  */
+#line 249 "src/rapidnet-compiler/ol-parser.y"
+                     { (yyval.u_termlist) = new ParseTermList(); (yyval.u_termlist)->push_front((yyvsp[0].u_term)); }
+#line 1576 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 47:
+  case 43: /* termlist: term OL_COMMA termlist  */
 #line 250 "src/rapidnet-compiler/ol-parser.y"
-    {
-		  (yyval.u_term)=new ParseFunctor((yyvsp[(2) - (3)].u_functorname), (yyvsp[(3) - (3)].u_exprlist), NULL, NULL, false, true); }
+                                         { (yyvsp[0].u_termlist)->push_front((yyvsp[-2].u_term)); (yyval.u_termlist)=(yyvsp[0].u_termlist); }
+#line 1582 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 48:
+  case 46: /* term: select  */
 #line 253 "src/rapidnet-compiler/ol-parser.y"
-    {
-      			(yyval.u_term)=new ParseFunctor((yyvsp[(4) - (5)].u_functorname), (yyvsp[(5) - (5)].u_exprlist), NULL, (yyvsp[(2) - (5)].v), true, true); }
+                                          { (yyval.u_term)=(yyvsp[0].u_term); }
+#line 1588 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 49:
+  case 47: /* functor: functorname functorbody  */
 #line 257 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_term)=new ParseFunctor((yyvsp[(1) - (4)].u_functorname), (yyvsp[(2) - (4)].u_exprlist), (yyvsp[(4) - (4)].v)); }
+                     { (yyval.u_term)=new ParseFunctor((yyvsp[-1].u_functorname), (yyvsp[0].u_exprlist)); }
+#line 1594 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 50:
+  case 48: /* functor: OL_VAR OL_SAYS functorname functorbody  */
 #line 259 "src/rapidnet-compiler/ol-parser.y"
-    {
-			(yyval.u_term)=new ParseFunctor((yyvsp[(3) - (6)].u_functorname), (yyvsp[(4) - (6)].u_exprlist), (yyvsp[(6) - (6)].v), (yyvsp[(1) - (6)].v), true); }
+                                                         {
+			(yyval.u_term)=new ParseFunctor((yyvsp[-1].u_functorname), (yyvsp[0].u_exprlist), NULL, (yyvsp[-3].v), true); }
+#line 1601 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 51:
+  case 49: /* functor: OL_ENCRYPTS functorname functorbody  */
 #line 262 "src/rapidnet-compiler/ol-parser.y"
-    {
-		  (yyval.u_term)=new ParseFunctor((yyvsp[(2) - (5)].u_functorname), (yyvsp[(3) - (5)].u_exprlist), (yyvsp[(5) - (5)].v), NULL, false, true); }
+                                                      {
+		  (yyval.u_term)=new ParseFunctor((yyvsp[-1].u_functorname), (yyvsp[0].u_exprlist), NULL, NULL, false, true); }
+#line 1608 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 52:
+  case 50: /* functor: OL_ENCRYPTS OL_VAR OL_SAYS functorname functorbody  */
 #line 265 "src/rapidnet-compiler/ol-parser.y"
-    {
-      			(yyval.u_term)=new ParseFunctor((yyvsp[(4) - (7)].u_functorname), (yyvsp[(5) - (7)].u_exprlist), (yyvsp[(7) - (7)].v), (yyvsp[(2) - (7)].v), true, true); }
+                                                                     {
+      			(yyval.u_term)=new ParseFunctor((yyvsp[-1].u_functorname), (yyvsp[0].u_exprlist), NULL, (yyvsp[-3].v), true, true); }
+#line 1615 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 51: /* functor: functorname functorbody OL_AT OL_VAR  */
+#line 269 "src/rapidnet-compiler/ol-parser.y"
+                    { (yyval.u_term)=new ParseFunctor((yyvsp[-3].u_functorname), (yyvsp[-2].u_exprlist), (yyvsp[0].v)); }
+#line 1621 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 53:
-#line 270 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_aggterm) = new ParseAggTerm((yyvsp[(1) - (8)].u_aoper), (yyvsp[(3) - (8)].u_exprlist), (yyvsp[(5) - (8)].u_exprlist), (yyvsp[(7) - (8)].u_term)); }
+  case 52: /* functor: OL_VAR OL_SAYS functorname functorbody OL_AT OL_VAR  */
+#line 271 "src/rapidnet-compiler/ol-parser.y"
+                                                                      {
+			(yyval.u_term)=new ParseFunctor((yyvsp[-3].u_functorname), (yyvsp[-2].u_exprlist), (yyvsp[0].v), (yyvsp[-5].v), true); }
+#line 1628 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 54:
+  case 53: /* functor: OL_ENCRYPTS functorname functorbody OL_AT OL_VAR  */
 #line 274 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_functorname) = new ParseFunctorName((yyvsp[(1) - (1)].v)); }
+                                                                   {
+		  (yyval.u_term)=new ParseFunctor((yyvsp[-3].u_functorname), (yyvsp[-2].u_exprlist), (yyvsp[0].v), NULL, false, true); }
+#line 1635 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 54: /* functor: OL_ENCRYPTS OL_VAR OL_SAYS functorname functorbody OL_AT OL_VAR  */
+#line 277 "src/rapidnet-compiler/ol-parser.y"
+                                                                                  {
+      			(yyval.u_term)=new ParseFunctor((yyvsp[-3].u_functorname), (yyvsp[-2].u_exprlist), (yyvsp[0].v), (yyvsp[-5].v), true, true); }
+#line 1642 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 55: /* aggview: agg_oper OL_LPAR functorbody OL_COMMA functorbody OL_COMMA functor OL_RPAR  */
+#line 282 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.u_aggterm) = new ParseAggTerm((yyvsp[-7].u_aoper), (yyvsp[-5].u_exprlist), (yyvsp[-3].u_exprlist), (yyvsp[-1].u_term)); }
+#line 1648 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 56: /* functorname: OL_NAME  */
+#line 286 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.u_functorname) = new ParseFunctorName((yyvsp[0].v)); }
+#line 1654 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 55:
-#line 278 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_exprlist)=new ParseExprList(); }
+  case 57: /* functorbody: OL_LPAR OL_RPAR  */
+#line 290 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.u_exprlist)=new ParseExprList(); }
+#line 1660 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 56:
-#line 280 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_exprlist)=(yyvsp[(2) - (3)].u_exprlist); }
+  case 58: /* functorbody: OL_LPAR functorargs OL_RPAR  */
+#line 292 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.u_exprlist)=(yyvsp[-1].u_exprlist); }
+#line 1666 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 57:
-#line 283 "src/rapidnet-compiler/ol-parser.y"
-    { 
+  case 59: /* functorargs: functorarg  */
+#line 295 "src/rapidnet-compiler/ol-parser.y"
+                        { 
                           (yyval.u_exprlist) = new ParseExprList(); 
-                          (yyval.u_exprlist)->push_front((yyvsp[(1) - (1)].v));
+                          (yyval.u_exprlist)->push_front((yyvsp[0].v));
                         }
+#line 1675 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 58:
-#line 287 "src/rapidnet-compiler/ol-parser.y"
-    {
-			(yyvsp[(3) - (3)].u_exprlist)->push_front((yyvsp[(1) - (3)].v)); 
-			(yyval.u_exprlist)=(yyvsp[(3) - (3)].u_exprlist); }
+  case 60: /* functorargs: functorarg OL_COMMA functorargs  */
+#line 299 "src/rapidnet-compiler/ol-parser.y"
+                                                  {
+			(yyvsp[0].u_exprlist)->push_front((yyvsp[-2].v)); 
+			(yyval.u_exprlist)=(yyvsp[0].u_exprlist); }
+#line 1683 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 59:
-#line 291 "src/rapidnet-compiler/ol-parser.y"
-    {
+  case 61: /* functorargs: OL_AT atom  */
+#line 303 "src/rapidnet-compiler/ol-parser.y"
+                        {
                           (yyval.u_exprlist) = new ParseExprList(); 
-                          ParseVar *pv = dynamic_cast<ParseVar*>((yyvsp[(2) - (2)].v));
+                          ParseVar *pv = dynamic_cast<ParseVar*>((yyvsp[0].v));
                           if (!pv) {
                             ostringstream oss;
                             oss << "location specifier is not a variable";
@@ -1968,15 +1694,16 @@ yyreduce:
                           }
                           else {
                             pv->SetLocSpec();
-                            (yyval.u_exprlist)->push_front((yyvsp[(2) - (2)].v)); 
+                            (yyval.u_exprlist)->push_front((yyvsp[0].v)); 
                           }
                         }
+#line 1701 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 60:
-#line 305 "src/rapidnet-compiler/ol-parser.y"
-    {
-                          ParseVar *pv = dynamic_cast<ParseVar*>((yyvsp[(2) - (4)].v));
+  case 62: /* functorargs: OL_AT atom OL_COMMA functorargs  */
+#line 317 "src/rapidnet-compiler/ol-parser.y"
+                        {
+                          ParseVar *pv = dynamic_cast<ParseVar*>((yyvsp[-2].v));
                           if (!pv) {
                             ostringstream oss;
                             oss << "location specifier is not a variable";
@@ -1984,386 +1711,415 @@ yyreduce:
                           }
                           else {
                             pv->SetLocSpec();
-                            (yyvsp[(4) - (4)].u_exprlist)->push_front((yyvsp[(2) - (4)].v)); 
-                            (yyval.u_exprlist)=(yyvsp[(4) - (4)].u_exprlist); 
+                            (yyvsp[0].u_exprlist)->push_front((yyvsp[-2].v)); 
+                            (yyval.u_exprlist)=(yyvsp[0].u_exprlist); 
                           }
                         }
+#line 1719 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 61:
-#line 321 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
-    break;
-
-  case 62:
-#line 323 "src/rapidnet-compiler/ol-parser.y"
-    {
-                          (yyval.v) = (yyvsp[(1) - (1)].v);
-                        }
-    break;
-
-  case 63:
-#line 330 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseFunction((yyvsp[(1) - (4)].v), (yyvsp[(3) - (4)].u_exprlist)); }
-    break;
-
-  case 64:
-#line 332 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseFunction((yyvsp[(1) - (3)].v), new ParseExprList()); }
+  case 63: /* functorarg: atom  */
+#line 333 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1725 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 65:
+  case 64: /* functorarg: aggregate  */
 #line 335 "src/rapidnet-compiler/ol-parser.y"
-    { 
-			(yyval.u_exprlist) = new ParseExprList(); 
-			(yyval.u_exprlist)->push_front((yyvsp[(1) - (1)].v)); }
+                        {
+                          (yyval.v) = (yyvsp[0].v);
+                        }
+#line 1733 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 66:
-#line 338 "src/rapidnet-compiler/ol-parser.y"
-    { 
-			(yyvsp[(3) - (3)].u_exprlist)->push_front((yyvsp[(1) - (3)].v)); 
-			(yyval.u_exprlist)=(yyvsp[(3) - (3)].u_exprlist); }
+  case 65: /* function: OL_FUNCTION OL_LPAR functionargs OL_RPAR  */
+#line 342 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = new ParseFunction((yyvsp[-3].v), (yyvsp[-1].u_exprlist)); }
+#line 1739 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 67:
+  case 66: /* function: OL_FUNCTION OL_LPAR OL_RPAR  */
 #line 344 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+                        { (yyval.v) = new ParseFunction((yyvsp[-2].v), new ParseExprList()); }
+#line 1745 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 68:
-#line 346 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+  case 67: /* functionargs: functionarg  */
+#line 347 "src/rapidnet-compiler/ol-parser.y"
+                            { 
+			(yyval.u_exprlist) = new ParseExprList(); 
+			(yyval.u_exprlist)->push_front((yyvsp[0].v)); }
+#line 1753 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 69:
+  case 68: /* functionargs: functionarg OL_COMMA functionargs  */
 #line 350 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_term) = new ParseSelect((yyvsp[(1) - (1)].v)); }
+                                                    { 
+			(yyvsp[0].u_exprlist)->push_front((yyvsp[-2].v)); 
+			(yyval.u_exprlist)=(yyvsp[0].u_exprlist); }
+#line 1761 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 70:
-#line 354 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_term) = new ParseAssign((yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v)); }
-    break;
-
-  case 71:
+  case 69: /* functionarg: math_expr  */
 #line 356 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_term) = new ParseAssign((yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v)); }
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1767 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 72:
-#line 360 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(2) - (3)].v); }
+  case 70: /* functionarg: atom  */
+#line 358 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1773 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 73:
+  case 71: /* select: bool_expr  */
 #line 362 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseBool(ParseBool::RANGE, (yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v)); }
-    break;
-
-  case 74:
-#line 364 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseBool(ParseBool::NOT, (yyvsp[(2) - (2)].v) ); }
+                        { (yyval.u_term) = new ParseSelect((yyvsp[0].v)); }
+#line 1779 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 75:
+  case 72: /* assign: OL_VAR OL_ASSIGN rel_atom  */
 #line 366 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseBool(ParseBool::OR, (yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v) ); }
+                        { (yyval.u_term) = new ParseAssign((yyvsp[-2].v), (yyvsp[0].v)); }
+#line 1785 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 76:
+  case 73: /* assign: OL_VAR OL_ASSIGN bool_expr  */
 #line 368 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseBool(ParseBool::AND, (yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v) ); }
+                        { (yyval.u_term) = new ParseAssign((yyvsp[-2].v), (yyvsp[0].v)); }
+#line 1791 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 77:
-#line 370 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseBool((yyvsp[(2) - (3)].u_boper), (yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v) ); }
+  case 74: /* bool_expr: OL_LPAR bool_expr OL_RPAR  */
+#line 372 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[-1].v); }
+#line 1797 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 78:
+  case 75: /* bool_expr: OL_VAR OL_IN range_expr  */
 #line 374 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+                        { (yyval.v) = new ParseBool(ParseBool::RANGE, (yyvsp[-2].v), (yyvsp[0].v)); }
+#line 1803 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 79:
+  case 76: /* bool_expr: OL_NOT bool_expr  */
 #line 376 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+                        { (yyval.v) = new ParseBool(ParseBool::NOT, (yyvsp[0].v) ); }
+#line 1809 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 80:
+  case 77: /* bool_expr: bool_expr OL_OR bool_expr  */
 #line 378 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+                        { (yyval.v) = new ParseBool(ParseBool::OR, (yyvsp[-2].v), (yyvsp[0].v) ); }
+#line 1815 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 81:
-#line 381 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_boper) = ParseBool::EQ; }
+  case 78: /* bool_expr: bool_expr OL_AND bool_expr  */
+#line 380 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = new ParseBool(ParseBool::AND, (yyvsp[-2].v), (yyvsp[0].v) ); }
+#line 1821 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 82:
+  case 79: /* bool_expr: rel_atom rel_oper rel_atom  */
 #line 382 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_boper) = ParseBool::NEQ; }
+                        { (yyval.v) = new ParseBool((yyvsp[-1].u_boper), (yyvsp[-2].v), (yyvsp[0].v) ); }
+#line 1827 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 83:
-#line 383 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_boper) = ParseBool::GT; }
+  case 80: /* rel_atom: math_expr  */
+#line 386 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1833 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 84:
-#line 384 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_boper) = ParseBool::LT; }
+  case 81: /* rel_atom: function  */
+#line 388 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1839 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 85:
-#line 385 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_boper) = ParseBool::GTE; }
+  case 82: /* rel_atom: atom  */
+#line 390 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1845 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 86:
-#line 386 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_boper) = ParseBool::LTE; }
+  case 83: /* rel_oper: OL_EQ  */
+#line 393 "src/rapidnet-compiler/ol-parser.y"
+                         { (yyval.u_boper) = ParseBool::EQ; }
+#line 1851 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 87:
-#line 390 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseMath((yyvsp[(2) - (3)].u_moper), (yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v) ); }
+  case 84: /* rel_oper: OL_NEQ  */
+#line 394 "src/rapidnet-compiler/ol-parser.y"
+                         { (yyval.u_boper) = ParseBool::NEQ; }
+#line 1857 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 88:
-#line 392 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseMath((yyvsp[(2) - (3)].u_moper), (yyvsp[(1) - (3)].v), (yyvsp[(3) - (3)].v) ); }
+  case 85: /* rel_oper: OL_GT  */
+#line 395 "src/rapidnet-compiler/ol-parser.y"
+                         { (yyval.u_boper) = ParseBool::GT; }
+#line 1863 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 89:
+  case 86: /* rel_oper: OL_LT  */
 #line 396 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+                         { (yyval.u_boper) = ParseBool::LT; }
+#line 1869 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 90:
-#line 398 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+  case 87: /* rel_oper: OL_GTE  */
+#line 397 "src/rapidnet-compiler/ol-parser.y"
+                         { (yyval.u_boper) = ParseBool::GTE; }
+#line 1875 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 91:
-#line 400 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(2) - (3)].v); }
+  case 88: /* rel_oper: OL_LTE  */
+#line 398 "src/rapidnet-compiler/ol-parser.y"
+                         { (yyval.u_boper) = ParseBool::LTE; }
+#line 1881 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 92:
-#line 403 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::LSHIFT; }
+  case 89: /* math_expr: math_expr math_oper math_atom  */
+#line 402 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = new ParseMath((yyvsp[-1].u_moper), (yyvsp[-2].v), (yyvsp[0].v) ); }
+#line 1887 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 93:
+  case 90: /* math_expr: math_atom math_oper math_atom  */
 #line 404 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::RSHIFT; }
+                        { (yyval.v) = new ParseMath((yyvsp[-1].u_moper), (yyvsp[-2].v), (yyvsp[0].v) ); }
+#line 1893 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 94:
-#line 405 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::PLUS; }
+  case 91: /* math_atom: atom  */
+#line 408 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1899 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 95:
-#line 406 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::MINUS; }
+  case 92: /* math_atom: function  */
+#line 410 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 1905 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 96:
-#line 407 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::TIMES; }
+  case 93: /* math_atom: OL_LPAR math_expr OL_RPAR  */
+#line 412 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[-1].v); }
+#line 1911 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 97:
-#line 408 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::DIVIDE; }
+  case 94: /* math_oper: OL_LSHIFT  */
+#line 415 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::LSHIFT; }
+#line 1917 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 98:
-#line 409 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::MODULUS; }
+  case 95: /* math_oper: OL_RSHIFT  */
+#line 416 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::RSHIFT; }
+#line 1923 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 99:
-#line 410 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::BIT_XOR; }
+  case 96: /* math_oper: OL_PLUS  */
+#line 417 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::PLUS; }
+#line 1929 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 100:
-#line 411 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::BIT_AND; }
+  case 97: /* math_oper: OL_MINUS  */
+#line 418 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::MINUS; }
+#line 1935 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 101:
-#line 412 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::BIT_OR; }
+  case 98: /* math_oper: OL_TIMES  */
+#line 419 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::TIMES; }
+#line 1941 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 102:
-#line 413 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.u_moper) = ParseMath::BIT_NOT; }
+  case 99: /* math_oper: OL_DIVIDE  */
+#line 420 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::DIVIDE; }
+#line 1947 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 103:
-#line 418 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseRange(ParseRange::RANGEOO, (yyvsp[(2) - (5)].v), (yyvsp[(4) - (5)].v)); }
+  case 100: /* math_oper: OL_MODULUS  */
+#line 421 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::MODULUS; }
+#line 1953 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 104:
-#line 420 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseRange(ParseRange::RANGEOC, (yyvsp[(2) - (5)].v), (yyvsp[(4) - (5)].v)); }
+  case 101: /* math_oper: OL_BITXOR  */
+#line 422 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::BIT_XOR; }
+#line 1959 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 105:
-#line 422 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseRange(ParseRange::RANGECO, (yyvsp[(2) - (5)].v), (yyvsp[(4) - (5)].v)); }
+  case 102: /* math_oper: OL_BITAND  */
+#line 423 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::BIT_AND; }
+#line 1965 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 106:
+  case 103: /* math_oper: OL_BITOR  */
 #line 424 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseRange(ParseRange::RANGECC, (yyvsp[(2) - (5)].v), (yyvsp[(4) - (5)].v)); }
+                             { (yyval.u_moper) = ParseMath::BIT_OR; }
+#line 1971 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 107:
-#line 428 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+  case 104: /* math_oper: OL_BITNOT  */
+#line 425 "src/rapidnet-compiler/ol-parser.y"
+                             { (yyval.u_moper) = ParseMath::BIT_NOT; }
+#line 1977 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 108:
+  case 105: /* range_expr: OL_LPAR range_atom OL_COMMA range_atom OL_RPAR  */
 #line 430 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+                        { (yyval.v) = new ParseRange(ParseRange::RANGEOO, (yyvsp[-3].v), (yyvsp[-1].v)); }
+#line 1983 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 106: /* range_expr: OL_LPAR range_atom OL_COMMA range_atom OL_RSQUB  */
+#line 432 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = new ParseRange(ParseRange::RANGEOC, (yyvsp[-3].v), (yyvsp[-1].v)); }
+#line 1989 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 112:
+  case 107: /* range_expr: OL_LSQUB range_atom OL_COMMA range_atom OL_RPAR  */
 #line 434 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = (yyvsp[(1) - (1)].v); }
+                        { (yyval.v) = new ParseRange(ParseRange::RANGECO, (yyvsp[-3].v), (yyvsp[-1].v)); }
+#line 1995 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 113:
-#line 438 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseAgg((yyvsp[(3) - (4)].v), (yyvsp[(1) - (4)].u_aoper), ValuePtr()); }
+  case 108: /* range_expr: OL_LSQUB range_atom OL_COMMA range_atom OL_RSQUB  */
+#line 436 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = new ParseRange(ParseRange::RANGECC, (yyvsp[-3].v), (yyvsp[-1].v)); }
+#line 2001 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 114:
-#line 441 "src/rapidnet-compiler/ol-parser.y"
-    {
+  case 109: /* range_atom: math_expr  */
+#line 440 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 2007 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 110: /* range_atom: atom  */
+#line 442 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 2013 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 114: /* atom: OL_NULL  */
+#line 446 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = (yyvsp[0].v); }
+#line 2019 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 115: /* aggregate: agg_oper OL_LT OL_VAR OL_GT  */
+#line 450 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = new ParseAgg((yyvsp[-1].v), (yyvsp[-3].u_aoper), ValuePtr()); }
+#line 2025 "src/rapidnet-compiler/ol-parser.cc"
+    break;
+
+  case 116: /* aggregate: agg_oper OL_LT OL_AT OL_VAR OL_GT  */
+#line 453 "src/rapidnet-compiler/ol-parser.y"
+                        {
                           // Make the variable a location specifier
-                          ParseVar *pv = dynamic_cast<ParseVar*>((yyvsp[(4) - (5)].v));
+                          ParseVar *pv = dynamic_cast<ParseVar*>((yyvsp[-1].v));
                           pv->SetLocSpec();
-                          (yyval.v) = new ParseAgg((yyvsp[(4) - (5)].v), (yyvsp[(1) - (5)].u_aoper), ValuePtr());
+                          (yyval.v) = new ParseAgg((yyvsp[-1].v), (yyvsp[-4].u_aoper), ValuePtr());
                         }
+#line 2036 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 115:
-#line 449 "src/rapidnet-compiler/ol-parser.y"
-    { (yyval.v) = new ParseAgg(ParseAgg::DONT_CARE, (yyvsp[(1) - (4)].u_aoper), ValuePtr()); }
+  case 117: /* aggregate: agg_oper OL_LT OL_TIMES OL_GT  */
+#line 461 "src/rapidnet-compiler/ol-parser.y"
+                        { (yyval.v) = new ParseAgg(ParseAgg::DONT_CARE, (yyvsp[-3].u_aoper), ValuePtr()); }
+#line 2042 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
-  case 116:
-#line 453 "src/rapidnet-compiler/ol-parser.y"
-    {
-                  (yyval.u_aoper) = (yyvsp[(1) - (1)].v)->value->ToString ().c_str ();
+  case 118: /* agg_oper: OL_AGGFUNCNAME  */
+#line 465 "src/rapidnet-compiler/ol-parser.y"
+                {
+                  (yyval.u_aoper) = (yyvsp[0].v)->value->ToString ().c_str ();
                 }
+#line 2050 "src/rapidnet-compiler/ol-parser.cc"
     break;
 
 
-/* Line 1267 of yacc.c.  */
-#line 2274 "src/rapidnet-compiler/ol-parser.cc"
+#line 2054 "src/rapidnet-compiler/ol-parser.cc"
+
       default: break;
     }
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  /* User semantic actions sometimes alter yychar, and that requires
+     that yytoken be updated with the new translation.  We take the
+     approach of translating immediately before every use of yytoken.
+     One alternative is translating here after every semantic action,
+     but that translation would be missed if the semantic action invokes
+     YYABORT, YYACCEPT, or YYERROR immediately after altering yychar or
+     if it invokes YYBACKUP.  In the case of YYABORT or YYACCEPT, an
+     incorrect destructor might then be invoked immediately.  In the
+     case of YYERROR or YYBACKUP, subsequent parser actions might lead
+     to an incorrect destructor call or verbose syntax error message
+     before the lookahead is translated.  */
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
-
-  /* Now `shift' the result of the reduction.  Determine what state
+  /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
 
-/*------------------------------------.
-| yyerrlab -- here on detecting error |
-`------------------------------------*/
+/*--------------------------------------.
+| yyerrlab -- here on detecting error.  |
+`--------------------------------------*/
 yyerrlab:
+  /* Make sure we have latest lookahead translation.  See comments at
+     user semantic actions for why this is necessary.  */
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
       yyerror (ctxt, YY_("syntax error"));
-#else
-      {
-	YYSIZE_T yysize = yysyntax_error (0, yystate, yychar);
-	if (yymsg_alloc < yysize && yymsg_alloc < YYSTACK_ALLOC_MAXIMUM)
-	  {
-	    YYSIZE_T yyalloc = 2 * yysize;
-	    if (! (yysize <= yyalloc && yyalloc <= YYSTACK_ALLOC_MAXIMUM))
-	      yyalloc = YYSTACK_ALLOC_MAXIMUM;
-	    if (yymsg != yymsgbuf)
-	      YYSTACK_FREE (yymsg);
-	    yymsg = (char *) YYSTACK_ALLOC (yyalloc);
-	    if (yymsg)
-	      yymsg_alloc = yyalloc;
-	    else
-	      {
-		yymsg = yymsgbuf;
-		yymsg_alloc = sizeof yymsgbuf;
-	      }
-	  }
-
-	if (0 < yysize && yysize <= yymsg_alloc)
-	  {
-	    (void) yysyntax_error (yymsg, yystate, yychar);
-	    yyerror (ctxt, yymsg);
-	  }
-	else
-	  {
-	    yyerror (ctxt, YY_("syntax error"));
-	    if (yysize != 0)
-	      goto yyexhaustedlab;
-	  }
-      }
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
-      /* If just tried and failed to reuse look-ahead token after an
-	 error, discard it.  */
+      /* If just tried and failed to reuse lookahead token after an
+         error, discard it.  */
 
       if (yychar <= YYEOF)
-	{
-	  /* Return failure if at end of input.  */
-	  if (yychar == YYEOF)
-	    YYABORT;
-	}
+        {
+          /* Return failure if at end of input.  */
+          if (yychar == YYEOF)
+            YYABORT;
+        }
       else
-	{
-	  yydestruct ("Error: discarding",
-		      yytoken, &yylval, ctxt);
-	  yychar = YYEMPTY;
-	}
+        {
+          yydestruct ("Error: discarding",
+                      yytoken, &yylval, ctxt);
+          yychar = YYEMPTY;
+        }
     }
 
-  /* Else will try to reuse look-ahead token after shifting the error
+  /* Else will try to reuse lookahead token after shifting the error
      token.  */
   goto yyerrlab1;
 
@@ -2372,14 +2128,13 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  /* Do not reclaim the symbols of the rule which action triggered
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
   yylen = 0;
@@ -2392,42 +2147,42 @@ yyerrorlab:
 | yyerrlab1 -- common code for both syntax error and YYERROR.  |
 `-------------------------------------------------------------*/
 yyerrlab1:
-  yyerrstatus = 3;	/* Each real token shifted decrements this.  */
+  yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
-      if (yyn != YYPACT_NINF)
-	{
-	  yyn += YYTERROR;
-	  if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
-	    {
-	      yyn = yytable[yyn];
-	      if (0 < yyn)
-		break;
-	    }
-	}
+      if (!yypact_value_is_default (yyn))
+        {
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
+            {
+              yyn = yytable[yyn];
+              if (0 < yyn)
+                break;
+            }
+        }
 
       /* Pop the current state because it cannot handle the error token.  */
       if (yyssp == yyss)
-	YYABORT;
+        YYABORT;
 
 
       yydestruct ("Error: popping",
-		  yystos[yystate], yyvsp, ctxt);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, ctxt);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
     }
 
-  if (yyn == YYFINAL)
-    YYACCEPT;
-
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2438,53 +2193,57 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#ifndef yyoverflow
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
   yyerror (ctxt, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
-  if (yychar != YYEOF && yychar != YYEMPTY)
-     yydestruct ("Cleanup: discarding lookahead",
-		 yytoken, &yylval, ctxt);
-  /* Do not reclaim the symbols of the rule which action triggered
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != YYEMPTY)
+    {
+      /* Make sure we have latest lookahead translation.  See comments at
+         user semantic actions for why this is necessary.  */
+      yytoken = YYTRANSLATE (yychar);
+      yydestruct ("Cleanup: discarding lookahead",
+                  yytoken, &yylval, ctxt);
+    }
+  /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
   YYPOPSTACK (yylen);
   YY_STACK_PRINT (yyss, yyssp);
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-		  yystos[*yyssp], yyvsp, ctxt);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, ctxt);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
-  if (yymsg != yymsgbuf)
-    YYSTACK_FREE (yymsg);
-#endif
-  /* Make sure YYID is used.  */
-  return YYID (yyresult);
-}
 
+  return yyresult;
+}
 
-#line 458 "src/rapidnet-compiler/ol-parser.y"
+#line 470 "src/rapidnet-compiler/ol-parser.y"
 
 
 // Epilog
@@ -2504,4 +2263,3 @@ ol_parser_error(OlContext *ctxt, string msg)
   ctxt->ReportError(msg);
 }
 
-
@@ -1,14 +1,14 @@
-/* A Bison parser, made by GNU Bison 2.3.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-/* Skeleton interface for Bison's Yacc-like parsers in C
+/* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989, 1990, 2000, 2001, 2002, 2003, 2004, 2005, 2006
-   Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
-   This program is free software; you can redistribute it and/or modify
+   This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
-   the Free Software Foundation; either version 2, or (at your option)
-   any later version.
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
 
    This program is distributed in the hope that it will be useful,
    but WITHOUT ANY WARRANTY; without even the implied warranty of
@@ -16,9 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program; if not, write to the Free Software
-   Foundation, Inc., 51 Franklin Street, Fifth Floor,
-   Boston, MA 02110-1301, USA.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,131 +31,103 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
-/* Tokens.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-   /* Put the tokens into the symbol table, so that GDB and other debuggers
-      know about them.  */
-   enum yytokentype {
-     OL_OR = 258,
-     OL_AND = 259,
-     OL_BITOR = 260,
-     OL_BITXOR = 261,
-     OL_BITAND = 262,
-     OL_BITNOT = 263,
-     OL_NEQ = 264,
-     OL_EQ = 265,
-     OL_LTE = 266,
-     OL_LT = 267,
-     OL_GTE = 268,
-     OL_GT = 269,
-     OL_RSHIFT = 270,
-     OL_LSHIFT = 271,
-     OL_MINUS = 272,
-     OL_PLUS = 273,
-     OL_MODULUS = 274,
-     OL_DIVIDE = 275,
-     OL_TIMES = 276,
-     OL_NOT = 277,
-     OL_IN = 278,
-     OL_ID = 279,
-     OL_ASSIGN = 280,
-     OL_AT = 281,
-     OL_NAME = 282,
-     OL_COMMA = 283,
-     OL_DOT = 284,
-     OL_EOF = 285,
-     OL_IF = 286,
-     OL_STRING = 287,
-     OL_VALUE = 288,
-     OL_VAR = 289,
-     OL_AGGFUNCNAME = 290,
-     OL_FUNCTION = 291,
-     OL_NULL = 292,
-     OL_RPAR = 293,
-     OL_LPAR = 294,
-     OL_LSQUB = 295,
-     OL_RSQUB = 296,
-     OL_LCURB = 297,
-     OL_RCURB = 298,
-     OL_COLON = 299,
-     OL_DEL = 300,
-     OL_QUERY = 301,
-     OL_MATERIALIZE = 302,
-     OL_KEYS = 303,
-     OL_SAYS = 304,
-     OL_ENCRYPTS = 305,
-     OL_CONTEXT = 306,
-     OL_WATCH = 307,
-     OL_WATCHFINE = 308,
-     OL_STAGE = 309,
-     OL_TRACE = 310,
-     OL_TRACETABLE = 311
-   };
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_OL_PARSER_SRC_RAPIDNET_COMPILER_OL_PARSER_HH_INCLUDED
+# define YY_OL_PARSER_SRC_RAPIDNET_COMPILER_OL_PARSER_HH_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 1
+#endif
+#if YYDEBUG
+extern int ol_parser_debug;
 #endif
-/* Tokens.  */
-#define OL_OR 258
-#define OL_AND 259
-#define OL_BITOR 260
-#define OL_BITXOR 261
-#define OL_BITAND 262
-#define OL_BITNOT 263
-#define OL_NEQ 264
-#define OL_EQ 265
-#define OL_LTE 266
-#define OL_LT 267
-#define OL_GTE 268
-#define OL_GT 269
-#define OL_RSHIFT 270
-#define OL_LSHIFT 271
-#define OL_MINUS 272
-#define OL_PLUS 273
-#define OL_MODULUS 274
-#define OL_DIVIDE 275
-#define OL_TIMES 276
-#define OL_NOT 277
-#define OL_IN 278
-#define OL_ID 279
-#define OL_ASSIGN 280
-#define OL_AT 281
-#define OL_NAME 282
-#define OL_COMMA 283
-#define OL_DOT 284
-#define OL_EOF 285
-#define OL_IF 286
-#define OL_STRING 287
-#define OL_VALUE 288
-#define OL_VAR 289
-#define OL_AGGFUNCNAME 290
-#define OL_FUNCTION 291
-#define OL_NULL 292
-#define OL_RPAR 293
-#define OL_LPAR 294
-#define OL_LSQUB 295
-#define OL_RSQUB 296
-#define OL_LCURB 297
-#define OL_RCURB 298
-#define OL_COLON 299
-#define OL_DEL 300
-#define OL_QUERY 301
-#define OL_MATERIALIZE 302
-#define OL_KEYS 303
-#define OL_SAYS 304
-#define OL_ENCRYPTS 305
-#define OL_CONTEXT 306
-#define OL_WATCH 307
-#define OL_WATCHFINE 308
-#define OL_STAGE 309
-#define OL_TRACE 310
-#define OL_TRACETABLE 311
+/* "%code requires" blocks.  */
+#line 94 "src/rapidnet-compiler/ol-parser.y"
 
+  namespace ns3 {
+  namespace rapidnet_compiler {
+  class OlContext;
+  } // namespace rapidnet_compiler
+  } // namespace ns3
 
+#line 57 "src/rapidnet-compiler/ol-parser.hh"
 
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    OL_OR = 258,                   /* OL_OR  */
+    OL_AND = 259,                  /* OL_AND  */
+    OL_BITOR = 260,                /* OL_BITOR  */
+    OL_BITXOR = 261,               /* OL_BITXOR  */
+    OL_BITAND = 262,               /* OL_BITAND  */
+    OL_BITNOT = 263,               /* OL_BITNOT  */
+    OL_EQ = 264,                   /* OL_EQ  */
+    OL_NEQ = 265,                  /* OL_NEQ  */
+    OL_GT = 266,                   /* OL_GT  */
+    OL_GTE = 267,                  /* OL_GTE  */
+    OL_LT = 268,                   /* OL_LT  */
+    OL_LTE = 269,                  /* OL_LTE  */
+    OL_LSHIFT = 270,               /* OL_LSHIFT  */
+    OL_RSHIFT = 271,               /* OL_RSHIFT  */
+    OL_PLUS = 272,                 /* OL_PLUS  */
+    OL_MINUS = 273,                /* OL_MINUS  */
+    OL_TIMES = 274,                /* OL_TIMES  */
+    OL_DIVIDE = 275,               /* OL_DIVIDE  */
+    OL_MODULUS = 276,              /* OL_MODULUS  */
+    OL_NOT = 277,                  /* OL_NOT  */
+    OL_IN = 278,                   /* OL_IN  */
+    OL_ID = 279,                   /* OL_ID  */
+    OL_ASSIGN = 280,               /* OL_ASSIGN  */
+    OL_AT = 281,                   /* OL_AT  */
+    OL_NAME = 282,                 /* OL_NAME  */
+    OL_COMMA = 283,                /* OL_COMMA  */
+    OL_DOT = 284,                  /* OL_DOT  */
+    OL_EOF = 285,                  /* OL_EOF  */
+    OL_IF = 286,                   /* OL_IF  */
+    OL_STRING = 287,               /* OL_STRING  */
+    OL_VALUE = 288,                /* OL_VALUE  */
+    OL_VAR = 289,                  /* OL_VAR  */
+    OL_AGGFUNCNAME = 290,          /* OL_AGGFUNCNAME  */
+    OL_FUNCTION = 291,             /* OL_FUNCTION  */
+    OL_NULL = 292,                 /* OL_NULL  */
+    OL_RPAR = 293,                 /* OL_RPAR  */
+    OL_LPAR = 294,                 /* OL_LPAR  */
+    OL_LSQUB = 295,                /* OL_LSQUB  */
+    OL_RSQUB = 296,                /* OL_RSQUB  */
+    OL_LCURB = 297,                /* OL_LCURB  */
+    OL_RCURB = 298,                /* OL_RCURB  */
+    OL_COLON = 299,                /* OL_COLON  */
+    OL_DEL = 300,                  /* OL_DEL  */
+    OL_QUERY = 301,                /* OL_QUERY  */
+    OL_MATERIALIZE = 302,          /* OL_MATERIALIZE  */
+    OL_KEYS = 303,                 /* OL_KEYS  */
+    OL_SAYS = 304,                 /* OL_SAYS  */
+    OL_ENCRYPTS = 305,             /* OL_ENCRYPTS  */
+    OL_CONTEXT = 306,              /* OL_CONTEXT  */
+    OL_WATCH = 307,                /* OL_WATCH  */
+    OL_WATCHFINE = 308,            /* OL_WATCHFINE  */
+    OL_STAGE = 309,                /* OL_STAGE  */
+    OL_TRACE = 310,                /* OL_TRACE  */
+    OL_TRACETABLE = 311            /* OL_TRACETABLE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
 
+/* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-typedef union YYSTYPE
-#line 96 "src/rapidnet-compiler/ol-parser.y"
+union YYSTYPE
 {
+#line 103 "src/rapidnet-compiler/ol-parser.y"
+
 
   ns3::rapidnet_compiler::ParseBool::Operator  u_boper;
   ns3::rapidnet_compiler::ParseMath::Operator  u_moper;
@@ -171,14 +141,19 @@ typedef union YYSTYPE
   ns3::rapidnet_compiler::ParseAggTerm         *u_aggterm;
   ns3::rapidnet_compiler::ParseKey             *u_key;
   ns3::rapidnet_compiler::ParseRule            *u_rule;
-}
-/* Line 1489 of yacc.c.  */
-#line 177 "src/rapidnet-compiler/ol-parser.hh"
-	YYSTYPE;
-# define yystype YYSTYPE /* obsolescent; will be withdrawn */
-# define YYSTYPE_IS_DECLARED 1
+
+#line 146 "src/rapidnet-compiler/ol-parser.hh"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
 
 
 
+
+int ol_parser_parse (ns3::rapidnet_compiler::OlContext *ctxt);
+
+
+#endif /* !YY_OL_PARSER_SRC_RAPIDNET_COMPILER_OL_PARSER_HH_INCLUDED  */
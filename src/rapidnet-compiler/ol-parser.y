@@ -91,8 +91,15 @@
 %start program
 %file-prefix="ol_parser"
 %name-prefix="ol_parser_"
-%parse-param { OlContext *ctxt }
-%lex-param { OlContext *ctxt }
+%code requires {
+  namespace ns3 {
+  namespace rapidnet_compiler {
+  class OlContext;
+  } // namespace rapidnet_compiler
+  } // namespace ns3
+}
+%parse-param { ns3::rapidnet_compiler::OlContext *ctxt }
+%lex-param { ns3::rapidnet_compiler::OlContext *ctxt }
 %union {
 
   ns3::rapidnet_compiler::ParseBool::Operator  u_boper;
@@ -133,6 +140,7 @@ clauselist:	clause
 clause:		  rule
 		| fact
                 | materialize
+                | annotation
                 | watch
                 | watchfine
 		| trace
@@ -147,6 +155,10 @@ materialize:	OL_MATERIALIZE OL_LPAR OL_NAME OL_COMMA
 			{ ctxt->table($3, $5, $7, $9); } 
 		;
 
+annotation:	functorname OL_LPAR OL_NAME OL_COMMA tablearg OL_RPAR OL_DOT
+			{ ctxt->Annotate($1, $3, $5); }
+		;
+
 tablearg:	OL_VALUE
 			{ $$ = $1; }
 		;
@@ -258,6 +258,9 @@ Capitalize (name) + "::StopApplication ()\n\
 #define FMT_TIMEOUTDEF \
 ",\n    Seconds (%ld));\n\n"
 
+#define FMT_TUPLE_PRIORITY \
+"  SetTuplePriority (%s, %d);\n"
+
 #define FMT_DEMUX_RECV_HEAD \
 "void\n\
 %s::DemuxRecv (Ptr<Tuple> tuple)\n\
@@ -1096,6 +1099,7 @@ RapidNetContext::PrepareTables (Ptr<TableStore> tableStore)
       m_tables[tblName] = table;
       m_allTupleNames [tblName] = tblName;
     }
+  m_tuplePriorities = tableStore->GetTuplePriorities ();
 }
 
 void
@@ -1314,6 +1318,22 @@ RapidNetContext::GenerateInitDatabase ()
           fprintf (ccFile, FMT_TIMEOUTDEF, it->second.GetTimeout ());
         }
     }
+  for (OlContext::TuplePriorityMap::iterator pt = m_tuplePriorities.begin ();
+    pt != m_tuplePriorities.end (); ++pt)
+    {
+      // Nothing to schedule for a relation that no rule uses
+      if (m_allTupleNames.find (pt->first) == m_allTupleNames.end ())
+        {
+          NS_LOG_WARN ("Priority declared for unused relation " << pt->first);
+          continue;
+        }
+      fprintf (ccFile, FMT_TUPLE_PRIORITY, cstr (AllCaps (pt->first)),
+        pt->second);
+    }
+  if (!m_tuplePriorities.empty ())
+    {
+      fprintf (ccFile, "\n");
+    }
   GenerateInitAggregators ();
 
   fprintf (ccFile, END_METHOD);
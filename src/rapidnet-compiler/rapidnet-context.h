@@ -434,6 +434,9 @@ protected:
   /** Map of all materialized tables against their respective names. */
   map<string, RapidNetTable> m_tables;
 
+  /** Wire priority classes declared with priority(name, class). */
+  OlContext::TuplePriorityMap m_tuplePriorities;
+
   /** Map (essentially a list - the value is same as key) for all tuples being
       used. */
   map<string, string> m_allTupleNames;
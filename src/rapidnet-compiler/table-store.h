@@ -55,6 +55,12 @@ public:
     _tableInfos->insert (make_pair (ti->tableName, ti));
   }
 
+  /** Get the declared wire priority classes */
+  OlContext::TuplePriorityMap GetTuplePriorities ()
+  {
+    return _ctxt->GetTuplePriorities ();
+  }
+
 protected:
   OlContext::TableInfoMap* _tableInfos;
   Ptr<OlContext> _ctxt;
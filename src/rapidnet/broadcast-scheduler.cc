@@ -0,0 +1,153 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "broadcast-scheduler.h"
+#include "rapidnet-rng.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace rapidnet {
+
+BroadcastScheduler::BroadcastScheduler ()
+  : m_min (Seconds (1)),
+    m_max (Seconds (60)),
+    m_suppressed (0)
+{
+}
+
+void
+BroadcastScheduler::SetIntervals (Time min, Time max)
+{
+  NS_ASSERT (min.IsStrictlyPositive () && min <= max);
+  m_min = min;
+  m_max = max;
+}
+
+Time
+BroadcastScheduler::GetNextInterval (Time interval) const
+{
+  return Min (interval * Scalar (2), m_max);
+}
+
+void
+BroadcastScheduler::Advance (State &state, Time now, RapidNetRng &rng)
+{
+  while (now >= state.m_start + state.m_interval)
+    {
+      // the broadcast of an interval which ended before it was sent is
+      // sent at the next opportunity
+      bool owed = !state.m_sent;
+      state.m_start = state.m_start + state.m_interval;
+      state.m_interval = GetNextInterval (state.m_interval);
+      state.m_sent = false;
+      state.m_fire = owed ? state.m_start : state.m_start
+        + state.m_interval * Scalar (0.5 + 0.5 * rng.GetValue ());
+    }
+}
+
+bool
+BroadcastScheduler::IsDue (uint32_t digest, Time now, RapidNetRng &rng)
+{
+  std::map<uint32_t, State>::iterator it = m_states.find (digest);
+  if (it == m_states.end ())
+    {
+      State state;
+      state.m_start = now;
+      state.m_interval = m_min;
+      state.m_fire = now;
+      state.m_last = now;
+      state.m_period = Seconds (0);
+      state.m_sent = false;
+      state.m_urgent = true;
+      it = m_states.insert (std::make_pair (digest, state)).first;
+    }
+  State &state = it->second;
+  Advance (state, now, rng);
+  if (now > state.m_last)
+    {
+      state.m_period = now - state.m_last;
+    }
+  state.m_last = now;
+  if (state.m_urgent || (!state.m_sent && now >= state.m_fire))
+    {
+      state.m_urgent = false;
+      state.m_sent = true;
+      return true;
+    }
+  m_suppressed++;
+  return false;
+}
+
+Time
+BroadcastScheduler::GetPromise (uint32_t digest, Time now) const
+{
+  std::map<uint32_t, State>::const_iterator it = m_states.find (digest);
+  if (it == m_states.end ())
+    {
+      return Seconds (0);
+    }
+  const State &state = it->second;
+  if (state.m_period.IsZero ())
+    {
+      // the period of the program is not known yet
+      return Seconds (0);
+    }
+  return state.m_start + state.m_interval + GetNextInterval (state.m_interval)
+    + state.m_period - now;
+}
+
+void
+BroadcastScheduler::Reset (Time now)
+{
+  for (std::map<uint32_t, State>::iterator it = m_states.begin ();
+    it != m_states.end (); ++it)
+    {
+      it->second.m_start = now;
+      it->second.m_interval = m_min;
+      it->second.m_fire = now;
+      it->second.m_sent = false;
+      it->second.m_urgent = true;
+    }
+}
+
+void
+BroadcastScheduler::Prune (Time now)
+{
+  for (std::map<uint32_t, State>::iterator it = m_states.begin ();
+    it != m_states.end (); )
+    {
+      if (now - it->second.m_last > m_max * Scalar (2))
+        {
+          m_states.erase (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
+uint32_t
+BroadcastScheduler::GetSuppressed (void) const
+{
+  return m_suppressed;
+}
+
+} // namespace rapidnet
+} // namespace ns3
@@ -0,0 +1,118 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef BROADCAST_SCHEDULER_H
+#define BROADCAST_SCHEDULER_H
+
+#include <map>
+#include <stdint.h>
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace rapidnet {
+
+class RapidNetRng;
+
+/**
+ * \ingroup rapidnet_library
+ *
+ * \brief Trickle-style suppression of periodic broadcasts.
+ *
+ * The program decides when a broadcast is sent; the scheduler decides
+ * whether it is redundant. Each broadcast, identified by the digest of
+ * its tuple, has an interval which starts at the minimum interval and
+ * doubles up to the maximum interval while the neighbourhood does not
+ * change. Only one broadcast is sent per interval, the first one after a
+ * random point of the second half of the interval: the others are
+ * suppressed. When the neighbourhood changes (Reset) or when a tuple is
+ * broadcast for the first time, the next broadcast is sent at once and
+ * the interval goes back to the minimum.
+ *
+ * An interval which ends before its broadcast is sent passes it on to
+ * the next interval, so a broadcast is always sent by the end of the
+ * interval after the current one, and at most one broadcast period of
+ * the program later: GetPromise returns this bound, or zero until the
+ * period of the program is known.
+ */
+class BroadcastScheduler
+{
+public:
+  BroadcastScheduler ();
+
+  /**
+   * \brief Sets the minimum and maximum intervals.
+   */
+  void SetIntervals (Time min, Time max);
+
+  /**
+   * \brief Returns true if the broadcast of the tuple with this digest
+   * is sent now, false if it is suppressed.
+   */
+  bool IsDue (uint32_t digest, Time now, RapidNetRng &rng);
+
+  /**
+   * \brief Returns the longest time until the next broadcast of the
+   * tuple with this digest, which has just been sent, or zero if it is
+   * not known.
+   */
+  Time GetPromise (uint32_t digest, Time now) const;
+
+  /**
+   * \brief Restarts all the broadcasts from the minimum interval.
+   */
+  void Reset (Time now);
+
+  /**
+   * \brief Forgets the broadcasts which have not been sent for two
+   * maximum intervals.
+   */
+  void Prune (Time now);
+
+  /**
+   * \brief Returns the number of suppressed broadcasts.
+   */
+  uint32_t GetSuppressed (void) const;
+
+private:
+  struct State
+  {
+    /* Start and length of the current interval */
+    Time m_start;
+    Time m_interval;
+    /* Time from which the broadcast of the interval may be sent */
+    Time m_fire;
+    /* Time of the last broadcast, and period of the program */
+    Time m_last;
+    Time m_period;
+    bool m_sent;
+    bool m_urgent;
+  };
+
+  void Advance (State &state, Time now, RapidNetRng &rng);
+  Time GetNextInterval (Time interval) const;
+
+  Time m_min;
+  Time m_max;
+  std::map<uint32_t, State> m_states;
+  uint32_t m_suppressed;
+};
+
+} // namespace rapidnet
+} // namespace ns3
+
+#endif // BROADCAST_SCHEDULER_H
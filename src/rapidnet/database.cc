@@ -17,10 +17,27 @@
  *
  */
 #include "database.h"
+#include "rapidnet-header.h"
+#include "ns3/packet.h"
 
 using namespace ns3;
 using namespace ns3::rapidnet;
 
+template <typename T>
+static void
+WriteRaw (ostream& os, T value)
+{
+  os.write (reinterpret_cast<const char *> (&value), sizeof (T));
+}
+
+template <typename T>
+static bool
+ReadRaw (istream& is, T& value)
+{
+  is.read (reinterpret_cast<char *> (&value), sizeof (T));
+  return is.good ();
+}
+
 TypeId
 Database::GetTypeId(void)
 {
@@ -77,6 +94,104 @@ Database::Delete (Ptr<Tuple> tuple)
   GetRelation (tuple->GetName ())->Delete (tuple);
 }
 
+void
+Database::Save (ostream& os)
+{
+  map<string, Ptr<Relation> > relations;
+  for (map<string, Ptr<RelationBase> >::iterator it = m_relations.begin ();
+    it != m_relations.end (); ++it)
+    {
+      Ptr<Relation> reln = DynamicCast<Relation, RelationBase> (it->second);
+      if (reln != 0)
+        {
+          relations[it->first] = reln;
+        }
+    }
+
+  WriteRaw<uint32_t> (os, relations.size ());
+  vector<uint8_t> buffer;
+  for (map<string, Ptr<Relation> >::iterator it = relations.begin ();
+    it != relations.end (); ++it)
+    {
+      WriteRaw<uint32_t> (os, it->first.size ());
+      os.write (it->first.data (), it->first.size ());
+      list<Ptr<Tuple> > tuples = it->second->GetAllTuples ();
+      WriteRaw<uint32_t> (os, tuples.size ());
+      for (list<Ptr<Tuple> >::iterator jt = tuples.begin (); jt != tuples.end (); ++jt)
+        {
+          // same encoding as on the wire
+          Ptr<Packet> packet = Create<Packet> ();
+          packet->AddHeader (RapidNetHeader (*jt));
+          buffer.resize (packet->GetSize ());
+          packet->CopyData (&buffer[0], buffer.size ());
+          WriteRaw<int64_t> (os, (*jt)->GetTimestamp ().GetTimeStep ());
+          WriteRaw<uint32_t> (os, (*jt)->GetRefCount ());
+          WriteRaw<uint32_t> (os, buffer.size ());
+          os.write (reinterpret_cast<const char *> (&buffer[0]), buffer.size ());
+        }
+    }
+}
+
+bool
+Database::Restore (istream& is)
+{
+  uint32_t nRelations;
+  if (!ReadRaw (is, nRelations))
+    {
+      return false;
+    }
+  vector<uint8_t> buffer;
+  for (uint32_t i = 0; i < nRelations; ++i)
+    {
+      uint32_t length;
+      if (!ReadRaw (is, length))
+        {
+          return false;
+        }
+      string name (length, ' ');
+      is.read (&name[0], length);
+      uint32_t nTuples;
+      if (!ReadRaw (is, nTuples))
+        {
+          return false;
+        }
+      if (!is.good () || !HasRelation (name))
+        {
+          return false;
+        }
+      Ptr<Relation> reln = DynamicCast<Relation, RelationBase> (GetRelation (name));
+      if (reln == 0)
+        {
+          return false;
+        }
+      for (uint32_t j = 0; j < nTuples; ++j)
+        {
+          int64_t timestamp;
+          uint32_t refCount;
+          uint32_t size;
+          if (!ReadRaw (is, timestamp) || !ReadRaw (is, refCount)
+            || !ReadRaw (is, size))
+            {
+              return false;
+            }
+          buffer.resize (size);
+          is.read (reinterpret_cast<char *> (&buffer[0]), size);
+          if (!is.good ())
+            {
+              return false;
+            }
+          Ptr<Packet> packet = Create<Packet> (&buffer[0], size);
+          RapidNetHeader header;
+          packet->RemoveHeader (header);
+          Ptr<Tuple> tuple = header.GetTuple ();
+          tuple->SetTimestamp (TimeStep (timestamp));
+          tuple->SetRefCount (refCount);
+          reln->Restore (tuple);
+        }
+    }
+  return true;
+}
+
 /* Delete this method later */
 void
 Database::CleanTupleBeforeInsert (Ptr<Tuple> &tuple)
@@ -21,6 +21,7 @@
 
 #include <string>
 #include <map>
+#include <iostream>
 #include "ns3/assert.h"
 #include "relation.h"
 #include "rapidnet-application-base.h"
@@ -83,6 +84,20 @@ public:
 
   void Delete (Ptr<Tuple> tuple);
 
+  /**
+   * \brief Writes the tuples of all the relations, with their timestamps
+   *        and reference counts, to the given binary stream.
+   */
+  void Save (ostream& os);
+
+  /**
+   * \brief Reads back the tuples written by @see Save(). The relations
+   *        must already exist: they are created with their keys by the
+   *        application, not read from the stream. Returns false if the
+   *        stream is truncated or names a relation that does not exist.
+   */
+  bool Restore (istream& is);
+
   /**
    * \brief Returns the associated @see RapidNet application object.
    */
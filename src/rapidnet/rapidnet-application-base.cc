@@ -20,6 +20,7 @@
 #include "ns3/ptr.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/simulator.h"
+#include "ns3/event-trace.h"
 #include "ns3/ipv4-value.h"
 #include "pki-authentication-manager.h"
 #include "blowfish-encryption-manager.h"
@@ -27,6 +28,10 @@
 #include "ns3/udp-socket-factory.h"
 #include "ns3/udp-transport-socket-factory-impl.h"
 #include "ns3/uinteger.h"
+#include "ns3/enum.h"
+#include "ns3/boolean.h"
+#include "ns3/string.h"
+#include "ns3/qos-tag.h"
 
 #include <fstream> // add-on
 #include <sstream> //add-on
@@ -40,6 +45,8 @@ using namespace ns3::rapidnet;
 NS_LOG_COMPONENT_DEFINE ("RapidNetApplicationBase");
 NS_OBJECT_ENSURE_REGISTERED (RapidNetApplicationBase);
 
+__thread RapidNetApplicationBase *RapidNetApplicationBase::m_evaluating = 0;
+
 TypeId
 RapidNetApplicationBase::GetTypeId (void)
 {
@@ -61,6 +68,52 @@ RapidNetApplicationBase::GetTypeId (void)
                    TimeValue (MilliSeconds (DEFAULT_CONNECTION_INACTIVITY_TIMEOUT)),
                    MakeTimeAccessor (&RapidNetApplicationBase::m_tcpInactivityTimeout),
                    MakeTimeChecker ())
+    .AddAttribute ("RefreshTokens",
+                   "Replace resends of unchanged tuples with compact refresh tokens.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RapidNetApplicationBase::m_refreshTokens),
+                   MakeBooleanChecker ())
+    .AddAttribute ("RefreshTokenLifetime",
+                   "How long after a full send a resend of the same tuple may be replaced by a refresh token.",
+                   TimeValue (Seconds (10)),
+                   MakeTimeAccessor (&RapidNetApplicationBase::m_refreshTokenLifetime),
+                   MakeTimeChecker ())
+    .AddAttribute ("BroadcastSuppression",
+                   "Suppress the rebroadcasts of unchanged tuples while the neighbourhood does not change.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RapidNetApplicationBase::m_broadcastSuppression),
+                   MakeBooleanChecker ())
+    .AddAttribute ("BroadcastIntervalMin",
+                   "Broadcast interval after a change of the neighbourhood.",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&RapidNetApplicationBase::m_broadcastIntervalMin),
+                   MakeTimeChecker ())
+    .AddAttribute ("BroadcastIntervalMax",
+                   "Longest broadcast interval of an unchanged neighbourhood, at most the time to live of NeighborRelation.",
+                   TimeValue (Seconds (60)),
+                   MakeTimeAccessor (&RapidNetApplicationBase::m_broadcastIntervalMax),
+                   MakeTimeChecker ())
+    .AddAttribute ("NeighborRelation",
+                   "Relation whose second attribute holds the neighbours, such as link(@Src, Nbr, Cost).",
+                   StringValue ("link"),
+                   MakeStringAccessor (&RapidNetApplicationBase::m_neighborRelation),
+                   MakeStringChecker ())
+    .AddAttribute ("DefaultTuplePriority",
+                   "Wire priority class of tuples whose relation has no priority declaration (0 is most urgent).",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&RapidNetApplicationBase::m_defaultTuplePriority),
+                   MakeUintegerChecker<uint8_t> (0, RapidNetTCPConnection::PRIORITY_CLASSES - 1))
+    .AddAttribute ("TxScheduling",
+                   "How TCP connections share the link between tuple priority classes.",
+                   EnumValue (RapidNetTCPConnection::TX_STRICT),
+                   MakeEnumAccessor (&RapidNetApplicationBase::m_txScheduling),
+                   MakeEnumChecker (RapidNetTCPConnection::TX_STRICT, "Strict",
+                                    RapidNetTCPConnection::TX_WEIGHTED, "Weighted"))
+    .AddAttribute ("WifiQos",
+                   "Tag simulated packets with the 802.11e traffic id of their tuple priority class.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RapidNetApplicationBase::m_wifiQos),
+                   MakeBooleanChecker ())
     ;
   return tid;
 }
@@ -73,6 +126,8 @@ RapidNetApplicationBase::RapidNetApplicationBase ()
   BytesOfDataSent = 0;
   totalPacketsReceived = 0;
   totalPacketsSent = 0;
+  totalRefreshesSuppressed = 0;
+  totalRefreshesResent = 0;
   SetAddress (Ipv4Address ("0.0.0.0"));
   SetPort (11111);
   //m_maxJitter = MAX_JITTER; // Use default
@@ -302,6 +357,29 @@ RapidNetApplicationBase::GetRelation (string name)
   return m_database->GetRelation (name);
 }
 
+void
+RapidNetApplicationBase::Checkpoint (ostream& os)
+{
+  m_database->Save (os);
+  GetRng ().Save (os);
+}
+
+bool
+RapidNetApplicationBase::Restore (istream& is, bool random)
+{
+  if (!m_database->Restore (is))
+    {
+      return false;
+    }
+  if (random)
+    {
+      return GetRng ().Restore (is);
+    }
+  RapidNetRng skipped;
+  skipped.SetNode (GetNode ()->GetId ());
+  return skipped.Restore (is);
+}
+
 void
 RapidNetApplicationBase::SetMaxJitter (uint32_t maxJitter)
 {
@@ -322,11 +400,19 @@ RapidNetApplicationBase::DoDispose (void)
           }
         // Cancel timers
         m_auditTCPConnectionsTimer.Cancel ();
+        Simulator::Cancel (m_refreshFlushEvent);
+        m_refreshSent.clear ();
+        m_refreshRecvd.clear ();
+        m_refreshPending.clear ();
         Application::DoDispose ();
     }
   else
     {
       NS_LOG_FUNCTION_NOARGS ();
+      Simulator::Cancel (m_refreshFlushEvent);
+      m_refreshSent.clear ();
+      m_refreshRecvd.clear ();
+      m_refreshPending.clear ();
       Application::DoDispose ();
     }
 }
@@ -338,6 +424,15 @@ RapidNetApplicationBase::StartApplication (void)
 
   InitDatabase ();
   InitSocket ();
+  Time intervalMax = m_broadcastIntervalMax;
+  if (m_database->HasRelation (m_neighborRelation)
+    && GetRelation (m_neighborRelation)->IsSoftState ())
+    {
+      // Bounds the promises: see SuppressBroadcast
+      intervalMax = Max (m_broadcastIntervalMin, Min (intervalMax,
+        GetRelation (m_neighborRelation)->GetTimeToLive ()));
+    }
+  m_broadcastScheduler.SetIntervals (m_broadcastIntervalMin, intervalMax);
 
   clog << "Application Started at " << Now () << endl;
 }
@@ -452,7 +547,7 @@ RapidNetApplicationBase::Send (Ptr<Tuple> tuple)
   else
     {
 
-      uint32_t jitter = m_maxJitter == 0 ? 0 : rand () % m_maxJitter;
+      uint32_t jitter = m_maxJitter == 0 ? 0 : GetRng ().GetFastInteger (m_maxJitter);
 
       Simulator::Schedule (MilliSeconds (jitter), &RapidNetApplicationBase::DoSend,
                            this, tuple);
@@ -505,6 +600,22 @@ RapidNetApplicationBase::Decrypt (Ptr<Tuple> tuple)
 
 
 
+RapidNetApplicationBase *
+RapidNetApplicationBase::GetEvaluating (void)
+{
+  return m_evaluating;
+}
+
+RapidNetRng &
+RapidNetApplicationBase::GetRng (void)
+{
+  if (!m_rng.IsInitialized ())
+    {
+      m_rng.SetNode (GetNode ()->GetId ());
+    }
+  return m_rng;
+}
+
 void
 RapidNetApplicationBase::PrintStats ()
 {
@@ -512,6 +623,15 @@ RapidNetApplicationBase::PrintStats ()
   cout<<"Total Bytes Sent = "<<BytesOfDataSent<<endl;
   cout<<"Total Packets Received = "<<totalPacketsReceived<<endl;
   cout<<"Total Packets Sent = "<<totalPacketsSent<<endl;
+  if (m_broadcastSuppression)
+    {
+      cout<<"Total Broadcasts Suppressed = "<<m_broadcastScheduler.GetSuppressed ()<<endl;
+    }
+  if (m_refreshTokens)
+    {
+      cout<<"Total Refreshes Suppressed = "<<totalRefreshesSuppressed<<endl;
+      cout<<"Total Refreshes Resent = "<<totalRefreshesResent<<endl;
+    }
 
   cout<<"*********************************************************"<<endl;
 }
@@ -519,7 +639,6 @@ RapidNetApplicationBase::PrintStats ()
 void
 RapidNetApplicationBase::DoSend (Ptr<Tuple> tuple)
 {
-
   if(m_l4Platform)
     {
 
@@ -539,6 +658,11 @@ RapidNetApplicationBase::DoSend (Ptr<Tuple> tuple)
           SendLocal (tuple);
           return;
         }
+
+      if (m_refreshTokens && SuppressRefresh (tuple, value))
+        {
+          return;
+        }
       
       if (!tuple->HasAttribute (RN_ACTION))
         {
@@ -556,17 +680,30 @@ RapidNetApplicationBase::DoSend (Ptr<Tuple> tuple)
         }
 
 
-      SendOverTCP (addr.GetIpv4 (), addr.GetPort ()+1, packet);
+      SendOverTCP (addr.GetIpv4 (), addr.GetPort ()+1, packet,
+                   GetTuplePriority (tuple));
 
     }
   else
     {
+      Ptr<Value> dest = tuple->GetAttribute (RN_DEST)->GetValue ();
+      Ipv4Address destIpv4 = ipv4_value(tuple->GetAttribute (RN_DEST));
+
+      if (m_broadcastSuppression && destIpv4.IsBroadcast () && SuppressBroadcast (tuple))
+        {
+          return;
+        }
+
+      if (m_refreshTokens && destIpv4 != m_address && SuppressRefresh (tuple, dest))
+        {
+          return;
+        }
+
       if (!tuple->HasAttribute (RN_ACTION))
         {
           OnSend.Invoke (tuple);
         }
       
-      Ipv4Address destIpv4 = ipv4_value(tuple->GetAttribute (RN_DEST));
       tuple->RemoveAttribute (RN_DEST);
       
       if (destIpv4 == m_address)
@@ -577,11 +714,17 @@ RapidNetApplicationBase::DoSend (Ptr<Tuple> tuple)
       InetSocketAddress addr = InetSocketAddress (destIpv4, s_Port);
       Ptr<Packet> packet = Create<Packet> ();
       packet->AddHeader (RapidNetHeader (tuple));
+      if (m_wifiQos)
+        {
+          AddQosTag (packet, tuple);
+        }
       
       if (!tuple->HasAttribute (RN_ACTION))
         {
           RAPIDNET_LOG_INFO ("Sending " << tuple << " to " << addr.GetIpv4 ());
         }
+      totalPacketsSent++;
+      BytesOfDataSent += packet->GetSize ();
       m_Socket->SendTo (packet, 0, addr);
     }
   
@@ -633,10 +776,21 @@ RapidNetApplicationBase::ProcessPendingTuples ()
 void
 RapidNetApplicationBase::SendBroadcast (Ptr<Tuple> tuple)
 {
+  if (m_broadcastSuppression && SuppressBroadcast (tuple))
+    {
+      return;
+    }
+
   Ptr<Packet> packet = Create<Packet> ();
   packet->AddHeader (RapidNetHeader (tuple));
+  if (m_wifiQos)
+    {
+      AddQosTag (packet, tuple);
+    }
 
   RAPIDNET_LOG_INFO ("Sending Broadcast ");
+  totalPacketsSent++;
+  BytesOfDataSent += packet->GetSize ();
   m_Socket->SendTo (packet, 0, InetSocketAddress (Ipv4Address (
     "255.255.255.255"), s_Port));
 }
@@ -698,20 +852,28 @@ RapidNetApplicationBase::Receive (Ptr<Socket> socket)
     {
       NS_LOG_FUNCTION (this << socket);
       NS_LOG_INFO ("RapidNetApplicationBase::Receive on UDP");
+      Ptr<UdpTransportSocketImpl> udpSocket = DynamicCast<UdpTransportSocketImpl> (socket);
+      if (udpSocket != 0)
+        {
+          // Take whole recvmmsg batches from the transport socket
+          vector<Ptr<Packet> > packets;
+          vector<Address> fromAddresses;
+          while (udpSocket->RecvFromBatch (packets, fromAddresses) > 0)
+            {
+              for (uint32_t i = 0; i < packets.size (); i++)
+                {
+                  ReceiveL4 (packets[i], fromAddresses[i]);
+                }
+              packets.clear ();
+              fromAddresses.clear ();
+            }
+          return;
+        }
       Ptr<Packet> packet;
       Address from;
       while (packet = socket->RecvFrom (from))
         {
-          if (InetSocketAddress::IsMatchingType (from))
-            {
-              RapidNetHeader header;
-              packet->RemoveHeader (header);
-              Ptr<Tuple> tuple = header.GetTuple ();
-              ProcessTuple (tuple, from);
-              totalPacketsReceived++;
-              BytesOfDataReceived += packet->GetSize(); 
-              
-            }
+          ReceiveL4 (packet, from);
         }
     }
   else
@@ -724,6 +886,8 @@ RapidNetApplicationBase::Receive (Ptr<Socket> socket)
           {
             if (InetSocketAddress::IsMatchingType (from))
               {
+                totalPacketsReceived++;
+                BytesOfDataReceived += packet->GetSize ();
                 RapidNetHeader header;
                 packet->RemoveHeader (header);
                 Ptr<Tuple> tuple = header.GetTuple ();
@@ -749,13 +913,27 @@ RapidNetApplicationBase::Receive (Ptr<Socket> socket)
                 tuple->OverwriteAttribute (TupleAttribute::New (RN_SRC,
                                                                 Ipv4Value::New (fromIpv4)));
                 
-                DemuxRecv (tuple);
+                Dispatch (tuple);
                 
               }
           }
     }
 }
 
+void
+RapidNetApplicationBase::ReceiveL4 (Ptr<Packet> packet, Address from)
+{
+  if (InetSocketAddress::IsMatchingType (from))
+    {
+      RapidNetHeader header;
+      packet->RemoveHeader (header);
+      Ptr<Tuple> tuple = header.GetTuple ();
+      ProcessTuple (tuple, from);
+      totalPacketsReceived++;
+      BytesOfDataReceived += packet->GetSize ();
+    }
+}
+
 void
 RapidNetApplicationBase::ProcessTCPMessage (Ptr<Packet> packet, Ptr<RapidNetTCPConnection> tcpConnection)
 {
@@ -794,7 +972,41 @@ RapidNetApplicationBase::ProcessTuple (Ptr<Tuple> tuple, Address from)
   string srcLocSpec = GetLocSpec (fromIpv4, fromPort);
   tuple->OverwriteAttribute (TupleAttribute::New (RN_SRC,
     StrValue::New (srcLocSpec)));
-  DemuxRecv (tuple);
+  Dispatch (tuple);
+}
+
+void
+RapidNetApplicationBase::Dispatch (Ptr<Tuple> tuple)
+{
+  RapidNetApplicationBase *evaluating = m_evaluating;
+  m_evaluating = this;
+  DoDispatch (tuple);
+  m_evaluating = evaluating;
+}
+
+void
+RapidNetApplicationBase::DoDispatch (Ptr<Tuple> tuple)
+{
+  EventTrace *trace = EventTrace::GetActive ();
+  if (trace == 0)
+    {
+      if (!DemuxRefresh (tuple))
+        {
+          DemuxRecv (tuple);
+        }
+      return;
+    }
+  string name = "rapidnet " + tuple->GetName ();
+  if (tuple->HasAttribute (RN_ACTION))
+    {
+      name += " " + str_value (tuple->GetAttribute (RN_ACTION));
+    }
+  uint64_t start = trace->BeginRegion ();
+  if (!DemuxRefresh (tuple))
+    {
+      DemuxRecv (tuple);
+    }
+  trace->EndRegion (name, start);
 }
 
 
@@ -883,6 +1095,15 @@ RapidNetApplicationBase::DemuxRecv (Ptr<Tuple> tuple)
   if (IsRecvEvent (tuple))
     {
       OnRecv.Invoke (tuple);
+      if (tuple->HasAttribute (RN_PROMISE))
+        {
+          RecvBroadcastPromise (tuple);
+        }
+    }
+  if (m_broadcastSuppression && (IsInsertEvent (tuple, m_neighborRelation)
+    || IsDeleteEvent (tuple, m_neighborRelation)))
+    {
+      UpdateBroadcastNeighbors (tuple);
     }
 
 }
@@ -985,14 +1206,22 @@ RapidNetApplicationBase::SoftStateDelete ()
       for (list<Ptr<Tuple> >::iterator jt = tuples.begin (); jt
           != tuples.end (); ++jt)
         {
-          if (HasTimedout ((*jt)->GetTimestamp (), ttl, now))
+          if (HasTimedout ((*jt)->GetTimestamp (), ttl, now)
+              && !IsPromisedNeighbor (*jt, ttl, now))
             {
               RAPIDNET_LOG_INFO ("Timed out " << *jt << " timestamp: " << (*jt)->GetTimestamp ());
               Delete (*jt);
             }
         }
+      if (it->first == m_neighborRelation)
+        {
+          PruneBroadcastPromises (ttl, now);
+        }
     }
 
+  PruneRefreshTokens ();
+  m_broadcastScheduler.Prune (now);
+
   m_eventSoftStateDelete = Simulator::Schedule (SOFTSTATE_DELETE_PERIOD,
     &RapidNetApplicationBase::SoftStateDelete, this);
 }
@@ -1092,6 +1321,7 @@ RapidNetApplicationBase::AddConnection (Ptr<Socket> socket, Ipv4Address ipAddres
   Ptr<RapidNetTCPConnection> rapidNetTCPConnection = Create<RapidNetTCPConnection> (ipAddress, port, socket);
   rapidNetTCPConnection->SetRecvCallback (MakeCallback (&RapidNetApplicationBase::ProcessTCPMessage, this));
   rapidNetTCPConnection->SetConnState (connState);
+  rapidNetTCPConnection->SetTxScheduling (m_txScheduling);
   socket->SetCloseCallbacks (MakeCallback (&RapidNetApplicationBase::HandleClose, this),
                              MakeCallback (&RapidNetApplicationBase::HandleClose, this));
   socket->SetConnectCallback (MakeCallback (&RapidNetApplicationBase::HandleConnectSuccess, this),
@@ -1162,8 +1392,395 @@ RapidNetApplicationBase::DoPeriodicAuditConnections ()
   m_auditTCPConnectionsTimer.Schedule (m_tcpInactivityTimeout);
 }
 
+bool
+RapidNetApplicationBase::SuppressRefresh (Ptr<Tuple> tuple, Ptr<Value> dest)
+{
+  if (tuple->HasAttribute (RN_ACTION) || tuple->GetName () == RN_REFRESH_TOKEN
+    || tuple->GetName () == RN_REFRESH_NACK)
+    {
+      return false;
+    }
+
+  string peer = dest->ToString ();
+  if (m_refreshOptOut.find (peer) != m_refreshOptOut.end ())
+    {
+      return false;
+    }
+
+  uint32_t key = GetTupleDigest (tuple);
+  uint32_t version = GetTupleDigest (tuple, REFRESH_VERSION_BASIS);
+  Time now = Simulator::Now ();
+
+  RefreshEntryMap &sent = m_refreshSent[peer];
+  RefreshEntryMap::iterator it = sent.find (key);
+  if (it == sent.end () || it->second.m_version != version
+      || HasTimedout (it->second.m_timestamp, m_refreshTokenLifetime, now))
+    {
+      // New, or the receiver may have dropped its copy: send in full
+      RefreshEntry entry;
+      entry.m_version = version;
+      entry.m_timestamp = now;
+      entry.m_tuple = Tuple::New (tuple->GetName ());
+      entry.m_tuple->AddAllAttributes (tuple);
+      entry.m_tuple->OverwriteAttribute (TupleAttribute::New (RN_DEST, dest));
+      sent[key] = entry;
+      return false;
+    }
+
+  it->second.m_timestamp = now;
+  totalRefreshesSuppressed++;
+  PendingRefresh &pending = m_refreshPending[peer];
+  pending.m_dest = dest;
+  pending.m_keys.push_back (Int32Value::New (key));
+  pending.m_versions.push_back (Int32Value::New (version));
+  if (!m_refreshFlushEvent.IsRunning ())
+    {
+      m_refreshFlushEvent = Simulator::ScheduleNow (
+        &RapidNetApplicationBase::FlushRefreshTokens, this);
+    }
+  return true;
+}
+
+void
+RapidNetApplicationBase::FlushRefreshTokens ()
+{
+  std::map<string, PendingRefresh> pending;
+  pending.swap (m_refreshPending);
+
+  std::map<string, PendingRefresh>::iterator it;
+  for (it = pending.begin (); it != pending.end (); ++it)
+    {
+      list<Ptr<Value> >::iterator kt = it->second.m_keys.begin ();
+      list<Ptr<Value> >::iterator vt = it->second.m_versions.begin ();
+      while (kt != it->second.m_keys.end ())
+        {
+          list<Ptr<Value> > keys, versions;
+          for (uint32_t i = 0; i < MAX_REFRESH_TOKENS
+            && kt != it->second.m_keys.end (); ++i, ++kt, ++vt)
+            {
+              keys.push_back (*kt);
+              versions.push_back (*vt);
+            }
+
+          Ptr<Tuple> token = Tuple::New (RN_REFRESH_TOKEN);
+          token->AddAttribute (TupleAttribute::New (RN_KEYS, ListValue::New (keys)));
+          token->AddAttribute (TupleAttribute::New (RN_VERSIONS,
+            ListValue::New (versions)));
+          token->AddAttribute (TupleAttribute::New (RN_PEER,
+            StrValue::New (it->first)));
+          if (m_l4Platform)
+            {
+              // The TCP source port is not our listening port
+              token->AddAttribute (TupleAttribute::New (RN_REPLY,
+                StrValue::New (GetLocSpec (m_address, GetPort ()))));
+            }
+          token->AddAttribute (TupleAttribute::New (RN_DEST, it->second.m_dest));
+          DoSend (token);
+        }
+    }
+}
+
+void
+RapidNetApplicationBase::PruneRefreshTokens ()
+{
+  Time now = Simulator::Now ();
+  std::map<string, RefreshEntryMap>::iterator it;
+  for (it = m_refreshSent.begin (); it != m_refreshSent.end (); )
+    {
+      for (RefreshEntryMap::iterator jt = it->second.begin ();
+        jt != it->second.end (); )
+        {
+          if (HasTimedout (jt->second.m_timestamp, m_refreshTokenLifetime, now))
+            {
+              it->second.erase (jt++);
+            }
+          else
+            {
+              ++jt;
+            }
+        }
+      if (it->second.empty ())
+        {
+          m_refreshSent.erase (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+
+  // Receivers keep their copies longer than senders use them, so that a
+  // token sent just before the sender's lifetime runs out still matches
+  for (RefreshEntryMap::iterator jt = m_refreshRecvd.begin ();
+    jt != m_refreshRecvd.end (); )
+    {
+      if (HasTimedout (jt->second.m_timestamp, m_refreshTokenLifetime * Scalar (2), now))
+        {
+          m_refreshRecvd.erase (jt++);
+        }
+      else
+        {
+          ++jt;
+        }
+    }
+}
+
+bool
+RapidNetApplicationBase::DemuxRefresh (Ptr<Tuple> tuple)
+{
+  if (tuple->GetName () == RN_REFRESH_TOKEN)
+    {
+      RecvRefreshTokens (tuple);
+      return true;
+    }
+  if (tuple->GetName () == RN_REFRESH_NACK)
+    {
+      RecvRefreshNack (tuple);
+      return true;
+    }
+
+  if (m_refreshTokens && !tuple->HasAttribute (RN_ACTION))
+    {
+      RefreshEntry entry;
+      entry.m_version = GetTupleDigest (tuple, REFRESH_VERSION_BASIS);
+      entry.m_timestamp = Simulator::Now ();
+      entry.m_tuple = Tuple::New (tuple->GetName ());
+      entry.m_tuple->AddAllAttributes (tuple);
+      m_refreshRecvd[GetTupleDigest (tuple)] = entry;
+    }
+  return false;
+}
+
+bool
+RapidNetApplicationBase::SuppressBroadcast (Ptr<Tuple> tuple)
+{
+  Time now = Simulator::Now ();
+  uint32_t digest = GetTupleDigest (tuple);
+  if (!m_broadcastScheduler.IsDue (digest, now, GetRng ()))
+    {
+      RAPIDNET_LOG_INFO ("Suppressed broadcast " << tuple);
+      return true;
+    }
+  Time promise = CapBroadcastPromise (m_broadcastScheduler.GetPromise (digest, now));
+  if (promise.IsZero ())
+    {
+      return false;
+    }
+  tuple->OverwriteAttribute (TupleAttribute::New (RN_PROMISE,
+    RealValue::New (promise.GetSeconds ())));
+  // The sender hears its own broadcasts, but not their promise.
+  m_broadcastPromises[m_address] = now + promise;
+  return false;
+}
+
 void
-RapidNetApplicationBase::SendOverTCP (Ipv4Address ipAddress, uint16_t port, Ptr<Packet> packet)
+RapidNetApplicationBase::RecvBroadcastPromise (Ptr<Tuple> tuple)
+{
+  Ipv4Address src = GetIpv4Address (tuple->GetAttribute (RN_SRC)->GetValue ()->ToString ());
+  Ptr<RealValue> promise = DynamicCast<RealValue, Value> (
+    tuple->GetAttribute (RN_PROMISE)->GetValue ());
+  if (promise != 0)
+    {
+      m_broadcastPromises[src] = Simulator::Now ()
+        + CapBroadcastPromise (Seconds (promise->GetRealValue ()));
+    }
+}
+
+void
+RapidNetApplicationBase::UpdateBroadcastNeighbors (Ptr<Tuple> tuple)
+{
+  string neighborAttr = m_neighborRelation + "_attr2";
+  Ptr<RelationBase> relation = GetRelation (m_neighborRelation);
+  if (relation == NULL || !tuple->HasAttribute (neighborAttr))
+    {
+      return;
+    }
+  string neighbor = tuple->GetAttribute (neighborAttr)->GetValue ()->ToString ();
+  Ipv4Address address = GetIpv4Address (neighbor);
+
+  // An updated tuple is deleted and inserted again: the neighbourhood
+  // only changes when the relation gains or loses the neighbour.
+  bool present = false;
+  list<Ptr<Tuple> > tuples = relation->GetAllTuples ();
+  for (list<Ptr<Tuple> >::iterator it = tuples.begin ();
+    it != tuples.end () && !present; ++it)
+    {
+      present = (*it)->HasAttribute (neighborAttr) && (*it)->GetAttribute (
+        neighborAttr)->GetValue ()->ToString () == neighbor;
+    }
+  bool known = m_broadcastNeighbors.find (address) != m_broadcastNeighbors.end ();
+  if (present == known)
+    {
+      return;
+    }
+  if (present)
+    {
+      m_broadcastNeighbors.insert (address);
+    }
+  else
+    {
+      m_broadcastNeighbors.erase (address);
+    }
+  RAPIDNET_LOG_INFO ("Neighbourhood changed, resetting broadcast intervals");
+  m_broadcastScheduler.Reset (Simulator::Now ());
+}
+
+bool
+RapidNetApplicationBase::IsPromisedNeighbor (Ptr<Tuple> tuple, Time ttl, Time now)
+{
+  string neighborAttr = m_neighborRelation + "_attr2";
+  if (m_broadcastPromises.empty () || tuple->GetName () != m_neighborRelation
+      || !tuple->HasAttribute (neighborAttr))
+    {
+      return false;
+    }
+  Ipv4Address neighbor = GetIpv4Address (
+    tuple->GetAttribute (neighborAttr)->GetValue ()->ToString ());
+  std::map<Ipv4Address, Time>::iterator it = m_broadcastPromises.find (neighbor);
+  return it != m_broadcastPromises.end () && !HasTimedout (it->second, ttl, now);
+}
+
+Time
+RapidNetApplicationBase::CapBroadcastPromise (Time promise)
+{
+  if (!m_database->HasRelation (m_neighborRelation)
+    || !GetRelation (m_neighborRelation)->IsSoftState ())
+    {
+      return promise;
+    }
+  return Min (promise, GetRelation (m_neighborRelation)->GetTimeToLive ()
+    * Scalar (BROADCAST_PROMISE_TTLS));
+}
+
+void
+RapidNetApplicationBase::PruneBroadcastPromises (Time ttl, Time now)
+{
+  for (std::map<Ipv4Address, Time>::iterator it = m_broadcastPromises.begin ();
+    it != m_broadcastPromises.end (); )
+    {
+      if (HasTimedout (it->second, ttl, now))
+        {
+          m_broadcastPromises.erase (it++);
+        }
+      else
+        {
+          ++it;
+        }
+    }
+}
+
+void
+RapidNetApplicationBase::RecvRefreshTokens (Ptr<Tuple> token)
+{
+  list<Ptr<Value> > keys = rn_list (token->GetAttribute (RN_KEYS)->GetValue ());
+  list<Ptr<Value> > versions = rn_list (token->GetAttribute (RN_VERSIONS)->GetValue ());
+  list<Ptr<Value> > missing;
+  Time now = Simulator::Now ();
+
+  list<Ptr<Value> >::iterator kt, vt;
+  for (kt = keys.begin (), vt = versions.begin (); kt != keys.end () &&
+    vt != versions.end (); ++kt, ++vt)
+    {
+      RefreshEntryMap::iterator it = m_refreshRecvd.find (rn_int32 (*kt));
+      if (it == m_refreshRecvd.end ()
+        || it->second.m_version != (uint32_t) rn_int32 (*vt))
+        {
+          missing.push_back (*kt);
+          continue;
+        }
+      // Deliver the stored copy as if it had been resent
+      it->second.m_timestamp = now;
+      Ptr<Tuple> refresh = Tuple::New (it->second.m_tuple->GetName ());
+      refresh->AddAllAttributes (it->second.m_tuple);
+      refresh->OverwriteAttribute (token->GetAttribute (RN_SRC));
+      DemuxRecv (refresh);
+    }
+
+  if (!missing.empty ())
+    {
+      RAPIDNET_LOG_INFO ("Requesting " << missing.size () << " full tuples");
+      Ptr<Tuple> nack = Tuple::New (RN_REFRESH_NACK);
+      nack->AddAttribute (TupleAttribute::New (RN_KEYS, ListValue::New (missing)));
+      nack->AddAttribute (token->GetAttribute (RN_PEER));
+      if (!m_refreshTokens)
+        {
+          // Without copies every later token would be NACKed as well
+          nack->AddAttribute (TupleAttribute::New (RN_NO_TOKENS,
+            BoolValue::New (true)));
+        }
+      nack->AddAttribute (TupleAttribute::New (RN_DEST, token->HasAttribute (RN_REPLY) ?
+        token->GetAttribute (RN_REPLY)->GetValue () :
+        token->GetAttribute (RN_SRC)->GetValue ()));
+      DoSend (nack);
+    }
+}
+
+void
+RapidNetApplicationBase::RecvRefreshNack (Ptr<Tuple> nack)
+{
+  string peer = str_value (nack->GetAttribute (RN_PEER));
+  std::map<string, RefreshEntryMap>::iterator st = m_refreshSent.find (peer);
+  if (st == m_refreshSent.end ())
+    {
+      return;
+    }
+
+  list<Ptr<Tuple> > resend;
+  list<Ptr<Value> > keys = rn_list (nack->GetAttribute (RN_KEYS)->GetValue ());
+  for (list<Ptr<Value> >::iterator kt = keys.begin (); kt != keys.end (); ++kt)
+    {
+      RefreshEntryMap::iterator it = st->second.find (rn_int32 (*kt));
+      if (it != st->second.end ())
+        {
+          // Forget the entry so that DoSend sends the tuple in full
+          resend.push_back (it->second.m_tuple);
+          st->second.erase (it);
+        }
+    }
+
+  if (nack->HasAttribute (RN_NO_TOKENS))
+    {
+      RAPIDNET_LOG_INFO ("Refresh tokens disabled toward " << peer);
+      m_refreshOptOut.insert (peer);
+      m_refreshSent.erase (st);
+    }
+
+  for (list<Ptr<Tuple> >::iterator it = resend.begin (); it != resend.end (); ++it)
+    {
+      totalRefreshesResent++;
+      DoSend (*it);
+    }
+}
+
+void
+RapidNetApplicationBase::SetTuplePriority (string relnName, uint8_t priority)
+{
+  NS_ASSERT (priority < RapidNetTCPConnection::PRIORITY_CLASSES);
+  m_tuplePriorities[relnName] = priority;
+}
+
+uint8_t
+RapidNetApplicationBase::GetTuplePriority (Ptr<Tuple> tuple)
+{
+  std::map<string, uint8_t>::iterator it = m_tuplePriorities.find (tuple->GetName ());
+  return it == m_tuplePriorities.end () ? m_defaultTuplePriority : it->second;
+}
+
+void
+RapidNetApplicationBase::AddQosTag (Ptr<Packet> packet, Ptr<Tuple> tuple)
+{
+  // Priority classes 0 to 3 go to the video, best effort (twice) and
+  // background access categories: the default class stays best effort
+  // and voice is left to non-RapidNet traffic.
+  static const uint8_t tids[RapidNetTCPConnection::PRIORITY_CLASSES] = {5, 0, 3, 1};
+  QosTag tag;
+  tag.Set (tids[GetTuplePriority (tuple)]);
+  packet->AddPacketTag (tag);
+}
+
+void
+RapidNetApplicationBase::SendOverTCP (Ipv4Address ipAddress, uint16_t port, Ptr<Packet> packet,
+                                      uint8_t priority)
 {
   if (packet->GetSize ())
   {
@@ -1182,7 +1799,7 @@ RapidNetApplicationBase::SendOverTCP (Ipv4Address ipAddress, uint16_t port, Ptr<
       socket->Connect (InetSocketAddress (ipAddress, port));
     }
 
-    connection->SendTCPData (packet);
+    connection->SendTCPData (packet, priority);
         
   }
 }
@@ -1192,8 +1809,3 @@ RapidNetApplicationBase::SetL4Platform (bool l4Platform)
 {
   m_l4Platform = l4Platform;
 }
-
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::rapidnet::AppTrigger)
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::rapidnet::InsertTrigger)
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::rapidnet::DeleteTrigger)
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::rapidnet::RefreshTrigger)
@@ -22,6 +22,7 @@
 #include <string>
 #include <iostream>
 #include <list>
+#include <set>
 #include <ctime>
 #include "ns3/log.h"
 #include "ns3/socket.h"
@@ -46,6 +47,8 @@
 #include "sendlog-authentication-manager.h"
 #include "sendlog-encryption-manager.h"
 #include "rapidnet-tcp-connection.h"
+#include "rapidnet-rng.h"
+#include "broadcast-scheduler.h"
 #include "ns3/event-impl.h"
 
 #define RAPIDNET_LOG(level,msg) \
@@ -84,8 +87,17 @@ const string RN_ACTION = "rn-action";
 const string RN_INSERT = "rn-insert";
 const string RN_DELETE = "rn-delete";
 const string RN_REFRESH = "rn-refresh";
+const string RN_REFRESH_TOKEN = "rn-refresh-token";
+const string RN_REFRESH_NACK = "rn-refresh-nack";
+const string RN_KEYS = "rn-keys";
+const string RN_VERSIONS = "rn-versions";
+const string RN_PEER = "rn-peer";
+const string RN_NO_TOKENS = "rn-no-tokens";
+const string RN_REPLY = "rn-reply";
+const string RN_PROMISE = "rn-promise";
 const Ipv4Address HOME_IP = Ipv4Address::GetLoopback ();
 const Time SOFTSTATE_DELETE_PERIOD = Seconds (1.0);
+const uint32_t BROADCAST_PROMISE_TTLS = 3;
 
 class Tuple;
 class Database;
@@ -125,6 +137,27 @@ public:
    */
   Ptr<Database> GetDatabase();
 
+  /**
+   * \brief Assigns tuples of the given relation to a wire priority class.
+   *
+   * Class 0 is the most urgent; see RapidNetTCPConnection::TxScheduling
+   * for how classes share a connection. Generated from priority(name, c)
+   * declarations in NDlog.
+   */
+  void SetTuplePriority (string relnName, uint8_t priority);
+
+  /**
+   * \brief Returns the wire priority class of the given tuple.
+   */
+  uint8_t GetTuplePriority (Ptr<Tuple> tuple);
+
+  /**
+   * \brief Tags the packet with the 802.11e traffic id of the priority
+   *        class of the tuple, which a QoS wifi MAC maps to its access
+   *        category.
+   */
+  void AddQosTag (Ptr<Packet> packet, Ptr<Tuple> tuple);
+
   /**
    * \brief Sets the IP address for this application instance.
    */
@@ -235,9 +268,20 @@ public:
   void SetMaxJitter (uint32_t maxJitter);
 
   /**
-   * \brief Serialize the designated relation
+   * \brief Writes the application database and the position of its
+   *        random numbers to the given binary stream. See
+   *        @see Database::Save().
    */
-  // virtual void SerializeRel(vector<string>& relNames, int nodeID, string storePath);
+  virtual void Checkpoint (ostream& os);
+
+  /**
+   * \brief Reads back the state written by @see Checkpoint(). It must
+   *        be called once the application has started, when its relations
+   *        exist. No rule fires on the restored tuples. The random numbers
+   *        carry on from the saved position if random is true, and are
+   *        left alone otherwise.
+   */
+  virtual bool Restore (istream& is, bool random);
   
   
   // TCP processing
@@ -285,9 +329,28 @@ public:
    */
   TriggerList OnDelete;
 
-  void SendOverTCP (Ipv4Address ipAddress, uint16_t port, Ptr<Packet> packet);
+  void SendOverTCP (Ipv4Address ipAddress, uint16_t port, Ptr<Packet> packet,
+    uint8_t priority = 0);
   void PrintStats();
 
+  /**
+   * \brief Returns the random number generator of this node.
+   *
+   * Its values only depend on the global seed, the run number and the id
+   * of the node, see RapidNetRng.
+   */
+  RapidNetRng &GetRng (void);
+
+  /**
+   * \brief Returns the application whose rules the calling thread is
+   * evaluating, or 0 outside of them.
+   *
+   * Rules run from Dispatch. Functions such as f_rand use the application
+   * to draw from its generator, whatever the context of the event: a wifi
+   * or CSMA reception runs in the context of the sender.
+   */
+  static RapidNetApplicationBase *GetEvaluating (void);
+
   /*
    *  \brief Total number of packets sent. 
    */
@@ -308,6 +371,16 @@ public:
    */
   uint32_t BytesOfDataReceived;
 
+  /*
+   *  \brief Number of sends replaced by refresh tokens.
+   */
+  uint32_t totalRefreshesSuppressed;
+
+  /*
+   *  \brief Number of tuples resent in full on a refresh NACK.
+   */
+  uint32_t totalRefreshesResent;
+
 protected:
 
   /**
@@ -398,6 +471,12 @@ protected:
   */
   void Receive (Ptr<Socket> socket);
 
+  /**
+  * \brief Retrieves the @see Tuple of a packet received on the L4
+  * platform and invokes the @see ProcessTuple() method.
+  */
+  void ReceiveL4 (Ptr<Packet> packet, Address from);
+
   /**
   * \brief Processes the network event retrieves the @see Tuple and
   * invokes the @see DemuxRecv() method.
@@ -526,9 +605,20 @@ protected:
   Ptr<RapidNetDecoratorFrontend> m_decoratorFrontend;
 
   uint32_t m_maxJitter;
+  RapidNetRng m_rng;
   uint32_t m_udpMaxBytes;
   Time m_tcpInactivityTimeout;
   Timer m_auditTCPConnectionsTimer;
+  bool m_refreshTokens;
+  Time m_refreshTokenLifetime;
+  bool m_broadcastSuppression;
+  Time m_broadcastIntervalMin;
+  Time m_broadcastIntervalMax;
+  string m_neighborRelation;
+  uint8_t m_defaultTuplePriority;
+  RapidNetTCPConnection::TxScheduling m_txScheduling;
+  bool m_wifiQos;
+  std::map<string, uint8_t> m_tuplePriorities;
   typedef std::map<Ptr<Socket>, Ptr<RapidNetTCPConnection> > TCPConnectionMap;
   TCPConnectionMap m_tcpConnectionTable;
 
@@ -551,6 +641,114 @@ private:
    */
   void DoSend (Ptr<Tuple> tuple);
 
+  /**
+   * \brief Refresh protocol for periodically resent tuples.
+   *
+   * When RefreshTokens is enabled, a tuple that was already sent with
+   * identical contents to the same destination within
+   * RefreshTokenLifetime is not sent again. Its (key digest, version
+   * digest) pair is queued instead, and all pairs for one destination
+   * leave together in RN_REFRESH_TOKEN tuples. The receiver keeps the
+   * tuples it received in full and replays its copy of each matching one
+   * through DemuxRecv, so soft-state relations are refreshed exactly as
+   * if the tuple had been resent. Unknown keys are returned in an
+   * RN_REFRESH_NACK tuple and the sender resends those tuples in full.
+   * A receiver with RefreshTokens disabled keeps no copies: its NACKs
+   * carry RN_NO_TOKENS, and the sender stops suppressing toward it.
+   *
+   * \returns true if the tuple was replaced by a refresh token.
+   */
+  bool SuppressRefresh (Ptr<Tuple> tuple, Ptr<Value> dest);
+  void FlushRefreshTokens ();
+  void PruneRefreshTokens ();
+
+  /**
+   * \brief Handles RN_REFRESH_TOKEN and RN_REFRESH_NACK tuples, and keeps
+   * a copy of every other received tuple for later refresh tokens.
+   * \returns true if the tuple was a token or NACK and has been consumed.
+   */
+  bool DemuxRefresh (Ptr<Tuple> tuple);
+
+  /**
+   * \brief Passes a received tuple to DemuxRefresh and then DemuxRecv.
+   * When the simulator records an EventTrace, the time spent in the rules
+   * is recorded as a region named after the tuple and its action.
+   */
+  void Dispatch (Ptr<Tuple> tuple);
+  void DoDispatch (Ptr<Tuple> tuple);
+
+  /* per-thread, since the parallel simulator runs nodes concurrently */
+  static __thread RapidNetApplicationBase *m_evaluating;
+  void RecvRefreshTokens (Ptr<Tuple> token);
+  void RecvRefreshNack (Ptr<Tuple> nack);
+
+  /* Maximum number of refresh tokens carried by one tuple */
+  static const uint32_t MAX_REFRESH_TOKENS = 64;
+
+  /* Digest basis for versions, independent of the key digest */
+  static const uint32_t REFRESH_VERSION_BASIS = 0x811c9dc5U ^ 0x5bd1e995U;
+
+  struct RefreshEntry
+  {
+    uint32_t m_version;
+    Time m_timestamp;
+    Ptr<Tuple> m_tuple;
+  };
+
+  struct PendingRefresh
+  {
+    Ptr<Value> m_dest;
+    list<Ptr<Value> > m_keys;
+    list<Ptr<Value> > m_versions;
+  };
+
+  typedef std::map<uint32_t, RefreshEntry> RefreshEntryMap;
+
+  /* Last full tuple sent per destination and key digest */
+  std::map<string, RefreshEntryMap> m_refreshSent;
+  /* Last full tuple received per key digest */
+  RefreshEntryMap m_refreshRecvd;
+  std::map<string, PendingRefresh> m_refreshPending;
+  /* Destinations that do not accept refresh tokens */
+  std::set<string> m_refreshOptOut;
+  EventId m_refreshFlushEvent;
+
+  /**
+   * \brief Broadcast suppression.
+   *
+   * When BroadcastSuppression is enabled, the broadcasts of unchanged
+   * tuples go through a trickle-style BroadcastScheduler, which is reset
+   * whenever NeighborRelation gains or loses a neighbour.
+   * A broadcast tuple carries an RN_PROMISE attribute: the longest time,
+   * in seconds, until the sender broadcasts it again. The receiver keeps
+   * the tuples of NeighborRelation whose second attribute is the sender
+   * until the promise has run out, and then for their time to live, so
+   * that the neighbour links outlive the longer broadcast intervals.
+   *
+   * This delays the removal of a neighbour which has left. So that the
+   * delay stays within a few times to live, the broadcast intervals stop
+   * growing at the time to live of NeighborRelation, which bounds the
+   * promises to two times to live and one broadcast period, and the
+   * receiver caps the promises at BROADCAST_PROMISE_TTLS times to live.
+   * A departed neighbour is thus removed at most
+   * BROADCAST_PROMISE_TTLS + 1 times to live after its last broadcast,
+   * instead of one time to live without suppression.
+   *
+   * \returns true if the broadcast was suppressed.
+   */
+  bool SuppressBroadcast (Ptr<Tuple> tuple);
+  void RecvBroadcastPromise (Ptr<Tuple> tuple);
+  void UpdateBroadcastNeighbors (Ptr<Tuple> tuple);
+  bool IsPromisedNeighbor (Ptr<Tuple> tuple, Time ttl, Time now);
+  Time CapBroadcastPromise (Time promise);
+  void PruneBroadcastPromises (Time ttl, Time now);
+
+  BroadcastScheduler m_broadcastScheduler;
+  /* Time until which each neighbour promised to broadcast again */
+  std::map<Ipv4Address, Time> m_broadcastPromises;
+  /* Neighbours found in NeighborRelation */
+  std::set<Ipv4Address> m_broadcastNeighbors;
+
   /**
   * \brief Initializes the socket.
   */
@@ -592,16 +790,6 @@ public:
 
 protected:
 
-  friend class boost::serialization::access;
-
-  template<typename Archive>
-  void serialize(Archive& ar, const unsigned version)
-  {
-    std::cout << "Process App trigger" << endl;
-    ar & boost::serialization::base_object<Trigger>(*this);
-    ar & m_app;
-  }
-
   Ptr<RapidNetApplicationBase> m_app;
 };
 
@@ -617,15 +805,6 @@ public:
   virtual ~InsertTrigger () {}
 
   virtual void Invoke (Ptr<Tuple> tuple);
-
-  friend class boost::serialization::access;
-
-  template<typename Archive>
-  void serialize(Archive& ar, const unsigned version)
-  {
-    std::cout << "Process Insert trigger" << endl;
-    ar & boost::serialization::base_object<AppTrigger>(*this);
-  }
 };
 
 /**
@@ -640,15 +819,6 @@ public:
   virtual ~DeleteTrigger () {}
 
   virtual void Invoke (Ptr<Tuple> tuple);
-
-  friend class boost::serialization::access;
-
-  template<typename Archive>
-  void serialize(Archive& ar, const unsigned version)
-  {
-    std::cout << "Process Delete trigger" << endl;
-    ar & boost::serialization::base_object<AppTrigger>(*this);
-  }
 };
 
 /**
@@ -663,24 +833,10 @@ public:
   virtual ~RefreshTrigger () {}
 
   virtual void Invoke (Ptr<Tuple> tuple);
-
-  friend class boost::serialization::access;
-
-  template<typename Archive>
-  void serialize(Archive& ar, const unsigned version)
-  {
-    std::cout << "Process Refresh trigger" << endl;
-    ar & boost::serialization::base_object<AppTrigger>(*this);
-  }
 };
 
 } // namespace rapidnet
 } // namespace ns3
 
-BOOST_CLASS_EXPORT_KEY(ns3::rapidnet::AppTrigger)
-BOOST_CLASS_EXPORT_KEY(ns3::rapidnet::InsertTrigger)
-BOOST_CLASS_EXPORT_KEY(ns3::rapidnet::DeleteTrigger)
-BOOST_CLASS_EXPORT_KEY(ns3::rapidnet::RefreshTrigger)
-
 #endif // RAPIDNET_APPLICATION_BASE_H
 
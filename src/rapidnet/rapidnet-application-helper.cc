@@ -25,6 +25,7 @@
 #include "netinet/in.h"
 #include "arpa/inet.h"
 #include <netdb.h>
+#include <unistd.h>
 
 namespace ns3 {
 namespace rapidnet {
@@ -269,11 +269,32 @@ FTypeOf::New (Ptr<Expression> arg)
   return retval;
 }
 
+/*
+ * Returns the generator of the RapidNet application evaluating the rule,
+ * so that f_rand values do not depend on the other nodes. Outside of the
+ * rules, a shared generator is used.
+ */
+static RapidNetRng &
+GetRng (void)
+{
+  RapidNetApplicationBase *app = RapidNetApplicationBase::GetEvaluating ();
+  if (app != 0)
+    {
+      return app->GetRng ();
+    }
+  static RapidNetRng rng;
+  if (!rng.IsInitialized ())
+    {
+      rng.SetNode (Simulator::NO_CONTEXT);
+    }
+  return rng;
+}
+
 Ptr<Value>
 FRand::Eval (Ptr<Tuple> tuple)
 {
   stringstream ss;
-  ss << rand ();
+  ss << GetRng ().GetInteger (RAND_MAX);
   return StrValue::New (ss.str ());
 }
 
@@ -0,0 +1,136 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "rapidnet-rng.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+namespace rapidnet {
+
+RapidNetRng::RapidNetRng ()
+  : m_stream (0),
+    m_key (0),
+    m_counter (0)
+{}
+
+RapidNetRng::~RapidNetRng ()
+{
+  delete m_stream;
+}
+
+void
+RapidNetRng::Advance (uint64_t n, int32_t e)
+{
+  // n * 2^e steps, one power of two at a time
+  for (int32_t bit = 0; n != 0; bit++, n >>= 1)
+    {
+      if (n & 1)
+        {
+          m_stream->AdvanceState (e + bit, 0);
+        }
+    }
+}
+
+void
+RapidNetRng::SetNode (uint32_t nodeId)
+{
+  // built from the package seed rather than allocated as the next stream
+  // of the package, which would shift the RandomVariable streams.
+  uint32_t seed[6];
+  RngStream::GetPackageSeed (seed);
+  delete m_stream;
+  m_stream = new RngStream (seed);
+  m_stream->AdvanceState (180, 0);
+  Advance (RngStream::GetPackageRun (), 140);
+  Advance (nodeId, 76);
+  // make the advanced state the start of the stream and substream
+  m_stream->GetState (seed);
+  m_stream->SetSeeds (seed);
+
+  m_key = (uint64_t) (m_stream->RandU01 () * 4294967296.0) << 32;
+  m_key |= (uint64_t) (m_stream->RandU01 () * 4294967296.0);
+  m_counter = 0;
+}
+
+bool
+RapidNetRng::IsInitialized (void) const
+{
+  return m_stream != 0;
+}
+
+double
+RapidNetRng::GetValue (void)
+{
+  NS_ASSERT (IsInitialized ());
+  return m_stream->RandU01 ();
+}
+
+uint32_t
+RapidNetRng::GetInteger (uint32_t n)
+{
+  return (uint32_t) (GetValue () * n);
+}
+
+uint32_t
+RapidNetRng::GetFastInteger (uint32_t n)
+{
+  NS_ASSERT (IsInitialized ());
+  // SplitMix64 (Steele, Lea and Flood, OOPSLA 2014): a Weyl sequence
+  // hashed by a 64-bit finalizer.
+  uint64_t z = m_key + (++m_counter) * 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= z >> 31;
+  // maps the high 32 bits to [0, n) without a division
+  return (uint32_t) (((z >> 32) * n) >> 32);
+}
+
+void
+RapidNetRng::Save (std::ostream &os) const
+{
+  NS_ASSERT (IsInitialized ());
+  uint32_t state[6];
+  m_stream->GetState (state);
+  os.write (reinterpret_cast<const char *> (state), sizeof (state));
+  os.write (reinterpret_cast<const char *> (&m_key), sizeof (m_key));
+  os.write (reinterpret_cast<const char *> (&m_counter), sizeof (m_counter));
+}
+
+bool
+RapidNetRng::Restore (std::istream &is)
+{
+  NS_ASSERT (IsInitialized ());
+  uint32_t state[6];
+  uint64_t key;
+  uint64_t counter;
+  is.read (reinterpret_cast<char *> (state), sizeof (state));
+  is.read (reinterpret_cast<char *> (&key), sizeof (key));
+  is.read (reinterpret_cast<char *> (&counter), sizeof (counter));
+  if (!is.good ())
+    {
+      return false;
+    }
+  m_stream->SetState (state);
+  m_key = key;
+  m_counter = counter;
+  return true;
+}
+
+} // namespace rapidnet
+} // namespace ns3
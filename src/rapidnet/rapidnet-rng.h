@@ -0,0 +1,104 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef RAPIDNET_RNG_H
+#define RAPIDNET_RNG_H
+
+#include <stdint.h>
+#include <iostream>
+#include "ns3/rng-stream.h"
+
+namespace ns3 {
+namespace rapidnet {
+
+/**
+ * \ingroup rapidnet_library
+ *
+ * \brief The random numbers of one RapidNet node.
+ *
+ * Unlike the RandomVariable objects, whose streams are allocated in
+ * creation order, the numbers of a node only depend on the global seed,
+ * the run number and the id of the node: they do not change when nodes
+ * are added to or removed from the simulation, nor when the simulation
+ * is partitioned. The RngStream of node n is the substream n of a block
+ * of 2^140 values per run, far away (2^180 values) from the streams used
+ * by the RandomVariable objects.
+ *
+ * GetFastInteger is a cheap counter-based generator (SplitMix64 of a key
+ * drawn from the node stream and of a counter), for the hot paths such as
+ * the send jitter.
+ */
+class RapidNetRng
+{
+public:
+  RapidNetRng ();
+  ~RapidNetRng ();
+
+  /**
+   * \brief Positions the generator on the stream of the given node.
+   */
+  void SetNode (uint32_t nodeId);
+
+  /**
+   * \brief Returns true if SetNode was called.
+   */
+  bool IsInitialized (void) const;
+
+  /**
+   * \brief Returns a uniform value in [0, 1) from the node stream.
+   */
+  double GetValue (void);
+
+  /**
+   * \brief Returns a uniform integer in [0, n) from the node stream.
+   */
+  uint32_t GetInteger (uint32_t n);
+
+  /**
+   * \brief Returns an integer in [0, n) from the counter-based generator.
+   */
+  uint32_t GetFastInteger (uint32_t n);
+
+  /**
+   * \brief Writes the position of both generators to the given binary
+   *        stream.
+   */
+  void Save (std::ostream &os) const;
+
+  /**
+   * \brief Reads back the position written by @see Save(). The generator
+   *        must be on the stream of the same node. Returns false if the
+   *        stream is truncated.
+   */
+  bool Restore (std::istream &is);
+
+private:
+  RapidNetRng (const RapidNetRng &);
+  RapidNetRng &operator = (const RapidNetRng &);
+
+  void Advance (uint64_t n, int32_t e);
+
+  RngStream *m_stream;
+  uint64_t m_key;
+  uint64_t m_counter;
+};
+
+} // namespace rapidnet
+} // namespace ns3
+
+#endif // RAPIDNET_RNG_H
@@ -23,8 +23,13 @@
 #include <sstream>
 #include "ns3/simulator.h"
 #include "ns3/random-variable.h"
+#include "ns3/rng-stream.h"
 #include "ns3/rapidnet-types.h"
 #include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include "ns3/abort.h"
+#include "ns3/ipv4.h"
+#include "ns3/ref-count-base.h"
 #include "ns3/chord.h"
 
 using namespace std;
@@ -49,9 +54,17 @@ InitRapidNetApps (int numNodes, Ptr<RapidNetApplicationHelper> appHelper,
   InternetStackHelper stack;
   stack.Install (csmaNodes);
 
+  // the network and broadcast addresses are not assigned
+  uint32_t prefix = 24;
+  while (prefix > 1 && (uint32_t) numNodes > (1u << (32 - prefix)) - 2)
+    {
+      prefix--;
+    }
+  Ipv4Mask mask (0xffffffff << (32 - prefix));
+
   Ipv4AddressHelper address;
 
-  address.SetBase (base, DEFAULT_MASK);
+  address.SetBase (base.CombineMask (mask), mask);
   address.Assign (csmaDevices);
 
   CsmaHelper::EnablePcapAll (pcapLogFileName, true);
@@ -95,16 +108,36 @@ PrintRelation (ApplicationContainer apps, string relnName, ostream& os)
 }
 
 NetDeviceContainer
-InstallWifi (NodeContainer nodes, bool enablePcap, string pcapFilename)
+InstallWifi (NodeContainer nodes, bool enablePcap, string pcapFilename,
+  bool enableQos, uint32_t maxAmsduSize)
 {
-  NS_LOG_INFO ("Installing Wifi");
+  NS_LOG_INFO ("Installing Wifi" << (enableQos ? " with QoS" : ""));
   WifiHelper wifi = WifiHelper::Default ();
-  wifi.SetRemoteStationManager ("ns3::ArfWifiManager");
   YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
   YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
   wifiPhy.SetChannel (wifiChannel.Create ());
-  NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
-  NetDeviceContainer retval = wifi.Install(wifiPhy, wifiMac, nodes);
+  NetDeviceContainer retval;
+  if (enableQos)
+    {
+      // an A-MSDU is sent as a single MPDU: it must not be fragmented.
+      wifi.SetRemoteStationManager ("ns3::ArfWifiManager",
+        "FragmentationThreshold", UintegerValue (maxAmsduSize + 100));
+      QosWifiMacHelper wifiMac = QosWifiMacHelper::Default ();
+      wifiMac.SetType ("ns3::QadhocWifiMac");
+      AccessClass acs[] = {AC_VO, AC_VI, AC_BE, AC_BK};
+      for (uint32_t i = 0; i < 4; i++)
+        {
+          wifiMac.SetMsduAggregatorForAc (acs[i], "ns3::MsduStandardAggregator",
+            "MaxAmsduSize", UintegerValue (maxAmsduSize));
+        }
+      retval = wifi.Install (wifiPhy, wifiMac, nodes);
+    }
+  else
+    {
+      wifi.SetRemoteStationManager ("ns3::ArfWifiManager");
+      NqosWifiMacHelper wifiMac = NqosWifiMacHelper::Default ();
+      retval = wifi.Install (wifiPhy, wifiMac, nodes);
+    }
   if (enablePcap)
     {
       wifiPhy.EnablePcapAll (pcapFilename);
@@ -275,7 +308,7 @@ list<string>
 Tokenize (string names, char delim=',')
 {
   list<string> retval;
-  uint32_t lastPos = 0, pos = 0;
+  string::size_type lastPos = 0, pos = 0;
   do
     {
       pos = names.find_first_of (delim, lastPos);
@@ -347,6 +380,7 @@ Ptr<Tuple> GetApptableTuple (string srcAddr, string destAddr, int cost)
 void
 ImportIntoApps (ApplicationContainer& apps, stringstream& strstr)
 {
+  streampos start = strstr.tellg ();
   for (ApplicationContainer::Iterator it = apps.Begin(); it != apps.End(); it++)
     {
       Ptr<RapidNetApplicationBase> app = Ptr<RapidNetApplicationBase> (
@@ -365,10 +399,17 @@ ImportIntoApps (ApplicationContainer& apps, stringstream& strstr)
       //Loopback
       app->Insert (GetApptableTuple (addr, addr, 1));
 
+      // Every application reads all the lines
+      strstr.clear ();
+      strstr.seekg (start);
       while (!strstr.eof ())
         {
           getline (strstr, line);
           list<string> words = Tokenize (line, ' ');
+          if (words.size () < 3)
+            {
+              continue;
+            }
           list<string>::iterator it = words.begin ();
           string action = *it++;
           string srcAddr = *it++;
@@ -606,6 +647,244 @@ SetMaxJitter (ApplicationContainer& apps, uint32_t maxJitter)
     }
 }
 
+static const uint32_t CHECKPOINT_MAGIC = 0x524e434b; // "RNCK"
+static const uint32_t CHECKPOINT_VERSION = 2;
+
+void
+SaveCheckpoint (ApplicationContainer apps, string fileName)
+{
+  ofstream os (fileName.c_str (), ios::out | ios::binary);
+  NS_ABORT_MSG_UNLESS (os.is_open (), "Cannot open checkpoint " << fileName);
+
+  uint32_t header[5] = {CHECKPOINT_MAGIC, CHECKPOINT_VERSION,
+    SeedManager::GetSeed (), SeedManager::GetRun (), apps.GetN ()};
+  int64_t now = Simulator::Now ().GetTimeStep ();
+  uint32_t nextSeed[6];
+  RngStream::GetNextSeed (nextSeed);
+  os.write (reinterpret_cast<const char *> (header), sizeof (header));
+  os.write (reinterpret_cast<const char *> (&now), sizeof (now));
+  os.write (reinterpret_cast<const char *> (nextSeed), sizeof (nextSeed));
+
+  Ptr<RapidNetApplicationBase> app;
+  for (ApplicationContainer::Iterator it = apps.Begin (); it != apps.End ();
+    ++it)
+    {
+      app = DynamicCast<RapidNetApplicationBase, Application> (*it);
+      app->Checkpoint (os);
+    }
+  NS_LOG_INFO ("Saved checkpoint " << fileName << " at " << Simulator::Now ());
+}
+
+static void
+DoRestoreCheckpoint (ApplicationContainer apps, string fileName,
+  streampos offset, bool random)
+{
+  ifstream is (fileName.c_str (), ios::in | ios::binary);
+  is.seekg (offset);
+  uint32_t nextSeed[6];
+  is.read (reinterpret_cast<char *> (nextSeed), sizeof (nextSeed));
+  NS_ABORT_MSG_UNLESS (is.good (), "Truncated checkpoint " << fileName);
+  if (random)
+    {
+      // the streams allocated from now on are those of the original run
+      RngStream::SetNextSeed (nextSeed);
+    }
+  Ptr<RapidNetApplicationBase> app;
+  for (ApplicationContainer::Iterator it = apps.Begin (); it != apps.End ();
+    ++it)
+    {
+      app = DynamicCast<RapidNetApplicationBase, Application> (*it);
+      NS_ABORT_MSG_UNLESS (app->Restore (is, random), "Truncated checkpoint " << fileName);
+    }
+  NS_LOG_INFO ("Restored checkpoint " << fileName << " at " << Simulator::Now ());
+}
+
+Time
+RestoreCheckpoint (ApplicationContainer apps, string fileName)
+{
+  ifstream is (fileName.c_str (), ios::in | ios::binary);
+  NS_ABORT_MSG_UNLESS (is.is_open (), "Cannot open checkpoint " << fileName);
+
+  uint32_t header[5];
+  int64_t now;
+  is.read (reinterpret_cast<char *> (header), sizeof (header));
+  is.read (reinterpret_cast<char *> (&now), sizeof (now));
+  NS_ABORT_MSG_UNLESS (is.good () && header[0] == CHECKPOINT_MAGIC
+    && header[1] == CHECKPOINT_VERSION, fileName << " is not a checkpoint");
+  NS_ABORT_MSG_UNLESS (header[4] == apps.GetN (), "Checkpoint " << fileName
+    << " has " << header[4] << " applications, not " << apps.GetN ());
+
+  SeedManager::SetSeed (header[2]);
+  // in another run, the random numbers restart from those of that run
+  bool random = SeedManager::GetRun () == header[3];
+  NS_LOG_INFO ("Checkpoint " << fileName << " was taken in run " << header[3]
+    << ", restoring in run " << SeedManager::GetRun ()
+    << (random ? ", random numbers included" : ", random numbers restarted"));
+  Time time = TimeStep (now);
+  apps.Start (time);
+  // scheduled after the applications start, which create the relations
+  Simulator::Schedule (time - Simulator::Now (), &DoRestoreCheckpoint, apps,
+    fileName, is.tellg (), random);
+  return time;
+}
+
+/**
+ * Sweep perturbations and results
+ */
+
+class SweepPerturbation : public RefCountBase
+{
+public:
+  SweepPerturbation (ApplicationContainer apps)
+    : m_apps (apps)
+  {}
+
+  void Add (string action, string arg, double delay)
+  {
+    Action a = {action, arg, delay};
+    m_actions.push_back (a);
+  }
+
+  void Apply ()
+  {
+    for (list<Action>::iterator it = m_actions.begin (); it != m_actions.end (); ++it)
+      {
+        Simulator::Schedule (Seconds (it->m_delay), &SweepPerturbation::Do,
+          Ptr<SweepPerturbation> (this), it->m_action, it->m_arg);
+      }
+  }
+
+private:
+  void Do (string action, string arg)
+  {
+    NS_LOG_INFO ("Perturbation " << action << "=" << arg);
+    if (action == "down" || action == "up")
+      {
+        uint32_t id = atoi (arg.c_str ());
+        NS_ABORT_MSG_UNLESS (id >= 1 && id <= m_apps.GetN (), "No node " << arg);
+        Ptr<Ipv4> ipv4 = m_apps.Get (id - 1)->GetNode ()->GetObject<Ipv4> ();
+        // interface 0 is the loopback
+        for (uint32_t i = 1; i < ipv4->GetNInterfaces (); ++i)
+          {
+            if (action == "down")
+              {
+                ipv4->SetDown (i);
+              }
+            else
+              {
+                ipv4->SetUp (i);
+              }
+          }
+      }
+    else if (action == "apptable")
+      {
+        ifstream file (arg.c_str ());
+        NS_ABORT_MSG_UNLESS (file.is_open (), "Cannot open apptable " << arg);
+        stringstream strstr;
+        strstr << file.rdbuf ();
+        ImportIntoApps (m_apps, strstr);
+      }
+    else
+      {
+        NS_FATAL_ERROR ("Unknown perturbation: " << action);
+      }
+  }
+
+  struct Action
+  {
+    string m_action;
+    string m_arg;
+    double m_delay;
+  };
+
+  ApplicationContainer m_apps;
+  list<Action> m_actions;
+};
+
+void
+AddSweepVariants (Sweep& sweep, ApplicationContainer apps, string spec)
+{
+  list<string> variants = Tokenize (spec, ';');
+  for (list<string>::iterator it = variants.begin (); it != variants.end (); ++it)
+    {
+      if (it->empty ())
+        {
+          continue;
+        }
+      string::size_type colon = it->find (':');
+      string name = it->substr (0, colon);
+      Ptr<SweepPerturbation> perturbation = Create<SweepPerturbation> (apps);
+      if (colon != string::npos)
+        {
+          list<string> actions = Tokenize (it->substr (colon + 1), ',');
+          for (list<string>::iterator jt = actions.begin (); jt != actions.end (); ++jt)
+            {
+              if (jt->empty ())
+                {
+                  continue;
+                }
+              string::size_type equal = jt->find ('=');
+              string::size_type at = jt->find ('@');
+              NS_ABORT_MSG_UNLESS (equal != string::npos, "Bad perturbation: " << *jt);
+              double delay = at == string::npos ? 0 : atof (jt->substr (at + 1).c_str ());
+              perturbation->Add (jt->substr (0, equal),
+                jt->substr (equal + 1, at == string::npos ? string::npos : at - equal - 1),
+                delay);
+            }
+        }
+      sweep.AddVariant (name, MakeCallback (&SweepPerturbation::Apply, perturbation));
+    }
+}
+
+class SweepCollector : public RefCountBase
+{
+public:
+  SweepCollector (ApplicationContainer apps, string relations)
+    : m_apps (apps), m_relations (Tokenize (relations, ','))
+  {}
+
+  void Collect ()
+  {
+    double packetsSent = 0, packetsReceived = 0, bytesSent = 0, bytesReceived = 0;
+    map<string, double> tuples;
+    for (ApplicationContainer::Iterator it = m_apps.Begin (); it != m_apps.End (); ++it)
+      {
+        Ptr<RapidNetApplicationBase> app =
+          DynamicCast<RapidNetApplicationBase, Application> (*it);
+        packetsSent += app->totalPacketsSent;
+        packetsReceived += app->totalPacketsReceived;
+        bytesSent += app->BytesOfDataSent;
+        bytesReceived += app->BytesOfDataReceived;
+        for (list<string>::iterator jt = m_relations.begin (); jt != m_relations.end (); ++jt)
+          {
+            if (app->GetDatabase ()->HasRelation (*jt))
+              {
+                tuples[*jt] += app->GetRelation (*jt)->Count ();
+              }
+          }
+      }
+    Sweep::Record ("packets_sent", packetsSent);
+    Sweep::Record ("packets_received", packetsReceived);
+    Sweep::Record ("bytes_sent", bytesSent);
+    Sweep::Record ("bytes_received", bytesReceived);
+    for (list<string>::iterator jt = m_relations.begin (); jt != m_relations.end (); ++jt)
+      {
+        Sweep::Record (*jt, tuples[*jt]);
+      }
+  }
+
+private:
+  ApplicationContainer m_apps;
+  list<string> m_relations;
+};
+
+void
+SetSweepCollector (Sweep& sweep, ApplicationContainer apps, string relations)
+{
+  sweep.SetCollector (MakeCallback (&SweepCollector::Collect,
+    Create<SweepCollector> (apps, relations)));
+}
+
 /**
  * Chord specific functions
  */
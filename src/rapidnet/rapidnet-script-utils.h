@@ -34,6 +34,7 @@
 #include "ns3/wifi-helper.h"
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/nqos-wifi-mac-helper.h"
+#include "ns3/qos-wifi-mac-helper.h"
 #include "ns3/csma-helper.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -48,6 +49,7 @@
 #include "rapidnet-utils.h"
 #include "app-decorator-trigger.h"
 #include "rapidnet-decorator-frontend.h"
+#include "rapidnet-sweep.h"
 
 //Scripts should use 1-based indexing
 #define app(i) (apps.Get(i-1)->GetObject<RapidNetApplicationBase>())
@@ -85,6 +87,9 @@ namespace rapidnet {
  * \brief Initializes RapidNet applications using the given
  * helper on given the given number of nodes and sets
  * addresses with the given base.
+ *
+ * The nodes share one CSMA segment, whose mask is widened beyond
+ * DEFAULT_MASK when the nodes do not fit in it.
  */
 ApplicationContainer
 InitRapidNetApps (int numNodes, Ptr<RapidNetApplicationHelper> appHelper,
@@ -99,9 +104,15 @@ PrintRelation (ApplicationContainer apps, string relnName, ostream& os = cout);
 
 /**
  * \brief Installs Wifi NetDevices on the the nodes and returns the container.
+ *
+ * With enableQos, the devices use an ns3::QadhocWifiMac which aggregates
+ * the queued unicast frames of each access category into A-MSDUs of up
+ * to maxAmsduSize bytes. RapidNet tags its packets with the access
+ * category of their tuple priority when its WifiQos attribute is set.
  */
 NetDeviceContainer
-InstallWifi (NodeContainer nodes, bool enablePcap, string pcapFilename);
+InstallWifi (NodeContainer nodes, bool enablePcap, string pcapFilename,
+  bool enableQos = false, uint32_t maxAmsduSize = 3839);
 
 /**
  * \brief Installs Ethernet NetDevices on the the nodes and returns the container.
@@ -206,6 +217,71 @@ ScheduleEpidemicMessages (ApplicationContainer& apps, int count,
 void
 SetMaxJitter (ApplicationContainer& apps, uint32_t maxJitter);
 
+/**
+ * \brief Saves the databases of all applications, the simulation time,
+ *        the random number seed and the position of the random number
+ *        streams to the given file.
+ *
+ * Only the state which determines the future of the protocols is saved:
+ * the pending events cannot be written out (they hold arbitrary function
+ * objects). Periodic rules and soft-state timeouts are rescheduled by the
+ * applications when they start again; any other pending event, such as a
+ * one-shot timer of an application or a packet in flight, is lost, as
+ * after a short network outage. The random numbers saved are those of the
+ * nodes (see RapidNetRng) and the seed of the next RandomVariable stream;
+ * the streams of the existing RandomVariable objects are not. Schedule it
+ * at the end of the warm-up:
+ *
+ * \code
+ * Simulator::Schedule (Seconds (warmup), &SaveCheckpoint, apps, "converged.ckpt");
+ * \endcode
+ */
+void
+SaveCheckpoint (ApplicationContainer apps, string fileName);
+
+/**
+ * \brief Resumes a simulation from a file written by @see SaveCheckpoint().
+ *
+ * The applications must be installed on the same topology as when the
+ * checkpoint was taken. They are started at the checkpoint time, at which
+ * their databases are restored: the simulator skips straight to it since
+ * nothing else is scheduled before. Returns the checkpoint time, at which
+ * the experiment starts.
+ *
+ * In the run in which the checkpoint was taken, the random numbers of
+ * the nodes carry on from where they were, and the RandomVariable objects
+ * created afterwards get the streams they had in the original simulation.
+ * With another run number (--RngRun), they restart from those of that run
+ * instead, so that each what-if experiment can draw its own.
+ */
+Time
+RestoreCheckpoint (ApplicationContainer apps, string fileName);
+
+/**
+ * \brief Adds the variants described by spec to the sweep.
+ *
+ * The variants are separated by ';'. Each one is a name, optionally
+ * followed by ':' and a comma-separated list of perturbations, applied at
+ * the end of the prefix or, with "@<seconds>", that long after:
+ *  - "down=<node>" takes all the interfaces of the node down,
+ *  - "up=<node>" brings them back up,
+ *  - "apptable=<file>" imports the INSERT/DELETE lines of the file into
+ *    the apptable relations (see @see ImportAppTable()).
+ *
+ * Nodes are numbered from 1. For example:
+ * "base;fail3:down=3;flap3:down=3,up=3@20;cut:apptable=cut.txt@5".
+ */
+void
+AddSweepVariants (Sweep& sweep, ApplicationContainer apps, string spec);
+
+/**
+ * \brief Makes each continuation of the sweep record the packets and bytes
+ *        sent and received by all the applications, and the number of
+ *        tuples in each of the given relations (comma separated).
+ */
+void
+SetSweepCollector (Sweep& sweep, ApplicationContainer apps, string relations);
+
 /**
  * \brief Initializes the chord applications.
  */
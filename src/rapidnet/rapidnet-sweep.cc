@@ -0,0 +1,232 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#include "rapidnet-sweep.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+NS_LOG_COMPONENT_DEFINE ("Sweep");
+
+namespace ns3 {
+namespace rapidnet {
+
+vector<pair<string, double> > Sweep::s_results;
+
+Sweep::Sweep ()
+{
+  long n = sysconf (_SC_NPROCESSORS_ONLN);
+  m_maxProcesses = n > 0 ? n : 1;
+}
+
+void
+Sweep::AddVariant (string name, Callback<void> perturbation)
+{
+  m_variants.push_back (make_pair (name, perturbation));
+}
+
+void
+Sweep::SetCollector (Callback<void> collector)
+{
+  m_collector = collector;
+}
+
+void
+Sweep::SetMaxProcesses (uint32_t maxProcesses)
+{
+  m_maxProcesses = maxProcesses > 0 ? maxProcesses : 1;
+}
+
+void
+Sweep::Record (string column, double value)
+{
+  s_results.push_back (make_pair (column, value));
+}
+
+string
+Sweep::GetPartFileName (string tableFile, uint32_t index)
+{
+  stringstream name;
+  name << tableFile << ".part" << index;
+  return name.str ();
+}
+
+bool
+Sweep::Run (Time prefixEnd, string tableFile)
+{
+  Simulator::Stop (prefixEnd - Simulator::Now ());
+  Simulator::Run ();
+  NS_LOG_INFO ("Prefix done at " << Simulator::Now () << ", running "
+    << m_variants.size () << " variants");
+
+  bool success = true;
+  uint32_t running = 0;
+  for (uint32_t i = 0; i <= m_variants.size (); ++i)
+    {
+      // wait for a child to end when all the slots are taken, and for all
+      // of them after the last variant is started.
+      while (running > 0 && (running == m_maxProcesses || i == m_variants.size ()))
+        {
+          int status;
+          if (wait (&status) < 0)
+            {
+              break;
+            }
+          success = success && WIFEXITED (status) && WEXITSTATUS (status) == 0;
+          running--;
+        }
+      if (i == m_variants.size ())
+        {
+          break;
+        }
+      Flush ();
+      pid_t pid = fork ();
+      if (pid == 0)
+        {
+          RunVariant (i, tableFile);
+        }
+      else if (pid < 0)
+        {
+          NS_LOG_ERROR ("Cannot fork variant " << m_variants[i].first);
+          success = false;
+          continue;
+        }
+      running++;
+    }
+  return WriteTable (tableFile) && success;
+}
+
+void
+Sweep::RunVariant (uint32_t index, string tableFile)
+{
+  string logFile = tableFile + "." + m_variants[index].first + ".log";
+  int fd = open (logFile.c_str (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd >= 0)
+    {
+      dup2 (fd, STDERR_FILENO);
+      close (fd);
+    }
+
+  s_results.clear ();
+  m_variants[index].second ();
+  Simulator::Run ();
+  if (!m_collector.IsNull ())
+    {
+      m_collector ();
+    }
+
+  ofstream part (GetPartFileName (tableFile, index).c_str ());
+  for (vector<pair<string, double> >::iterator it = s_results.begin ();
+    it != s_results.end (); ++it)
+    {
+      part << it->first << '\t' << it->second << '\n';
+    }
+  part.close ();
+  Flush ();
+  // skip the destructors of the state shared with the parent
+  _exit (part.fail () ? 1 : 0);
+}
+
+bool
+Sweep::RunInChild (Callback<void> run)
+{
+  Flush ();
+  pid_t pid = fork ();
+  if (pid == 0)
+    {
+      run ();
+      Flush ();
+      _exit (0);
+    }
+  int status;
+  return pid > 0 && waitpid (pid, &status, 0) == pid && WIFEXITED (status)
+    && WEXITSTATUS (status) == 0;
+}
+
+void
+Sweep::Flush (void)
+{
+  // the buffered output would otherwise be written once by each child
+  cout.flush ();
+  clog.flush ();
+  fflush (NULL);
+}
+
+bool
+Sweep::WriteTable (string tableFile)
+{
+  // the columns, in the order they are first recorded
+  vector<string> columns;
+  vector<map<string, string> > rows (m_variants.size ());
+  bool success = true;
+  for (uint32_t i = 0; i < m_variants.size (); ++i)
+    {
+      string partFile = GetPartFileName (tableFile, i);
+      ifstream part (partFile.c_str ());
+      if (!part.is_open ())
+        {
+          NS_LOG_ERROR ("No results for variant " << m_variants[i].first);
+          success = false;
+          continue;
+        }
+      string column, value;
+      while (getline (part, column, '\t') && getline (part, value))
+        {
+          if (find (columns.begin (), columns.end (), column) == columns.end ())
+            {
+              columns.push_back (column);
+            }
+          rows[i][column] = value;
+        }
+      part.close ();
+      remove (partFile.c_str ());
+    }
+
+  ofstream table (tableFile.c_str ());
+  table << "variant";
+  for (vector<string>::iterator it = columns.begin (); it != columns.end (); ++it)
+    {
+      table << '\t' << *it;
+    }
+  table << '\n';
+  for (uint32_t i = 0; i < m_variants.size (); ++i)
+    {
+      table << m_variants[i].first;
+      for (vector<string>::iterator it = columns.begin (); it != columns.end (); ++it)
+        {
+          map<string, string>::iterator value = rows[i].find (*it);
+          table << '\t' << (value == rows[i].end () ? "-" : value->second);
+        }
+      table << '\n';
+    }
+  NS_LOG_INFO ("Wrote " << m_variants.size () << " variants to " << tableFile);
+  return success && !table.fail ();
+}
+
+} // namespace rapidnet
+} // namespace ns3
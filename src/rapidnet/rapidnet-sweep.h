@@ -0,0 +1,115 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+#ifndef RAPIDNET_SWEEP_H
+#define RAPIDNET_SWEEP_H
+
+#include <string>
+#include <vector>
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+
+using namespace std;
+
+namespace ns3 {
+namespace rapidnet {
+
+/**
+ * \ingroup rapidnet_library
+ *
+ * \brief Runs several continuations of a simulation from a common prefix.
+ *
+ * The simulation is run once up to the end of the prefix (typically, until
+ * the protocols have converged). The process is then forked once per
+ * variant: each child process inherits the complete simulator state,
+ * including the pending events, applies the perturbation of its variant
+ * (link or node failures, apptable changes, ...) and runs to the end of
+ * the simulation. At most SetMaxProcesses () children run at a time.
+ *
+ * At the end of each continuation, the collector is invoked and calls
+ * @see Record() for every result; the parent process writes the results of
+ * all the variants as one tab-separated table, one row per variant. The
+ * standard error of each child, where RapidNet logs go, is redirected to
+ * "<table>.<variant>.log".
+ *
+ * Sweep does not work with the realtime or the parallel simulator: only
+ * the thread which calls fork () survives in the child.
+ */
+class Sweep
+{
+public:
+  Sweep ();
+
+  /**
+   * \brief Adds a continuation. The perturbation is invoked in the child
+   *        process at the end of the prefix.
+   */
+  void AddVariant (string name, Callback<void> perturbation);
+
+  /**
+   * \brief Sets the callback invoked in each child process when its
+   *        simulation has ended, to record its results.
+   */
+  void SetCollector (Callback<void> collector);
+
+  /**
+   * \brief Sets the maximum number of child processes which run at once.
+   *        Defaults to the number of processors.
+   */
+  void SetMaxProcesses (uint32_t maxProcesses);
+
+  /**
+   * \brief Runs the simulation until prefixEnd, then all the variants until
+   *        the simulation stops, and writes the results to tableFile.
+   *        Returns false if a continuation failed.
+   */
+  bool Run (Time prefixEnd, string tableFile);
+
+  /**
+   * \brief Records a result of the current continuation.
+   */
+  static void Record (string column, double value);
+
+  /**
+   * \brief Runs the callback in a child process and waits for it to end.
+   *
+   * The child exits without running any destructor, so a simulation which
+   * the callback builds from scratch leaves no global state (node list,
+   * address generator, random streams, ...) to the next one: the
+   * benchmarks which compare several configurations run each of them this
+   * way. Returns false if the child could not be forked or failed.
+   */
+  static bool RunInChild (Callback<void> run);
+
+private:
+  void RunVariant (uint32_t index, string tableFile);
+  static void Flush (void);
+  bool WriteTable (string tableFile);
+  static string GetPartFileName (string tableFile, uint32_t index);
+
+  vector<pair<string, Callback<void> > > m_variants;
+  Callback<void> m_collector;
+  uint32_t m_maxProcesses;
+
+  static vector<pair<string, double> > s_results;
+};
+
+} // namespace rapidnet
+} // namespace ns3
+
+#endif // RAPIDNET_SWEEP_H
@@ -24,15 +24,19 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("RapidNetTCPConnection");
 NS_OBJECT_ENSURE_REGISTERED (RapidNetTCPHeader);
 
+const uint8_t RapidNetTCPConnection::PRIORITY_CLASSES;
+
 RapidNetTCPConnection::RapidNetTCPConnection (Ipv4Address ipAddress, uint16_t port, Ptr<Socket> socket)
 {
   m_ipAddress = ipAddress;
   m_port = port;
   m_socket = socket;
   m_txState = TX_IDLE;
+  m_txScheduling = TX_STRICT;
   m_rxState = RX_IDLE;
   m_totalTxBytes = 0;
   m_currentTxBytes = 0;
+  ClearTxQueues ();
   m_lastActivityTime = Simulator::Now ();
   m_socket->SetRecvCallback (MakeCallback (&RapidNetTCPConnection::ReadTCPBuffer, this));
 }
@@ -43,9 +47,11 @@ RapidNetTCPConnection::RapidNetTCPConnection ()
   m_port = 0;
   m_socket = 0;
   m_txState = TX_IDLE;
+  m_txScheduling = TX_STRICT;
   m_rxState = RX_IDLE;
   m_totalTxBytes = 0;
   m_currentTxBytes = 0;
+  ClearTxQueues ();
   m_lastActivityTime = Simulator::Now ();
   m_socket->SetRecvCallback (MakeCallback (&RapidNetTCPConnection::ReadTCPBuffer, this));
 }
@@ -56,9 +62,11 @@ RapidNetTCPConnection::RapidNetTCPConnection (const RapidNetTCPConnection &conne
   m_port = rapidNetTCPConnection->GetPort ();
   m_socket = rapidNetTCPConnection->GetSocket ();
   m_txState = TX_IDLE;
+  m_txScheduling = connection.m_txScheduling;
   m_rxState = RX_IDLE;
   m_totalTxBytes = 0;
   m_currentTxBytes = 0;
+  ClearTxQueues ();
   m_lastActivityTime = Simulator::Now ();
   m_connState = rapidNetTCPConnection->GetConnState();
   m_socket->SetRecvCallback (MakeCallback (&RapidNetTCPConnection::ReadTCPBuffer, this));
@@ -78,7 +86,7 @@ RapidNetTCPConnection::~RapidNetTCPConnection ()
   m_rxState = RX_IDLE;
   m_totalTxBytes = 0;
   m_currentTxBytes = 0;
-  m_txPacketList.clear ();
+  ClearTxQueues ();
 }
 
 
@@ -97,7 +105,7 @@ RapidNetTCPConnection::DoDispose ()
   m_rxState = RX_IDLE;
   m_totalTxBytes = 0;
   m_currentTxBytes = 0;
-  m_txPacketList.clear ();
+  ClearTxQueues ();
 }
 
 RapidNetTCPConnection::ConnectionState
@@ -130,12 +138,68 @@ RapidNetTCPConnection::GetSocket ()
   return m_socket;
 }
 
+void
+RapidNetTCPConnection::SetTxScheduling (TxScheduling scheduling)
+{
+  m_txScheduling = scheduling;
+}
+
+uint32_t
+RapidNetTCPConnection::GetTxQueueSize (uint8_t priority)
+{
+  return priority < PRIORITY_CLASSES ? m_txPacketList[priority].size () : 0;
+}
+
+void
+RapidNetTCPConnection::ClearTxQueues (void)
+{
+  for (uint8_t i = 0; i < PRIORITY_CLASSES; i++)
+    {
+      m_txPacketList[i].clear ();
+      m_txCredits[i] = 0;
+    }
+}
+
+uint8_t
+RapidNetTCPConnection::SelectTxQueue (void)
+{
+  for (int round = 0; round < 2; round++)
+    {
+      for (uint8_t i = 0; i < PRIORITY_CLASSES; i++)
+        {
+          if (m_txPacketList[i].empty ())
+            {
+              continue;
+            }
+          if (m_txScheduling == TX_STRICT)
+            {
+              return i;
+            }
+          if (m_txCredits[i] > 0)
+            {
+              m_txCredits[i]--;
+              return i;
+            }
+        }
+      // Every backlogged class has used its share: start a new round
+      for (uint8_t i = 0; i < PRIORITY_CLASSES; i++)
+        {
+          m_txCredits[i] = 1 << (PRIORITY_CLASSES - 1 - i);
+        }
+    }
+  return PRIORITY_CLASSES;
+}
+
 void 
-RapidNetTCPConnection::SendTCPData (Ptr<Packet> packet)
+RapidNetTCPConnection::SendTCPData (Ptr<Packet> packet, uint8_t priority)
 {
-  // Add packet to pending tx list
-  m_txPacketList.push_back (packet);
-  NS_LOG_INFO ("Preparing to send TCP Data. m_txState: " << m_txState << " m_connState: " << m_connState);
+  // Add packet to pending tx list of its class
+  if (priority >= PRIORITY_CLASSES)
+    {
+      priority = PRIORITY_CLASSES - 1;
+    }
+  m_txPacketList[priority].push_back (packet);
+  NS_LOG_INFO ("Preparing to send TCP Data. m_txState: " << m_txState << " m_connState: " << m_connState << " priority: " << (uint32_t) priority);
   // Set state to transmitting
   if (m_txState == TX_IDLE)
     {
@@ -160,12 +224,14 @@ RapidNetTCPConnection::WriteTCPBuffer (Ptr<Socket> socket, uint32_t txSpace)
     {
       // Start new packet Tx
       m_currentTxBytes = 0;
-      if (m_txPacketList.size () == 0)
+      uint8_t priority = SelectTxQueue ();
+      if (priority == PRIORITY_CLASSES)
         {
           m_txState = TX_IDLE;
           return;
         }
-      m_currentTxPacket = *(m_txPacketList.begin ());
+      m_currentTxPacket = m_txPacketList[priority].front ();
+      m_txPacketList[priority].pop_front ();
       m_totalTxBytes = m_currentTxPacket->GetSize ();
       RapidNetTCPHeader rapidNetTCPHeader;
       rapidNetTCPHeader.SetLength (m_totalTxBytes);
@@ -179,9 +245,9 @@ RapidNetTCPConnection::WriteTCPBuffer (Ptr<Socket> socket, uint32_t txSpace)
   // 2 Things: Either full packet fits or we have to fragment
   if ((m_totalTxBytes - m_currentTxBytes) <= availTxBytes)
     {
-      // Send entire packet at once and remove current packet from queue
+      // Send entire packet at once; it already left its queue
       socket->Send (m_currentTxPacket, 0);
-      m_txPacketList.erase (m_txPacketList.begin ());
+      m_currentTxPacket = 0;
       m_totalTxBytes = 0;
       m_currentTxBytes = 0;
       return;
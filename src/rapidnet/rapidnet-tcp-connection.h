@@ -29,6 +29,7 @@
 #include "ns3/simulator.h"
 #include "ns3/simple-ref-count.h"
 #include <vector>
+#include <deque>
 
 namespace ns3 {
 
@@ -80,6 +81,24 @@ public:
     CONNECTED = 1,
   };
 
+  /**
+   *  \brief How the per-priority transmit queues are served.
+   *
+   *  TX_STRICT always drains the most urgent non-empty class first.
+   *  TX_WEIGHTED serves up to 2^(PRIORITY_CLASSES-1-c) messages of class c
+   *  per round, so bulk classes cannot be starved by control traffic.
+   */
+  enum TxScheduling
+  {
+    TX_STRICT = 0,
+    TX_WEIGHTED = 1,
+  };
+
+  /**
+   *  \brief Number of priority classes; class 0 is the most urgent.
+   */
+  static const uint8_t PRIORITY_CLASSES = 4;
+
   /**
    *  \brief Constructor
    *  \param ipAddress Ipv4Address of remote node
@@ -126,8 +145,18 @@ public:
   /**
    *  \brief Sends data on open connection
    *  \param packet Ptr to Packet
+   *  \param priority Priority class, clamped to PRIORITY_CLASSES - 1
+   */
+  void SendTCPData (Ptr<Packet> packet, uint8_t priority = 0);
+  /**
+   *  \brief Sets the discipline used to pick the next message to send
+   *  \param scheduling TX_STRICT or TX_WEIGHTED
    */
-  void SendTCPData (Ptr<Packet> packet);
+  void SetTxScheduling (TxScheduling scheduling);
+  /**
+   *  \returns number of messages waiting to be sent in the given class
+   */
+  uint32_t GetTxQueueSize (uint8_t priority);
   /**
    *  \brief Writes data on socket based on available space info
    *  \param Ptr to Socket
@@ -174,7 +203,11 @@ private:
   // TCP assembly/trasnmission buffer handling
 
   TxState m_txState;
-  std::vector<Ptr<Packet> > m_txPacketList;
+  TxScheduling m_txScheduling;
+  // One FIFO per priority class; a started message is always finished
+  // before the next class is considered
+  std::deque<Ptr<Packet> > m_txPacketList[PRIORITY_CLASSES];
+  uint32_t m_txCredits[PRIORITY_CLASSES];
   Ptr<Packet> m_currentTxPacket;
   // Current packet tx counters
   uint32_t m_totalTxBytes;
@@ -199,6 +232,12 @@ private:
    *  \returns Ptr to complete Message Packet
    */
   Ptr<Packet> AssembleMessage (Ptr<Packet>& packet, uint32_t& availRxBytes);
+  /**
+   *  \brief Picks the class whose head message is sent next
+   *  \returns priority class, or PRIORITY_CLASSES if all queues are empty
+   */
+  uint8_t SelectTxQueue (void);
+  void ClearTxQueues (void);
 
   // Operators
   friend bool operator < (const RapidNetTCPConnection &connectionL, const RapidNetTCPConnection &connectionR);
@@ -150,6 +150,31 @@ RemoveAllRapidNetAttributes (Ptr<Tuple> tuple)
   return retval;
 }
 
+uint32_t
+GetTupleDigest (Ptr<Tuple> tuple, uint32_t basis)
+{
+  stringstream ss;
+  ss << tuple->GetName ();
+  map<string, Ptr<TupleAttribute> > attrMap = tuple->GetAllAttributes ();
+  map<string, Ptr<TupleAttribute> >::iterator it;
+  for (it = attrMap.begin (); it != attrMap.end (); ++it)
+    {
+      if ((it->first).find ("rn-") != 0)
+        {
+          ss << ';' << it->first << '=' << it->second->GetValue ()->ToString ();
+        }
+    }
+
+  string message = ss.str ();
+  uint32_t digest = basis;
+  for (string::size_type i = 0; i < message.length (); i++)
+    {
+      digest ^= (uint8_t) message[i];
+      digest *= 16777619U;
+    }
+  return digest;
+}
+
 Ptr<ByteArrayValue>
 SerializeTupleToByteArray (Ptr<Tuple> tuple)
 {
@@ -285,6 +285,15 @@ string GetSHA1Digest (string message);
  */
 Ptr<Tuple> RemoveAllRapidNetAttributes (Ptr<Tuple> tuple);
 
+/**
+ * \brief Returns a 32-bit FNV-1a digest of the tuple name and all
+ *        attributes except the RapidNet indicator ("rn-") ones. The
+ *        digest is the same on every node, so it can stand in for the
+ *        tuple contents on the wire. A different basis gives an
+ *        independent digest of the same contents.
+ */
+uint32_t GetTupleDigest (Ptr<Tuple> tuple, uint32_t basis = 2166136261U);
+
 /**
  * \brief Utility method to serialize the contents of a tuple
  *        into a byte array using standard serialize primitives
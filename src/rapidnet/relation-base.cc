@@ -279,5 +279,3 @@ RelationBase::Tokenize(const std::string& str,
     pos = str.find_first_of(delimiters, lastPos);
   }
 }
-
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::rapidnet::RelationBase)
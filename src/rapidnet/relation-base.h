@@ -30,9 +30,6 @@
 #include "assignor.h"
 #include "rapidnet-utils.h"
 
-#include <boost/serialization/export.hpp>
-#include <boost/serialization/base_object.hpp>
-
 #define JOIN_NAMES(lname, rname) lname + "-join-" + rname
 #define COUNT_STAR "COUNT_STAR"
 
@@ -236,20 +233,6 @@ public:
 
 protected:
 
-  friend class boost::serialization::access;
-
-  template<typename Archive>
-  void serialize(Archive& ar, const unsigned version)
-  {
-    std::cout << "Serialize object... " << endl;
-    ar & boost::serialization::base_object<Object>(*this);
-    std::cout << "Object done!" << endl;
-    //Warning: we do not serialize triggers
-    //ar & OnInsert & OnDelete & OnRefresh;
-    ar & m_name & m_timeToLive;
-    std::cout << "Relation base done!" << endl;
-  }
-
   string m_name;
 
   /**
@@ -272,6 +255,4 @@ private:
 } //namespace rapidnet
 } //namepsace ns3
 
-BOOST_CLASS_EXPORT_KEY(ns3::rapidnet::RelationBase)
-
 #endif // RELATION_BASE_H
@@ -131,6 +131,12 @@ Relation::Delete (Ptr<Tuple> tuple)
     }
 }
 
+void
+Relation::Restore (Ptr<Tuple> tuple)
+{
+  m_tuples [GetKey (tuple)] = tuple;
+}
+
 list<Ptr<Tuple> >
 Relation::GetAllTuples ()
 {
@@ -204,5 +210,3 @@ Relation::SetRelaxed (bool value)
 {
   m_relaxed = value;
 }
-
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::rapidnet::Relation)
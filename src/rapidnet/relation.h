@@ -26,19 +26,8 @@
 #include "relation-base.h"
 #include "rapidnet-utils.h"
 
-#include <boost/serialization/map.hpp>
-#include <boost/serialization/base_object.hpp>
-#include <boost/serialization/export.hpp>
-
 using namespace std;
 
-//Forward declaration of class boost::serialization::access
-namespace boost{
-  namespace serialization{
-    class access;
-  }
-}
-
 namespace ns3 {
 namespace rapidnet {
 
@@ -111,6 +100,13 @@ public:
    */
   virtual void Delete (Ptr<Tuple> tuple);
 
+  /**
+   * \brief Puts back a tuple saved in a checkpoint. Unlike @see Insert(),
+   *        the timestamp of the tuple is kept and no trigger is invoked:
+   *        the rules already fired before the checkpoint was taken.
+   */
+  virtual void Restore (Ptr<Tuple> tuple);
+
   /**
    * \brief Returns all the tuples as a list.
    */
@@ -0,0 +1,154 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/broadcast-scheduler.h"
+#include "ns3/rapidnet-rng.h"
+
+using namespace std;
+using namespace ns3;
+using namespace ns3::rapidnet;
+
+namespace ns3 {
+namespace rapidnet {
+namespace tests {
+
+/**
+ * \ingroup rapidnet_tests
+ *
+ * \brief Tests the trickle-style broadcast suppression.
+ *
+ */
+class BroadcastSchedulerTest : public Test
+{
+public:
+
+  BroadcastSchedulerTest () : Test ("Rapidnet-BroadcastSchedulerTest") {}
+
+  virtual ~BroadcastSchedulerTest () {}
+
+  virtual bool RunTests (void);
+
+protected:
+
+  bool TestFirstBroadcast ();
+
+  bool TestBackoff ();
+
+  bool TestReset ();
+};
+
+bool
+BroadcastSchedulerTest::RunTests ()
+{
+  bool result = true;
+  result = TestFirstBroadcast ()
+    && TestBackoff ()
+    && TestReset ();
+
+  return result;
+}
+
+bool
+BroadcastSchedulerTest::TestFirstBroadcast ()
+{
+  bool result = true;
+
+  RapidNetRng rng;
+  rng.SetNode (0);
+  BroadcastScheduler scheduler;
+  scheduler.SetIntervals (Seconds (1), Seconds (60));
+
+  // A new tuple is sent at once, a second broadcast of it is redundant
+  NS_TEST_ASSERT (scheduler.IsDue (1, Seconds (10), rng));
+  NS_TEST_ASSERT (!scheduler.IsDue (1, Seconds (10), rng));
+  // Other tuples are scheduled on their own
+  NS_TEST_ASSERT (scheduler.IsDue (2, Seconds (10), rng));
+  NS_TEST_ASSERT_EQUAL (scheduler.GetSuppressed (), 1u);
+
+  return result;
+}
+
+bool
+BroadcastSchedulerTest::TestBackoff ()
+{
+  bool result = true;
+
+  RapidNetRng rng;
+  rng.SetNode (1);
+  BroadcastScheduler scheduler;
+  scheduler.SetIntervals (Seconds (1), Seconds (60));
+
+  // A program which broadcasts every 5 seconds for an hour
+  uint32_t sent = 0;
+  Time last;
+  Time promise;
+  for (uint32_t i = 0; i < 720; i++)
+    {
+      Time now = Seconds (5 * i);
+      if (scheduler.IsDue (1, now, rng))
+        {
+          // the broadcast comes before the previous promise ran out
+          NS_TEST_ASSERT (promise.IsZero () || now - last <= promise);
+          sent++;
+          last = now;
+          promise = scheduler.GetPromise (1, now);
+        }
+    }
+  // about one broadcast per minute once the interval reached its maximum
+  NS_TEST_ASSERT (sent > 45 && sent < 75);
+  NS_TEST_ASSERT_EQUAL (scheduler.GetSuppressed (), 720 - sent);
+
+  return result;
+}
+
+bool
+BroadcastSchedulerTest::TestReset ()
+{
+  bool result = true;
+
+  RapidNetRng rng;
+  rng.SetNode (2);
+  BroadcastScheduler scheduler;
+  scheduler.SetIntervals (Seconds (1), Seconds (60));
+
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      scheduler.IsDue (1, Seconds (5 * i), rng);
+    }
+  NS_TEST_ASSERT (!scheduler.IsDue (1, Seconds (500), rng));
+
+  // A change of the neighbourhood sends the next broadcast at once, and
+  // the intervals start again from the minimum
+  scheduler.Reset (Seconds (501));
+  NS_TEST_ASSERT (scheduler.IsDue (1, Seconds (502), rng));
+  NS_TEST_ASSERT (scheduler.GetPromise (1, Seconds (502)) <= Seconds (10));
+
+  // Broadcasts which are not sent for long are forgotten
+  scheduler.Prune (Seconds (1000));
+  NS_TEST_ASSERT (scheduler.IsDue (1, Seconds (1000), rng));
+
+  return result;
+}
+
+static BroadcastSchedulerTest g_broadcastSchedulerTest;
+
+} // namespace tests
+} // namespace rapidnet
+} // namespace ns3
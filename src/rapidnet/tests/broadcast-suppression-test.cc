@@ -0,0 +1,339 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <algorithm>
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+#include "ns3/csma-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/rapidnet-application-base.h"
+#include "ns3/rapidnet-application-helper.h"
+
+using namespace std;
+using namespace ns3;
+using namespace ns3::rapidnet;
+
+namespace ns3 {
+namespace rapidnet {
+namespace tests {
+
+const Time BEACON_TTL = Seconds (3);
+
+/**
+ * \brief Broadcasts a beacon every second, like the discovery program,
+ * and keeps a link(@Local, Neighbor) tuple per neighbour heard, with a
+ * time to live of BEACON_TTL. Records when the beacons of the neighbour
+ * arrive and the promises they carry.
+ */
+class BeaconTestApp : public RapidNetApplicationBase
+{
+public:
+
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::rapidnet::tests::BeaconTestApp")
+      .SetParent<RapidNetApplicationBase> ()
+      .AddConstructor<BeaconTestApp> ()
+      ;
+    return tid;
+  }
+
+  BeaconTestApp () {}
+
+  virtual ~BeaconTestApp () {}
+
+  void StartBeacons ()
+  {
+    SendBeacon ();
+  }
+
+  void StopBeacons ()
+  {
+    Simulator::Cancel (m_beaconEvent);
+  }
+
+  void AddLink (Ipv4Address neighbor)
+  {
+    Ptr<Tuple> link = Tuple::New ("link");
+    link->AddAttribute (TupleAttribute::New ("link_attr1",
+      Ipv4Value::New (GetAddress ())));
+    link->AddAttribute (TupleAttribute::New ("link_attr2",
+      Ipv4Value::New (neighbor)));
+    Insert (link);
+  }
+
+  bool HasLink (Ipv4Address neighbor)
+  {
+    list<Ptr<Tuple> > links = GetRelation ("link")->GetAllTuples ();
+    for (list<Ptr<Tuple> >::iterator it = links.begin ();
+      it != links.end (); ++it)
+      {
+        if (ipv4_value ((*it)->GetAttribute ("link_attr2")) == neighbor)
+          {
+            return true;
+          }
+      }
+    return false;
+  }
+
+  /* Arrival times and promises of the beacons of the neighbour */
+  vector<Time> m_beacons;
+  vector<double> m_promises;
+
+protected:
+
+  virtual void InitDatabase ()
+  {
+    AddRelationWithKeys ("link", attrdeflist (
+      attrdef ("link_attr1", IPV4),
+      attrdef ("link_attr2", IPV4)),
+      BEACON_TTL);
+  }
+
+  virtual void DemuxRecv (Ptr<Tuple> tuple)
+  {
+    RapidNetApplicationBase::DemuxRecv (tuple);
+    if (IsRecvEvent (tuple, "beacon"))
+      {
+        Ipv4Address neighbor = ipv4_value (tuple->GetAttribute ("beacon_attr1"));
+        if (neighbor != GetAddress ())
+          {
+            m_beacons.push_back (Simulator::Now ());
+            m_promises.push_back (tuple->HasAttribute (RN_PROMISE)
+              ? DynamicCast<RealValue, Value> (tuple->GetAttribute (
+                RN_PROMISE)->GetValue ())->GetRealValue () : 0);
+          }
+        AddLink (neighbor);
+      }
+  }
+
+  void SendBeacon ()
+  {
+    Ptr<Tuple> beacon = Tuple::New ("beacon");
+    beacon->AddAttribute (TupleAttribute::New ("beacon_attr1",
+      Ipv4Value::New (GetAddress ())));
+    beacon->AddAttribute (TupleAttribute::New (RN_DEST,
+      Ipv4Value::New ("255.255.255.255")));
+    Send (beacon);
+    m_beaconEvent = Simulator::Schedule (Seconds (1),
+      &BeaconTestApp::SendBeacon, this);
+  }
+
+  EventId m_beaconEvent;
+};
+
+class BeaconTestAppHelper : public RapidNetApplicationHelper
+{
+public:
+
+  BeaconTestAppHelper ()
+  {
+    m_factory.SetTypeId (BeaconTestApp::GetTypeId ());
+  }
+
+protected:
+
+  Ptr<RapidNetApplicationBase> CreateNewApplication ()
+  {
+    return m_factory.Create<BeaconTestApp> ();
+  }
+};
+
+/**
+ * \ingroup rapidnet_tests
+ *
+ * \brief Tests the broadcast suppression between two applications on
+ * one LAN: the promises keep the links beyond their time to live, but
+ * no longer than BROADCAST_PROMISE_TTLS + 1 times to live, and a change
+ * of the neighbourhood restarts the broadcast intervals.
+ *
+ */
+class BroadcastSuppressionTest : public Test
+{
+public:
+
+  BroadcastSuppressionTest () : Test ("Rapidnet-BroadcastSuppressionTest") {}
+
+  virtual ~BroadcastSuppressionTest () {}
+
+  virtual bool RunTests (void);
+
+protected:
+
+  void Setup ();
+
+  void CheckLink ();
+
+  bool TestPromise ();
+
+  bool TestNeighborChange ();
+
+  Ptr<BeaconTestApp> m_sender;
+  Ptr<BeaconTestApp> m_receiver;
+  /* Times at which the receiver had no link to the sender */
+  vector<Time> m_linkMissing;
+};
+
+bool
+BroadcastSuppressionTest::RunTests ()
+{
+  bool result = true;
+  result = TestPromise ()
+    && TestNeighborChange ();
+
+  return result;
+}
+
+void
+BroadcastSuppressionTest::Setup ()
+{
+  Ipv4AddressGenerator::Reset ();
+  NodeContainer nodes;
+  nodes.Create (2);
+  CsmaHelper csma;
+  NetDeviceContainer devices = csma.Install (nodes);
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  address.Assign (devices);
+
+  Ptr<BeaconTestAppHelper> helper = Create<BeaconTestAppHelper> ();
+  helper->SetAttribute ("BroadcastSuppression", BooleanValue (true));
+  helper->SetAttribute ("BroadcastIntervalMin", TimeValue (Seconds (1)));
+  helper->SetAttribute ("BroadcastIntervalMax", TimeValue (Seconds (60)));
+  ApplicationContainer apps = helper->Install (nodes);
+  apps.Start (Seconds (0));
+
+  m_sender = DynamicCast<BeaconTestApp> (apps.Get (0));
+  m_receiver = DynamicCast<BeaconTestApp> (apps.Get (1));
+  Simulator::Schedule (Seconds (0.5), &BeaconTestApp::StartBeacons, m_sender);
+  m_linkMissing.clear ();
+  for (double at = 2; at < 60; at += 0.25)
+    {
+      Simulator::Schedule (Seconds (at), &BroadcastSuppressionTest::CheckLink, this);
+    }
+}
+
+void
+BroadcastSuppressionTest::CheckLink ()
+{
+  if (!m_receiver->HasLink (m_sender->GetAddress ()))
+    {
+      m_linkMissing.push_back (Simulator::Now ());
+    }
+}
+
+bool
+BroadcastSuppressionTest::TestPromise ()
+{
+  bool result = true;
+
+  Setup ();
+  Simulator::Schedule (Seconds (30), &BeaconTestApp::StopBeacons, m_sender);
+  Simulator::Stop (Seconds (50));
+  Simulator::Run ();
+
+  // Most beacons are suppressed, and the gaps between those sent are
+  // longer than the time to live of the links
+  vector<Time> &beacons = m_receiver->m_beacons;
+  NS_TEST_ASSERT (beacons.size () > 2 && beacons.size () < 15);
+  Time gap = Seconds (0);
+  for (uint32_t i = 1; i < beacons.size (); i++)
+    {
+      gap = Max (gap, beacons[i] - beacons[i - 1]);
+    }
+  NS_TEST_ASSERT (gap > BEACON_TTL);
+
+  // The intervals stop growing at the time to live, which bounds the
+  // promises
+  for (uint32_t i = 0; i < m_receiver->m_promises.size (); i++)
+    {
+      NS_TEST_ASSERT (m_receiver->m_promises[i] <= 2 * BEACON_TTL.GetSeconds () + 1);
+    }
+
+  // The promised link outlives its time to live while the beacons go
+  // on, and is deleted within BROADCAST_PROMISE_TTLS + 1 times to live
+  // of the last beacon once they stop
+  NS_TEST_ASSERT (!m_linkMissing.empty ());
+  if (!m_linkMissing.empty ())
+    {
+      Time lost = m_linkMissing.front ();
+      NS_TEST_ASSERT (lost > beacons.back () + BEACON_TTL);
+      NS_TEST_ASSERT (lost <= beacons.back ()
+        + BEACON_TTL * Scalar (BROADCAST_PROMISE_TTLS + 1) + SOFTSTATE_DELETE_PERIOD);
+    }
+  Simulator::Destroy ();
+
+  return result;
+}
+
+bool
+BroadcastSuppressionTest::TestNeighborChange ()
+{
+  bool result = true;
+
+  Setup ();
+  // A new neighbour of the sender at 20.25s restarts its intervals
+  Simulator::Schedule (Seconds (20.25), &BeaconTestApp::AddLink, m_sender,
+    Ipv4Address ("10.1.1.99"));
+  Simulator::Stop (Seconds (30));
+  Simulator::Run ();
+
+  vector<Time> &beacons = m_receiver->m_beacons;
+  vector<double> &promises = m_receiver->m_promises;
+  double longest = 0;
+  int32_t after = -1;
+  for (uint32_t i = 0; i < beacons.size (); i++)
+    {
+      if (beacons[i] < Seconds (20.25))
+        {
+          longest = std::max (longest, promises[i]);
+        }
+      else if (after < 0)
+        {
+          after = i;
+        }
+    }
+  // The intervals had grown before the change; the next beacon is sent
+  // at once, with the promise of the minimum interval
+  NS_TEST_ASSERT (longest > 4);
+  NS_TEST_ASSERT (after >= 0);
+  if (after >= 0)
+    {
+      NS_TEST_ASSERT (beacons[after] < Seconds (21.5));
+      NS_TEST_ASSERT (promises[after] <= 4);
+    }
+  NS_TEST_ASSERT (m_linkMissing.empty ());
+  Simulator::Destroy ();
+
+  return result;
+}
+
+static BroadcastSuppressionTest g_broadcastSuppressionTest;
+
+} // namespace tests
+} // namespace rapidnet
+} // namespace ns3
@@ -18,6 +18,7 @@
  */
 
 #include <iostream>
+#include <sstream>
 #include <string>
 #include <map>
 
@@ -125,6 +126,44 @@ DatabaseTest::RunTests ()
 
   //db->AddRelation (Relation::New (STUDENT));
 
+  // checkpoint and restore into a database with the same schema
+  stringstream checkpoint;
+  db->Save (checkpoint);
+
+  Ptr<Database> restored = CreateObject<Database> ();
+  Ptr<Relation> restored_student = Relation::New (STUDENT);
+  restored_student->AddKeyAttribute (attrdeftype (STR_ID, INT32));
+  restored_student->OnInsert += Create<CountTrigger> ();
+  restored->AddRelation (restored_student);
+  Ptr<Relation> restored_course = Relation::New (COURSE);
+  restored_course->AddKeyAttribute (attrdeftype (STR_ID, INT32));
+  restored->AddRelation (restored_course);
+
+  CountTrigger::count = 0;
+  NS_TEST_ASSERT (restored->Restore (checkpoint));
+  NS_TEST_ASSERT_EQUAL (CountTrigger::count, 0);
+  NS_TEST_ASSERT_EQUAL (restored_student->Count (), 2);
+  NS_TEST_ASSERT_EQUAL (restored_course->Count (), 2);
+  list<Ptr<Tuple> > before = reln_student->GetAllTuples ();
+  list<Ptr<Tuple> > after = restored_student->GetAllTuples ();
+  for (list<Ptr<Tuple> >::iterator it = before.begin (), jt = after.begin ();
+    it != before.end () && jt != after.end (); ++it, ++jt)
+    {
+      NS_TEST_ASSERT ((*it)->Equals (*jt));
+      NS_TEST_ASSERT_EQUAL ((*it)->GetTimestamp (), (*jt)->GetTimestamp ());
+    }
+
+  stringstream truncated (checkpoint.str ().substr (0, 10));
+  NS_TEST_ASSERT (!restored->Restore (truncated));
+
+  // a checkpoint of a relation missing from the schema is rejected
+  Ptr<Database> partial = CreateObject<Database> ();
+  Ptr<Relation> partial_course = Relation::New (COURSE);
+  partial_course->AddKeyAttribute (attrdeftype (STR_ID, INT32));
+  partial->AddRelation (partial_course);
+  stringstream missing (checkpoint.str ());
+  NS_TEST_ASSERT (!partial->Restore (missing));
+
   NS_TEST_ASSERT (db->HasRelation (STUDENT));
   NS_TEST_ASSERT (db->RemoveRelation (STUDENT) == true);
 
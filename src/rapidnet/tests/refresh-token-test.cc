@@ -0,0 +1,278 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/nstime.h"
+#include "ns3/node-container.h"
+#include "ns3/csma-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-address-generator.h"
+#include "ns3/rapidnet-application-base.h"
+#include "ns3/rapidnet-application-helper.h"
+
+using namespace std;
+using namespace ns3;
+using namespace ns3::rapidnet;
+
+namespace ns3 {
+namespace rapidnet {
+namespace tests {
+
+/**
+ * \brief Sends probe tuples on request and counts the probes it receives,
+ * whether they arrive in full or are replayed from a refresh token.
+ */
+class RefreshTestApp : public RapidNetApplicationBase
+{
+public:
+
+  static TypeId GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::rapidnet::tests::RefreshTestApp")
+      .SetParent<RapidNetApplicationBase> ()
+      .AddConstructor<RefreshTestApp> ()
+      ;
+    return tid;
+  }
+
+  RefreshTestApp () : m_received (0) {}
+
+  virtual ~RefreshTestApp () {}
+
+  void SendProbe (Ipv4Address dest, int32_t version)
+  {
+    Ptr<Tuple> probe = Tuple::New ("probe");
+    probe->AddAttribute (TupleAttribute::New ("probe_attr1",
+      Ipv4Value::New (dest)));
+    probe->AddAttribute (TupleAttribute::New ("probe_attr2",
+      Int32Value::New (version)));
+    probe->AddAttribute (TupleAttribute::New (RN_DEST, Ipv4Value::New (dest)));
+    Send (probe);
+  }
+
+  uint32_t m_received;
+
+protected:
+
+  virtual void DemuxRecv (Ptr<Tuple> tuple)
+  {
+    if (tuple->GetName () == "probe")
+      {
+        m_received++;
+      }
+    RapidNetApplicationBase::DemuxRecv (tuple);
+  }
+};
+
+class RefreshTestAppHelper : public RapidNetApplicationHelper
+{
+public:
+
+  RefreshTestAppHelper ()
+  {
+    m_factory.SetTypeId (RefreshTestApp::GetTypeId ());
+  }
+
+protected:
+
+  Ptr<RapidNetApplicationBase> CreateNewApplication ()
+  {
+    return m_factory.Create<RefreshTestApp> ();
+  }
+};
+
+/**
+ * \ingroup rapidnet_tests
+ *
+ * \brief Tests the refresh tokens and NACKs between two applications on
+ * one LAN.
+ *
+ */
+class RefreshTokenTest : public Test
+{
+public:
+
+  RefreshTokenTest () : Test ("Rapidnet-RefreshTokenTest") {}
+
+  virtual ~RefreshTokenTest () {}
+
+  virtual bool RunTests (void);
+
+protected:
+
+  void Setup (bool receiverTokens, Time receiverLifetime);
+
+  void Schedule (double at, int32_t version);
+
+  bool TestSuppression ();
+
+  bool TestExpiry ();
+
+  bool TestNack ();
+
+  bool TestOptOut ();
+
+  Ptr<RefreshTestApp> m_sender;
+  Ptr<RefreshTestApp> m_receiver;
+};
+
+bool
+RefreshTokenTest::RunTests ()
+{
+  bool result = true;
+  result = TestSuppression ()
+    && TestExpiry ()
+    && TestNack ()
+    && TestOptOut ();
+
+  return result;
+}
+
+void
+RefreshTokenTest::Setup (bool receiverTokens, Time receiverLifetime)
+{
+  Ipv4AddressGenerator::Reset ();
+  NodeContainer nodes;
+  nodes.Create (2);
+  CsmaHelper csma;
+  NetDeviceContainer devices = csma.Install (nodes);
+  InternetStackHelper stack;
+  stack.Install (nodes);
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.1.0", "255.255.255.0");
+  address.Assign (devices);
+
+  Ptr<RefreshTestAppHelper> helper = Create<RefreshTestAppHelper> ();
+  helper->SetAttribute ("RefreshTokens", BooleanValue (true));
+  helper->SetAttribute ("RefreshTokenLifetime", TimeValue (Seconds (10)));
+  ApplicationContainer apps = helper->Install (nodes);
+  apps.Start (Seconds (0));
+
+  m_sender = DynamicCast<RefreshTestApp> (apps.Get (0));
+  m_receiver = DynamicCast<RefreshTestApp> (apps.Get (1));
+  m_receiver->SetAttribute ("RefreshTokens", BooleanValue (receiverTokens));
+  m_receiver->SetAttribute ("RefreshTokenLifetime", TimeValue (receiverLifetime));
+}
+
+void
+RefreshTokenTest::Schedule (double at, int32_t version)
+{
+  Simulator::Schedule (Seconds (at), &RefreshTestApp::SendProbe, m_sender,
+    m_receiver->GetAddress (), version);
+}
+
+bool
+RefreshTokenTest::TestSuppression ()
+{
+  bool result = true;
+
+  Setup (true, Seconds (10));
+  Schedule (1, 1);
+  Schedule (2, 1);
+  Schedule (3, 1);
+  Schedule (4, 2);
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+
+  // Unchanged resends become tokens, a changed tuple is sent in full
+  NS_TEST_ASSERT_EQUAL (m_receiver->m_received, 4);
+  NS_TEST_ASSERT_EQUAL (m_sender->totalRefreshesSuppressed, 2);
+  NS_TEST_ASSERT_EQUAL (m_sender->totalRefreshesResent, 0);
+  Simulator::Destroy ();
+
+  return result;
+}
+
+bool
+RefreshTokenTest::TestExpiry ()
+{
+  bool result = true;
+
+  Setup (true, Seconds (10));
+  Schedule (1, 1);
+  Schedule (9, 1);
+  Schedule (20, 1);
+  Simulator::Stop (Seconds (21));
+  Simulator::Run ();
+
+  // The send at 20s comes more than RefreshTokenLifetime after the
+  // last one and goes in full
+  NS_TEST_ASSERT_EQUAL (m_receiver->m_received, 3);
+  NS_TEST_ASSERT_EQUAL (m_sender->totalRefreshesSuppressed, 1);
+  NS_TEST_ASSERT_EQUAL (m_sender->totalRefreshesResent, 0);
+  Simulator::Destroy ();
+
+  return result;
+}
+
+bool
+RefreshTokenTest::TestNack ()
+{
+  bool result = true;
+
+  // The receiver drops its copy after 2s, long before the sender's
+  // lifetime runs out
+  Setup (true, Seconds (1));
+  Schedule (1, 1);
+  Schedule (5, 1);
+  Schedule (6, 1);
+  Simulator::Stop (Seconds (7));
+  Simulator::Run ();
+
+  // The token at 5s is NACKed and the tuple resent, the one at 6s
+  // matches the resent copy
+  NS_TEST_ASSERT_EQUAL (m_receiver->m_received, 3);
+  NS_TEST_ASSERT_EQUAL (m_sender->totalRefreshesSuppressed, 2);
+  NS_TEST_ASSERT_EQUAL (m_sender->totalRefreshesResent, 1);
+  Simulator::Destroy ();
+
+  return result;
+}
+
+bool
+RefreshTokenTest::TestOptOut ()
+{
+  bool result = true;
+
+  Setup (false, Seconds (10));
+  Schedule (1, 1);
+  Schedule (2, 1);
+  Schedule (3, 1);
+  Schedule (4, 1);
+  Simulator::Stop (Seconds (5));
+  Simulator::Run ();
+
+  // Only the first resend is suppressed: the receiver keeps no copies
+  // and its NACK turns refresh tokens off toward it
+  NS_TEST_ASSERT_EQUAL (m_receiver->m_received, 4);
+  NS_TEST_ASSERT_EQUAL (m_sender->totalRefreshesSuppressed, 1);
+  NS_TEST_ASSERT_EQUAL (m_sender->totalRefreshesResent, 1);
+  Simulator::Destroy ();
+
+  return result;
+}
+
+static RefreshTokenTest g_refreshTokenTest;
+
+} // namespace tests
+} // namespace rapidnet
+} // namespace ns3
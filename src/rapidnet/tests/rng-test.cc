@@ -0,0 +1,243 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <vector>
+#include <sstream>
+
+#include "ns3/test.h"
+#include "ns3/rapidnet-rng.h"
+#include "ns3/rng-stream.h"
+
+using namespace std;
+using namespace ns3;
+using namespace ns3::rapidnet;
+
+namespace ns3 {
+namespace rapidnet {
+namespace tests {
+
+/**
+ * \ingroup rapidnet_tests
+ *
+ * \brief Tests the per-node random number generators.
+ *
+ */
+class RngTest : public Test
+{
+public:
+
+  RngTest () : Test ("Rapidnet-RngTest") {}
+
+  virtual ~RngTest () {}
+
+  virtual bool RunTests (void);
+
+protected:
+
+  vector<uint32_t> Draw (uint32_t nodeId, bool fast);
+
+  bool TestReproducible ();
+
+  bool TestIndependent ();
+
+  bool TestRange ();
+
+  bool TestPackageStreams ();
+
+  bool TestSaveRestore ();
+};
+
+bool
+RngTest::RunTests ()
+{
+  bool result = true;
+  result = TestReproducible ()
+    && TestIndependent ()
+    && TestRange ()
+    && TestPackageStreams ()
+    && TestSaveRestore ();
+
+  return result;
+}
+
+vector<uint32_t>
+RngTest::Draw (uint32_t nodeId, bool fast)
+{
+  RapidNetRng rng;
+  rng.SetNode (nodeId);
+  vector<uint32_t> values;
+  for (uint32_t i = 0; i < 16; i++)
+    {
+      values.push_back (fast ? rng.GetFastInteger (1000000) :
+        rng.GetInteger (1000000));
+    }
+  return values;
+}
+
+bool
+RngTest::TestReproducible ()
+{
+  bool result = true;
+
+  // The values of a node do not depend on the generators created before
+  vector<uint32_t> first = Draw (7, false);
+  vector<uint32_t> firstFast = Draw (7, true);
+  Draw (3, false);
+  Draw (8, true);
+  NS_TEST_ASSERT (Draw (7, false) == first);
+  NS_TEST_ASSERT (Draw (7, true) == firstFast);
+
+  // SetNode restarts the stream
+  RapidNetRng rng;
+  rng.SetNode (7);
+  rng.GetValue ();
+  rng.GetFastInteger (10);
+  rng.SetNode (7);
+  NS_TEST_ASSERT_EQUAL (rng.GetInteger (1000000), first[0]);
+
+  return result;
+}
+
+bool
+RngTest::TestIndependent ()
+{
+  bool result = true;
+
+  NS_TEST_ASSERT (Draw (0, false) != Draw (1, false));
+  NS_TEST_ASSERT (Draw (0, true) != Draw (1, true));
+  NS_TEST_ASSERT (Draw (1, false) != Draw (1000, false));
+  NS_TEST_ASSERT (Draw (0, false) != Draw (0, true));
+
+  return result;
+}
+
+bool
+RngTest::TestRange ()
+{
+  bool result = true;
+
+  RapidNetRng rng;
+  rng.SetNode (2);
+  uint32_t counts[10] = {0};
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      uint32_t value = rng.GetFastInteger (10);
+      NS_TEST_ASSERT (value < 10);
+      if (value < 10)
+        {
+          counts[value]++;
+        }
+      double u = rng.GetValue ();
+      NS_TEST_ASSERT (u >= 0 && u < 1);
+    }
+  // every value is drawn about 1000 times
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      NS_TEST_ASSERT (counts[i] > 800 && counts[i] < 1200);
+    }
+  NS_TEST_ASSERT_EQUAL (rng.GetFastInteger (1), 0u);
+
+  return result;
+}
+
+bool
+RngTest::TestPackageStreams ()
+{
+  bool result = true;
+
+  // The node generators do not take streams of the package: the stream
+  // created after them is the one which follows the stream created before
+  RngStream before;
+  Draw (4, false);
+  RngStream after;
+
+  uint32_t seed[6];
+  before.ResetStartStream ();
+  before.GetState (seed);
+  RngStream next (seed);
+  next.AdvanceState (127, 0);
+  uint32_t expected[6], actual[6];
+  next.GetState (expected);
+  after.ResetStartStream ();
+  after.GetState (actual);
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      NS_TEST_ASSERT_EQUAL (actual[i], expected[i]);
+    }
+
+  return result;
+}
+
+bool
+RngTest::TestSaveRestore ()
+{
+  bool result = true;
+
+  // A restored generator carries on where the saved one was
+  RapidNetRng rng;
+  rng.SetNode (5);
+  rng.GetValue ();
+  rng.GetFastInteger (10);
+  stringstream saved;
+  rng.Save (saved);
+  vector<uint32_t> expected;
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      expected.push_back (rng.GetInteger (1000000));
+      expected.push_back (rng.GetFastInteger (1000000));
+    }
+
+  RapidNetRng restored;
+  restored.SetNode (5);
+  NS_TEST_ASSERT (restored.Restore (saved));
+  vector<uint32_t> actual;
+  for (uint32_t i = 0; i < 8; i++)
+    {
+      actual.push_back (restored.GetInteger (1000000));
+      actual.push_back (restored.GetFastInteger (1000000));
+    }
+  NS_TEST_ASSERT (actual == expected);
+
+  stringstream truncated (saved.str ().substr (0, 10));
+  NS_TEST_ASSERT (!restored.Restore (truncated));
+
+  // So does the allocation of the streams of the package
+  uint32_t seed[6];
+  RngStream::GetNextSeed (seed);
+  RngStream first;
+  // moves the next seed on
+  RngStream second;
+  NS_TEST_ASSERT (RngStream::SetNextSeed (seed));
+  RngStream again;
+  uint32_t firstState[6], againState[6];
+  first.GetState (firstState);
+  again.GetState (againState);
+  for (uint32_t i = 0; i < 6; i++)
+    {
+      NS_TEST_ASSERT_EQUAL (againState[i], firstState[i]);
+    }
+
+  return result;
+}
+
+static RngTest g_rngTest;
+
+} // namespace tests
+} // namespace rapidnet
+} // namespace ns3
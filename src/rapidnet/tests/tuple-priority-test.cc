@@ -0,0 +1,313 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+// The compiler headers come first: rapidnet-utils.h defines
+// TIME_INFINITY as a macro, which is a member name in rapidnet-context.h
+#include "ns3/ol-context.h"
+#include "ns3/table-store.h"
+#include "ns3/localize-context.h"
+#include "ns3/eca-context.h"
+#include "ns3/rapidnet-context.h"
+
+#include "ns3/test.h"
+#include "ns3/socket.h"
+#include "ns3/uinteger.h"
+#include "ns3/rapidnet-tcp-connection.h"
+#include "ns3/rapidnet-application-base.h"
+
+using namespace std;
+using namespace ns3;
+using namespace ns3::rapidnet;
+
+namespace ns3 {
+namespace rapidnet {
+namespace tests {
+
+/**
+ * \brief A connected socket with unlimited transmit space that records
+ * the class and sequence number of each message sent through it.
+ */
+class CaptureSocket : public Socket
+{
+public:
+
+  virtual enum Socket::SocketErrno GetErrno (void) const { return ERROR_NOTERROR; }
+  virtual Ptr<Node> GetNode (void) const { return 0; }
+  virtual int Bind (const Address &address) { return 0; }
+  virtual int Bind () { return 0; }
+  virtual int Close (void) { return 0; }
+  virtual int ShutdownSend (void) { return 0; }
+  virtual int ShutdownRecv (void) { return 0; }
+  virtual int Connect (const Address &address) { return 0; }
+  virtual int Listen (void) { return 0; }
+  virtual uint32_t GetTxAvailable (void) const { return 65535; }
+  virtual uint32_t GetRxAvailable (void) const { return 0; }
+  virtual int GetSockName (Address &address) const { return 0; }
+
+  virtual int Send (Ptr<Packet> p, uint32_t flags)
+  {
+    Ptr<Packet> message = p->Copy ();
+    RapidNetTCPHeader header;
+    message->RemoveHeader (header);
+    uint8_t data[2];
+    message->CopyData (data, 2);
+    m_classes.push_back (data[0]);
+    m_sequences.push_back (data[1]);
+    return p->GetSize ();
+  }
+
+  virtual int SendTo (Ptr<Packet> p, uint32_t flags, const Address &toAddress)
+  {
+    return Send (p, flags);
+  }
+
+  virtual Ptr<Packet> Recv (uint32_t maxSize, uint32_t flags)
+  {
+    return 0;
+  }
+
+  virtual Ptr<Packet> RecvFrom (uint32_t maxSize, uint32_t flags,
+    Address &fromAddress)
+  {
+    return 0;
+  }
+
+  vector<uint8_t> m_classes;
+  vector<uint8_t> m_sequences;
+};
+
+/**
+ * \ingroup rapidnet_tests
+ *
+ * \brief Tests the priority classes of tuples: the order in which a
+ * connection dequeues the classes under the strict and the weighted
+ * (8:4:2:1) scheduling, and that priority(relation, class) declarations
+ * in NDlog assign the class to the relation.
+ *
+ */
+class TuplePriorityTest : public Test
+{
+public:
+
+  TuplePriorityTest () : Test ("Rapidnet-TuplePriorityTest") {}
+
+  virtual ~TuplePriorityTest () {}
+
+  virtual bool RunTests (void);
+
+protected:
+
+  /**
+   * \brief Queues perClass messages of each class on a connection that
+   * is not yet connected, then drains it and returns what was sent.
+   */
+  Ptr<CaptureSocket> Drain (RapidNetTCPConnection::TxScheduling scheduling,
+    uint8_t perClass);
+
+  bool TestStrict ();
+
+  bool TestWeighted ();
+
+  bool TestApplication ();
+
+  bool TestCompiler ();
+};
+
+bool
+TuplePriorityTest::RunTests ()
+{
+  bool result = true;
+  result = TestStrict ()
+    && TestWeighted ()
+    && TestApplication ()
+    && TestCompiler ();
+
+  return result;
+}
+
+Ptr<CaptureSocket>
+TuplePriorityTest::Drain (RapidNetTCPConnection::TxScheduling scheduling,
+  uint8_t perClass)
+{
+  Ptr<CaptureSocket> socket = CreateObject<CaptureSocket> ();
+  Ptr<RapidNetTCPConnection> connection = Create<RapidNetTCPConnection> (
+    Ipv4Address ("10.1.1.2"), 11111, socket);
+  connection->SetConnState (RapidNetTCPConnection::NOT_CONNECTED);
+  connection->SetTxScheduling (scheduling);
+
+  // Queue the least urgent class first so that arrival order does not
+  // match the expected order
+  for (uint8_t seq = 0; seq < perClass; seq++)
+    {
+      for (int c = RapidNetTCPConnection::PRIORITY_CLASSES - 1; c >= 0; c--)
+        {
+          uint8_t data[2] = {(uint8_t) c, seq};
+          connection->SendTCPData (Create<Packet> (data, 2), c);
+        }
+    }
+
+  connection->SetConnState (RapidNetTCPConnection::CONNECTED);
+  uint32_t total = perClass * RapidNetTCPConnection::PRIORITY_CLASSES;
+  while (socket->m_classes.size () < total)
+    {
+      connection->WriteTCPBuffer (socket, socket->GetTxAvailable ());
+    }
+  for (uint8_t c = 0; c < RapidNetTCPConnection::PRIORITY_CLASSES; c++)
+    {
+      NS_ASSERT (connection->GetTxQueueSize (c) == 0);
+    }
+  return socket;
+}
+
+bool
+TuplePriorityTest::TestStrict ()
+{
+  bool result = true;
+
+  Ptr<CaptureSocket> socket = Drain (RapidNetTCPConnection::TX_STRICT, 4);
+  NS_TEST_ASSERT_EQUAL (socket->m_classes.size (), 16);
+  for (uint32_t i = 0; i < socket->m_classes.size (); i++)
+    {
+      // Each class is drained in FIFO order before the next one
+      NS_TEST_ASSERT_EQUAL ((uint32_t) socket->m_classes[i], i / 4);
+      NS_TEST_ASSERT_EQUAL ((uint32_t) socket->m_sequences[i], i % 4);
+    }
+
+  return result;
+}
+
+bool
+TuplePriorityTest::TestWeighted ()
+{
+  bool result = true;
+
+  Ptr<CaptureSocket> socket = Drain (RapidNetTCPConnection::TX_WEIGHTED, 16);
+  NS_TEST_ASSERT_EQUAL (socket->m_classes.size (), 64);
+
+  // While every class is backlogged, each round serves 8, 4, 2 and 1
+  // messages of the classes 0 to 3
+  const uint8_t round[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 3};
+  for (uint32_t i = 0; i < 2 * sizeof (round); i++)
+    {
+      NS_TEST_ASSERT_EQUAL ((uint32_t) socket->m_classes[i],
+        (uint32_t) round[i % sizeof (round)]);
+    }
+
+  // Class 0 is done after two rounds; the others keep their share
+  const uint8_t third[] = {1, 1, 1, 1, 2, 2, 3};
+  for (uint32_t i = 0; i < sizeof (third); i++)
+    {
+      NS_TEST_ASSERT_EQUAL ((uint32_t) socket->m_classes[2 * sizeof (round) + i],
+        (uint32_t) third[i]);
+    }
+
+  // Every class is served in FIFO order
+  uint8_t next[RapidNetTCPConnection::PRIORITY_CLASSES] = {0, 0, 0, 0};
+  for (uint32_t i = 0; i < socket->m_classes.size (); i++)
+    {
+      NS_TEST_ASSERT_EQUAL ((uint32_t) socket->m_sequences[i],
+        (uint32_t) next[socket->m_classes[i]]++);
+    }
+
+  return result;
+}
+
+bool
+TuplePriorityTest::TestApplication ()
+{
+  bool result = true;
+
+  Ptr<RapidNetApplicationBase> app = CreateObject<RapidNetApplicationBase> ();
+  app->SetAttribute ("DefaultTuplePriority", UintegerValue (2));
+  app->SetTuplePriority ("linkDelete", 0);
+  NS_TEST_ASSERT_EQUAL ((uint32_t) app->GetTuplePriority (
+    Tuple::New ("linkDelete")), 0);
+  NS_TEST_ASSERT_EQUAL ((uint32_t) app->GetTuplePriority (
+    Tuple::New ("path")), 2);
+
+  return result;
+}
+
+bool
+TuplePriorityTest::TestCompiler ()
+{
+  bool result = true;
+
+  char dir[] = "/tmp/rapidnet-priority-XXXXXX";
+  NS_TEST_ASSERT (mkdtemp (dir) != 0);
+  string base = string (dir) + "/prio";
+
+  // linkDelete and path are derived by the rules; unused is not
+  istringstream program (
+    "materialize(link,infinity,infinity,keys(1,2)).\n"
+    "materialize(path,infinity,infinity,keys(1,2)).\n"
+    "r1 path(@X,Y,C) :- link(@X,Y,C).\n"
+    "r2 linkDelete(@Y,X) :- link(@X,Y,C).\n"
+    "priority(linkDelete, 0).\n"
+    "priority(path, 3).\n"
+    "priority(unused, 2).\n");
+
+  Ptr<rapidnet_compiler::OlContext> ctxt =
+    Create<rapidnet_compiler::OlContext> ();
+  Ptr<rapidnet_compiler::TableStore> tableStore =
+    Create<rapidnet_compiler::TableStore> (ctxt);
+  ctxt->ParseStream (&program, false);
+  NS_TEST_ASSERT (!ctxt->GotErrors ());
+
+  Ptr<rapidnet_compiler::LocalizeContext> lctxt =
+    Create<rapidnet_compiler::LocalizeContext> ();
+  lctxt->Rewrite (ctxt, tableStore);
+  Ptr<rapidnet_compiler::EcaContext> ectxt =
+    Create<rapidnet_compiler::EcaContext> ();
+  ectxt->Rewrite (lctxt, tableStore);
+  Ptr<rapidnet_compiler::RapidNetContext> npctxt =
+    Create<rapidnet_compiler::RapidNetContext> (base + ".olg");
+  npctxt->Rewrite (ectxt, tableStore);
+  npctxt->Generate ();
+
+  ifstream generated ((base + ".cc").c_str ());
+  NS_TEST_ASSERT (generated.is_open ());
+  string code ((istreambuf_iterator<char> (generated)),
+    istreambuf_iterator<char> ());
+  generated.close ();
+  NS_TEST_ASSERT (code.find ("SetTuplePriority (LINKDELETE, 0);")
+    != string::npos);
+  NS_TEST_ASSERT (code.find ("SetTuplePriority (PATH, 3);") != string::npos);
+  NS_TEST_ASSERT (code.find ("SetTuplePriority (UNUSED") == string::npos);
+
+  unlink ((base + ".h").c_str ());
+  unlink ((base + ".cc").c_str ());
+  unlink ((base + "-helper.h").c_str ());
+  rmdir (dir);
+
+  return result;
+}
+
+static TuplePriorityTest g_tuplePriorityTest;
+
+} // namespace tests
+} // namespace rapidnet
+} // namespace ns3
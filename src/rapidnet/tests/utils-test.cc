@@ -58,6 +58,8 @@ protected:
   bool TestStringList3 ();
 
   bool TupleSerializeTest ();
+
+  bool TupleDigestTest ();
 };
 
 bool
@@ -67,7 +69,8 @@ UtilsTest::RunTests ()
   result = TestStringList1 ()
     && TestStringList2 ()
     && TestStringList3 ()
-    && TupleSerializeTest ();
+    && TupleSerializeTest ()
+    && TupleDigestTest ();
 
   return result;
 }
@@ -147,6 +150,29 @@ UtilsTest::TupleSerializeTest()
 
 }
 
+bool
+UtilsTest::TupleDigestTest ()
+{
+  bool result = true;
+  Ptr<Tuple> tuple = GetTuple ();
+  uint32_t digest = GetTupleDigest (tuple);
+
+  // Indicator attributes do not change the digest
+  tuple->AddAttribute (TupleAttribute::New ("rn-src",
+    Ipv4Value::New ("10.0.0.1")));
+  NS_TEST_ASSERT (GetTupleDigest (tuple) == digest);
+
+  // Any other change does
+  tuple->OverwriteAttribute (TupleAttribute::New ("int32",
+    Int32Value::New (79)));
+  NS_TEST_ASSERT (GetTupleDigest (tuple) != digest);
+
+  // Another basis gives another digest
+  NS_TEST_ASSERT (GetTupleDigest (tuple, 1) != GetTupleDigest (tuple));
+
+  return result;
+}
+
 static UtilsTest g_utilsTest;
 
 } // namespace tests
@@ -398,5 +398,3 @@ Tuple::New (string name, list<Ptr<TupleAttribute> > attributes)
   tuple->AddAttributes (attributes);
   return tuple;
 }
-
-BOOST_CLASS_EXPORT_IMPLEMENT(ns3::rapidnet::Tuple)
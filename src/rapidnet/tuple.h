@@ -31,22 +31,11 @@
 #include "ns3/int32-value.h"
 #include "tuple-attribute.h"
 
-#include <boost/serialization/map.hpp>
-#include <boost/serialization/base_object.hpp>
-#include <boost/serialization/export.hpp>
-
 #define QUAL(qual, name) qual + ":" + name
 #define EMPTY "EMPTY"
 
 using namespace std;
 
-//Forward declaration of class boost::serialization::access
-namespace boost{
-  namespace serialization{
-    class access;
-  }
-}
-
 namespace ns3 {
 namespace rapidnet {
 
@@ -220,6 +209,11 @@ public:
     return m_timestamp;
   }
 
+  void SetTimestamp (Time timestamp)
+  {
+    m_timestamp = timestamp;
+  }
+
   void IncRefCount ()
   {
     m_refCount++;
@@ -230,6 +224,11 @@ public:
     return m_refCount;
   }
 
+  void SetRefCount (unsigned int refCount)
+  {
+    m_refCount = refCount;
+  }
+
   static bool Less (Ptr<Tuple> l1, Ptr<Tuple> l2);
 
   /**
@@ -277,6 +276,4 @@ ostream& operator << (ostream& os, const Ptr<Tuple>& tuple);
 } //namespace rapidnet
 } //namepsace ns3
 
-BOOST_CLASS_EXPORT_KEY(ns3::rapidnet::Tuple)
-
 #endif // TUPLE_H
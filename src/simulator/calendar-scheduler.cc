@@ -343,4 +343,25 @@ CalendarScheduler::Resize (uint32_t newSize)
   DoResize (newSize, newWidth);
 }
 
+void
+CalendarScheduler::RemoveCancelled (std::vector<Event> &cancelled)
+{
+  uint32_t first = cancelled.size ();
+  for (uint32_t i = 0; i < m_nBuckets; i++)
+    {
+      for (Bucket::const_iterator j = m_buckets[i].begin (); j != m_buckets[i].end (); ++j)
+        {
+          if (j->impl->IsCancelled ())
+            {
+              cancelled.push_back (*j);
+            }
+        }
+    }
+  // Remove finds the events again and keeps the bucket sizes right.
+  for (uint32_t i = first; i < cancelled.size (); i++)
+    {
+      Remove (cancelled[i]);
+    }
+}
+
 } // namespace ns3
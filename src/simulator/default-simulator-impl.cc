@@ -25,6 +25,7 @@
 
 #include "ns3/ptr.h"
 #include "ns3/pointer.h"
+#include "ns3/string.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
@@ -42,6 +43,12 @@ DefaultSimulatorImpl::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::DefaultSimulatorImpl")
     .SetParent<Object> ()
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("EventTraceFile",
+                   "If not empty, every event run is recorded in this file, "
+                   "with the wall-clock time it took (see ns3::EventTrace).",
+                   StringValue (""),
+                   MakeStringAccessor (&DefaultSimulatorImpl::SetEventTraceFile),
+                   MakeStringChecker ())
     ;
   return tid;
 }
@@ -57,7 +64,10 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   // before ::Run is entered, the m_currentUid will be zero
   m_currentUid = 0;
   m_currentTs = 0;
+  m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_cancelledEvents = 0;
+  m_trace = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
@@ -68,6 +78,7 @@ DefaultSimulatorImpl::~DefaultSimulatorImpl ()
       next.impl->Unref ();
     }
   m_events = 0;
+  delete m_trace;
 }
 
 void
@@ -85,6 +96,18 @@ DefaultSimulatorImpl::Destroy ()
     }
 }
 
+void
+DefaultSimulatorImpl::SetEventTraceFile (std::string fileName)
+{
+  delete m_trace;
+  m_trace = 0;
+  if (!fileName.empty ())
+    {
+      m_trace = new EventTrace (fileName);
+    }
+  EventTrace::SetActive (m_trace);
+}
+
 void
 DefaultSimulatorImpl::SetScheduler (Ptr<Scheduler> scheduler)
 {
@@ -106,11 +129,28 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
 
   NS_ASSERT (next.key.m_ts >= m_currentTs);
   --m_unscheduledEvents;
+  if (next.impl->IsCancelled ())
+    {
+      --m_cancelledEvents;
+    }
 
   NS_LOG_LOGIC ("handle " << next.key.m_ts);
   m_currentTs = next.key.m_ts;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  m_currentContext = next.key.m_context;
+  if (m_trace == 0)
+    {
+      next.impl->Invoke ();
+    }
+  else
+    {
+      bool cancelled = next.impl->IsCancelled ();
+      uint32_t uidBegin = m_uid;
+      uint64_t start = EventTrace::GetWallClock ();
+      next.impl->Invoke ();
+      m_trace->RecordEvent (next.key.m_ts, next.key.m_uid, next.key.m_context,
+                            typeid (*next.impl), cancelled, start, uidBegin, m_uid);
+    }
   next.impl->Unref ();
 }
 
@@ -175,12 +215,30 @@ DefaultSimulatorImpl::Schedule (Time const &time, EventImpl *event)
   ev.impl = event;
   ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
   ev.key.m_uid = m_uid;
+  ev.key.m_context = m_currentContext;
   m_uid++;
   ++m_unscheduledEvents;
   m_events->Insert (ev);
   return EventId (event, ev.key.m_ts, ev.key.m_uid);
 }
 
+void
+DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event)
+{
+  Time tAbsolute = time + Now();
+
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (m_currentTs));
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+  ev.key.m_uid = m_uid;
+  ev.key.m_context = context;
+  m_uid++;
+  ++m_unscheduledEvents;
+  m_events->Insert (ev);
+}
+
 EventId
 DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
 {
@@ -188,6 +246,7 @@ DefaultSimulatorImpl::ScheduleNow (EventImpl *event)
   ev.impl = event;
   ev.key.m_ts = m_currentTs;
   ev.key.m_uid = m_uid;
+  ev.key.m_context = m_currentContext;
   m_uid++;
   ++m_unscheduledEvents;
   m_events->Insert (ev);
@@ -246,6 +305,7 @@ DefaultSimulatorImpl::Remove (const EventId &id)
   event.impl = id.PeekEventImpl ();
   event.key.m_ts = id.GetTs ();
   event.key.m_uid = id.GetUid ();
+  event.key.m_context = 0;
   m_events->Remove (event);
   event.impl->Cancel ();
   // whenever we remove an event from the event list, we have to unref it.
@@ -260,7 +320,30 @@ DefaultSimulatorImpl::Cancel (const EventId &id)
   if (!IsExpired (id))
     {
       id.PeekEventImpl ()->Cancel ();
+      if (id.GetUid () != 2)
+        {
+          ++m_cancelledEvents;
+          if (m_cancelledEvents >= COMPACT_MIN_CANCELLED &&
+              2 * m_cancelledEvents >= m_unscheduledEvents)
+            {
+              CompactEvents ();
+            }
+        }
+    }
+}
+
+void
+DefaultSimulatorImpl::CompactEvents (void)
+{
+  std::vector<Scheduler::Event> cancelled;
+  m_events->RemoveCancelled (cancelled);
+  NS_LOG_LOGIC ("removed " << cancelled.size () << " cancelled events");
+  for (std::vector<Scheduler::Event>::const_iterator i = cancelled.begin (); i != cancelled.end (); ++i)
+    {
+      i->impl->Unref ();
     }
+  m_unscheduledEvents -= cancelled.size ();
+  m_cancelledEvents -= cancelled.size ();
 }
 
 bool
@@ -292,6 +375,18 @@ DefaultSimulatorImpl::IsExpired (const EventId &ev) const
     }
 }
 
+uint32_t
+DefaultSimulatorImpl::GetContext (void) const
+{
+  return m_currentContext;
+}
+
+bool
+DefaultSimulatorImpl::IsLocalContext (uint32_t context) const
+{
+  return true;
+}
+
 Time 
 DefaultSimulatorImpl::GetMaximumSimulationTime (void) const
 {
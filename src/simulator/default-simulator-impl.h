@@ -24,6 +24,7 @@
 #include "simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-trace.h"
 
 #include "ns3/ptr.h"
 #include "ns3/assert.h"
@@ -48,6 +49,7 @@ public:
   virtual EventId Schedule (Time const &time, EventImpl *event);
   virtual EventId ScheduleNow (EventImpl *event);
   virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
   virtual void Remove (const EventId &ev);
   virtual void Cancel (const EventId &ev);
   virtual bool IsExpired (const EventId &ev) const;
@@ -57,10 +59,14 @@ public:
   virtual Time GetDelayLeft (const EventId &id) const;
   virtual Time GetMaximumSimulationTime (void) const;
   virtual void SetScheduler (Ptr<Scheduler> scheduler);
+  virtual uint32_t GetContext (void) const;
+  virtual bool IsLocalContext (uint32_t context) const;
 
 private:
   void ProcessOneEvent (void);
   uint64_t NextTs (void) const;
+  void CompactEvents (void);
+  void SetEventTraceFile (std::string fileName);
 
   typedef std::list<EventId> DestroyEvents;
   DestroyEvents m_destroyEvents;
@@ -69,9 +75,17 @@ private:
   uint32_t m_uid;
   uint32_t m_currentUid;
   uint64_t m_currentTs;
+  uint32_t m_currentContext;
   // number of events that have been inserted but not yet scheduled,
   // not counting the "destroy" events; this is used for validation
   int m_unscheduledEvents;
+  // number of cancelled events still in m_events: when they make up
+  // half of the queue, they are removed in one pass rather than being
+  // dequeued one by one.
+  int m_cancelledEvents;
+  static const int COMPACT_MIN_CANCELLED = 1000;
+  // records every event run when the EventTraceFile attribute is set
+  EventTrace *m_trace;
 };
 
 } // namespace ns3
@@ -18,11 +18,155 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/core-config.h"
 #include "event-impl.h"
+#include <new>
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
 
+#define EVENT_SIZE_GRANULARITY 16
+#define EVENT_SIZE_CLASSES 16
+#define EVENT_FREE_LIST_SIZE 4096
 
 namespace ns3 {
 
+struct EventImplFreeBlock
+{
+  EventImplFreeBlock *m_next;
+};
+
+static class EventImplFreeList
+{
+public:
+  EventImplFreeList ();
+  ~EventImplFreeList ();
+  void *Allocate (uint32_t sizeClass);
+  void Deallocate (void *buffer, uint32_t sizeClass);
+private:
+  EventImplFreeBlock *m_blocks[EVENT_SIZE_CLASSES];
+  uint32_t m_size[EVENT_SIZE_CLASSES];
+  bool m_enable;
+} g_mainFreeList;
+// per-thread, so that the parallel simulator can schedule concurrently.
+static __thread EventImplFreeList *g_freeList = 0;
+
+EventImplFreeList::EventImplFreeList ()
+  : m_enable (true)
+{
+  for (uint32_t i = 0; i < EVENT_SIZE_CLASSES; i++)
+    {
+      m_blocks[i] = 0;
+      m_size[i] = 0;
+    }
+}
+
+EventImplFreeList::~EventImplFreeList ()
+{
+  for (uint32_t i = 0; i < EVENT_SIZE_CLASSES; i++)
+    {
+      while (m_blocks[i] != 0)
+        {
+          EventImplFreeBlock *block = m_blocks[i];
+          m_blocks[i] = block->m_next;
+          ::operator delete (block);
+        }
+      m_size[i] = 0;
+    }
+  // events deleted by the destructors of other static objects go
+  // straight back to the heap.
+  m_enable = false;
+}
+
+void *
+EventImplFreeList::Allocate (uint32_t sizeClass)
+{
+  EventImplFreeBlock *block = m_blocks[sizeClass];
+  if (block == 0 || !m_enable)
+    {
+      return ::operator new ((sizeClass + 1) * EVENT_SIZE_GRANULARITY);
+    }
+  m_blocks[sizeClass] = block->m_next;
+  m_size[sizeClass]--;
+  return block;
+}
+
+void
+EventImplFreeList::Deallocate (void *buffer, uint32_t sizeClass)
+{
+  if (m_size[sizeClass] >= EVENT_FREE_LIST_SIZE || !m_enable)
+    {
+      ::operator delete (buffer);
+      return;
+    }
+  EventImplFreeBlock *block = static_cast<EventImplFreeBlock *> (buffer);
+  block->m_next = m_blocks[sizeClass];
+  m_blocks[sizeClass] = block;
+  m_size[sizeClass]++;
+}
+
+#ifdef HAVE_PTHREAD_H
+static pthread_t g_mainThread = pthread_self ();
+static pthread_key_t g_freeListKey;
+static pthread_once_t g_freeListKeyOnce = PTHREAD_ONCE_INIT;
+
+static void
+DeleteFreeList (void *list)
+{
+  delete static_cast<EventImplFreeList *> (list);
+  g_freeList = 0;
+}
+
+static void
+CreateFreeListKey (void)
+{
+  pthread_key_create (&g_freeListKey, &DeleteFreeList);
+}
+#endif
+
+static EventImplFreeList *
+GetFreeList (void)
+{
+  if (g_freeList == 0)
+    {
+#ifdef HAVE_PTHREAD_H
+      if (!pthread_equal (pthread_self (), g_mainThread))
+        {
+          pthread_once (&g_freeListKeyOnce, &CreateFreeListKey);
+          g_freeList = new EventImplFreeList ();
+          pthread_setspecific (g_freeListKey, g_freeList);
+          return g_freeList;
+        }
+#endif
+      g_freeList = &g_mainFreeList;
+    }
+  return g_freeList;
+}
+
+void *
+EventImpl::operator new (size_t size)
+{
+  uint32_t sizeClass = (size - 1) / EVENT_SIZE_GRANULARITY;
+  if (sizeClass >= EVENT_SIZE_CLASSES)
+    {
+      return ::operator new (size);
+    }
+  return GetFreeList ()->Allocate (sizeClass);
+}
+
+void
+EventImpl::operator delete (void *buffer, size_t size)
+{
+  // size is the size of the dynamic type since the destructor is virtual.
+  uint32_t sizeClass = (size - 1) / EVENT_SIZE_GRANULARITY;
+  if (sizeClass >= EVENT_SIZE_CLASSES)
+    {
+      ::operator delete (buffer);
+      return;
+    }
+  GetFreeList ()->Deallocate (buffer, sizeClass);
+}
+
 EventImpl::~EventImpl ()
 {}
 
@@ -53,3 +197,72 @@ EventImpl::IsCancelled (void)
 }
 
 } // namespace ns3
+
+
+#ifdef RUN_SELF_TESTS
+
+#include "ns3/test.h"
+#include "make-event.h"
+
+namespace ns3 {
+
+class EventImplTests : public Test
+{
+public:
+  EventImplTests ();
+  virtual bool RunTests (void);
+private:
+  void A (void);
+  void B (uint64_t a, uint64_t b, uint64_t c);
+  bool m_invoked;
+};
+
+EventImplTests::EventImplTests ()
+  : Test ("EventImpl")
+{}
+
+void
+EventImplTests::A (void)
+{
+  m_invoked = true;
+}
+
+void
+EventImplTests::B (uint64_t a, uint64_t b, uint64_t c)
+{
+  m_invoked = (a + b + c == 6);
+}
+
+bool
+EventImplTests::RunTests (void)
+{
+  bool result = true;
+
+  // the memory of an event is reused by the next event of the same
+  // size class.
+  EventImpl *first = MakeEvent (&EventImplTests::A, this);
+  first->Unref ();
+  EventImpl *second = MakeEvent (&EventImplTests::A, this);
+  NS_TEST_ASSERT_EQUAL (first, second);
+  m_invoked = false;
+  second->Invoke ();
+  NS_TEST_ASSERT (m_invoked);
+  second->Unref ();
+
+  EventImpl *large = MakeEvent (&EventImplTests::B, this, 1, 2, 3);
+  m_invoked = false;
+  large->Invoke ();
+  NS_TEST_ASSERT (m_invoked);
+  large->Unref ();
+  EventImpl *small = MakeEvent (&EventImplTests::A, this);
+  NS_TEST_ASSERT_EQUAL (small, second);
+  small->Unref ();
+
+  return result;
+}
+
+static EventImplTests g_eventImplTests;
+
+} // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 namespace ns3 {
 
@@ -34,6 +35,11 @@ namespace ns3 {
  * obviously (there are Ref and Unref methods) reference-counted and
  * most subclasses are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The memory of all subclasses is recycled through per-thread free
+ * lists, one for each 16-byte size class up to 256 bytes: once the
+ * lists are warm, scheduling and running an event does not touch the
+ * general heap.
  */
 class EventImpl
 {
@@ -59,6 +65,9 @@ public:
    */
   bool IsCancelled (void);
 
+  static void *operator new (size_t size);
+  static void operator delete (void *buffer, size_t size);
+
 protected:
   virtual void Notify (void) = 0;
 
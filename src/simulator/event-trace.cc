@@ -0,0 +1,323 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-trace.h"
+#include "simulator.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+#include <string.h>
+#include <time.h>
+
+NS_LOG_COMPONENT_DEFINE ("EventTrace");
+
+namespace ns3 {
+
+static const char MAGIC[8] = {'n', 's', '3', 'e', 't', 'r', 'c', '1'};
+static const uint32_t BUFFER_SIZE = 1 << 16;
+static const uint32_t MAX_DURATION = 0xffffffff;
+
+EventTrace *EventTrace::m_active = 0;
+
+EventTrace::EventTrace (std::string fileName)
+  : m_depth (0)
+{
+  m_file = fopen (fileName.c_str (), "wb");
+  if (m_file == 0)
+    {
+      NS_FATAL_ERROR ("EventTrace: could not open " << fileName);
+    }
+  m_buffer.reserve (BUFFER_SIZE);
+  Write (MAGIC, sizeof (MAGIC));
+}
+
+EventTrace::~EventTrace ()
+{
+  if (m_active == this)
+    {
+      m_active = 0;
+    }
+  Flush ();
+  fclose (m_file);
+}
+
+EventTrace *
+EventTrace::GetActive (void)
+{
+  return m_active;
+}
+
+void
+EventTrace::SetActive (EventTrace *trace)
+{
+  m_active = trace;
+}
+
+uint64_t
+EventTrace::GetWallClock (void)
+{
+  struct timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+void
+EventTrace::Write (const void *data, uint32_t size)
+{
+  if (m_buffer.size () + size > BUFFER_SIZE)
+    {
+      Flush ();
+    }
+  const char *bytes = (const char *)data;
+  m_buffer.insert (m_buffer.end (), bytes, bytes + size);
+}
+
+void
+EventTrace::Flush (void)
+{
+  if (!m_buffer.empty ())
+    {
+      if (fwrite (&m_buffer[0], 1, m_buffer.size (), m_file) != m_buffer.size ())
+        {
+          NS_LOG_WARN ("EventTrace: write failed, records lost");
+        }
+      m_buffer.clear ();
+    }
+  fflush (m_file);
+}
+
+uint32_t
+EventTrace::GetSymbol (const std::string &name)
+{
+  std::map<std::string, uint32_t>::const_iterator i = m_names.find (name);
+  if (i != m_names.end ())
+    {
+      return i->second;
+    }
+  uint32_t symbol = m_names.size ();
+  m_names[name] = symbol;
+  Record record;
+  memset (&record, 0, sizeof (record));
+  record.symbol = symbol;
+  record.duration = name.size ();
+  record.type = SYMBOL;
+  Write (&record, sizeof (record));
+  Write (name.data (), name.size ());
+  return symbol;
+}
+
+void
+EventTrace::RecordEvent (uint64_t ts, uint32_t uid, uint32_t context,
+                         const std::type_info &type, bool cancelled,
+                         uint64_t start, uint32_t uidBegin, uint32_t uidEnd)
+{
+  uint64_t duration = GetWallClock () - start;
+  // type names are unique strings: the lookup is by address and the
+  // name is only compared the first time an event type is seen.
+  uint32_t symbol;
+  std::map<const char *, uint32_t>::const_iterator i = m_types.find (type.name ());
+  if (i != m_types.end ())
+    {
+      symbol = i->second;
+    }
+  else
+    {
+      symbol = GetSymbol (type.name ());
+      m_types[type.name ()] = symbol;
+    }
+  Record record;
+  record.ts = ts;
+  record.uid = uid;
+  record.context = context;
+  record.symbol = symbol;
+  record.duration = duration > MAX_DURATION ? MAX_DURATION : duration;
+  record.uidBegin = uidBegin;
+  record.uidEnd = uidEnd;
+  record.type = cancelled ? CANCELLED : EVENT;
+  record.depth = 0;
+  record.reserved = 0;
+  Write (&record, sizeof (record));
+}
+
+uint64_t
+EventTrace::BeginRegion (void)
+{
+  m_depth++;
+  return GetWallClock ();
+}
+
+void
+EventTrace::EndRegion (const std::string &name, uint64_t start)
+{
+  uint64_t duration = GetWallClock () - start;
+  Record record;
+  record.ts = Simulator::Now ().GetTimeStep ();
+  record.uid = 0;
+  record.context = Simulator::GetContext ();
+  record.symbol = GetSymbol (name);
+  record.duration = duration > MAX_DURATION ? MAX_DURATION : duration;
+  record.uidBegin = 0;
+  record.uidEnd = 0;
+  record.type = REGION;
+  record.depth = m_depth;
+  record.reserved = 0;
+  Write (&record, sizeof (record));
+  m_depth--;
+}
+
+EventTraceReader::EventTraceReader ()
+  : m_file (0)
+{}
+
+EventTraceReader::~EventTraceReader ()
+{
+  if (m_file != 0)
+    {
+      fclose (m_file);
+    }
+}
+
+bool
+EventTraceReader::Open (std::string fileName)
+{
+  m_file = fopen (fileName.c_str (), "rb");
+  if (m_file == 0)
+    {
+      return false;
+    }
+  char magic[sizeof (MAGIC)];
+  return fread (magic, 1, sizeof (magic), m_file) == sizeof (magic)
+    && memcmp (magic, MAGIC, sizeof (magic)) == 0;
+}
+
+bool
+EventTraceReader::Read (EventTrace::Record &record)
+{
+  while (fread (&record, sizeof (record), 1, m_file) == 1)
+    {
+      if (record.type != EventTrace::SYMBOL)
+        {
+          return true;
+        }
+      std::string name (record.duration, ' ');
+      if (record.duration != 0
+          && fread (&name[0], 1, record.duration, m_file) != record.duration)
+        {
+          return false;
+        }
+      if (record.symbol >= m_symbols.size ())
+        {
+          m_symbols.resize (record.symbol + 1);
+        }
+      m_symbols[record.symbol] = name;
+    }
+  return false;
+}
+
+std::string
+EventTraceReader::GetSymbol (uint32_t symbol) const
+{
+  if (symbol < m_symbols.size ())
+    {
+      return m_symbols[symbol];
+    }
+  return "?";
+}
+
+} // namespace ns3
+
+
+#ifdef RUN_SELF_TESTS
+
+#include "ns3/test.h"
+#include "event-impl.h"
+#include <unistd.h>
+
+namespace ns3 {
+
+class EventTraceTestEvent : public EventImpl
+{
+protected:
+  virtual void Notify (void) {}
+};
+
+class EventTraceTests : public Test
+{
+public:
+  EventTraceTests ();
+  virtual bool RunTests (void);
+};
+
+EventTraceTests::EventTraceTests ()
+  : Test ("EventTrace")
+{}
+
+bool
+EventTraceTests::RunTests (void)
+{
+  bool result = true;
+
+  char fileName[] = "/tmp/ns3-event-trace-XXXXXX";
+  int fd = mkstemp (fileName);
+  NS_TEST_ASSERT (fd >= 0);
+  close (fd);
+
+  EventTraceTestEvent ev;
+  {
+    EventTrace trace (fileName);
+    uint64_t start = EventTrace::GetWallClock ();
+    trace.RecordEvent (10, 4, 1, typeid (ev), false, start, 5, 7);
+    start = trace.BeginRegion ();
+    trace.EndRegion ("rule", start);
+    trace.RecordEvent (20, 5, 2, typeid (ev), true, start, 7, 7);
+    trace.RecordEvent (30, 6, 3, typeid (int), false, start, 7, 8);
+  }
+
+  EventTraceReader reader;
+  NS_TEST_ASSERT (reader.Open (fileName));
+  EventTrace::Record record;
+  NS_TEST_ASSERT (reader.Read (record));
+  NS_TEST_ASSERT_EQUAL (record.ts, 10);
+  NS_TEST_ASSERT_EQUAL (record.uid, 4);
+  NS_TEST_ASSERT_EQUAL (record.context, 1);
+  NS_TEST_ASSERT_EQUAL (record.uidBegin, 5);
+  NS_TEST_ASSERT_EQUAL (record.uidEnd, 7);
+  NS_TEST_ASSERT_EQUAL (record.type, EventTrace::EVENT);
+  uint32_t eventSymbol = record.symbol;
+  NS_TEST_ASSERT_EQUAL (reader.GetSymbol (eventSymbol), typeid (ev).name ());
+  NS_TEST_ASSERT (reader.Read (record));
+  NS_TEST_ASSERT_EQUAL (record.type, EventTrace::REGION);
+  NS_TEST_ASSERT_EQUAL (record.depth, 1);
+  NS_TEST_ASSERT_EQUAL (reader.GetSymbol (record.symbol), "rule");
+  NS_TEST_ASSERT (reader.Read (record));
+  NS_TEST_ASSERT_EQUAL (record.type, EventTrace::CANCELLED);
+  NS_TEST_ASSERT_EQUAL (record.symbol, eventSymbol);
+  NS_TEST_ASSERT (reader.Read (record));
+  NS_TEST_ASSERT_EQUAL (reader.GetSymbol (record.symbol), typeid (int).name ());
+  NS_TEST_ASSERT (!reader.Read (record));
+
+  unlink (fileName);
+  Simulator::Destroy ();
+  return result;
+}
+
+static EventTraceTests g_eventTraceTests;
+
+} // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
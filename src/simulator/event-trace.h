@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <typeinfo>
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ * \brief a binary trace of the events run by the simulator, with the
+ *        wall-clock time each one took.
+ *
+ * Enabled with the EventTraceFile attribute of ns3::DefaultSimulatorImpl:
+ * \code
+ * NS_ATTRIBUTE_DEFAULT="ns3::DefaultSimulatorImpl::EventTraceFile=run.etrace" ./waf --run ...
+ * ./waf --run "print-event-trace --trace=run.etrace"
+ * \endcode
+ *
+ * The file starts with an 8-byte magic followed by fixed-size records in
+ * host byte order, buffered in memory and written in blocks. Each event
+ * record holds the event timestamp, uid and context, the symbol of its
+ * handler, its wall-clock duration and the range of uids it allocated,
+ * from which the insertions of the run can be rebuilt. The symbol of an event is the
+ * type name of its EventImpl, which names the handler class and its
+ * signature, e.g. void (ns3::YansWifiChannel::*)(...). Code which runs
+ * many kinds of work in one event, such as the RapidNet rule engine,
+ * records named regions inside the event with BeginRegion/EndRegion.
+ * Symbol names are written once, in a SYMBOL record followed by the
+ * name, before the first record which uses them.
+ */
+class EventTrace
+{
+public:
+  enum Type
+  {
+    EVENT = 0,
+    CANCELLED = 1,
+    REGION = 2,
+    SYMBOL = 3
+  };
+  struct Record
+  {
+    uint64_t ts;
+    uint32_t uid;
+    uint32_t context;
+    uint32_t symbol;
+    // wall-clock nanoseconds, saturated; name length for SYMBOL records
+    uint32_t duration;
+    // uids allocated while the event ran: [uidBegin, uidEnd)
+    uint32_t uidBegin;
+    uint32_t uidEnd;
+    uint16_t type;
+    // nesting level: 0 for events, 1 for the regions they contain, ...
+    uint16_t depth;
+    uint32_t reserved;
+  };
+
+  EventTrace (std::string fileName);
+  ~EventTrace ();
+
+  /**
+   * \returns the trace of the running simulator, or zero when tracing
+   *          is disabled.
+   */
+  static EventTrace *GetActive (void);
+  static void SetActive (EventTrace *trace);
+
+  /**
+   * \returns a monotonic wall clock, in nanoseconds.
+   */
+  static uint64_t GetWallClock (void);
+
+  /**
+   * \param type the EventImpl subclass of the event
+   * \param start the wall clock before the event was invoked
+   */
+  void RecordEvent (uint64_t ts, uint32_t uid, uint32_t context,
+                    const std::type_info &type, bool cancelled,
+                    uint64_t start, uint32_t uidBegin, uint32_t uidEnd);
+  /**
+   * \returns the wall clock at the start of the region
+   */
+  uint64_t BeginRegion (void);
+  void EndRegion (const std::string &name, uint64_t start);
+
+  void Flush (void);
+
+private:
+  uint32_t GetSymbol (const std::string &name);
+  void Write (const void *data, uint32_t size);
+
+  FILE *m_file;
+  std::vector<char> m_buffer;
+  std::map<const char *, uint32_t> m_types;
+  std::map<std::string, uint32_t> m_names;
+  uint16_t m_depth;
+  static EventTrace *m_active;
+};
+
+/**
+ * \ingroup simulator
+ * \brief reads the files written by EventTrace.
+ */
+class EventTraceReader
+{
+public:
+  EventTraceReader ();
+  ~EventTraceReader ();
+
+  bool Open (std::string fileName);
+  /**
+   * Reads the next EVENT, CANCELLED or REGION record: the SYMBOL
+   * records are consumed on the way.
+   * \returns false at the end of the file.
+   */
+  bool Read (EventTrace::Record &record);
+  std::string GetSymbol (uint32_t symbol) const;
+
+private:
+  FILE *m_file;
+  std::vector<std::string> m_symbols;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_TRACE_H */
@@ -193,26 +193,55 @@ HeapScheduler::RemoveNext (void)
   Exch (Root (), Last ());
   m_heap.pop_back ();
   TopDown (Root ());
+  PopRemoved ();
   return next;
 }
 
+void
+HeapScheduler::PopRemoved (void)
+{
+  // keep the root valid for PeekNext.
+  while (!m_removed.empty () && !IsEmpty () &&
+         m_removed.erase (m_heap[Root ()].key.m_uid) == 1)
+    {
+      Exch (Root (), Last ());
+      m_heap.pop_back ();
+      TopDown (Root ());
+    }
+}
 
 void
 HeapScheduler::Remove (const Event &ev)
 {
-  uint32_t uid = ev.key.m_uid;
-  for (uint32_t i = 1; i < m_heap.size (); i++)
+  NS_ASSERT (!IsEmpty ());
+  m_removed.insert (ev.key.m_uid);
+  PopRemoved ();
+}
+
+void
+HeapScheduler::RemoveCancelled (std::vector<Event> &cancelled)
+{
+  uint32_t last = Root ();
+  for (uint32_t i = Root (); i < m_heap.size (); i++)
     {
-      if (uid == m_heap[i].key.m_uid)
+      if (m_removed.erase (m_heap[i].key.m_uid) == 1)
         {
-          NS_ASSERT (m_heap[i].impl == ev.impl);
-          Exch (i, Last ());
-          m_heap.pop_back ();
-          TopDown (i);
-          return;
+          continue;
         }
+      if (m_heap[i].impl->IsCancelled ())
+        {
+          cancelled.push_back (m_heap[i]);
+          continue;
+        }
+      m_heap[last] = m_heap[i];
+      last++;
+    }
+  m_heap.resize (last);
+  NS_ASSERT (m_removed.empty ());
+  for (uint32_t i = Last () / 2; i >= Root (); i--)
+    {
+      TopDown (i);
     }
-  NS_ASSERT (false);
 }
 
 } // namespace ns3
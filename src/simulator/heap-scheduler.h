@@ -24,6 +24,7 @@
 #include "scheduler.h"
 #include <stdint.h>
 #include <vector>
+#include <set>
 
 namespace ns3 {
 
@@ -43,6 +44,9 @@ namespace ns3 {
  *    the index of the root is 1.
  *  - It uses a slightly non-standard while loop for top-down heapify
  *    to move one if statement out of the loop.
+ *  - Remove does not search the heap: it records the uid of the event,
+ *    which is dropped when it reaches the root, so that it costs
+ *    O(log n) amortized.
  */
 class HeapScheduler : public Scheduler 
 {
@@ -57,6 +61,7 @@ public:
   virtual Event PeekNext (void) const;
   virtual Event RemoveNext (void);
   virtual void Remove (const Event &ev);
+  virtual void RemoveCancelled (std::vector<Event> &cancelled);
 
 private:
   typedef std::vector<Event> BinaryHeap;
@@ -76,8 +81,11 @@ private:
   inline void Exch (uint32_t a, uint32_t b);
   void BottomUp (void);
   void TopDown (uint32_t start);
+  void PopRemoved (void);
 
   BinaryHeap m_heap;
+  // the uids of the events removed but still in m_heap.
+  std::set<uint32_t> m_removed;
 };
 
 } // namespace ns3
@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "high-precision-int64.h"
+
+#include <cmath>
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+// 2^63: the smallest double above the int64_t range. -2^63 is the
+// smallest int64_t, so the range is [-2^63, 2^63).
+static const double MAX_63 = 9223372036854775808.0;
+static const int64_t MAX_INT64 = 0x7fffffffffffffffLL;
+static const int64_t MIN_INT64 = -MAX_INT64 - 1;
+
+HighPrecision::HighPrecision (double value)
+{
+  SetSlow (value);
+}
+
+void
+HighPrecision::SetSlow (double value)
+{
+  // go back to the fast representation whenever the value is an
+  // integer which fits: Scalar (0.5) * Seconds (2) is fast again.
+  if (value >= -MAX_63 && value < MAX_63 && value == floor (value))
+    {
+      m_isFast = true;
+      m_fastValue = (int64_t)value;
+    }
+  else
+    {
+      m_isFast = false;
+      m_slowValue = value;
+    }
+}
+
+int64_t
+HighPrecision::SlowGetInteger (void) const
+{
+  double value = floor (m_slowValue);
+  if (value >= MAX_63)
+    {
+      return MAX_INT64;
+    }
+  else if (value < -MAX_63)
+    {
+      return MIN_INT64;
+    }
+  return (int64_t)value;
+}
+
+bool
+HighPrecision::SlowAdd (HighPrecision const &o)
+{
+  bool overflow = m_isFast && o.m_isFast;
+  SetSlow (GetDouble () + o.GetDouble ());
+  return overflow;
+}
+bool
+HighPrecision::SlowSub (HighPrecision const &o)
+{
+  bool overflow = m_isFast && o.m_isFast;
+  SetSlow (GetDouble () - o.GetDouble ());
+  return overflow;
+}
+bool
+HighPrecision::SlowMul (HighPrecision const &o)
+{
+  if (m_isFast && o.m_isFast)
+    {
+      int64_t a = m_fastValue;
+      int64_t b = o.m_fastValue;
+      int64_t result = (int64_t)((uint64_t)a * (uint64_t)b);
+      if (a == 0 || (!(a == -1 && b == MIN_INT64) && result / a == b))
+        {
+          m_fastValue = result;
+          return false;
+        }
+      SetSlow ((double)a * (double)b);
+      return true;
+    }
+  SetSlow (GetDouble () * o.GetDouble ());
+  return false;
+}
+bool
+HighPrecision::Div (HighPrecision const &o)
+{
+  if (m_isFast && o.m_isFast && o.m_fastValue != 0
+      && !(m_fastValue == MIN_INT64 && o.m_fastValue == -1)
+      && m_fastValue % o.m_fastValue == 0)
+    {
+      m_fastValue /= o.m_fastValue;
+      return false;
+    }
+  NS_ASSERT (o.GetDouble () != 0);
+  SetSlow (GetDouble () / o.GetDouble ());
+  return false;
+}
+int
+HighPrecision::SlowCompare (HighPrecision const &o) const
+{
+  double a = GetDouble ();
+  double b = o.GetDouble ();
+  if (a < b)
+    {
+      return -1;
+    }
+  else if (a == b)
+    {
+      return 0;
+    }
+  else
+    {
+      return 1;
+    }
+}
+
+}; // namespace ns3
+
+
+#ifdef RUN_SELF_TESTS
+#include "ns3/test.h"
+
+namespace ns3 {
+
+class HighPrecisionInt64Tests : public Test
+{
+public:
+  HighPrecisionInt64Tests ();
+  virtual ~HighPrecisionInt64Tests ();
+  virtual bool RunTests (void);
+};
+
+HighPrecisionInt64Tests::HighPrecisionInt64Tests ()
+  : Test ("Int64")
+{}
+HighPrecisionInt64Tests::~HighPrecisionInt64Tests ()
+{}
+
+#define V(v) \
+  HighPrecision (v, false)
+
+bool
+HighPrecisionInt64Tests::RunTests (void)
+{
+  bool result = true;
+
+  HighPrecision a;
+
+  a = V (1);
+  a.Sub (V (3));
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), -2);
+  a = V (-2);
+  a.Add (V (5));
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), 3);
+  a = V (-3);
+  a.Mul (V (4));
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), -12);
+
+  // integers beyond 32 bits stay exact
+  a = V (3000000000LL);
+  NS_TEST_ASSERT (!a.Mul (V (3000000000LL)));
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), 9000000000000000000LL);
+
+  a = V (6);
+  a.Div (V (3));
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), 2);
+  a = V (2);
+  a.Div (V (3));
+  a.Mul (V (3));
+  NS_TEST_ASSERT_EQUAL (a.GetDouble (), 2.0);
+
+  // fractional values, such as scalars
+  a = HighPrecision (0.5);
+  a.Mul (HighPrecision (-5));
+  NS_TEST_ASSERT_EQUAL (a.GetDouble (), -2.5);
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), -3);
+  a.Mul (V (2));
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), -5);
+  NS_TEST_ASSERT (HighPrecision (0.5).Compare (V (1)) < 0);
+  NS_TEST_ASSERT (V (1).Compare (HighPrecision (0.5)) > 0);
+  a = HighPrecision (0.1);
+  a.Div (HighPrecision (1.25));
+  NS_TEST_ASSERT_EQUAL (a.GetDouble (), 0.08);
+
+  // overflows are reported, and saturate the integer value
+  a = V (MAX_INT64);
+  NS_TEST_ASSERT (a.Add (V (1)));
+  NS_TEST_ASSERT (a.Compare (V (0)) > 0);
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), MAX_INT64);
+  a = V (MIN_INT64);
+  NS_TEST_ASSERT (a.Sub (V (1)));
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), MIN_INT64);
+  a = V (MAX_INT64 / 2 + 1);
+  NS_TEST_ASSERT (a.Mul (V (2)));
+  NS_TEST_ASSERT (a.Compare (V (0)) > 0);
+  a = V (MAX_INT64 - 1);
+  NS_TEST_ASSERT (!a.Add (V (1)));
+  NS_TEST_ASSERT_EQUAL (a.GetInteger (), MAX_INT64);
+
+  return result;
+}
+
+static HighPrecisionInt64Tests g_int64Tests;
+
+} // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
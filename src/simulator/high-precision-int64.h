@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef HIGH_PRECISION_INT64_H
+#define HIGH_PRECISION_INT64_H
+
+#include <stdint.h>
+
+/**
+ * This file contains an implementation of the HighPrecision class
+ * which stores time values as plain 64 bit integers (timesteps, that
+ * is, nanoseconds with the default TimeStepPrecision).
+ *
+ * Like the 128 bit implementation, it has a m_fastValue and a
+ * m_slowValue, but the slow value is a double rather than a 128 bit
+ * fixed point number, and it is only used for the values which are
+ * not integers: scalars such as Scalar (0.5) and the result of a
+ * division which is not exact. In this mode, Seconds () and the
+ * other constructors of Time round to the nearest timestep, so the
+ * time values are integers (unless computed from a fractional scalar)
+ * and almost all the Time arithmetic and comparisons are inline 64 bit
+ * integer operations.
+ *
+ * Additions, subtractions and multiplications of integers are checked
+ * for overflow: a result which does not fit in 64 bits is kept as a
+ * (less precise) double and the operation returns true. The 128 bit
+ * implementation remains the default, for the simulations which need
+ * exact fractional time arithmetic.
+ */
+
+namespace ns3 {
+
+class HighPrecision
+{
+public:
+  inline HighPrecision ();
+  inline HighPrecision (int64_t value, bool dummy);
+  HighPrecision (double value);
+
+  inline int64_t GetInteger (void) const;
+  inline double GetDouble (void) const;
+  inline bool Add (HighPrecision const &o);
+  inline bool Sub (HighPrecision const &o);
+  inline bool Mul (HighPrecision const &o);
+  bool Div (HighPrecision const &o);
+
+  inline int Compare (HighPrecision const &o) const;
+  inline static HighPrecision Zero (void);
+private:
+  int64_t SlowGetInteger (void) const;
+  bool SlowAdd (HighPrecision const &o);
+  bool SlowSub (HighPrecision const &o);
+  bool SlowMul (HighPrecision const &o);
+  int SlowCompare (HighPrecision const &o) const;
+  void SetSlow (double value);
+
+  bool m_isFast;
+  int64_t m_fastValue;
+  double m_slowValue;
+};
+
+}; // namespace ns3
+
+namespace ns3 {
+
+HighPrecision::HighPrecision ()
+  : m_isFast (true),
+    m_fastValue (0)
+{}
+
+HighPrecision::HighPrecision (int64_t value, bool dummy)
+  : m_isFast (true),
+    m_fastValue (value)
+{}
+
+int64_t
+HighPrecision::GetInteger (void) const
+{
+  if (m_isFast)
+    {
+      return m_fastValue;
+    }
+  else
+    {
+      return SlowGetInteger ();
+    }
+}
+double
+HighPrecision::GetDouble (void) const
+{
+  if (m_isFast)
+    {
+      return (double)m_fastValue;
+    }
+  else
+    {
+      return m_slowValue;
+    }
+}
+bool
+HighPrecision::Add (HighPrecision const &o)
+{
+  if (m_isFast && o.m_isFast)
+    {
+      // two's complement addition never traps when done unsigned;
+      // it overflowed iff the operands have the same sign and the
+      // result has the other one.
+      int64_t result = (int64_t)((uint64_t)m_fastValue + (uint64_t)o.m_fastValue);
+      if (((m_fastValue ^ result) & (o.m_fastValue ^ result)) >= 0)
+        {
+          m_fastValue = result;
+          return false;
+        }
+    }
+  return SlowAdd (o);
+}
+bool
+HighPrecision::Sub (HighPrecision const &o)
+{
+  if (m_isFast && o.m_isFast)
+    {
+      int64_t result = (int64_t)((uint64_t)m_fastValue - (uint64_t)o.m_fastValue);
+      if (((m_fastValue ^ o.m_fastValue) & (m_fastValue ^ result)) >= 0)
+        {
+          m_fastValue = result;
+          return false;
+        }
+    }
+  return SlowSub (o);
+}
+bool
+HighPrecision::Mul (HighPrecision const &o)
+{
+  if (m_isFast && o.m_isFast)
+    {
+      // both operands fit in 32 bits: the product fits in 64 bits.
+      // This is by far the most common case (Scalar (2) * Seconds (1)).
+      int64_t a = m_fastValue;
+      int64_t b = o.m_fastValue;
+      if (a == (int32_t)a && b == (int32_t)b)
+        {
+          m_fastValue = a * b;
+          return false;
+        }
+    }
+  return SlowMul (o);
+}
+
+int
+HighPrecision::Compare (HighPrecision const &o) const
+{
+  if (m_isFast && o.m_isFast)
+    {
+      if (m_fastValue < o.m_fastValue)
+        {
+          return -1;
+        }
+      else if (m_fastValue == o.m_fastValue)
+        {
+          return 0;
+        }
+      else
+        {
+          return +1;
+        }
+    }
+  else
+    {
+      return SlowCompare (o);
+    }
+  // The below statement is unreachable but necessary for optimized
+  // builds with gcc-4.0.x due to a compiler bug.
+  return 0;
+}
+HighPrecision
+HighPrecision::Zero (void)
+{
+  return HighPrecision ();
+}
+
+}; // namespace ns3
+
+#endif /* HIGH_PRECISION_INT64_H */
@@ -23,11 +23,13 @@
 #include <stdint.h>
 #include "ns3/simulator-config.h"
 
-#ifdef USE_HIGH_PRECISION_DOUBLE
+#if defined (USE_HIGH_PRECISION_DOUBLE)
 #include "high-precision-double.h"
-#else /* USE_HIGH_PRECISION_DOUBLE */
+#elif defined (USE_HIGH_PRECISION_INT64)
+#include "high-precision-int64.h"
+#else
 #include "high-precision-128.h"
-#endif /* USE_HIGH_PRECISION_DOUBLE */
+#endif
 
 namespace ns3 {
 
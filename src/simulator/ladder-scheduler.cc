@@ -0,0 +1,564 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ladder-scheduler.h"
+#include "event-impl.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("LadderScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+// a bucket with no more events than this is sorted into the bottom list
+// instead of being spread over a finer rung.
+static const uint32_t THRESHOLD = 50;
+static const uint32_t MAX_RUNGS = 8;
+static const uint32_t MAX_BUCKETS = 1 << 16;
+
+static bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return a.key > b.key;
+}
+
+TypeId
+LadderScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::LadderScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<LadderScheduler> ()
+    ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_fifoHead (0),
+    m_now (0),
+    m_nRungs (0),
+    m_topStart (0)
+{
+  // CreateRung hands out pointers into m_rungs: it must never be
+  // reallocated.
+  m_rungs.reserve (MAX_RUNGS);
+}
+
+LadderScheduler::~LadderScheduler ()
+{}
+
+uint64_t
+LadderScheduler::BucketStart (const Rung &rung) const
+{
+  return rung.m_start + rung.m_current * rung.m_width;
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  if (ev.key.m_ts == m_now &&
+      (m_fifo.empty () || m_fifo.back ().key.m_uid < ev.key.m_uid))
+    {
+      m_fifo.push_back (ev);
+      return;
+    }
+  InsertInLadder (ev);
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+}
+
+void
+LadderScheduler::InsertInLadder (const Event &ev)
+{
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      m_top.push_back (ev);
+      return;
+    }
+  // the rung i + 1 spans the bucket of the rung i which precedes its
+  // current one, so the first rung whose current bucket starts before
+  // ts is the one which holds ts.
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      if (ts >= BucketStart (m_rungs[i]))
+        {
+          AddToRung (&m_rungs[i], ev);
+          return;
+        }
+    }
+  InsertInBottom (ev);
+}
+
+void
+LadderScheduler::InsertInBottom (const Event &ev)
+{
+  Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, &IsLater);
+  m_bottom.insert (i, ev);
+  if (m_bottom.size () > THRESHOLD && m_nRungs < MAX_RUNGS &&
+      m_bottom.front ().key.m_ts != m_bottom.back ().key.m_ts)
+    {
+      SpawnFromBottom ();
+    }
+}
+
+LadderScheduler::Rung *
+LadderScheduler::CreateRung (uint64_t start, uint64_t end, uint32_t n)
+{
+  NS_ASSERT (m_nRungs < MAX_RUNGS && end > start);
+  uint64_t span = end - start;
+  uint64_t nBuckets = std::max (std::min (n, MAX_BUCKETS), (uint32_t)1);
+  uint64_t width = std::max ((span + nBuckets - 1) / nBuckets, (uint64_t)1);
+  nBuckets = (span + width - 1) / width;
+  if (m_rungs.size () == m_nRungs)
+    {
+      m_rungs.push_back (Rung ());
+    }
+  Rung *rung = &m_rungs[m_nRungs];
+  m_nRungs++;
+  rung->m_start = start;
+  rung->m_width = width;
+  rung->m_current = 0;
+  rung->m_count = 0;
+  rung->m_buckets.resize (nBuckets);
+  NS_LOG_LOGIC ("rung " << (m_nRungs - 1) << " start=" << start << " width=" << width <<
+                " buckets=" << nBuckets);
+  return rung;
+}
+
+void
+LadderScheduler::AddToRung (Rung *rung, const Event &ev)
+{
+  uint64_t index = (ev.key.m_ts - rung->m_start) / rung->m_width;
+  NS_ASSERT (index >= rung->m_current && index < rung->m_buckets.size ());
+  rung->m_buckets[index].push_back (ev);
+  rung->m_count++;
+}
+
+void
+LadderScheduler::DropRemovedFromTop (void)
+{
+  if (m_topRemoved.empty ())
+    {
+      return;
+    }
+  Bucket::iterator end = m_top.begin ();
+  for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); ++i)
+    {
+      if (m_topRemoved.find (i->key.m_uid) == m_topRemoved.end ())
+        {
+          *end = *i;
+          ++end;
+        }
+    }
+  m_top.erase (end, m_top.end ());
+  m_topRemoved.clear ();
+}
+
+bool
+LadderScheduler::SpawnFromTop (void)
+{
+  NS_ASSERT (m_nRungs == 0);
+  DropRemovedFromTop ();
+  if (m_top.empty ())
+    {
+      return false;
+    }
+  uint64_t min = m_top.front ().key.m_ts;
+  uint64_t max = min;
+  for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); ++i)
+    {
+      min = std::min (min, i->key.m_ts);
+      max = std::max (max, i->key.m_ts);
+    }
+  Rung *rung = CreateRung (min, max + 1, m_top.size ());
+  m_topStart = rung->m_start + rung->m_buckets.size () * rung->m_width;
+  for (Bucket::const_iterator i = m_top.begin (); i != m_top.end (); ++i)
+    {
+      AddToRung (rung, *i);
+    }
+  m_top.clear ();
+  return true;
+}
+
+void
+LadderScheduler::SpawnFromBottom (void)
+{
+  // all the events of the bottom list are earlier than the current
+  // bucket of the last rung.
+  uint64_t end = m_topStart;
+  if (m_nRungs > 0)
+    {
+      end = BucketStart (m_rungs[m_nRungs - 1]);
+    }
+  Rung *rung = CreateRung (m_bottom.back ().key.m_ts, end, m_bottom.size ());
+  for (Bucket::const_iterator i = m_bottom.begin (); i != m_bottom.end (); ++i)
+    {
+      AddToRung (rung, *i);
+    }
+  m_bottom.clear ();
+}
+
+void
+LadderScheduler::Refill (void)
+{
+  NS_ASSERT (m_bottom.empty ());
+  while (true)
+    {
+      if (m_nRungs == 0 && !SpawnFromTop ())
+        {
+          return;
+        }
+      Rung *rung = &m_rungs[m_nRungs - 1];
+      if (rung->m_count == 0)
+        {
+          m_nRungs--;
+          continue;
+        }
+      while (rung->m_buckets[rung->m_current].empty ())
+        {
+          rung->m_current++;
+        }
+      Bucket &bucket = rung->m_buckets[rung->m_current];
+      if (bucket.size () <= THRESHOLD || rung->m_width == 1 || m_nRungs == MAX_RUNGS)
+        {
+          rung->m_count -= bucket.size ();
+          rung->m_current++;
+          m_bottom.swap (bucket);
+          std::sort (m_bottom.begin (), m_bottom.end (), &IsLater);
+          return;
+        }
+      // too many events to sort: spread them over a finer rung.
+      uint64_t start = BucketStart (*rung);
+      m_spill.swap (bucket);
+      rung->m_count -= m_spill.size ();
+      rung->m_current++;
+      Rung *child = CreateRung (start, start + rung->m_width, m_spill.size ());
+      for (Bucket::const_iterator i = m_spill.begin (); i != m_spill.end (); ++i)
+        {
+          AddToRung (child, *i);
+        }
+      m_spill.clear ();
+    }
+}
+
+bool
+LadderScheduler::IsNextInFifo (void) const
+{
+  return m_fifoHead < m_fifo.size () &&
+    (m_bottom.empty () || m_fifo[m_fifoHead].key < m_bottom.back ().key);
+}
+
+bool
+LadderScheduler::IsEmpty (void) const
+{
+  return m_fifoHead == m_fifo.size () && m_bottom.empty ();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext (void) const
+{
+  NS_ASSERT (!IsEmpty ());
+  if (IsNextInFifo ())
+    {
+      return m_fifo[m_fifoHead];
+    }
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext (void)
+{
+  NS_ASSERT (!IsEmpty ());
+  Event next;
+  if (IsNextInFifo ())
+    {
+      next = m_fifo[m_fifoHead];
+      m_fifoHead++;
+      if (m_fifoHead == m_fifo.size ())
+        {
+          m_fifo.clear ();
+          m_fifoHead = 0;
+        }
+    }
+  else
+    {
+      next = m_bottom.back ();
+      m_bottom.pop_back ();
+      if (m_bottom.empty ())
+        {
+          Refill ();
+        }
+    }
+  // the fifo only ever holds events at m_now, so it must be empty
+  // whenever m_now moves forward.
+  NS_ASSERT (next.key.m_ts == m_now || m_fifo.empty ());
+  m_now = next.key.m_ts;
+  return next;
+}
+
+bool
+LadderScheduler::RemoveFrom (Bucket &bucket, const Event &ev)
+{
+  for (Bucket::iterator i = bucket.begin (); i != bucket.end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          NS_ASSERT (i->impl == ev.impl);
+          // buckets are not sorted
+          *i = bucket.back ();
+          bucket.pop_back ();
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  uint64_t ts = ev.key.m_ts;
+  if (ts == m_now)
+    {
+      for (Bucket::iterator i = m_fifo.begin () + m_fifoHead; i != m_fifo.end (); ++i)
+        {
+          if (i->key.m_uid == ev.key.m_uid)
+            {
+              m_fifo.erase (i);
+              if (m_fifoHead == m_fifo.size ())
+                {
+                  m_fifo.clear ();
+                  m_fifoHead = 0;
+                }
+              return;
+            }
+        }
+    }
+  if (ts >= m_topStart)
+    {
+      m_topRemoved.insert (ev.key.m_uid);
+      return;
+    }
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= BucketStart (rung))
+        {
+          bool found = RemoveFrom (rung.m_buckets[(ts - rung.m_start) / rung.m_width], ev);
+          NS_ASSERT (found);
+          rung.m_count--;
+          return;
+        }
+    }
+  Bucket::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, &IsLater);
+  NS_ASSERT (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid);
+  m_bottom.erase (i);
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+}
+
+uint32_t
+LadderScheduler::RemoveCancelledFrom (Bucket &bucket, uint32_t start, std::vector<Event> &cancelled)
+{
+  // keeps the order of the remaining events.
+  uint32_t last = start;
+  for (uint32_t i = start; i < bucket.size (); i++)
+    {
+      if (bucket[i].impl->IsCancelled ())
+        {
+          cancelled.push_back (bucket[i]);
+        }
+      else
+        {
+          bucket[last] = bucket[i];
+          last++;
+        }
+    }
+  uint32_t n = bucket.size () - last;
+  bucket.resize (last);
+  return n;
+}
+
+void
+LadderScheduler::RemoveCancelled (std::vector<Event> &cancelled)
+{
+  RemoveCancelledFrom (m_fifo, m_fifoHead, cancelled);
+  if (m_fifoHead == m_fifo.size ())
+    {
+      m_fifo.clear ();
+      m_fifoHead = 0;
+    }
+  RemoveCancelledFrom (m_bottom, 0, cancelled);
+  for (uint32_t i = 0; i < m_nRungs; i++)
+    {
+      Rung &rung = m_rungs[i];
+      for (uint32_t j = rung.m_current; j < rung.m_buckets.size (); j++)
+        {
+          rung.m_count -= RemoveCancelledFrom (rung.m_buckets[j], 0, cancelled);
+        }
+    }
+  // the events removed from the top list are not cancelled events for
+  // the caller: they must be dropped first.
+  DropRemovedFromTop ();
+  RemoveCancelledFrom (m_top, 0, cancelled);
+  if (m_bottom.empty ())
+    {
+      Refill ();
+    }
+}
+
+} // namespace ns3
+
+
+#ifdef RUN_SELF_TESTS
+
+#include "ns3/test.h"
+#include "map-scheduler.h"
+
+namespace ns3 {
+
+class LadderSchedulerTests : public Test
+{
+public:
+  LadderSchedulerTests ();
+  virtual bool RunTests (void);
+private:
+  uint32_t Random (uint32_t n);
+  bool RunOne (uint32_t seed);
+
+  uint32_t m_random;
+};
+
+LadderSchedulerTests::LadderSchedulerTests ()
+  : Test ("LadderScheduler")
+{}
+
+uint32_t
+LadderSchedulerTests::Random (uint32_t n)
+{
+  m_random = m_random * 1103515245 + 12345;
+  return (m_random >> 8) % n;
+}
+
+bool
+LadderSchedulerTests::RunOne (uint32_t seed)
+{
+  bool result = true;
+  // compare a mix of bursts, jittered sends, timers and removals with
+  // the std::map scheduler.
+  Ptr<Scheduler> ladder = CreateObject<LadderScheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+  std::vector<Scheduler::Event> pending;
+  std::vector<bool> removed;
+  uint64_t now = 0;
+  uint32_t uid = 0;
+  m_random = seed;
+  for (uint32_t step = 0; step < 20000 && result; step++)
+    {
+      uint32_t op = Random (100);
+      if (op < 55 || reference->IsEmpty ())
+        {
+          uint32_t n = 1;
+          uint64_t delay = 0;
+          uint32_t kind = Random (4);
+          if (kind == 0)
+            {
+              n = 1 + Random (80);
+            }
+          else if (kind == 1)
+            {
+              delay = Random (10);
+            }
+          else if (kind == 2)
+            {
+              delay = Random (100000);
+            }
+          else
+            {
+              delay = (uint64_t)Random (1000) * 1000000000;
+            }
+          for (uint32_t i = 0; i < n; i++)
+            {
+              Scheduler::Event ev;
+              ev.impl = 0;
+              ev.key.m_ts = now + delay;
+              ev.key.m_uid = uid++;
+              ev.key.m_context = 0;
+              ladder->Insert (ev);
+              reference->Insert (ev);
+              pending.push_back (ev);
+              removed.push_back (false);
+            }
+        }
+      else if (op < 90)
+        {
+          Scheduler::Event expected = reference->RemoveNext ();
+          NS_TEST_ASSERT_EQUAL (ladder->PeekNext ().key.m_uid, expected.key.m_uid);
+          Scheduler::Event next = ladder->RemoveNext ();
+          NS_TEST_ASSERT_EQUAL (next.key.m_uid, expected.key.m_uid);
+          NS_TEST_ASSERT_EQUAL (next.key.m_ts, expected.key.m_ts);
+          removed[next.key.m_uid] = true;
+          now = next.key.m_ts;
+        }
+      else
+        {
+          // remove some event still in the queue
+          uint32_t index = Random (pending.size ());
+          Scheduler::Event ev = pending[index];
+          pending[index] = pending.back ();
+          pending.pop_back ();
+          if (removed[ev.key.m_uid])
+            {
+              continue;
+            }
+          removed[ev.key.m_uid] = true;
+          ladder->Remove (ev);
+          reference->Remove (ev);
+        }
+      NS_TEST_ASSERT_EQUAL (ladder->IsEmpty (), reference->IsEmpty ());
+    }
+  while (!reference->IsEmpty () && result)
+    {
+      NS_TEST_ASSERT_EQUAL (ladder->RemoveNext ().key.m_uid, reference->RemoveNext ().key.m_uid);
+    }
+  NS_TEST_ASSERT (ladder->IsEmpty ());
+  return result;
+}
+
+bool
+LadderSchedulerTests::RunTests (void)
+{
+  bool result = true;
+  for (uint32_t seed = 1; seed <= 4; seed++)
+    {
+      NS_TEST_ASSERT (RunOne (seed));
+    }
+  return result;
+}
+
+static LadderSchedulerTests g_ladderSchedulerTests;
+
+} // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
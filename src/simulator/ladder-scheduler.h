@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+#include <set>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a ladder queue event scheduler
+ *
+ * This is the ladder queue of Tang, Goh and Thng ("Ladder Queue: An
+ * O(1) Priority Queue Structure for Large-Scale Discrete Event
+ * Simulation", ACM TOMACS, 2005).  Far-future events are appended,
+ * unsorted, to the "top" list.  When they are needed, they are spread
+ * over the buckets of a "rung", and the buckets with too many events
+ * are themselves spread over finer rungs, until the earliest bucket is
+ * small enough to be sorted into the "bottom" list, from which events
+ * are dequeued.  Insert and RemoveNext are O(1) amortized for the
+ * distributions usually seen in network simulations.
+ *
+ * Events scheduled for the timestamp of the last event removed (that
+ * is, Simulator::ScheduleNow) are appended to a separate FIFO which
+ * bypasses the ladder entirely: bursts of same-time events cost one
+ * append and one pop each.
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  LadderScheduler ();
+  virtual ~LadderScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+  virtual void RemoveCancelled (std::vector<Event> &cancelled);
+
+private:
+  typedef std::vector<Event> Bucket;
+  struct Rung
+  {
+    uint64_t m_start;
+    uint64_t m_width;
+    uint32_t m_current;
+    uint32_t m_count;
+    std::vector<Bucket> m_buckets;
+  };
+
+  uint64_t BucketStart (const Rung &rung) const;
+  void InsertInLadder (const Event &ev);
+  void InsertInBottom (const Event &ev);
+  Rung *CreateRung (uint64_t start, uint64_t end, uint32_t n);
+  void AddToRung (Rung *rung, const Event &ev);
+  void DropRemovedFromTop (void);
+  bool SpawnFromTop (void);
+  void SpawnFromBottom (void);
+  void Refill (void);
+  bool RemoveFrom (Bucket &bucket, const Event &ev);
+  uint32_t RemoveCancelledFrom (Bucket &bucket, uint32_t start, std::vector<Event> &cancelled);
+  bool IsNextInFifo (void) const;
+
+  // events at m_now, in uid order, starting at m_fifoHead.
+  Bucket m_fifo;
+  uint32_t m_fifoHead;
+  uint64_t m_now;
+  // sorted in decreasing order: the next event is at the back.
+  Bucket m_bottom;
+  // the rungs are reused: only the first m_nRungs ones are in use.
+  std::vector<Rung> m_rungs;
+  uint32_t m_nRungs;
+  Bucket m_top;
+  uint64_t m_topStart;
+  // the uids of the events removed from m_top: they are only dropped
+  // when m_top is spread over a rung.
+  std::set<uint32_t> m_topRemoved;
+  // scratch space for the events of a bucket being spread over a rung.
+  Bucket m_spill;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
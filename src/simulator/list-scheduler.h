@@ -50,6 +50,7 @@ class ListScheduler : public Scheduler
   virtual Event PeekNext (void) const;
   virtual Event RemoveNext (void);
   virtual void Remove (const Event &ev);
+  virtual void RemoveCancelled (std::vector<Event> &cancelled);
 
  private:
 
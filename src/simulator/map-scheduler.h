@@ -48,6 +48,7 @@ public:
   virtual Event PeekNext (void) const;
   virtual Event RemoveNext (void);
   virtual void Remove (const Event &ev);
+  virtual void RemoveCancelled (std::vector<Event> &cancelled);
 private:
 
   typedef std::map<Scheduler::EventKey, EventImpl*> EventMap;
@@ -492,4 +492,26 @@ Ns2CalendarScheduler::newwidth(int newsize)
 }
 
   
+void
+Ns2CalendarScheduler::RemoveCancelled (std::vector<Event> &cancelled)
+{
+	uint32_t first = cancelled.size ();
+	for (int i = 0; i < nbuckets_; i++) {
+		BucketItem *head = buckets_[i].list_;
+		if (head == 0) {
+			continue;
+		}
+		BucketItem *e = head;
+		do {
+			if (e->event.impl->IsCancelled ()) {
+				cancelled.push_back (e->event);
+			}
+			e = e->next_;
+		} while (e != head);
+	}
+	for (uint32_t i = first; i < cancelled.size (); i++) {
+		Remove (cancelled[i]);
+	}
+}
+
 } // namespace ns3
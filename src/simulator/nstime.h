@@ -27,7 +27,6 @@
 #include <math.h>
 #include <ostream>
 #include "high-precision.h"
-#include "cairo-wideint-private.h"
 
 namespace ns3 {
 
@@ -335,7 +334,7 @@ TimeUnit<N> Min (TimeUnit<N> const &ta, TimeUnit<N> const &tb)
 {
   HighPrecision a = ta.GetHighPrecision ();
   HighPrecision b = tb.GetHighPrecision ();  
-  return TimeUnit<N> (Max (a, b));
+  return TimeUnit<N> (Min (a, b));
 }
 
 // Explicit instatiation of the TimeUnit template for N=1, with a few
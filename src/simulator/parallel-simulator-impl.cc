@@ -0,0 +1,1040 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simulator.h"
+#include "parallel-simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+
+#include "ns3/ptr.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/global-value.h"
+
+#include <algorithm>
+#include <sched.h>
+#include <unistd.h>
+
+NS_LOG_COMPONENT_DEFINE ("ParallelSimulatorImpl");
+
+namespace ns3 {
+
+// the logical process run by the calling thread, or zero outside of
+// a window.
+static __thread void *g_currentLp = 0;
+
+static const uint32_t GLOBAL_LP = 0xffffffff;
+
+NS_OBJECT_ENSURE_REGISTERED (ParallelSimulatorImpl);
+
+TypeId
+ParallelSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ParallelSimulatorImpl")
+    .SetParent<Object> ()
+    .AddConstructor<ParallelSimulatorImpl> ()
+    .AddAttribute ("Lookahead",
+                   "The length of a synchronization window: no event may be "
+                   "scheduled in another logical process with a smaller delay.",
+                   TimeValue (Seconds (0)),
+                   MakeTimeAccessor (&ParallelSimulatorImpl::m_lookahead),
+                   MakeTimeChecker ())
+    .AddAttribute ("MaxThreads",
+                   "The maximum number of threads running logical processes; "
+                   "zero means one per online processor.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ParallelSimulatorImpl::m_maxThreads),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+  return tid;
+}
+
+ParallelSimulatorImpl::ParallelSimulatorImpl ()
+  : m_stop (false),
+    m_done (false),
+    m_inWindow (false),
+    m_ordered (false),
+    m_windowEnd (0),
+    m_windowUid (0),
+    m_nextLp (0),
+    m_nWindows (0)
+{
+  m_global.m_index = GLOBAL_LP;
+  // uids are allocated from 4, see DefaultSimulatorImpl.
+  m_global.m_uid = 4;
+  m_global.m_currentEvent = 0;
+  m_global.m_currentTs = 0;
+  m_global.m_currentContext = Simulator::NO_CONTEXT;
+
+  // Simulator::SetImplementation does not provide a scheduler.
+  StringValue s ("ns3::MapScheduler");
+  for (GlobalValue::Iterator i = GlobalValue::Begin (); i != GlobalValue::End (); ++i)
+    {
+      if ((*i)->GetName () == "SchedulerType")
+        {
+          (*i)->GetValue (s);
+        }
+    }
+  m_schedulerFactory.SetTypeId (s.Get ());
+  m_global.m_events = m_schedulerFactory.Create<Scheduler> ();
+}
+
+ParallelSimulatorImpl::~ParallelSimulatorImpl ()
+{
+  while (!m_global.m_events->IsEmpty ())
+    {
+      m_global.m_events->RemoveNext ().impl->Unref ();
+    }
+  m_global.m_events = 0;
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      LogicalProcess *lp = *i;
+      while (!lp->m_events->IsEmpty ())
+        {
+          lp->m_events->RemoveNext ().impl->Unref ();
+        }
+      for (std::vector<Outgoing>::iterator j = lp->m_outbox.begin (); j != lp->m_outbox.end (); ++j)
+        {
+          j->m_event.impl->Unref ();
+        }
+      delete lp;
+    }
+  m_lps.clear ();
+}
+
+void
+ParallelSimulatorImpl::Destroy ()
+{
+  while (!m_destroyEvents.empty ())
+    {
+      Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
+      m_destroyEvents.pop_front ();
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+ParallelSimulatorImpl::SetScheduler (Ptr<Scheduler> scheduler)
+{
+  m_schedulerFactory.SetTypeId (scheduler->GetInstanceTypeId ());
+  if (m_global.m_events != 0)
+    {
+      while (!m_global.m_events->IsEmpty ())
+        {
+          scheduler->Insert (m_global.m_events->RemoveNext ());
+        }
+    }
+  m_global.m_events = scheduler;
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      Ptr<Scheduler> events = m_schedulerFactory.Create<Scheduler> ();
+      while (!(*i)->m_events->IsEmpty ())
+        {
+          events->Insert ((*i)->m_events->RemoveNext ());
+        }
+      (*i)->m_events = events;
+    }
+}
+
+void
+ParallelSimulatorImpl::SetPartition (uint32_t context, uint32_t lp)
+{
+  NS_LOG_FUNCTION (this << context << lp);
+  if (!m_lps.empty ())
+    {
+      NS_FATAL_ERROR ("ParallelSimulatorImpl::SetPartition(): cannot change the partitioning once the simulation has run");
+    }
+  NS_ASSERT (context != Simulator::NO_CONTEXT);
+  if (context >= m_partition.size ())
+    {
+      m_partition.resize (context + 1, 0);
+    }
+  m_partition[context] = lp;
+}
+
+uint32_t
+ParallelSimulatorImpl::GetPartition (uint32_t context) const
+{
+  if (context == Simulator::NO_CONTEXT)
+    {
+      return GLOBAL_LP;
+    }
+  if (context < m_partition.size ())
+    {
+      return m_partition[context];
+    }
+  return 0;
+}
+
+uint32_t
+ParallelSimulatorImpl::GetNLogicalProcesses (void) const
+{
+  uint32_t n = 1;
+  for (std::vector<uint32_t>::const_iterator i = m_partition.begin (); i != m_partition.end (); ++i)
+    {
+      n = std::max (n, *i + 1);
+    }
+  return n;
+}
+
+void
+ParallelSimulatorImpl::SetLookahead (Time lookahead)
+{
+  m_lookahead = lookahead;
+}
+
+Time
+ParallelSimulatorImpl::GetLookahead (void) const
+{
+  return m_lookahead;
+}
+
+uint64_t
+ParallelSimulatorImpl::GetNWindows (void) const
+{
+  return m_nWindows;
+}
+
+ParallelSimulatorImpl::LogicalProcess *
+ParallelSimulatorImpl::Current (void) const
+{
+  LogicalProcess *lp = static_cast<LogicalProcess *> (g_currentLp);
+  if (lp != 0)
+    {
+      return lp;
+    }
+  return const_cast<LogicalProcess *> (&m_global);
+}
+
+ParallelSimulatorImpl::LogicalProcess *
+ParallelSimulatorImpl::GetLogicalProcess (uint32_t context)
+{
+  uint32_t index = GetPartition (context);
+  if (index == GLOBAL_LP || m_lps.empty ())
+    {
+      // before the first run, all the events wait in the global list
+      // and are dispatched by CreateLogicalProcesses.
+      return &m_global;
+    }
+  return m_lps[index];
+}
+
+void
+ParallelSimulatorImpl::Insert (LogicalProcess *lp, uint64_t ts, uint32_t uid, uint32_t context, EventImpl *event)
+{
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_uid = uid;
+  ev.key.m_context = context;
+  lp->m_events->Insert (ev);
+}
+
+uint32_t
+ParallelSimulatorImpl::Post (LogicalProcess *from, LogicalProcess *to, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  if (!m_inWindow)
+    {
+      // the uids allocated outside of the windows follow the order of
+      // the sequential simulator.
+      uint32_t uid = m_global.m_uid++;
+      Insert (to, ts, uid, context, event);
+      return uid;
+    }
+  uint32_t uid = from->m_uid;
+  if (!m_ordered)
+    {
+      // a single LP runs alone: its uids are the global ones.
+      from->m_uid++;
+      Insert (to, ts, uid, context, event);
+      return uid;
+    }
+  if (to == from && ts < m_windowEnd)
+    {
+      // run within the window, in the order in which this LP schedules.
+      from->m_parents.push_back (from->m_log.size () - 1);
+      from->m_uid++;
+      Insert (to, ts, uid, context, event);
+      return uid;
+    }
+  if (ts < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("ParallelSimulatorImpl::ScheduleWithContext(): event for context " << context <<
+                      " scheduled " << TimeStep (ts - from->m_currentTs) << " ahead is within the lookahead of " <<
+                      m_lookahead);
+    }
+  Outgoing outgoing;
+  outgoing.m_to = to;
+  outgoing.m_event.impl = event;
+  outgoing.m_event.key.m_ts = ts;
+  outgoing.m_event.key.m_uid = 0;
+  outgoing.m_event.key.m_context = context;
+  outgoing.m_parent = from->m_log.size () - 1;
+  from->m_outbox.push_back (outgoing);
+  // the event gets its uid when the window ends; IsExpired does not
+  // depend on the uid of the EventId.
+  return uid;
+}
+
+void
+ParallelSimulatorImpl::CreateLogicalProcesses (void)
+{
+  uint32_t n = GetNLogicalProcesses ();
+  NS_LOG_LOGIC ("creating " << n << " logical processes");
+  for (uint32_t i = 0; i < n; i++)
+    {
+      LogicalProcess *lp = new LogicalProcess ();
+      lp->m_index = i;
+      lp->m_events = m_schedulerFactory.Create<Scheduler> ();
+      // uids of the events moved below are smaller than this one.
+      lp->m_uid = m_global.m_uid;
+      lp->m_currentEvent = 0;
+      lp->m_currentTs = m_global.m_currentTs;
+      lp->m_currentContext = Simulator::NO_CONTEXT;
+      m_lps.push_back (lp);
+    }
+  Ptr<Scheduler> global = m_schedulerFactory.Create<Scheduler> ();
+  while (!m_global.m_events->IsEmpty ())
+    {
+      Scheduler::Event ev = m_global.m_events->RemoveNext ();
+      LogicalProcess *lp = GetLogicalProcess (ev.key.m_context);
+      if (lp == &m_global)
+        {
+          global->Insert (ev);
+        }
+      else
+        {
+          lp->m_events->Insert (ev);
+        }
+    }
+  m_global.m_events = global;
+}
+
+void
+ParallelSimulatorImpl::ProcessOneEvent (LogicalProcess *lp)
+{
+  Scheduler::Event next = lp->m_events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= lp->m_currentTs);
+  NS_LOG_LOGIC ("handle " << next.key.m_ts << " in lp " << lp->m_index);
+  lp->m_currentTs = next.key.m_ts;
+  lp->m_currentContext = next.key.m_context;
+  lp->m_currentEvent = next.impl;
+  if (m_inWindow && m_ordered)
+    {
+      Executed executed;
+      executed.m_ts = next.key.m_ts;
+      executed.m_uid = next.key.m_uid;
+      executed.m_rank = 0;
+      lp->m_log.push_back (executed);
+    }
+  next.impl->Invoke ();
+  // the uids do not tell which events have run, see IsExpired.
+  next.impl->Cancel ();
+  lp->m_currentEvent = 0;
+  next.impl->Unref ();
+}
+
+bool
+ParallelSimulatorImpl::RunsBefore (const LogicalProcess *a, const Executed &x,
+                                   const LogicalProcess *b, const Executed &y) const
+{
+  if (x.m_ts != y.m_ts)
+    {
+      return x.m_ts < y.m_ts;
+    }
+  bool xInWindow = x.m_uid >= m_windowUid;
+  bool yInWindow = y.m_uid >= m_windowUid;
+  if (!xInWindow && !yInWindow)
+    {
+      return x.m_uid < y.m_uid;
+    }
+  if (xInWindow != yInWindow)
+    {
+      // the events scheduled before the window were scheduled first.
+      return yInWindow;
+    }
+  // both were scheduled within the window by an event of their own
+  // LP, which comes earlier in its log and has been ranked already.
+  return a->m_log[a->m_parents[x.m_uid - m_windowUid]].m_rank <
+    b->m_log[b->m_parents[y.m_uid - m_windowUid]].m_rank;
+}
+
+void
+ParallelSimulatorImpl::RankWindow (void)
+{
+  // merge the logs, each in the sequential order already.
+  std::vector<uint32_t> next (m_lps.size (), 0);
+  uint64_t rank = 0;
+  while (true)
+    {
+      uint32_t first = m_lps.size ();
+      for (uint32_t i = 0; i < m_lps.size (); i++)
+        {
+          if (next[i] == m_lps[i]->m_log.size ())
+            {
+              continue;
+            }
+          if (first == m_lps.size () ||
+              RunsBefore (m_lps[i], m_lps[i]->m_log[next[i]],
+                          m_lps[first], m_lps[first]->m_log[next[first]]))
+            {
+              first = i;
+            }
+        }
+      if (first == m_lps.size ())
+        {
+          break;
+        }
+      m_lps[first]->m_log[next[first]].m_rank = rank++;
+      next[first]++;
+    }
+}
+
+void
+ParallelSimulatorImpl::MergeOutboxes (void)
+{
+  uint32_t senders = 0;
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      if (!(*i)->m_outbox.empty ())
+        {
+          senders++;
+        }
+    }
+  if (senders > 1)
+    {
+      RankWindow ();
+    }
+  // each outbox is in the order in which its LP scheduled: merge them
+  // in the order of the events which scheduled them, so that the uids
+  // follow the order of the sequential simulator.
+  std::vector<uint32_t> next (m_lps.size (), 0);
+  while (true)
+    {
+      uint32_t first = m_lps.size ();
+      uint64_t firstRank = 0;
+      for (uint32_t i = 0; i < m_lps.size (); i++)
+        {
+          LogicalProcess *lp = m_lps[i];
+          if (next[i] == lp->m_outbox.size ())
+            {
+              continue;
+            }
+          uint64_t rank = lp->m_log[lp->m_outbox[next[i]].m_parent].m_rank;
+          if (first == m_lps.size () || rank < firstRank)
+            {
+              first = i;
+              firstRank = rank;
+            }
+        }
+      if (first == m_lps.size ())
+        {
+          break;
+        }
+      Outgoing &outgoing = m_lps[first]->m_outbox[next[first]];
+      Insert (outgoing.m_to, outgoing.m_event.key.m_ts, m_global.m_uid++,
+              outgoing.m_event.key.m_context, outgoing.m_event.impl);
+      next[first]++;
+    }
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      (*i)->m_outbox.clear ();
+      (*i)->m_log.clear ();
+      (*i)->m_parents.clear ();
+    }
+}
+
+ParallelSimulatorImpl::LogicalProcess *
+ParallelSimulatorImpl::NextLogicalProcess (void) const
+{
+  // between two windows, the uids of all the pending events follow
+  // the order of the sequential simulator.
+  LogicalProcess *next = 0;
+  Scheduler::EventKey nextKey;
+  nextKey.m_ts = 0;
+  nextKey.m_uid = 0;
+  if (!m_global.m_events->IsEmpty ())
+    {
+      next = const_cast<LogicalProcess *> (&m_global);
+      nextKey = m_global.m_events->PeekNext ().key;
+    }
+  for (std::vector<LogicalProcess *>::const_iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+    {
+      if ((*i)->m_events->IsEmpty ())
+        {
+          continue;
+        }
+      Scheduler::EventKey key = (*i)->m_events->PeekNext ().key;
+      if (next == 0 || key.m_ts < nextKey.m_ts ||
+          (key.m_ts == nextKey.m_ts && key.m_uid < nextKey.m_uid))
+        {
+          next = *i;
+          nextKey = key;
+        }
+    }
+  return next;
+}
+
+void
+ParallelSimulatorImpl::ProcessWindow (void)
+{
+  uint32_t index;
+  while ((index = __sync_fetch_and_add (&m_nextLp, 1)) < m_lps.size ())
+    {
+      LogicalProcess *lp = m_lps[index];
+      g_currentLp = lp;
+      while (!lp->m_events->IsEmpty () &&
+             lp->m_events->PeekNext ().key.m_ts < m_windowEnd)
+        {
+          ProcessOneEvent (lp);
+        }
+      g_currentLp = 0;
+    }
+}
+
+void
+ParallelSimulatorImpl::Worker (void)
+{
+  while (true)
+    {
+      m_barrier.Wait ();
+      if (m_done)
+        {
+          break;
+        }
+      ProcessWindow ();
+      m_barrier.Wait ();
+    }
+}
+
+bool
+ParallelSimulatorImpl::IsFinished (void) const
+{
+  return NextLogicalProcess () == 0 || m_stop;
+}
+
+Time
+ParallelSimulatorImpl::Next (void) const
+{
+  LogicalProcess *next = NextLogicalProcess ();
+  NS_ASSERT (next != 0);
+  return TimeStep (next->m_events->PeekNext ().key.m_ts);
+}
+
+void
+ParallelSimulatorImpl::Run (void)
+{
+  if (m_lps.empty ())
+    {
+      CreateLogicalProcesses ();
+    }
+  uint64_t lookahead = m_lookahead.GetTimeStep ();
+  if (m_lps.size () > 1 && lookahead == 0)
+    {
+      NS_FATAL_ERROR ("ParallelSimulatorImpl::Run(): a lookahead is required with more than one logical process");
+    }
+  uint32_t nThreads = m_maxThreads;
+  if (nThreads == 0)
+    {
+      nThreads = sysconf (_SC_NPROCESSORS_ONLN);
+    }
+  nThreads = std::max (1U, std::min (nThreads, (uint32_t)m_lps.size ()));
+  NS_LOG_LOGIC ("running " << m_lps.size () << " logical processes on " << nThreads << " threads");
+
+  m_ordered = m_lps.size () > 1;
+  m_stop = false;
+  m_done = false;
+  m_barrier.Init (nThreads);
+  for (uint32_t i = 1; i < nThreads; i++)
+    {
+      Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback (&ParallelSimulatorImpl::Worker, this));
+      m_threads.push_back (thread);
+      thread->Start ();
+    }
+
+  while (!m_stop)
+    {
+      LogicalProcess *next = NextLogicalProcess ();
+      if (next == 0)
+        {
+          break;
+        }
+      uint64_t tMin = next->m_events->PeekNext ().key.m_ts;
+      if (next == &m_global ||
+          (!m_global.m_events->IsEmpty () && m_global.m_events->PeekNext ().key.m_ts == tMin))
+        {
+          // events without a context, and the events which come
+          // before them at the same time, run alone between two windows.
+          g_currentLp = next;
+          ProcessOneEvent (next);
+          g_currentLp = 0;
+          continue;
+        }
+      m_windowEnd = GetMaximumSimulationTime ().GetTimeStep ();
+      if (m_lps.size () > 1 && m_windowEnd - tMin > lookahead)
+        {
+          m_windowEnd = tMin + lookahead;
+        }
+      if (!m_global.m_events->IsEmpty ())
+        {
+          m_windowEnd = std::min (m_windowEnd, m_global.m_events->PeekNext ().key.m_ts);
+        }
+      m_windowUid = m_global.m_uid;
+      for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); ++i)
+        {
+          (*i)->m_uid = m_windowUid;
+        }
+      m_nextLp = 0;
+      m_inWindow = true;
+      m_nWindows++;
+      m_barrier.Wait ();
+      ProcessWindow ();
+      m_barrier.Wait ();
+      m_inWindow = false;
+      if (m_ordered)
+        {
+          MergeOutboxes ();
+        }
+      else
+        {
+          m_global.m_uid = m_lps[0]->m_uid;
+        }
+    }
+
+  m_done = true;
+  m_barrier.Wait ();
+  for (std::vector<Ptr<SystemThread> >::iterator i = m_threads.begin (); i != m_threads.end (); ++i)
+    {
+      (*i)->Join ();
+    }
+  m_threads.clear ();
+}
+
+void
+ParallelSimulatorImpl::RunOneEvent (void)
+{
+  if (m_lps.empty ())
+    {
+      CreateLogicalProcesses ();
+    }
+  LogicalProcess *next = NextLogicalProcess ();
+  NS_ASSERT (next != 0);
+  g_currentLp = next;
+  ProcessOneEvent (next);
+  g_currentLp = 0;
+}
+
+void
+ParallelSimulatorImpl::Stop (void)
+{
+  // the current window is always run to completion so that the
+  // stopping point does not depend on the number of threads.
+  m_stop = true;
+}
+
+EventId
+ParallelSimulatorImpl::Schedule (Time const &time, EventImpl *event)
+{
+  LogicalProcess *lp = Current ();
+  Time tAbsolute = time + TimeStep (lp->m_currentTs);
+
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (lp->m_currentTs));
+  uint64_t ts = (uint64_t) tAbsolute.GetTimeStep ();
+  uint32_t uid = Post (lp, lp, ts, lp->m_currentContext, event);
+  return EventId (event, ts, uid);
+}
+
+void
+ParallelSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << time << event);
+  LogicalProcess *from = Current ();
+  Time tAbsolute = time + TimeStep (from->m_currentTs);
+
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (from->m_currentTs));
+  uint64_t ts = (uint64_t) tAbsolute.GetTimeStep ();
+  Post (from, GetLogicalProcess (context), ts, context, event);
+}
+
+EventId
+ParallelSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  LogicalProcess *lp = Current ();
+  uint32_t uid = Post (lp, lp, lp->m_currentTs, lp->m_currentContext, event);
+  return EventId (event, lp->m_currentTs, uid);
+}
+
+EventId
+ParallelSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  CriticalSection cs (m_destroyMutex);
+  EventId id (Ptr<EventImpl> (event, false), Current ()->m_currentTs, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+ParallelSimulatorImpl::Now (void) const
+{
+  return TimeStep (Current ()->m_currentTs);
+}
+
+Time
+ParallelSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs () - Current ()->m_currentTs);
+    }
+}
+
+void
+ParallelSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+         }
+      return;
+    }
+  // the event may sit in the event list of another logical process.
+  Cancel (id);
+}
+
+void
+ParallelSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+ParallelSimulatorImpl::IsExpired (const EventId &ev) const
+{
+  if (ev.GetUid () == 2)
+    {
+      // destroy events.
+      CriticalSection cs (m_destroyMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == ev)
+            {
+              return false;
+            }
+         }
+      return true;
+    }
+  // the events which have run are marked as cancelled by
+  // ProcessOneEvent.
+  LogicalProcess *lp = Current ();
+  if (ev.PeekEventImpl () == 0 ||
+      ev.GetTs () < lp->m_currentTs ||
+      ev.PeekEventImpl () == lp->m_currentEvent ||
+      ev.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+uint32_t
+ParallelSimulatorImpl::GetContext (void) const
+{
+  return Current ()->m_currentContext;
+}
+
+bool
+ParallelSimulatorImpl::IsLocalContext (uint32_t context) const
+{
+  return GetPartition (context) == Current ()->m_index;
+}
+
+Time
+ParallelSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+void
+ParallelSimulatorImpl::Barrier::Init (uint32_t n)
+{
+  m_n = n;
+  m_count = 0;
+  m_sense = 0;
+}
+
+void
+ParallelSimulatorImpl::Barrier::Wait (void)
+{
+  uint32_t sense = m_sense;
+  if (__sync_add_and_fetch (&m_count, 1) == m_n)
+    {
+      m_count = 0;
+      __sync_synchronize ();
+      m_sense = !sense;
+      return;
+    }
+  while (m_sense == sense)
+    {
+      sched_yield ();
+    }
+  __sync_synchronize ();
+}
+
+} // namespace ns3
+
+
+#ifdef RUN_SELF_TESTS
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+#include "default-simulator-impl.h"
+#include "map-scheduler.h"
+#include <sstream>
+
+namespace ns3 {
+
+class ParallelSimulatorImplTests : public Test
+{
+public:
+  ParallelSimulatorImplTests ();
+  virtual bool RunTests (void);
+private:
+  Ptr<ParallelSimulatorImpl> CreateParallel (uint32_t nThreads, uint32_t nLps);
+  std::string RunRing (uint32_t nThreads, uint32_t nLps);
+  std::string RunTies (Ptr<SimulatorImpl> impl);
+  void Hop (uint32_t node, uint32_t hops);
+  void Record (uint32_t node);
+  void Ping (uint32_t node, uint32_t tag, uint32_t hops);
+  void Echo (uint32_t node, uint32_t tag);
+  void RecordTag (uint32_t node, uint32_t tag);
+  void RecordAll (uint32_t tag);
+
+  std::vector<std::ostringstream *> m_traces;
+  uint32_t m_nNodes;
+  bool m_contextOk;
+};
+
+ParallelSimulatorImplTests::ParallelSimulatorImplTests ()
+  : Test ("ParallelSimulatorImpl")
+{}
+
+void
+ParallelSimulatorImplTests::Record (uint32_t node)
+{
+  // each node only ever writes to its own trace.
+  *m_traces[node] << Simulator::Now ().GetTimeStep () << " ";
+}
+
+void
+ParallelSimulatorImplTests::Hop (uint32_t node, uint32_t hops)
+{
+  if (Simulator::GetContext () != node)
+    {
+      m_contextOk = false;
+    }
+  Record (node);
+  Simulator::Schedule (MicroSeconds (3), &ParallelSimulatorImplTests::Record, this, node);
+  if (hops == 0)
+    {
+      return;
+    }
+  uint32_t next = (node + 1 + hops % 3) % m_nNodes;
+  Simulator::ScheduleWithContext (next, MicroSeconds (10 + hops % 7),
+                                  &ParallelSimulatorImplTests::Hop, this, next, hops - 1);
+}
+
+void
+ParallelSimulatorImplTests::RecordTag (uint32_t node, uint32_t tag)
+{
+  *m_traces[node] << Simulator::Now ().GetTimeStep () << ":" << tag << " ";
+}
+
+void
+ParallelSimulatorImplTests::RecordAll (uint32_t tag)
+{
+  // events without a context run alone.
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      RecordTag (i, tag);
+    }
+}
+
+void
+ParallelSimulatorImplTests::Ping (uint32_t node, uint32_t tag, uint32_t hops)
+{
+  RecordTag (node, tag);
+  if (hops == 0)
+    {
+      return;
+    }
+  // all the nodes ping all the others at the same times, with the
+  // lookahead as delay: the pings which reach a node at the same time
+  // come from several LPs, and were all scheduled at the same time.
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      if (i != node)
+        {
+          Simulator::ScheduleWithContext (i, MicroSeconds (10), &ParallelSimulatorImplTests::Ping,
+                                          this, i, (tag * 7 + node) % 1000, hops - 1);
+        }
+    }
+  Simulator::Schedule (MicroSeconds (5), &ParallelSimulatorImplTests::Echo, this, node, tag);
+  Simulator::ScheduleNow (&ParallelSimulatorImplTests::RecordTag, this, node, tag + 1000);
+}
+
+void
+ParallelSimulatorImplTests::Echo (uint32_t node, uint32_t tag)
+{
+  // runs at the same time as the pings scheduled before it in other
+  // LPs, and the pings of this node.
+  Simulator::Schedule (MicroSeconds (5), &ParallelSimulatorImplTests::RecordTag, this, node, tag + 2000);
+}
+
+Ptr<ParallelSimulatorImpl>
+ParallelSimulatorImplTests::CreateParallel (uint32_t nThreads, uint32_t nLps)
+{
+  Ptr<ParallelSimulatorImpl> impl = CreateObject<ParallelSimulatorImpl> ();
+  impl->SetAttribute ("MaxThreads", UintegerValue (nThreads));
+  impl->SetLookahead (MicroSeconds (10));
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      impl->SetPartition (i, i % nLps);
+    }
+  return impl;
+}
+
+std::string
+ParallelSimulatorImplTests::RunTies (Ptr<SimulatorImpl> impl)
+{
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      m_traces.push_back (new std::ostringstream ());
+    }
+  Simulator::Destroy ();
+  Simulator::SetImplementation (impl);
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      Simulator::ScheduleWithContext (i, MicroSeconds (0),
+                                      &ParallelSimulatorImplTests::Ping, this, i, i, 3);
+    }
+  // node 3 runs before the event without a context at 20us, which
+  // runs before the pings.
+  Simulator::ScheduleWithContext (3, MicroSeconds (20),
+                                  &ParallelSimulatorImplTests::RecordTag, this, 3, 3000);
+  Simulator::Schedule (MicroSeconds (20), &ParallelSimulatorImplTests::RecordAll, this, 4000);
+  Simulator::Schedule (MicroSeconds (25), &ParallelSimulatorImplTests::RecordAll, this, 5000);
+  Simulator::Run ();
+  std::string result;
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      result += m_traces[i]->str () + "\n";
+      delete m_traces[i];
+    }
+  m_traces.clear ();
+  Simulator::Destroy ();
+  return result;
+}
+
+std::string
+ParallelSimulatorImplTests::RunRing (uint32_t nThreads, uint32_t nLps)
+{
+  m_nNodes = 8;
+  m_contextOk = true;
+  Ptr<ParallelSimulatorImpl> impl = CreateParallel (nThreads, nLps);
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      m_traces.push_back (new std::ostringstream ());
+    }
+  Simulator::Destroy ();
+  Simulator::SetImplementation (impl);
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      Simulator::ScheduleWithContext (i, MicroSeconds (i),
+                                      &ParallelSimulatorImplTests::Hop, this, i, 200);
+    }
+  Simulator::Run ();
+  std::string result;
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      result += m_traces[i]->str () + "\n";
+      delete m_traces[i];
+    }
+  m_traces.clear ();
+  Simulator::Destroy ();
+  return result;
+}
+
+bool
+ParallelSimulatorImplTests::RunTests (void)
+{
+  bool result = true;
+
+  std::string reference = RunRing (1, 1);
+  NS_TEST_ASSERT (m_contextOk);
+  NS_TEST_ASSERT (RunRing (1, 4) == reference);
+  NS_TEST_ASSERT (m_contextOk);
+  NS_TEST_ASSERT (RunRing (4, 4) == reference);
+  NS_TEST_ASSERT (m_contextOk);
+  NS_TEST_ASSERT (RunRing (3, 8) == reference);
+  NS_TEST_ASSERT (m_contextOk);
+
+  m_nNodes = 6;
+  Ptr<DefaultSimulatorImpl> sequential = CreateObject<DefaultSimulatorImpl> ();
+  sequential->SetScheduler (CreateObject<MapScheduler> ());
+  reference = RunTies (sequential);
+  NS_TEST_ASSERT (RunTies (CreateParallel (1, 1)) == reference);
+  NS_TEST_ASSERT (RunTies (CreateParallel (2, 2)) == reference);
+  NS_TEST_ASSERT (RunTies (CreateParallel (4, 3)) == reference);
+  NS_TEST_ASSERT (RunTies (CreateParallel (3, 6)) == reference);
+
+  return result;
+}
+
+static ParallelSimulatorImplTests g_parallelSimulatorImplTests;
+
+} // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
@@ -0,0 +1,215 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PARALLEL_SIMULATOR_IMPL_H
+#define PARALLEL_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/object-factory.h"
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * \brief A conservative parallel simulator implementation.
+ *
+ * The event contexts (usually node ids, see
+ * Simulator::ScheduleWithContext) are partitioned into logical
+ * processes (LPs), each with its own event list.  The simulation
+ * advances in windows of at most Lookahead simulated time: within a
+ * window, the LPs run concurrently on up to MaxThreads threads and
+ * the events they schedule beyond the end of the window, whether in
+ * another LP or their own, are held in per-LP outboxes which are
+ * merged at the barrier which ends the window.  The lookahead must
+ * thus be no larger than the smallest delay of any link which crosses
+ * two LPs: scheduling an event in another LP sooner than the end of
+ * the current window is a fatal error.
+ *
+ * The events run in the order of DefaultSimulatorImpl, ties included:
+ * each LP logs the events it runs in a window, the barrier merges the
+ * logs into the sequential order of the window, and the merged events
+ * are numbered in the order in which the sequential simulator would
+ * have scheduled them.  The results thus depend neither on the number
+ * of threads nor on the partitioning; utils/bench-parallel and the
+ * ParallelSimulatorHelper self-test check the packet arrivals against
+ * the sequential simulator.  Event uids are not those of
+ * DefaultSimulatorImpl.
+ *
+ * Events without a context (Simulator::NO_CONTEXT), such as the
+ * events scheduled from main (), run serially at window boundaries
+ * and may access any node.  Contexts which were not assigned with
+ * SetPartition run in LP 0.
+ *
+ * Events scheduled in another LP cannot be cancelled, and
+ * Simulator::Remove is implemented as Simulator::Cancel.
+ */
+class ParallelSimulatorImpl : public SimulatorImpl
+{
+public:
+  static TypeId GetTypeId (void);
+
+  ParallelSimulatorImpl ();
+  ~ParallelSimulatorImpl ();
+
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual Time Next (void) const;
+  virtual void Stop (void);
+  virtual EventId Schedule (Time const &time, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
+  virtual void Remove (const EventId &ev);
+  virtual void Cancel (const EventId &ev);
+  virtual bool IsExpired (const EventId &ev) const;
+  virtual void Run (void);
+  virtual void RunOneEvent (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (Ptr<Scheduler> scheduler);
+  virtual uint32_t GetContext (void) const;
+  virtual bool IsLocalContext (uint32_t context) const;
+
+  /**
+   * \param context an event context, usually a node id
+   * \param lp the index of the logical process which runs the events
+   *        of this context
+   *
+   * The partitioning cannot be changed once the simulation has run.
+   */
+  void SetPartition (uint32_t context, uint32_t lp);
+  /**
+   * \param context an event context
+   * \returns the index of the logical process which runs the events of
+   *          this context.
+   */
+  uint32_t GetPartition (uint32_t context) const;
+  /**
+   * \returns the number of logical processes defined by the partitioning.
+   */
+  uint32_t GetNLogicalProcesses (void) const;
+
+  void SetLookahead (Time lookahead);
+  Time GetLookahead (void) const;
+
+  /**
+   * \returns the number of synchronization windows run so far.
+   */
+  uint64_t GetNWindows (void) const;
+
+private:
+  struct LogicalProcess;
+  struct Outgoing
+  {
+    LogicalProcess *m_to;
+    Scheduler::Event m_event;
+    // index in the log of the sender of the event which scheduled it
+    uint32_t m_parent;
+  };
+  struct Executed
+  {
+    uint64_t m_ts;
+    uint32_t m_uid;
+    // position of the event in the sequential order of the window
+    uint64_t m_rank;
+  };
+  struct LogicalProcess
+  {
+    uint32_t m_index;
+    Ptr<Scheduler> m_events;
+    uint32_t m_uid;
+    EventImpl *m_currentEvent;
+    uint64_t m_currentTs;
+    uint32_t m_currentContext;
+    // only the thread which runs this LP writes to the members below
+    // during a window.
+    // events scheduled beyond the end of the current window.
+    std::vector<Outgoing> m_outbox;
+    // events run during the current window, in order.
+    std::vector<Executed> m_log;
+    // for each event scheduled and run within the current window, by
+    // uid from the first uid of the window, the index in m_log of the
+    // event which scheduled it.
+    std::vector<uint32_t> m_parents;
+  };
+  class Barrier
+  {
+  public:
+    void Init (uint32_t n);
+    void Wait (void);
+  private:
+    uint32_t m_n;
+    volatile uint32_t m_count;
+    volatile uint32_t m_sense;
+  };
+
+  LogicalProcess *Current (void) const;
+  LogicalProcess *GetLogicalProcess (uint32_t context);
+  void Insert (LogicalProcess *lp, uint64_t ts, uint32_t uid, uint32_t context, EventImpl *event);
+  uint32_t Post (LogicalProcess *from, LogicalProcess *to, uint64_t ts, uint32_t context, EventImpl *event);
+  void CreateLogicalProcesses (void);
+  void ProcessOneEvent (LogicalProcess *lp);
+  void ProcessWindow (void);
+  bool RunsBefore (const LogicalProcess *a, const Executed &x,
+                   const LogicalProcess *b, const Executed &y) const;
+  void RankWindow (void);
+  void MergeOutboxes (void);
+  LogicalProcess *NextLogicalProcess (void) const;
+  void Worker (void);
+
+  typedef std::list<EventId> DestroyEvents;
+  DestroyEvents m_destroyEvents;
+  mutable SystemMutex m_destroyMutex;
+
+  ObjectFactory m_schedulerFactory;
+  LogicalProcess m_global;
+  std::vector<LogicalProcess *> m_lps;
+  std::vector<uint32_t> m_partition;
+
+  Time m_lookahead;
+  uint32_t m_maxThreads;
+
+  volatile bool m_stop;
+  volatile bool m_done;
+  bool m_inWindow;
+  // whether windows are logged and merged: there is more than one LP.
+  bool m_ordered;
+  uint64_t m_windowEnd;
+  // the first uid allocated within the current window.
+  uint32_t m_windowUid;
+  volatile uint32_t m_nextLp;
+  uint64_t m_nWindows;
+  Barrier m_barrier;
+  std::vector<Ptr<SystemThread> > m_threads;
+};
+
+} // namespace ns3
+
+#endif /* PARALLEL_SIMULATOR_IMPL_H */
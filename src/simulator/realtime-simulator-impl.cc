@@ -52,7 +52,8 @@ RealtimeSimulatorImpl::GetTypeId (void)
                    EnumValue (SYNC_BEST_EFFORT),
                    MakeEnumAccessor (&RealtimeSimulatorImpl::SetSynchronizationMode),
                    MakeEnumChecker (SYNC_BEST_EFFORT, "BestEffort",
-                                    SYNC_HARD_LIMIT, "HardLimit"))
+                                    SYNC_HARD_LIMIT, "HardLimit",
+                                    SYNC_CATCH_UP, "CatchUp"))
     .AddAttribute ("HardLimit", 
                    "Maximum acceptable real-time jitter (used in conjunction with SynchronizationMode=HardLimit)",
                    TimeValue (Seconds (0.1)),
@@ -77,7 +78,16 @@ RealtimeSimulatorImpl::RealtimeSimulatorImpl ()
   // before ::Run is entered, the m_currentUid will be zero
   m_currentUid = 0;
   m_currentTs = 0;
+  m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
+  m_cancelledEvents = 0;
+  m_batchHead = 0;
+  m_batchPreempted = false;
+  m_batchNow = 0;
+  m_batches = 0;
+  m_batchedEvents = 0;
+  m_lag.resize (HISTOGRAM_BUCKETS, 0);
+  m_jitter.resize (HISTOGRAM_BUCKETS, 0);
 
   // Be very careful not to do anything that would cause a change or assignment
   // of the underlying reference counts of m_synchronizer or you will be sorry.
@@ -164,10 +174,15 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
   // Synchronize() returns true, we will have successfully synchronized the execution 
   // time of the next event with the wall clock time of the synchronizer.
   //
+  // In SYNC_CATCH_UP mode, if we are late, all the events which are already
+  // due are taken off the event list at once and run by ProcessBatch.
+  //
+  uint64_t tsDelay = 0;
+  uint64_t tsNow = 0;
+  bool batched = false;
 
   for (;;) 
     {
-      uint64_t tsDelay = 0;
       uint64_t tsNext = 0;
 
       //
@@ -182,7 +197,6 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
       //
       // We use tsNow as the indication of the current real time.
       //
-      uint64_t tsNow;
 
       { 
         CriticalSection cs (m_mutex);
@@ -226,17 +240,30 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
           {
             tsDelay = tsNext - tsNow;
           }
-      
-        //
-        // We've figured out how long we need to delay in order to pace the 
-        // simulation time with the real time.  We're going to sleep, but need
-        // to work with the synchronizer to make sure we're awakened if something 
-        // external happens (like a packet is received).  This next line resets
-        // the synchronizer so that any future event will cause it to interrupt.
-        //
-        m_synchronizer->SetCondition (false);
+
+        if (m_synchronizationMode == SYNC_CATCH_UP && tsDelay == 0)
+          {
+            DequeueDueEvents (tsNow);
+            batched = true;
+          }
+        else
+          {
+            //
+            // We've figured out how long we need to delay in order to pace the
+            // simulation time with the real time.  We're going to sleep, but need
+            // to work with the synchronizer to make sure we're awakened if something
+            // external happens (like a packet is received).  This next line resets
+            // the synchronizer so that any future event will cause it to interrupt.
+            //
+            m_synchronizer->SetCondition (false);
+          }
       }
 
+      if (batched)
+        {
+          break;
+        }
+
       //
       // We have a time to delay.  This time may actually not be valid anymore
       // since we released the critical section immediately above, and a real-time
@@ -293,6 +320,12 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
   // is the one we think it is.  What we can be sure of is that it is time to execute
   // whatever event is at the head of this list if the list is in time order.
   //
+  if (batched)
+    {
+      ProcessBatch ();
+      return;
+    }
+
   Scheduler::Event next;
 
   { 
@@ -308,6 +341,10 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
       "RealtimeSimulatorImpl::ProcessOneEvent(): event queue is empty");
     next = m_events->RemoveNext ();
     --m_unscheduledEvents;
+    if (next.impl->IsCancelled ())
+      {
+        --m_cancelledEvents;
+      }
 
     //
     // We cannot make any assumption that "next" is the same event we originally waited 
@@ -326,6 +363,17 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     //
     m_currentTs = next.key.m_ts;
     m_currentUid = next.key.m_uid;
+    m_currentContext = next.key.m_context;
+
+    if (tsDelay == 0)
+      {
+        Record (m_lag, tsNow > m_currentTs ? tsNow - m_currentTs : 0);
+      }
+    else
+      {
+        uint64_t tsWake = m_synchronizer->GetCurrentRealtime ();
+        Record (m_jitter, tsWake >= m_currentTs ? tsWake - m_currentTs : m_currentTs - tsWake);
+      }
 
     // 
     // We're about to run the event and we've done our best to synchronize this
@@ -370,6 +418,118 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
   event->Unref ();
 }
 
+//
+// Takes all the events due at tsNow off the event list, in order.  Must be
+// called with m_mutex held.
+//
+void
+RealtimeSimulatorImpl::DequeueDueEvents (uint64_t tsNow)
+{
+  NS_LOG_FUNCTION (tsNow);
+  NS_ASSERT (m_batch.empty ());
+  while (m_events->IsEmpty () == false && m_events->PeekNext ().key.m_ts <= tsNow)
+    {
+      Scheduler::Event ev = m_events->RemoveNext ();
+      --m_unscheduledEvents;
+      m_batch.push_back (ev);
+    }
+  m_batchNow = tsNow;
+  m_batchHead = 0;
+  m_batchPreempted = false;
+  m_batches++;
+  m_batchedEvents += m_batch.size ();
+}
+
+//
+// Runs the events taken off the event list by DequeueDueEvents.  They are
+// late already, so there is nothing to synchronize: the lock is only held
+// to take each event off the batch, since other threads look at the batch
+// and may preempt it.
+//
+void
+RealtimeSimulatorImpl::ProcessBatch (void)
+{
+  NS_LOG_FUNCTION (m_batch.size ());
+  int cancelled = 0;
+  m_synchronizer->EventStart ();
+  while (true)
+    {
+      Scheduler::Event next;
+      {
+        CriticalSection cs (m_mutex);
+        //
+        // An event scheduled before the end of the batch (typically with
+        // ScheduleNow) must run before the rest of the batch: give it back
+        // to the scheduler, which will sort it out.
+        //
+        if (m_stop || m_batchPreempted || m_batchHead >= m_batch.size ())
+          {
+            break;
+          }
+        next = m_batch[m_batchHead++];
+        NS_ASSERT_MSG (next.key.m_ts >= m_currentTs,
+                       "RealtimeSimulatorImpl::ProcessBatch(): "
+                       "next.GetTs() earlier than m_currentTs (list order error)");
+        NS_LOG_LOGIC ("handle " << next.key.m_ts);
+        m_currentTs = next.key.m_ts;
+        m_currentUid = next.key.m_uid;
+        m_currentContext = next.key.m_context;
+      }
+      // the events given back to the scheduler are recorded when they run.
+      Record (m_lag, m_batchNow - next.key.m_ts);
+      if (next.impl->IsCancelled ())
+        {
+          cancelled++;
+        }
+      next.impl->Invoke ();
+      next.impl->Unref ();
+    }
+  m_synchronizer->EventEnd ();
+
+  CriticalSection cs (m_mutex);
+  m_cancelledEvents -= cancelled;
+  for (; m_batchHead < m_batch.size (); m_batchHead++)
+    {
+      ++m_unscheduledEvents;
+      m_events->Insert (m_batch[m_batchHead]);
+    }
+  m_batch.clear ();
+  m_batchHead = 0;
+  m_batchPreempted = false;
+}
+
+//
+// Must be called with m_mutex held.
+//
+void
+RealtimeSimulatorImpl::InsertEvent (const Scheduler::Event &ev)
+{
+  ++m_unscheduledEvents;
+  m_events->Insert (ev);
+  //
+  // The events scheduled by other threads are for the current real time or
+  // later, so only the simulation thread itself can preempt a batch.
+  //
+  if (m_batch.empty () == false && ev.key < m_batch.back ().key)
+    {
+      m_batchPreempted = true;
+    }
+  m_synchronizer->Signal ();
+}
+
+void
+RealtimeSimulatorImpl::Record (std::vector<uint64_t> &histogram, uint64_t ts)
+{
+  uint64_t us = TimeStep (ts).GetMicroSeconds ();
+  uint32_t bucket = 0;
+  while (us >= 2 && bucket < HISTOGRAM_BUCKETS - 1)
+    {
+      us >>= 1;
+      bucket++;
+    }
+  histogram[bucket]++;
+}
+
 bool 
 RealtimeSimulatorImpl::IsFinished (void) const
 {
@@ -377,7 +537,7 @@ RealtimeSimulatorImpl::IsFinished (void) const
   bool rc;
   {
     CriticalSection cs (m_mutex);
-    rc = m_events->IsEmpty () || m_stop;
+    rc = (m_events->IsEmpty () && m_batchHead >= m_batch.size ()) || m_stop;
   }
 
   return rc;
@@ -390,6 +550,16 @@ uint64_t
 RealtimeSimulatorImpl::NextTs (void) const
 {
   NS_LOG_FUNCTION_NOARGS ();
+  if (m_batchHead < m_batch.size ())
+    {
+      // called by an event of a batch.
+      uint64_t ts = m_batch[m_batchHead].key.m_ts;
+      if (m_events->IsEmpty () == false && m_events->PeekNext ().key.m_ts < ts)
+        {
+          ts = m_events->PeekNext ().key.m_ts;
+        }
+      return ts;
+    }
   NS_ASSERT_MSG (m_events->IsEmpty () == false, 
     "RealtimeSimulatorImpl::NextTs(): event queue is empty");
   Scheduler::Event ev = m_events->PeekNext ();
@@ -505,10 +675,15 @@ RealtimeSimulatorImpl::RunOneEvent (void)
 
     NS_ASSERT (next.key.m_ts >= m_currentTs);
     --m_unscheduledEvents;
+    if (next.impl->IsCancelled ())
+      {
+        --m_cancelledEvents;
+      }
 
     NS_LOG_LOGIC ("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
     m_currentUid = next.key.m_ts;
+    m_currentContext = next.key.m_context;
     event = next.impl;
   }
   event->Invoke ();
@@ -545,15 +720,35 @@ RealtimeSimulatorImpl::Schedule (Time const &time, EventImpl *impl)
     ev.impl = impl;
     ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
     ev.key.m_uid = m_uid;
+    ev.key.m_context = m_currentContext;
     m_uid++;
-    ++m_unscheduledEvents;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
+    InsertEvent (ev);
   }
 
   return EventId (impl, ev.key.m_ts, ev.key.m_uid);
 }
 
+void
+RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &time, EventImpl *impl)
+{
+  NS_LOG_FUNCTION (context << time << impl);
+
+  {
+    CriticalSection cs (m_mutex);
+
+    Time tAbsolute = Simulator::Now () + time;
+    NS_ASSERT_MSG (tAbsolute.IsPositive (), "RealtimeSimulatorImpl::ScheduleWithContext(): Negative time");
+    NS_ASSERT_MSG (tAbsolute >= TimeStep (m_currentTs), "RealtimeSimulatorImpl::ScheduleWithContext(): time < m_currentTs");
+    Scheduler::Event ev;
+    ev.impl = impl;
+    ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+    ev.key.m_uid = m_uid;
+    ev.key.m_context = context;
+    m_uid++;
+    InsertEvent (ev);
+  }
+}
+
 EventId
 RealtimeSimulatorImpl::ScheduleNow (EventImpl *impl)
 {
@@ -565,10 +760,9 @@ RealtimeSimulatorImpl::ScheduleNow (EventImpl *impl)
     ev.impl = impl;
     ev.key.m_ts = m_currentTs;
     ev.key.m_uid = m_uid;
+    ev.key.m_context = m_currentContext;
     m_uid++;
-    ++m_unscheduledEvents;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
+    InsertEvent (ev);
   }
 
   return EventId (impl, ev.key.m_ts, ev.key.m_uid);
@@ -598,10 +792,9 @@ RealtimeSimulatorImpl::ScheduleRealtime (Time const &time, EventImpl *impl)
     ev.impl = impl;
     ev.key.m_ts = ts;
     ev.key.m_uid = m_uid;
+    ev.key.m_context = m_currentContext;
     m_uid++;
-    ++m_unscheduledEvents;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
+    InsertEvent (ev);
   }
 
 }
@@ -623,10 +816,9 @@ RealtimeSimulatorImpl::ScheduleRealtimeNow (EventImpl *impl)
     ev.impl = impl;
     ev.key.m_ts = ts;
     ev.key.m_uid = m_uid;
+    ev.key.m_context = m_currentContext;
     m_uid++;
-    ++m_unscheduledEvents;
-    m_events->Insert (ev);
-    m_synchronizer->Signal ();
+    InsertEvent (ev);
   }
 }
 
@@ -703,6 +895,18 @@ RealtimeSimulatorImpl::Remove (const EventId &id)
     event.impl = id.PeekEventImpl ();
     event.key.m_ts = id.GetTs ();
     event.key.m_uid = id.GetUid ();
+    event.key.m_context = 0;
+
+    for (std::vector<Scheduler::Event>::const_iterator i = m_batch.begin (); i != m_batch.end (); ++i)
+      {
+        if (i->key.m_uid == event.key.m_uid)
+          {
+            // still in the batch being run: ProcessBatch will drop it.
+            event.impl->Cancel ();
+            ++m_cancelledEvents;
+            return;
+          }
+      }
     
     m_events->Remove (event);
     --m_unscheduledEvents;
@@ -716,8 +920,45 @@ RealtimeSimulatorImpl::Cancel (const EventId &id)
 {
   if (IsExpired (id) == false)
     {
+      if (id.GetUid () == 2)
+        {
+          id.PeekEventImpl ()->Cancel ();
+          return;
+        }
+      //
+      // The event must be cancelled and counted atomically with respect to
+      // ProcessOneEvent, which discounts the cancelled events it dequeues.
+      //
+      CriticalSection cs (m_mutex);
+      if (id.PeekEventImpl ()->IsCancelled ())
+        {
+          return;
+        }
       id.PeekEventImpl ()->Cancel ();
+      ++m_cancelledEvents;
+      if (m_cancelledEvents >= COMPACT_MIN_CANCELLED &&
+          2 * m_cancelledEvents >= m_unscheduledEvents)
+        {
+          CompactEvents ();
+        }
+    }
+}
+
+//
+// Must be called with m_mutex held.
+//
+void
+RealtimeSimulatorImpl::CompactEvents (void)
+{
+  std::vector<Scheduler::Event> cancelled;
+  m_events->RemoveCancelled (cancelled);
+  NS_LOG_LOGIC ("removed " << cancelled.size () << " cancelled events");
+  for (std::vector<Scheduler::Event>::const_iterator i = cancelled.begin (); i != cancelled.end (); ++i)
+    {
+      i->impl->Unref ();
     }
+  m_unscheduledEvents -= cancelled.size ();
+  m_cancelledEvents -= cancelled.size ();
 }
 
 bool
@@ -758,6 +999,18 @@ RealtimeSimulatorImpl::IsExpired (const EventId &ev) const
     }
 }
 
+uint32_t
+RealtimeSimulatorImpl::GetContext (void) const
+{
+  return m_currentContext;
+}
+
+bool
+RealtimeSimulatorImpl::IsLocalContext (uint32_t context) const
+{
+  return true;
+}
+
 Time 
 RealtimeSimulatorImpl::GetMaximumSimulationTime (void) const
 {
@@ -793,5 +1046,146 @@ RealtimeSimulatorImpl::GetHardLimit (void) const
   NS_LOG_FUNCTION_NOARGS ();
   return m_hardLimit;
 }
+
+std::vector<uint64_t>
+RealtimeSimulatorImpl::GetLagHistogram (void) const
+{
+  CriticalSection cs (m_mutex);
+  return m_lag;
+}
+
+std::vector<uint64_t>
+RealtimeSimulatorImpl::GetJitterHistogram (void) const
+{
+  CriticalSection cs (m_mutex);
+  return m_jitter;
+}
+
+void
+RealtimeSimulatorImpl::PrintStatistics (std::ostream &os) const
+{
+  CriticalSection cs (m_mutex);
+  os << "batches=" << m_batches << " batched-events=" << m_batchedEvents << std::endl;
+  os << "us\tlag\tjitter" << std::endl;
+  for (uint32_t i = 0; i < HISTOGRAM_BUCKETS; i++)
+    {
+      if (m_lag[i] == 0 && m_jitter[i] == 0)
+        {
+          continue;
+        }
+      os << (i == 0 ? 0 : ((uint64_t)1 << i)) << "\t" << m_lag[i] << "\t" << m_jitter[i] << std::endl;
+    }
+}
   
 }; // namespace ns3
+
+#ifdef RUN_SELF_TESTS
+
+#include "ns3/test.h"
+#include "map-scheduler.h"
+#include <vector>
+
+namespace ns3 {
+
+class RealtimeSimulatorImplTests : public Test
+{
+public:
+  RealtimeSimulatorImplTests ();
+  virtual ~RealtimeSimulatorImplTests ();
+  virtual bool RunTests (void);
+private:
+  void Busy (Time duration);
+  void Handle (uint32_t i);
+  std::vector<uint32_t> m_order;
+  std::vector<EventId> m_ids;
+};
+
+RealtimeSimulatorImplTests::RealtimeSimulatorImplTests ()
+  : Test ("RealtimeSimulatorImpl")
+{}
+RealtimeSimulatorImplTests::~RealtimeSimulatorImplTests ()
+{}
+
+void
+RealtimeSimulatorImplTests::Busy (Time duration)
+{
+  Ptr<RealtimeSimulatorImpl> impl = DynamicCast<RealtimeSimulatorImpl> (Simulator::GetImplementation ());
+  Time end = impl->RealtimeNow () + duration;
+  while (impl->RealtimeNow () < end)
+    {}
+}
+
+void
+RealtimeSimulatorImplTests::Handle (uint32_t i)
+{
+  m_order.push_back (i);
+  if (i == 1)
+    {
+      Simulator::Cancel (m_ids[8]);
+    }
+  else if (i == 3)
+    {
+      Simulator::ScheduleNow (&RealtimeSimulatorImplTests::Handle, this, 103);
+    }
+}
+
+bool
+RealtimeSimulatorImplTests::RunTests (void)
+{
+  bool result = true;
+
+  Simulator::Destroy ();
+  Ptr<RealtimeSimulatorImpl> impl = CreateObject<RealtimeSimulatorImpl> ();
+  impl->SetScheduler (CreateObject<MapScheduler> ());
+  impl->SetSynchronizationMode (RealtimeSimulatorImpl::SYNC_CATCH_UP);
+  Simulator::SetImplementation (impl);
+
+  // the events at 2ms to 11ms are all late when Busy returns, so they run
+  // in one batch, which the event scheduled by event 3 preempts.
+  Simulator::Schedule (MilliSeconds (1), &RealtimeSimulatorImplTests::Busy, this, MilliSeconds (30));
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      m_ids.push_back (Simulator::Schedule (MilliSeconds (2 + i), &RealtimeSimulatorImplTests::Handle, this, i));
+    }
+  Simulator::Run ();
+
+  uint32_t expected[] = {0, 1, 2, 3, 103, 4, 5, 6, 7, 9};
+  NS_TEST_ASSERT_EQUAL (m_order.size (), 10);
+  for (uint32_t i = 0; i < m_order.size () && i < 10; i++)
+    {
+      NS_TEST_ASSERT_EQUAL (m_order[i], expected[i]);
+    }
+
+  std::vector<uint64_t> lag = impl->GetLagHistogram ();
+  uint64_t lagged = 0;
+  uint64_t lagged16ms = 0;
+  for (uint32_t i = 0; i < lag.size (); i++)
+    {
+      lagged += lag[i];
+      if (i >= 14)
+        {
+          lagged16ms += lag[i];
+        }
+    }
+  NS_TEST_ASSERT (lagged >= 10);
+  // event 0 was due at 2ms and ran after 31ms.
+  NS_TEST_ASSERT (lagged16ms >= 1);
+  // every event which ran, including the cancelled event 8, is recorded
+  // once, although events 4 to 9 went back to the scheduler.
+  std::vector<uint64_t> jitter = impl->GetJitterHistogram ();
+  for (uint32_t i = 0; i < jitter.size (); i++)
+    {
+      lagged += jitter[i];
+    }
+  NS_TEST_ASSERT_EQUAL (lagged, 12);
+
+  Simulator::Destroy ();
+
+  return result;
+}
+
+static RealtimeSimulatorImplTests g_realtimeSimulatorImplTests;
+
+}; // namespace ns3
+
+#endif /* RUN_SELF_TESTS */
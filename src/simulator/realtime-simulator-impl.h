@@ -31,6 +31,8 @@
 #include "ns3/system-mutex.h"
 
 #include <list>
+#include <vector>
+#include <ostream>
 
 namespace ns3 {
 
@@ -46,6 +48,7 @@ public:
   enum SynchronizationMode {
     SYNC_BEST_EFFORT, /** Make a best effort to keep synced to real-time */
     SYNC_HARD_LIMIT, /** Keep to real-time within a tolerance or die trying */
+    SYNC_CATCH_UP, /** Best effort, and run the events already due in batches */
   };
 
   RealtimeSimulatorImpl ();
@@ -58,6 +61,7 @@ public:
   virtual EventId Schedule (Time const &time, EventImpl *event);
   virtual EventId ScheduleNow (EventImpl *event);
   virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event);
   virtual void Remove (const EventId &ev);
   virtual void Cancel (const EventId &ev);
   virtual bool IsExpired (const EventId &ev) const;
@@ -67,6 +71,8 @@ public:
   virtual Time GetDelayLeft (const EventId &id) const;
   virtual Time GetMaximumSimulationTime (void) const;
   virtual void SetScheduler (Ptr<Scheduler> scheduler);
+  virtual uint32_t GetContext (void) const;
+  virtual bool IsLocalContext (uint32_t context) const;
 
   void ScheduleRealtime (Time const &time, EventImpl *event);
   void ScheduleRealtimeNow (EventImpl *event);
@@ -78,12 +84,41 @@ public:
   void SetHardLimit (Time limit);
   Time GetHardLimit (void) const;
 
+  /**
+   * Number of buckets of the lag and jitter histograms.  Bucket 0 counts
+   * the values below 2 microseconds, bucket i > 0 the values in
+   * [2^i, 2^(i+1)) microseconds, and the last bucket everything above.
+   */
+  static const uint32_t HISTOGRAM_BUCKETS = 32;
+
+  /**
+   * \returns the histogram of the lag of the events which were already due
+   * when the simulator looked at the real-time clock, that is, how far
+   * behind real time they were.
+   */
+  std::vector<uint64_t> GetLagHistogram (void) const;
+  /**
+   * \returns the histogram of the difference between the real time at
+   * which the simulator woke up to run an event and the time of the event.
+   */
+  std::vector<uint64_t> GetJitterHistogram (void) const;
+  /**
+   * Prints the lag and jitter histograms, and the number and size of the
+   * catch-up batches.
+   */
+  void PrintStatistics (std::ostream &os) const;
+
 private:
   bool Running (void) const;
   bool Realtime (void) const;
 
   void ProcessOneEvent (void);
+  void DequeueDueEvents (uint64_t tsNow);
+  void ProcessBatch (void);
+  void InsertEvent (const Scheduler::Event &ev);
   uint64_t NextTs (void) const;
+  void CompactEvents (void);
+  static void Record (std::vector<uint64_t> &histogram, uint64_t ts);
 
   typedef std::list<EventId> DestroyEvents;
   DestroyEvents m_destroyEvents;
@@ -93,12 +128,32 @@ private:
   // The following variables are protected using the m_mutex
   Ptr<Scheduler> m_events;
   int m_unscheduledEvents;
+  // cancelled events still in m_events, see DefaultSimulatorImpl.
+  int m_cancelledEvents;
+  static const int COMPACT_MIN_CANCELLED = 1000;
   uint32_t m_uid;
   uint32_t m_currentUid;
   uint64_t m_currentTs;
+  uint32_t m_currentContext;
 
   mutable SystemMutex m_mutex;
 
+  // In SYNC_CATCH_UP mode, the events which were due when the simulator
+  // looked at the clock are all taken off m_events at once and run from
+  // m_batch, starting at m_batchHead, without synchronizing each of them.
+  // InsertEvent sets m_batchPreempted if an event is scheduled before the
+  // end of the batch: the rest of the batch then goes back to m_events.
+  // m_batchNow is the real time at which the batch was taken off.
+  std::vector<Scheduler::Event> m_batch;
+  uint32_t m_batchHead;
+  bool m_batchPreempted;
+  uint64_t m_batchNow;
+  uint64_t m_batches;
+  uint64_t m_batchedEvents;
+
+  std::vector<uint64_t> m_lag;
+  std::vector<uint64_t> m_jitter;
+
   Ptr<Synchronizer> m_synchronizer;
 
   /**
@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "recording-scheduler.h"
+#include "ns3/object-factory.h"
+#include "ns3/string.h"
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE ("RecordingScheduler");
+
+namespace ns3 {
+
+NS_OBJECT_ENSURE_REGISTERED (RecordingScheduler);
+
+TypeId
+RecordingScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RecordingScheduler")
+    .SetParent<Scheduler> ()
+    .AddConstructor<RecordingScheduler> ()
+    .AddAttribute ("Scheduler",
+                   "The type of the scheduler which actually stores the events.",
+                   StringValue ("ns3::MapScheduler"),
+                   MakeStringAccessor (&RecordingScheduler::m_schedulerType),
+                   MakeStringChecker ())
+    .AddAttribute ("FileName",
+                   "The file the scheduler operations are written to.",
+                   StringValue ("scheduler.trace"),
+                   MakeStringAccessor (&RecordingScheduler::m_fileName),
+                   MakeStringChecker ())
+    ;
+  return tid;
+}
+
+RecordingScheduler::RecordingScheduler ()
+{}
+
+RecordingScheduler::~RecordingScheduler ()
+{}
+
+void
+RecordingScheduler::DoDispose (void)
+{
+  m_scheduler = 0;
+  if (m_output.is_open ())
+    {
+      m_output.close ();
+    }
+  Scheduler::DoDispose ();
+}
+
+Ptr<Scheduler>
+RecordingScheduler::GetScheduler (void) const
+{
+  // the attributes are only known once the constructor has returned.
+  if (m_scheduler == 0)
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (m_schedulerType);
+      m_scheduler = factory.Create<Scheduler> ();
+      std::ofstream &output = const_cast<std::ofstream &> (m_output);
+      output.open (m_fileName.c_str ());
+      if (!output.is_open ())
+        {
+          NS_FATAL_ERROR ("RecordingScheduler: could not open " << m_fileName);
+        }
+    }
+  return m_scheduler;
+}
+
+void
+RecordingScheduler::Insert (const Event &ev)
+{
+  GetScheduler ()->Insert (ev);
+  m_output << "i " << ev.key.m_ts << " " << ev.key.m_uid << "\n";
+}
+
+bool
+RecordingScheduler::IsEmpty (void) const
+{
+  return GetScheduler ()->IsEmpty ();
+}
+
+Scheduler::Event
+RecordingScheduler::PeekNext (void) const
+{
+  return GetScheduler ()->PeekNext ();
+}
+
+Scheduler::Event
+RecordingScheduler::RemoveNext (void)
+{
+  m_output << "n\n";
+  return GetScheduler ()->RemoveNext ();
+}
+
+void
+RecordingScheduler::Remove (const Event &ev)
+{
+  GetScheduler ()->Remove (ev);
+  m_output << "r " << ev.key.m_ts << " " << ev.key.m_uid << "\n";
+}
+
+void
+RecordingScheduler::RemoveCancelled (std::vector<Event> &cancelled)
+{
+  uint32_t first = cancelled.size ();
+  GetScheduler ()->RemoveCancelled (cancelled);
+  for (uint32_t i = first; i < cancelled.size (); i++)
+    {
+      m_output << "r " << cancelled[i].key.m_ts << " " << cancelled[i].key.m_uid << "\n";
+    }
+}
+
+} // namespace ns3
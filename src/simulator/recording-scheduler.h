@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RECORDING_SCHEDULER_H
+#define RECORDING_SCHEDULER_H
+
+#include "scheduler.h"
+#include "ns3/ptr.h"
+#include <string>
+#include <fstream>
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a scheduler which logs the operations it forwards to another
+ *        scheduler.
+ *
+ * Each operation is written to the file named by the FileName
+ * attribute, one per line:
+ *  - "i <ts> <uid>" for Insert,
+ *  - "n" for RemoveNext,
+ *  - "r <ts> <uid>" for Remove.
+ *
+ * utils/bench-scheduler replays such traces against every scheduler.
+ * To record a run without modifying it:
+ * \code
+ * NS_GLOBAL_VALUE="SchedulerType=ns3::RecordingScheduler" \
+ * NS_ATTRIBUTE_DEFAULT="ns3::RecordingScheduler::FileName=run.trace" ./waf --run ...
+ * \endcode
+ */
+class RecordingScheduler : public Scheduler
+{
+public:
+  static TypeId GetTypeId (void);
+
+  RecordingScheduler ();
+  virtual ~RecordingScheduler ();
+
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Event PeekNext (void) const;
+  virtual Event RemoveNext (void);
+  virtual void Remove (const Event &ev);
+  virtual void RemoveCancelled (std::vector<Event> &cancelled);
+
+private:
+  virtual void DoDispose (void);
+  Ptr<Scheduler> GetScheduler (void) const;
+
+  std::string m_schedulerType;
+  std::string m_fileName;
+  mutable Ptr<Scheduler> m_scheduler;
+  std::ofstream m_output;
+};
+
+} // namespace ns3
+
+#endif /* RECORDING_SCHEDULER_H */
@@ -35,4 +35,8 @@ Scheduler::GetTypeId (void)
   return tid;
 }
 
+void
+Scheduler::RemoveCancelled (std::vector<Event> &cancelled)
+{}
+
 } // namespace ns3
@@ -22,6 +22,7 @@
 #define SCHEDULER_H
 
 #include <stdint.h>
+#include <vector>
 #include "ns3/object.h"
 
 namespace ns3 {
@@ -58,6 +59,8 @@ class Scheduler : public Object
   struct EventKey {
       uint64_t m_ts;
       uint32_t m_uid;
+      /* not part of the ordering: the context the event will run in */
+      uint32_t m_context;
   };
   struct Event {
     EventImpl *impl;
@@ -92,6 +95,17 @@ class Scheduler : public Object
    * This methods cannot be invoked if the list is empty.
    */
   virtual void Remove (const Event &ev) = 0;
+  /**
+   * \param cancelled the events removed from the event list
+   *
+   * Remove from the event list all the events whose EventImpl has
+   * been cancelled and append them to cancelled. The caller owns the
+   * removed events exactly as if they had been returned by RemoveNext.
+   * The simulator calls this method when cancelled events make up a
+   * large part of the event list. The default implementation does
+   * nothing.
+   */
+  virtual void RemoveCancelled (std::vector<Event> &cancelled);
 };
 
 /* Note the invariants which this function must provide:
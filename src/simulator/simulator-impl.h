@@ -41,6 +41,7 @@ public:
   virtual EventId Schedule (Time const &time, EventImpl *event) = 0;
   virtual EventId ScheduleNow (EventImpl *event) = 0;
   virtual EventId ScheduleDestroy (EventImpl *event) = 0;
+  virtual void ScheduleWithContext (uint32_t context, Time const &time, EventImpl *event) = 0;
   virtual void Remove (const EventId &ev) = 0;
   virtual void Cancel (const EventId &ev) = 0;
   virtual bool IsExpired (const EventId &ev) const = 0;
@@ -50,6 +51,8 @@ public:
   virtual Time GetDelayLeft (const EventId &id) const = 0;
   virtual Time GetMaximumSimulationTime (void) const = 0;
   virtual void SetScheduler (Ptr<Scheduler> scheduler) = 0;
+  virtual uint32_t GetContext (void) const = 0;
+  virtual bool IsLocalContext (uint32_t context) const = 0;
 };
 
 } // namespace ns3
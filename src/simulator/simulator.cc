@@ -232,6 +232,11 @@ Simulator::DoScheduleDestroy (EventImpl *impl)
 {
   return GetImpl ()->ScheduleDestroy (impl);
 }
+void
+Simulator::DoScheduleWithContext (uint32_t context, Time const &time, EventImpl *impl)
+{
+  GetImpl ()->ScheduleWithContext (context, time, impl);
+}
 
 
 EventId
@@ -255,6 +260,13 @@ Simulator::ScheduleDestroy (void (*f) (void))
   return DoScheduleDestroy (MakeEvent (f));
 }
 
+void
+Simulator::ScheduleWithContext (uint32_t context, Time const &time, void (*f) (void))
+{
+  NS_LOG_FUNCTION (context << time << f);
+  DoScheduleWithContext (context, time, MakeEvent (f));
+}
+
 void
 Simulator::Remove (const EventId &ev)
 {
@@ -289,6 +301,20 @@ Simulator::GetMaximumSimulationTime (void)
   return GetImpl ()->GetMaximumSimulationTime ();
 }
 
+const uint32_t Simulator::NO_CONTEXT;
+
+uint32_t
+Simulator::GetContext (void)
+{
+  return GetImpl ()->GetContext ();
+}
+
+bool
+Simulator::IsLocalContext (uint32_t context)
+{
+  return GetImpl ()->IsLocalContext (context);
+}
+
 void
 Simulator::SetImplementation (Ptr<SimulatorImpl> impl)
 {
@@ -326,6 +352,8 @@ Simulator::GetImplementation (void)
 #include "map-scheduler.h"
 #include "calendar-scheduler.h"
 #include "ns2-calendar-scheduler.h"
+#include "ladder-scheduler.h"
+#include <vector>
 
 namespace ns3 {
 
@@ -384,6 +412,7 @@ private:
   void B (int b);
   void C (int c);
   void D (int d);
+  void E (uint32_t i);
   void bar0 (void);
   void bar1 (int);
   void bar2 (int, int);
@@ -419,6 +448,7 @@ private:
   void cbaz5c (const int &, const int &, const int &, const int &, const int &) const;
 
   void destroy (void);
+  void context (uint32_t expected);
   
   bool m_b;
   bool m_a;
@@ -427,6 +457,8 @@ private:
   EventId m_idC;
   bool m_destroy;
   EventId m_destroyId;
+  uint32_t m_contextChecks;
+  std::vector<uint32_t> m_invoked;
 };
 
 SimulatorTests::SimulatorTests ()
@@ -491,6 +523,12 @@ SimulatorTests::D (int d)
     }
 }
 
+void
+SimulatorTests::E (uint32_t i)
+{
+  m_invoked.push_back (i);
+}
+
 void
 SimulatorTests::destroy (void)
 {
@@ -500,6 +538,21 @@ SimulatorTests::destroy (void)
     }
 }
 
+void
+SimulatorTests::context (uint32_t expected)
+{
+  if (Simulator::GetContext () != expected)
+    {
+      return;
+    }
+  m_contextChecks++;
+  if (m_contextChecks == 1)
+    {
+      // plain Schedule inherits the context of the running event
+      Simulator::Schedule (Seconds (1.0), &SimulatorTests::context, this, expected);
+    }
+}
+
 void 
 SimulatorTests::bar0 (void)
 {}
@@ -650,6 +703,38 @@ SimulatorTests::RunOneTest (void)
   NS_TEST_ASSERT (m_b);
   NS_TEST_ASSERT (m_c);
   NS_TEST_ASSERT (m_d);
+
+  // cancel enough events for the cancelled events to be compacted
+  // out of the scheduler: the others must still run in order.
+  const uint32_t n = 3000;
+  std::vector<EventId> ids;
+  std::vector<uint64_t> ts;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      ts.push_back ((i * 7) % 500);
+      ids.push_back (Simulator::Schedule (MicroSeconds (ts.back ()), &SimulatorTests::E, this, i));
+    }
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (i % 3 != 0)
+        {
+          Simulator::Cancel (ids[i]);
+          NS_TEST_ASSERT (ids[i].IsExpired ());
+        }
+    }
+  m_invoked.clear ();
+  Simulator::Run ();
+  NS_TEST_ASSERT_EQUAL (m_invoked.size (), n / 3);
+  for (uint32_t i = 0; i < m_invoked.size (); i++)
+    {
+      NS_TEST_ASSERT_EQUAL (m_invoked[i] % 3, 0);
+      if (i > 0)
+        {
+          uint32_t prev = m_invoked[i - 1];
+          uint32_t cur = m_invoked[i];
+          NS_TEST_ASSERT (ts[prev] < ts[cur] || (ts[prev] == ts[cur] && prev < cur));
+        }
+    }
   return result;
 }
 
@@ -766,6 +851,13 @@ SimulatorTests::RunTests (void)
     }
   Simulator::Destroy ();
 
+  Simulator::SetScheduler (CreateObject<LadderScheduler> ());
+  if (!RunOneTest ()) 
+    {
+      result = false;
+    }
+  Simulator::Destroy ();
+
   Simulator::Schedule (Seconds (0.0), &foo0);
   Simulator::Schedule (Seconds (0.0), &foo1, 0);
   Simulator::Schedule (Seconds (0.0), &foo2, 0, 0);
@@ -915,6 +1007,16 @@ SimulatorTests::RunTests (void)
   Simulator::Run ();
   Simulator::Destroy ();
 
+  m_contextChecks = 0;
+  NS_TEST_ASSERT_EQUAL (Simulator::GetContext (), Simulator::NO_CONTEXT);
+  Simulator::ScheduleWithContext (7, Seconds (1.0), &SimulatorTests::context, this, 7);
+  Simulator::ScheduleWithContext (3, Seconds (1.0), &foo0);
+  Simulator::ScheduleWithContext (3, Seconds (1.0), &foo2, 0, 0);
+  Simulator::Run ();
+  NS_TEST_ASSERT_EQUAL (m_contextChecks, 2);
+  NS_TEST_ASSERT (Simulator::IsLocalContext (7));
+  Simulator::Destroy ();
+
   return result;
 }
 
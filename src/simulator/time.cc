@@ -67,6 +67,22 @@ Set (precision_t precision)
 
 } // namespace TimeStepPrecision
 
+/*
+ * Converts a number of timesteps computed from a floating point value.
+ * With 64 bit integer time values, it is rounded to the nearest timestep:
+ * Seconds (0.3) is then an integer, and so are all the times computed
+ * from it.
+ */
+static HighPrecision
+TimeStepFromDouble (double ts)
+{
+#ifdef USE_HIGH_PRECISION_INT64
+  return HighPrecision (floor (ts + 0.5));
+#else
+  return HighPrecision (ts);
+#endif
+}
+
 TimeUnit<1>::TimeUnit(const std::string& s)
 {
   std::string::size_type n = s.find_first_not_of("0123456789.");
@@ -79,7 +95,7 @@ TimeUnit<1>::TimeUnit(const std::string& s)
     std::string trailer = s.substr(n, std::string::npos);
     if (trailer == std::string("s"))
     {
-      m_data = HighPrecision (r * TimeStepPrecision::g_tsPrecFactor);
+      m_data = TimeStepFromDouble (r * TimeStepPrecision::g_tsPrecFactor);
       return;
     }
     if (trailer == std::string("ms"))
@@ -120,7 +136,7 @@ TimeUnit<1>::TimeUnit(const std::string& s)
   iss. str (s);
   double v;
   iss >> v;
-  m_data = HighPrecision (v * TimeStepPrecision::g_tsPrecFactor);
+  m_data = TimeStepFromDouble (v * TimeStepPrecision::g_tsPrecFactor);
 }
 
 double 
@@ -285,7 +301,7 @@ std::istream& operator>> (std::istream& is, Time & time)
 Time Seconds (double seconds)
 {
   double d_sec = seconds * TimeStepPrecision::g_tsPrecFactor;
-  return Time (HighPrecision (d_sec));
+  return Time (TimeStepFromDouble (d_sec));
   //  return Time (HighPrecision ((int64_t)d_sec, false));
 }
 
@@ -499,7 +515,15 @@ bool TimeTests::RunTests (void)
   tooBig = TimeStep (0x7fffffffffffffffLL);
   NS_TEST_ASSERT (tooBig.IsPositive ());
   tooBig += TimeStep (1);
+#ifdef USE_HIGH_PRECISION_INT64
+  // the overflow is detected instead of wrapping around
+  NS_TEST_ASSERT (tooBig.IsPositive ());
+#else
   NS_TEST_ASSERT (tooBig.IsNegative ());
+#endif
+
+  NS_TEST_ASSERT_EQUAL (Min (Seconds (1), Seconds (2)), Seconds (1));
+  NS_TEST_ASSERT_EQUAL (Max (Seconds (1), Seconds (2)), Seconds (2));
 
   return result;
 }
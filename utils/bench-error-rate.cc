@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Compares the TableErrorRateModel to the YansErrorRateModel it
+// tabulates: for each mode, the largest difference of the chunk success
+// rates over a range of snr values and chunk sizes, and the time of one
+// evaluation of each model.
+//
+
+#include "ns3/core-module.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/yans-error-rate-model.h"
+#include "ns3/table-error-rate-model.h"
+
+#include <math.h>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+using namespace ns3;
+
+static double
+GetNsPerCall (Ptr<ErrorRateModel> model, WifiMode mode, const std::vector<double> &snrs, uint32_t nbits)
+{
+  SystemWallClockMs time;
+  double sum = 0.0;
+  time.Start ();
+  for (uint32_t i = 0; i < snrs.size (); i++)
+    {
+      sum += model->GetChunkSuccessRate (mode, snrs[i], nbits);
+    }
+  unsigned long long ms = time.End ();
+  if (sum < 0.0)
+    {
+      std::cout << sum;
+    }
+  return ms * 1e6 / snrs.size ();
+}
+
+int main (int argc, char *argv[])
+{
+  double minSnr = -5.0;
+  double maxSnr = 35.0;
+  uint32_t n = 100000;
+
+  CommandLine cmd;
+  cmd.AddValue ("min", "The lowest snr (dB)", minSnr);
+  cmd.AddValue ("max", "The highest snr (dB)", maxSnr);
+  cmd.AddValue ("n", "Number of snr values per mode", n);
+  cmd.Parse (argc, argv);
+
+  Ptr<YansErrorRateModel> yans = CreateObject<YansErrorRateModel> ();
+  Ptr<TableErrorRateModel> table = CreateObject<TableErrorRateModel> ();
+  table->SetModel (yans);
+
+  WifiMode modes[] = {WifiPhy::Get6mba (), WifiPhy::Get9mba (), WifiPhy::Get12mba (),
+                      WifiPhy::Get18mba (), WifiPhy::Get24mba (), WifiPhy::Get36mba (),
+                      WifiPhy::Get48mba (), WifiPhy::Get54mba (), WifiPhy::Get1mbb (),
+                      WifiPhy::Get2mbb (), WifiPhy::Get5_5mbb (), WifiPhy::Get11mbb ()};
+  uint32_t sizes[] = {1, 8 * 14, 8 * 1500};
+
+  std::cout << std::setw (12) << "mode" << std::setw (14) << "max error"
+            << std::setw (10) << "at dB" << std::setw (8) << "bits"
+            << std::setw (12) << "yans ns" << std::setw (12) << "table ns" << std::endl;
+  for (uint32_t m = 0; m < sizeof (modes) / sizeof (modes[0]); m++)
+    {
+      std::vector<double> snrs;
+      for (uint32_t i = 0; i < n; i++)
+        {
+          snrs.push_back (pow (10.0, (minSnr + (maxSnr - minSnr) * i / n) / 10.0));
+        }
+      double maxError = 0.0;
+      double maxErrorDb = 0.0;
+      uint32_t maxErrorBits = 0;
+      for (uint32_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); s++)
+        {
+          for (uint32_t i = 0; i < n; i++)
+            {
+              double error = fabs (table->GetChunkSuccessRate (modes[m], snrs[i], sizes[s])
+                                   - yans->GetChunkSuccessRate (modes[m], snrs[i], sizes[s]));
+              if (error > maxError)
+                {
+                  maxError = error;
+                  maxErrorDb = 10.0 * log10 (snrs[i]);
+                  maxErrorBits = sizes[s];
+                }
+            }
+        }
+      std::cout << std::setw (12) << modes[m].GetUniqueName ()
+                << std::setw (14) << std::scientific << std::setprecision (2) << maxError
+                << std::setw (10) << std::fixed << maxErrorDb
+                << std::setw (8) << maxErrorBits
+                << std::setw (12) << std::setprecision (0) << GetNsPerCall (yans, modes[m], snrs, 8 * 1500)
+                << std::setw (12) << GetNsPerCall (table, modes[m], snrs, 8 * 1500)
+                << std::endl;
+    }
+  return 0;
+}
@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Runs the same point-to-point ring with the sequential simulator and
+// with ns3::ParallelSimulatorImpl on an increasing number of threads,
+// and reports the wall clock time of each run together with a digest
+// of the packet arrivals, which must be the same as with the
+// sequential simulator: the program fails if any digest differs.
+//
+//   ./waf --run "bench-parallel --nodes=128 --lps=8 --threads=8"
+//
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/node-module.h"
+#include "ns3/helper-module.h"
+#include "ns3/parallel-simulator-helper.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+static std::vector<uint64_t> g_rxDigest;
+static std::vector<uint64_t> g_rxBytes;
+
+static void
+SinkRx (uint32_t node, Ptr<const Packet> packet, const Address &from)
+{
+  // each sink only ever updates the slot of its own node.
+  g_rxDigest[node] = g_rxDigest[node] * 1000003 + Simulator::Now ().GetTimeStep ();
+  g_rxBytes[node] += packet->GetSize ();
+}
+
+static void
+BuildRing (const InternetStackHelper &stack, uint32_t nNodes, uint32_t hops, double stop)
+{
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+  stack.Install (nodes);
+
+  PointToPointHelper p2p;
+  p2p.SetDeviceAttribute ("DataRate", StringValue ("100Mbps"));
+  p2p.SetChannelAttribute ("Delay", StringValue ("1ms"));
+
+  Ipv4AddressHelper address;
+  std::vector<Ipv4Address> addresses (nNodes);
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      NetDeviceContainer devices = p2p.Install (nodes.Get (i), nodes.Get ((i + 1) % nNodes));
+      std::ostringstream subnet;
+      subnet << "10." << (i / 256) << "." << (i % 256) << ".0";
+      address.SetBase (subnet.str ().c_str (), "255.255.255.0");
+      Ipv4InterfaceContainer interfaces = address.Assign (devices);
+      addresses[i] = interfaces.GetAddress (0);
+    }
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+  uint16_t port = 9;
+  PacketSinkHelper sink ("ns3::UdpSocketFactory",
+                         Address (InetSocketAddress (Ipv4Address::GetAny (), port)));
+  ApplicationContainer sinks = sink.Install (nodes);
+  sinks.Start (Seconds (0.0));
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      sinks.Get (i)->TraceConnectWithoutContext ("Rx", MakeBoundCallback (&SinkRx, i));
+    }
+
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      OnOffHelper onoff ("ns3::UdpSocketFactory",
+                         Address (InetSocketAddress (addresses[(i + hops) % nNodes], port)));
+      onoff.SetAttribute ("OnTime", RandomVariableValue (ConstantVariable (1)));
+      onoff.SetAttribute ("OffTime", RandomVariableValue (ConstantVariable (0)));
+      onoff.SetAttribute ("DataRate", StringValue ("2Mbps"));
+      onoff.SetAttribute ("PacketSize", UintegerValue (512));
+      ApplicationContainer app = onoff.Install (nodes.Get (i));
+      app.Start (Seconds (1.0));
+      app.Stop (Seconds (stop));
+    }
+}
+
+static uint64_t
+RunOnce (const InternetStackHelper &stack, uint32_t nNodes, uint32_t hops, double stop, uint32_t nLps, uint32_t nThreads,
+         unsigned long long *ms, uint64_t *bytes)
+{
+  g_rxDigest.assign (nNodes, 0);
+  g_rxBytes.assign (nNodes, 0);
+  if (nThreads == 0)
+    {
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+    }
+  else
+    {
+      GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::ParallelSimulatorImpl"));
+    }
+
+  BuildRing (stack, nNodes, hops, stop);
+  if (nThreads != 0)
+    {
+      ParallelSimulatorHelper parallel;
+      parallel.SetMaxThreads (nThreads);
+      parallel.Partition (nLps);
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (stop + 1));
+  Simulator::Run ();
+  *ms = clock.End ();
+  Simulator::Destroy ();
+
+  uint64_t digest = 0;
+  *bytes = 0;
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      digest = digest * 31 + g_rxDigest[i];
+      *bytes += g_rxBytes[i];
+    }
+  return digest;
+}
+
+int main (int argc, char *argv[])
+{
+  uint32_t nNodes = 64;
+  uint32_t hops = 3;
+  uint32_t nLps = 8;
+  uint32_t maxThreads = 8;
+  double stop = 5.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("nodes", "Number of nodes in the ring", nNodes);
+  cmd.AddValue ("hops", "Distance, in hops, between a source and its sink", hops);
+  cmd.AddValue ("lps", "Number of logical processes", nLps);
+  cmd.AddValue ("threads", "Largest number of threads to try", maxThreads);
+  cmd.AddValue ("stop", "Time at which the sources stop, in seconds", stop);
+  cmd.Parse (argc, argv);
+
+  // every InternetStackHelper adds its routing protocols to a shared
+  // list, so the same helper is used for all the runs.
+  InternetStackHelper stack;
+  unsigned long long ms;
+  uint64_t bytes;
+  uint64_t digest = RunOnce (stack, nNodes, hops, stop, nLps, 0, &ms, &bytes);
+  unsigned long long sequential = ms;
+  std::cout << "sequential: " << ms << " ms, " << bytes << " bytes received" << std::endl;
+
+  bool identical = true;
+  for (uint32_t threads = 1; threads <= maxThreads; threads *= 2)
+    {
+      uint64_t result = RunOnce (stack, nNodes, hops, stop, nLps, threads, &ms, &bytes);
+      identical = identical && result == digest;
+      std::cout << threads << " threads: " << ms << " ms, speedup "
+                << (ms == 0 ? 0.0 : (double)sequential / ms) << ", "
+                << bytes << " bytes received, "
+                << (result == digest ? "same as sequential" : "DIFFERENT FROM SEQUENTIAL")
+                << std::endl;
+    }
+  return identical ? 0 : 1;
+}
@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Replays a trace of scheduler operations against each scheduler and
+// reports the time each one takes.  Traces are recorded from real runs
+// with ns3::RecordingScheduler:
+//
+//   export NS_GLOBAL_VALUE="SchedulerType=ns3::RecordingScheduler"
+//   export NS_ATTRIBUTE_DEFAULT="ns3::RecordingScheduler::FileName=run.trace"
+//   ./waf --run "rapidnet-app ..."
+//   unset NS_GLOBAL_VALUE NS_ATTRIBUTE_DEFAULT
+//   ./waf --run "bench-scheduler --trace=run.trace"
+//
+// Without a trace, a synthetic RapidNet-like workload is generated:
+// periodic timers which trigger bursts of same-time rule events,
+// jittered sends and soft-state timeouts which are often refreshed
+// (removed and rescheduled) before they expire.
+//
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <set>
+#include <stdlib.h>
+
+using namespace ns3;
+
+struct Op
+{
+  char type;
+  uint64_t ts;
+  uint32_t uid;
+};
+
+static bool
+ReadTrace (std::string fileName, std::vector<Op> &ops)
+{
+  std::ifstream input (fileName.c_str ());
+  if (!input.is_open ())
+    {
+      return false;
+    }
+  Op op;
+  while (input >> op.type)
+    {
+      op.ts = 0;
+      op.uid = 0;
+      if (op.type == 'i' || op.type == 'r')
+        {
+          input >> op.ts >> op.uid;
+        }
+      ops.push_back (op);
+    }
+  return true;
+}
+
+enum Kind
+{
+  TIMER,
+  RULE,
+  SEND,
+  EXPIRY
+};
+
+class Workload
+{
+public:
+  Workload (uint32_t nNodes, uint32_t seed);
+  void Generate (uint32_t nOps, std::vector<Op> &ops);
+private:
+  uint32_t Random (uint32_t n);
+  void Insert (uint64_t ts, enum Kind kind);
+
+  uint32_t m_nNodes;
+  uint32_t m_random;
+  uint32_t m_uid;
+  std::vector<Op> *m_ops;
+  std::set<std::pair<uint64_t, uint32_t> > m_pending;
+  std::vector<enum Kind> m_kind;
+  std::vector<std::pair<uint64_t, uint32_t> > m_expiries;
+};
+
+Workload::Workload (uint32_t nNodes, uint32_t seed)
+  : m_nNodes (nNodes),
+    m_random (seed),
+    m_uid (0),
+    m_ops (0)
+{}
+
+uint32_t
+Workload::Random (uint32_t n)
+{
+  m_random = m_random * 1103515245 + 12345;
+  return (m_random >> 8) % n;
+}
+
+void
+Workload::Insert (uint64_t ts, enum Kind kind)
+{
+  Op op = {'i', ts, m_uid};
+  m_ops->push_back (op);
+  m_pending.insert (std::make_pair (ts, m_uid));
+  m_kind.push_back (kind);
+  if (kind == EXPIRY)
+    {
+      m_expiries.push_back (std::make_pair (ts, m_uid));
+    }
+  m_uid++;
+}
+
+void
+Workload::Generate (uint32_t nOps, std::vector<Op> &ops)
+{
+  const uint64_t ms = 1000000;
+  m_ops = &ops;
+  for (uint32_t i = 0; i < m_nNodes; i++)
+    {
+      Insert (Random (1000) * ms, TIMER);
+    }
+  while (ops.size () < nOps && !m_pending.empty ())
+    {
+      std::pair<uint64_t, uint32_t> next = *m_pending.begin ();
+      m_pending.erase (m_pending.begin ());
+      Op op = {'n', 0, 0};
+      ops.push_back (op);
+      uint64_t now = next.first;
+      switch (m_kind[next.second])
+        {
+        case TIMER:
+          // a periodic refresh triggers a burst of local rule firings.
+          Insert (now + 1000 * ms, TIMER);
+          for (uint32_t i = Random (20); i > 0; i--)
+            {
+              Insert (now, RULE);
+            }
+          break;
+        case RULE:
+          if (Random (10) < 3)
+            {
+              Insert (now + Random (10 * ms), SEND);
+            }
+          if (Random (10) < 2)
+            {
+              Insert (now + 10000 * ms, EXPIRY);
+            }
+          if (Random (10) < 5 && !m_expiries.empty ())
+            {
+              // refresh a soft-state tuple: cancel its timeout.
+              uint32_t index = Random (m_expiries.size ());
+              std::pair<uint64_t, uint32_t> expiry = m_expiries[index];
+              m_expiries[index] = m_expiries.back ();
+              m_expiries.pop_back ();
+              if (m_pending.erase (expiry) == 1)
+                {
+                  Op remove = {'r', expiry.first, expiry.second};
+                  ops.push_back (remove);
+                }
+            }
+          break;
+        case SEND:
+          Insert (now + (1 + Random (5)) * ms, RULE);
+          break;
+        case EXPIRY:
+          Insert (now, RULE);
+          break;
+        }
+    }
+}
+
+static unsigned long long
+Replay (std::string type, const std::vector<Op> &ops, uint64_t *digest)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+  *digest = 0;
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (std::vector<Op>::const_iterator i = ops.begin (); i != ops.end (); ++i)
+    {
+      Scheduler::Event ev;
+      ev.impl = 0;
+      ev.key.m_ts = i->ts;
+      ev.key.m_uid = i->uid;
+      ev.key.m_context = 0;
+      switch (i->type)
+        {
+        case 'i':
+          scheduler->Insert (ev);
+          break;
+        case 'n':
+          *digest = *digest * 31 + scheduler->RemoveNext ().key.m_uid;
+          break;
+        case 'r':
+          scheduler->Remove (ev);
+          break;
+        }
+    }
+  return clock.End ();
+}
+
+int main (int argc, char *argv[])
+{
+  std::string trace;
+  std::string schedulers = "ns3::ListScheduler,ns3::MapScheduler,ns3::HeapScheduler,"
+    "ns3::CalendarScheduler,ns3::Ns2CalendarScheduler,ns3::LadderScheduler";
+  uint32_t nOps = 1000000;
+  uint32_t nNodes = 100;
+  uint32_t runs = 1;
+
+  CommandLine cmd;
+  cmd.AddValue ("trace", "Trace recorded with ns3::RecordingScheduler (default: synthetic workload)", trace);
+  cmd.AddValue ("schedulers", "Comma-separated list of the schedulers to compare", schedulers);
+  cmd.AddValue ("ops", "Number of operations of the synthetic workload", nOps);
+  cmd.AddValue ("nodes", "Number of nodes of the synthetic workload", nNodes);
+  cmd.AddValue ("runs", "Number of times each trace is replayed", runs);
+  cmd.Parse (argc, argv);
+
+  std::vector<Op> ops;
+  if (trace.empty ())
+    {
+      Workload workload (nNodes, 1);
+      workload.Generate (nOps, ops);
+    }
+  else if (!ReadTrace (trace, ops))
+    {
+      std::cerr << "could not read " << trace << std::endl;
+      return 1;
+    }
+  std::cout << ops.size () << " operations" << std::endl;
+
+  std::istringstream types (schedulers);
+  std::string type;
+  uint64_t reference = 0;
+  bool first = true;
+  bool identical = true;
+  while (std::getline (types, type, ','))
+    {
+      unsigned long long best = 0;
+      uint64_t digest = 0;
+      for (uint32_t i = 0; i < runs; i++)
+        {
+          unsigned long long ms = Replay (type, ops, &digest);
+          best = (i == 0) ? ms : std::min (best, ms);
+        }
+      if (first)
+        {
+          reference = digest;
+          first = false;
+        }
+      identical = identical && digest == reference;
+      std::cout << type << ": " << best << " ms, "
+                << (best == 0 ? 0.0 : ops.size () / (best * 1000.0)) << " Mops/s"
+                << (digest == reference ? "" : " (DIFFERENT ORDER)") << std::endl;
+    }
+  return identical ? 0 : 1;
+}
@@ -130,6 +130,9 @@ PrintHelp (void)
   std::cout << "      --list: use std::list scheduler"<<std::endl;
   std::cout << "      --map: use std::map cheduler"<<std::endl;
   std::cout << "      --heap: use Binary Heap scheduler"<<std::endl;
+  std::cout << "      --calendar: use Calendar scheduler"<<std::endl;
+  std::cout << "      --ns2calendar: use ns-2 Calendar scheduler"<<std::endl;
+  std::cout << "      --ladder: use Ladder Queue scheduler"<<std::endl;
   std::cout << "      --debug: enable some debugging"<<std::endl;
 }
 
@@ -172,6 +175,14 @@ int main (int argc, char *argv[])
         {
           Simulator::SetScheduler (CreateObject<CalendarScheduler> ());
         }
+      else if (strcmp ("--ns2calendar", argv[0]) == 0)
+        {
+          Simulator::SetScheduler (CreateObject<Ns2CalendarScheduler> ());
+        }
+      else if (strcmp ("--ladder", argv[0]) == 0)
+        {
+          Simulator::SetScheduler (CreateObject<LadderScheduler> ());
+        }
       else if (strcmp ("--debug", argv[0]) == 0) 
         {
           g_debug = true;
@@ -0,0 +1,148 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Microbenchmarks of the Time arithmetic, to compare the HighPrecision
+ * implementations (see the --high-precision-as-int64 and
+ * --high-precision-as-double configure options):
+ *  - convert: Seconds (double) and GetSeconds (), as done by every
+ *    application which reads its timers from attributes;
+ *  - softstate: the expiration test of soft-state tuples, now - timestamp
+ *    > lifetime, over a table of timestamps;
+ *  - schedule: a hold model which schedules every event with a delay
+ *    given in seconds and stamps it with Simulator::Now ().
+ */
+
+#include "ns3/simulator-module.h"
+#include "ns3/core-module.h"
+#include <iostream>
+#include <vector>
+#include <string.h>
+#include <stdlib.h>
+
+using namespace ns3;
+
+static uint32_t g_n = 1000000;
+
+static void
+Report (const char *name, uint32_t n, double ms)
+{
+  std::cout << name << " n=" << n << ", time=" << ms / 1000 << "s, "
+            << ms * 1000000 / n << "ns/op" << std::endl;
+}
+
+static void
+BenchConvert (void)
+{
+  SystemWallClockMs time;
+  double total = 0;
+  time.Start ();
+  for (uint32_t i = 0; i < 10 * g_n; i++)
+    {
+      Time t = Seconds ((i % 1000) * 0.0003);
+      total += t.GetSeconds ();
+    }
+  Report ("convert", 10 * g_n, time.End ());
+  if (total < 0)
+    {
+      std::cout << total << std::endl;
+    }
+}
+
+static void
+BenchSoftState (void)
+{
+  std::vector<Time> timestamps;
+  for (uint32_t i = 0; i < g_n; i++)
+    {
+      timestamps.push_back (Seconds ((i % 997) * 0.01));
+    }
+  Time lifetime = Seconds (5);
+  uint32_t expired = 0;
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t round = 0; round < 10; round++)
+    {
+      Time now = Seconds (round * 1.1);
+      for (std::vector<Time>::const_iterator i = timestamps.begin ();
+           i != timestamps.end (); i++)
+        {
+          if (now - *i > lifetime)
+            {
+              expired++;
+            }
+        }
+    }
+  Report ("softstate", 10 * g_n, time.End ());
+  if (expired == 0)
+    {
+      std::cout << "no expired tuple" << std::endl;
+    }
+}
+
+static uint32_t g_events = 0;
+static Time g_last;
+
+static void
+Hold (void)
+{
+  Time now = Simulator::Now ();
+  if (now < g_last)
+    {
+      std::cout << "events out of order" << std::endl;
+    }
+  g_last = now;
+  if (++g_events < g_n)
+    {
+      Simulator::Schedule (Seconds ((g_events % 100) * 0.0007), &Hold);
+    }
+}
+
+static void
+BenchSchedule (void)
+{
+  SystemWallClockMs time;
+  time.Start ();
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      Simulator::Schedule (Seconds (i * 0.0001), &Hold);
+    }
+  Simulator::Run ();
+  Report ("schedule", g_events, time.End ());
+  Simulator::Destroy ();
+}
+
+int main (int argc, char *argv[])
+{
+  for (int i = 1; i < argc; i++)
+    {
+      if (strncmp ("--n=", argv[i], strlen ("--n=")) == 0)
+        {
+          g_n = atoi (argv[i] + strlen ("--n="));
+        }
+      else
+        {
+          std::cout << "bench-time [--n=count]" << std::endl;
+          return 0;
+        }
+    }
+  BenchConvert ();
+  BenchSoftState ();
+  BenchSchedule ();
+  return 0;
+}
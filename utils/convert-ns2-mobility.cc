@@ -0,0 +1,48 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Converts an ns2 movement trace to the binary mobility trace played
+// by ns3::BinaryMobilityHelper.
+//
+
+#include "ns3/core-module.h"
+#include "ns3/binary-mobility-helper.h"
+
+#include <iostream>
+
+using namespace ns3;
+
+int main (int argc, char *argv[])
+{
+  std::string in;
+  std::string out;
+
+  CommandLine cmd;
+  cmd.AddValue ("in", "The ns2 movement trace", in);
+  cmd.AddValue ("out", "The binary mobility trace", out);
+  cmd.Parse (argc, argv);
+
+  if (in.empty () || out.empty ())
+    {
+      std::cerr << "usage: convert-ns2-mobility --in=ns2-trace --out=binary-trace" << std::endl;
+      return 1;
+    }
+  BinaryMobilityHelper::ConvertNs2 (in, out);
+  return 0;
+}
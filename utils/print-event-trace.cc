@@ -0,0 +1,301 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2009 University of Pennsylvania
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Summarizes a trace recorded with ns3::EventTrace:
+//
+//   export NS_ATTRIBUTE_DEFAULT="ns3::DefaultSimulatorImpl::EventTraceFile=run.etrace"
+//   ./waf --run "rapidnet-app ..."
+//   unset NS_ATTRIBUTE_DEFAULT
+//   ./waf --run "print-event-trace --trace=run.etrace --group=symbol"
+//
+// prints the wall-clock time spent in each event handler (--group=symbol),
+// each handler class (--group=class) or each node (--group=node). The
+// RapidNet rules show up as "rapidnet <tuple> <action>" regions; the
+// exclusive time of an event does not include the regions it contains.
+//
+// With --schedule=file, the insertions and removals of the run are
+// written in the format of ns3::RecordingScheduler, to be replayed by
+// bench-scheduler. Only the events which were run, or dequeued after
+// being cancelled, can be rebuilt.
+//
+
+#include "ns3/core-module.h"
+#include "ns3/simulator-module.h"
+#include "ns3/event-trace.h"
+
+#include <cxxabi.h>
+#include <stdlib.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+using namespace ns3;
+
+struct Entry
+{
+  Entry () : count (0), inclusive (0), exclusive (0) {}
+  uint64_t count;
+  uint64_t inclusive;
+  uint64_t exclusive;
+};
+
+struct Row
+{
+  std::string name;
+  Entry entry;
+  bool operator < (const Row &o) const
+  {
+    return entry.exclusive > o.entry.exclusive;
+  }
+};
+
+struct Scheduled
+{
+  uint64_t ts;
+  uint32_t uid;
+  uint32_t uidBegin;
+  uint32_t uidEnd;
+};
+
+// The events created by MakeEvent are local classes of the MakeEvent
+// functions: keep their first (template) argument, the type of the handler,
+// e.g. void (ns3::YansWifiChannel::*)(ns3::Ptr<ns3::Packet>, ...).
+static std::string
+GetHandlerName (std::string mangled)
+{
+  int status;
+  char *demangled = abi::__cxa_demangle (mangled.c_str (), 0, 0, &status);
+  if (demangled == 0)
+    {
+      return mangled;
+    }
+  std::string name = demangled;
+  free (demangled);
+  // MakeEvent<handler, ...>(...) or, without template, MakeEvent(handler)
+  std::string::size_type start = name.find ("MakeEvent");
+  if (start == std::string::npos)
+    {
+      return name;
+    }
+  start += std::string ("MakeEvent").size () + 1;
+  int level = 0;
+  for (std::string::size_type i = start; i < name.size (); i++)
+    {
+      char c = name[i];
+      if (c == '<' || c == '(')
+        {
+          level++;
+        }
+      else if (c == '>' || c == ')')
+        {
+          level--;
+        }
+      if (level < 0 || (level == 0 && c == ','))
+        {
+          return name.substr (start, i - start);
+        }
+    }
+  return name;
+}
+
+static std::string
+GetClassName (std::string handler)
+{
+  std::string::size_type end = handler.find ("::*)");
+  if (end != std::string::npos)
+    {
+      std::string::size_type start = handler.rfind ('(', end);
+      return handler.substr (start + 1, end - start - 1);
+    }
+  if (handler.find ("(*)") != std::string::npos)
+    {
+      return "functions";
+    }
+  // regions: "rapidnet <tuple> <action>"
+  return handler.substr (0, handler.find (' '));
+}
+
+static bool
+WriteSchedule (std::string fileName, const std::vector<Scheduled> &events)
+{
+  std::ofstream output (fileName.c_str ());
+  if (!output.is_open ())
+    {
+      return false;
+    }
+  std::map<uint32_t, uint64_t> ts;
+  for (std::vector<Scheduled>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      ts[i->uid] = i->ts;
+    }
+  uint32_t next = 0;
+  for (std::vector<Scheduled>::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      // the events scheduled before this one ran: before Simulator::Run
+      // for the first one, or inserted between two runs.
+      for (std::map<uint32_t, uint64_t>::const_iterator j = ts.lower_bound (next);
+           j != ts.end () && j->first < i->uidBegin; j++)
+        {
+          output << "i " << j->second << " " << j->first << "\n";
+        }
+      output << "n\n";
+      for (std::map<uint32_t, uint64_t>::const_iterator j = ts.lower_bound (i->uidBegin);
+           j != ts.end () && j->first < i->uidEnd; j++)
+        {
+          output << "i " << j->second << " " << j->first << "\n";
+        }
+      next = std::max (next, i->uidEnd);
+    }
+  return true;
+}
+
+int main (int argc, char *argv[])
+{
+  std::string trace;
+  std::string group = "symbol";
+  std::string schedule;
+  uint32_t top = 30;
+
+  CommandLine cmd;
+  cmd.AddValue ("trace", "Trace recorded with ns3::EventTrace", trace);
+  cmd.AddValue ("group", "Breakdown by symbol, class or node", group);
+  cmd.AddValue ("top", "Number of rows printed", top);
+  cmd.AddValue ("schedule", "Also write the scheduler operations to this file, for bench-scheduler", schedule);
+  cmd.Parse (argc, argv);
+
+  EventTraceReader reader;
+  if (trace.empty () || !reader.Open (trace))
+    {
+      std::cerr << "could not read " << trace << std::endl;
+      return 1;
+    }
+
+  std::map<std::string, Entry> entries;
+  std::map<uint32_t, std::string> handlers;
+  std::vector<uint64_t> childTime;
+  std::vector<Scheduled> events;
+  uint64_t nEvents = 0;
+  uint64_t nCancelled = 0;
+  uint64_t total = 0;
+  uint64_t firstTs = 0;
+  uint64_t lastTs = 0;
+  EventTrace::Record record;
+  while (reader.Read (record))
+    {
+      if (record.type != EventTrace::REGION)
+        {
+          Scheduled event = {record.ts, record.uid, record.uidBegin, record.uidEnd};
+          if (!schedule.empty ())
+            {
+              events.push_back (event);
+            }
+          if (nEvents + nCancelled == 0)
+            {
+              firstTs = record.ts;
+            }
+          lastTs = record.ts;
+          if (record.type == EventTrace::CANCELLED)
+            {
+              nCancelled++;
+              continue;
+            }
+          nEvents++;
+          total += record.duration;
+        }
+      // the regions of an event are written before it: their time is
+      // accumulated one level below, and subtracted from the parent.
+      if (childTime.size () < record.depth + 2u)
+        {
+          childTime.resize (record.depth + 2, 0);
+        }
+      uint64_t children = childTime[record.depth + 1];
+      childTime[record.depth + 1] = 0;
+      childTime[record.depth] += record.duration;
+
+      std::string key;
+      if (group == "node")
+        {
+          std::ostringstream oss;
+          if (record.context == Simulator::NO_CONTEXT)
+            {
+              oss << "no context";
+            }
+          else
+            {
+              oss << "node " << record.context;
+            }
+          key = oss.str ();
+        }
+      else
+        {
+          std::map<uint32_t, std::string>::const_iterator i = handlers.find (record.symbol);
+          if (i == handlers.end ())
+            {
+              i = handlers.insert (std::make_pair (record.symbol,
+                GetHandlerName (reader.GetSymbol (record.symbol)))).first;
+            }
+          key = group == "class" ? GetClassName (i->second) : i->second;
+        }
+      Entry &entry = entries[key];
+      entry.count++;
+      entry.inclusive += record.duration;
+      entry.exclusive += record.duration > children ? record.duration - children : 0;
+    }
+
+  std::cout << nEvents << " events, " << nCancelled << " cancelled, "
+            << total / 1e9 << " s of wall-clock time for "
+            << TimeStep (lastTs - firstTs).GetSeconds () << " s of simulated time"
+            << std::endl << std::endl;
+
+  std::vector<Row> rows;
+  for (std::map<std::string, Entry>::const_iterator i = entries.begin (); i != entries.end (); i++)
+    {
+      Row row;
+      row.name = i->first;
+      row.entry = i->second;
+      rows.push_back (row);
+    }
+  std::sort (rows.begin (), rows.end ());
+  std::cout << std::setw (7) << "self %" << std::setw (12) << "self ms"
+            << std::setw (12) << "total ms" << std::setw (12) << "count"
+            << std::setw (10) << "mean ns" << "  " << group << std::endl;
+  for (uint32_t i = 0; i < rows.size () && i < top; i++)
+    {
+      const Entry &entry = rows[i].entry;
+      std::cout << std::fixed << std::setprecision (1)
+                << std::setw (7) << (total == 0 ? 0.0 : 100.0 * entry.exclusive / total)
+                << std::setw (12) << entry.exclusive / 1e6
+                << std::setw (12) << entry.inclusive / 1e6
+                << std::setw (12) << entry.count
+                << std::setw (10) << std::setprecision (0)
+                << (double)entry.inclusive / entry.count
+                << "  " << rows[i].name << std::endl;
+    }
+
+  if (!schedule.empty () && !WriteSchedule (schedule, events))
+    {
+      std::cerr << "could not write " << schedule << std::endl;
+      return 1;
+    }
+  return 0;
+}